@@ -0,0 +1,438 @@
+/*
+ *   Copyright (c) 2024 Project CHIP Authors
+ *   All rights reserved.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+#include "PerfCommand.h"
+
+#include <app/InteractionModelEngine.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <tracing/metric_keys.h>
+#include <tracing/registry.h>
+
+#include <algorithm>
+#include <inttypes.h>
+
+using namespace ::chip;
+
+namespace {
+
+// Time allowed to establish the sessions to the nodes, on top of the duration of the load.
+constexpr uint16_t kConnectionTimeoutSeconds = 60;
+constexpr uint16_t kDefaultDurationSeconds   = 60;
+
+// Granularity of the pacing of the invokes.
+constexpr System::Clock::Milliseconds32 kSendInterval(10);
+
+uint64_t Percentile(const std::vector<uint64_t> & sortedSamples, uint8_t percent)
+{
+    size_t index = (sortedSamples.size() * percent + 99) / 100;
+    return sortedSamples[index == 0 ? 0 : index - 1];
+}
+
+// Rates are logged with two decimals, without relying on floating point support in the logging.
+uint64_t HundredthsPerSecond(uint64_t count, System::Clock::Milliseconds64 elapsed)
+{
+    return elapsed.count() == 0 ? 0 : count * 100000 / elapsed.count();
+}
+
+#define RateFormat "%" PRIu64 ".%02u/s"
+#define RateValue(count, elapsed)                                                                                                  \
+    HundredthsPerSecond(count, elapsed) / 100, static_cast<unsigned>(HundredthsPerSecond(count, elapsed) % 100)
+
+} // namespace
+
+void LatencyRecorder::Log(const char * label)
+{
+    if (mSamples.empty())
+    {
+        ChipLogProgress(chipTool, "  %s: no samples", label);
+        return;
+    }
+
+    std::sort(mSamples.begin(), mSamples.end());
+    ChipLogProgress(chipTool,
+                    "  %s (us): count %u min %" PRIu64 " p50 %" PRIu64 " p90 %" PRIu64 " p99 %" PRIu64 " max %" PRIu64, label,
+                    static_cast<unsigned>(mSamples.size()), mSamples.front(), Percentile(mSamples, 50), Percentile(mSamples, 90),
+                    Percentile(mSamples, 99), mSamples.back());
+}
+
+CHIP_ERROR PerfCommand::RunCommand()
+{
+    FabricIndex fabricIndex = CurrentCommissioner().GetFabricIndex();
+    VerifyOrReturnError(fabricIndex != kUndefinedFabricIndex, CHIP_ERROR_INCORRECT_STATE);
+
+    // Every node id of the range must be an operational node id, without the last one wrapping around.
+    VerifyOrReturnError(IsOperationalNodeId(mFirstNodeId) && mNodeCount - 1u <= kMaxOperationalNodeId - mFirstNodeId,
+                        CHIP_ERROR_INVALID_ARGUMENT,
+                        ChipLogError(chipTool, "The %u node ids from 0x" ChipLogFormatX64 " are not all operational node ids",
+                                     mNodeCount, ChipLogValueX64(mFirstNodeId)));
+
+    CASESessionManager * caseSessionManager = CurrentCommissioner().CASESessionMgr();
+    const FabricTable * fabricTable         = CurrentCommissioner().GetFabricTable();
+    VerifyOrReturnError(caseSessionManager != nullptr && fabricTable != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    mConnector = std::make_unique<Controller::CASESessionManagerReconnectConnector>(*caseSessionManager, *fabricTable);
+    const uint16_t maxConcurrent =
+        mMaxConcurrentConnections.ValueOr(static_cast<uint16_t>(Controller::CASEReconnectScheduler::kMaxConcurrent));
+    ReturnErrorOnFailure(mScheduler.Init(mConnector.get(), this, maxConcurrent, mPrefetchDepth.ValueOr(maxConcurrent)));
+
+    mMetrics.Reset();
+    Tracing::Register(mMetrics);
+    mMetricsRegistered = true;
+
+    mNodes.clear();
+    mConnectionTimes.Clear();
+    for (uint16_t i = 0; i < mNodeCount; i++)
+    {
+        mNodes.push_back(std::make_unique<Node>(mFirstNodeId + i));
+
+        const ScopedNodeId peerId(mNodes.back()->mNodeId, fabricIndex);
+        if (MeasuresSessionEstablishment())
+        {
+            CurrentCommissioner().SessionMgr()->ExpireAllSessions(peerId);
+        }
+        ReturnErrorOnFailure(mScheduler.Enqueue(peerId));
+    }
+
+    ChipLogProgress(chipTool, "Establishing sessions to %u nodes from 0x" ChipLogFormatX64, mNodeCount,
+                    ChipLogValueX64(mFirstNodeId));
+
+    // When the command measures the session establishments, their results start from here.
+    mConnectStartTime = System::SystemClock().GetMonotonicTimestamp();
+    mLoadStartTime    = mConnectStartTime;
+    return mScheduler.Start();
+}
+
+System::Clock::Timeout PerfCommand::GetWaitDuration() const
+{
+    return System::Clock::Seconds32(mDurationSeconds.ValueOr(kDefaultDurationSeconds) + kConnectionTimeoutSeconds);
+}
+
+void PerfCommand::Shutdown()
+{
+    DeviceLayer::SystemLayer().CancelTimer(OnLoadDurationElapsed, this);
+    StopLoad();
+
+    mScheduler.Cancel();
+    mConnector.reset();
+    mNodes.clear();
+
+    if (mMetricsRegistered)
+    {
+        Tracing::Unregister(mMetrics);
+        mMetricsRegistered = false;
+    }
+
+    CHIPCommand::Shutdown();
+}
+
+void PerfCommand::OnPeerConnected(const ScopedNodeId & peerId, Messaging::ExchangeManager & exchangeMgr,
+                                  const SessionHandle & sessionHandle)
+{
+    Node * node = FindNode(peerId);
+    VerifyOrReturn(node != nullptr);
+
+    node->mSession.Grab(sessionHandle);
+    mExchangeMgr = &exchangeMgr;
+    mConnectionTimes.Record(System::SystemClock().GetMonotonicTimestamp() - mConnectStartTime);
+}
+
+void PerfCommand::OnPeerConnectionFailure(const ScopedNodeId & peerId, CHIP_ERROR error)
+{
+    ChipLogError(chipTool, "Failed to connect to node 0x" ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
+                 ChipLogValueX64(peerId.GetNodeId()), error.Format());
+}
+
+void PerfCommand::OnReconnectComplete(const Controller::CASEReconnectScheduler::Stats & stats)
+{
+    ChipLogProgress(chipTool, "Sessions established to %u of %u nodes in %" PRIu64 " ms, with up to %u session setups in flight",
+                    static_cast<unsigned>(stats.connected), static_cast<unsigned>(mNodes.size()),
+                    static_cast<uint64_t>(stats.elapsed.count()), static_cast<unsigned>(stats.maxInFlight));
+    mConnectionTimes.Log("Time to session establishment");
+    VerifyOrReturn(stats.connected > 0, Finish(CHIP_ERROR_NOT_CONNECTED));
+
+    if (MeasuresSessionEstablishment())
+    {
+        Finish(CHIP_NO_ERROR);
+        return;
+    }
+
+    // Only count the retransmissions of the load, not the ones of the session establishments.
+    mMetrics.Reset();
+    mLoadStartTime = System::SystemClock().GetMonotonicTimestamp();
+
+    CHIP_ERROR err = StartLoad();
+    VerifyOrReturn(err == CHIP_NO_ERROR, Finish(err));
+
+    err = DeviceLayer::SystemLayer().StartTimer(System::Clock::Seconds32(mDurationSeconds.ValueOr(kDefaultDurationSeconds)),
+                                                OnLoadDurationElapsed, this);
+    VerifyOrReturn(err == CHIP_NO_ERROR, Finish(err));
+}
+
+PerfCommand::Node * PerfCommand::FindNode(const ScopedNodeId & peerId)
+{
+    VerifyOrReturnValue(peerId.GetNodeId() >= mFirstNodeId && peerId.GetNodeId() - mFirstNodeId < mNodes.size(), nullptr);
+    return mNodes[static_cast<size_t>(peerId.GetNodeId() - mFirstNodeId)].get();
+}
+
+void PerfCommand::OnLoadDurationElapsed(System::Layer * layer, void * context)
+{
+    auto * command = reinterpret_cast<PerfCommand *>(context);
+    command->Finish(CHIP_NO_ERROR);
+}
+
+void PerfCommand::Finish(CHIP_ERROR error)
+{
+    StopLoad();
+
+    if (error == CHIP_NO_ERROR)
+    {
+        System::Clock::Milliseconds64 elapsed = System::SystemClock().GetMonotonicTimestamp() - mLoadStartTime;
+        ChipLogProgress(chipTool, "Results after %" PRIu64 " ms:", elapsed.count());
+        LogResults(elapsed);
+
+        // Each acknowledged or abandoned message records the number of times it was retransmitted. The
+        // histogram stays empty if no reliable message completed, or if tracing is disabled in the build.
+        Tracing::Histogram::Log2Histogram retransmits;
+        mMetrics.GetHistogram(Tracing::kMetricMRPRetransmitCount, retransmits);
+        ChipLogProgress(chipTool,
+                        "  MRP retransmissions: %" PRIu64 " for %" PRIu64 " reliable messages (max %" PRIu64 " per message)",
+                        retransmits.Sum(), retransmits.Count(), retransmits.Max());
+    }
+
+    SetCommandExitStatus(error);
+}
+
+CHIP_ERROR PerfSubscribeCommand::StartLoad()
+{
+    VerifyOrReturnError(mMinInterval <= mMaxInterval, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mEstablishmentLatencies.Clear();
+    mEstablishedCount = 0;
+    mReportCount      = 0;
+    mAttributeCount   = 0;
+    mErrorCount       = 0;
+
+    for (auto & node : mNodes)
+    {
+        if (!node->mSession)
+        {
+            continue;
+        }
+
+        for (uint16_t i = 0; i < mSubscriptionsPerNode.ValueOr(1); i++)
+        {
+            auto subscription = std::make_unique<Subscription>(*this);
+            CHIP_ERROR err    = subscription->Start(*mExchangeMgr, node->mSession.Get().Value());
+            if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(chipTool, "Failed to subscribe to node 0x" ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
+                             ChipLogValueX64(node->mNodeId), err.Format());
+                mErrorCount++;
+                continue;
+            }
+            mSubscriptions.push_back(std::move(subscription));
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void PerfSubscribeCommand::StopLoad()
+{
+    // Destroying the read clients tears down the subscriptions on this side without calling OnDone.
+    mSubscriptions.clear();
+}
+
+void PerfSubscribeCommand::LogResults(System::Clock::Milliseconds64 elapsed)
+{
+    ChipLogProgress(chipTool, "  Subscriptions established: %" PRIu32 ", errors: %" PRIu32, mEstablishedCount, mErrorCount);
+    mEstablishmentLatencies.Log("Subscription establishment latency");
+    ChipLogProgress(chipTool, "  Reports: %" PRIu32 " (" RateFormat "), attribute reports: %" PRIu32 " (" RateFormat ")",
+                    mReportCount, RateValue(mReportCount, elapsed), mAttributeCount, RateValue(mAttributeCount, elapsed));
+}
+
+CHIP_ERROR PerfSubscribeCommand::Subscription::Start(Messaging::ExchangeManager & exchangeMgr, const SessionHandle & session)
+{
+    mPath = app::AttributePathParams(mCommand.mEndpointId, mCommand.mClusterId, mCommand.mAttributeId);
+
+    app::ReadPrepareParams params(session);
+    params.mpAttributePathParamsList    = &mPath;
+    params.mAttributePathParamsListSize = 1;
+    params.mMinIntervalFloorSeconds     = mCommand.mMinInterval;
+    params.mMaxIntervalCeilingSeconds   = mCommand.mMaxInterval;
+    // The subscriptions of the load must not replace each other on the node.
+    params.mKeepSubscriptions = true;
+
+    mClient = std::make_unique<app::ReadClient>(app::InteractionModelEngine::GetInstance(), &exchangeMgr, *this,
+                                                app::ReadClient::InteractionType::Subscribe);
+    VerifyOrReturnError(mClient != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    mRequestTime   = System::SystemClock().GetMonotonicMicroseconds64();
+    CHIP_ERROR err = mClient->SendRequest(params);
+    if (err != CHIP_NO_ERROR)
+    {
+        mClient.reset();
+    }
+    return err;
+}
+
+void PerfSubscribeCommand::Subscription::OnAttributeData(const app::ConcreteDataAttributePath & path, TLV::TLVReader * data,
+                                                         const app::StatusIB & status)
+{
+    // The priming report is part of the establishment of the subscription.
+    VerifyOrReturn(mEstablished);
+    mCommand.mAttributeCount++;
+}
+
+void PerfSubscribeCommand::Subscription::OnReportEnd()
+{
+    VerifyOrReturn(mEstablished);
+    mCommand.mReportCount++;
+}
+
+void PerfSubscribeCommand::Subscription::OnSubscriptionEstablished(SubscriptionId subscriptionId)
+{
+    mEstablished = true;
+    mCommand.mEstablishedCount++;
+    mCommand.mEstablishmentLatencies.Record(System::SystemClock().GetMonotonicMicroseconds64() - mRequestTime);
+}
+
+void PerfSubscribeCommand::Subscription::OnError(CHIP_ERROR error)
+{
+    ChipLogError(chipTool, "Subscription error: %" CHIP_ERROR_FORMAT, error.Format());
+    mCommand.mErrorCount++;
+}
+
+void PerfSubscribeCommand::Subscription::OnDone(app::ReadClient * client)
+{
+    mClient.reset();
+}
+
+CHIP_ERROR PerfInvokeCommand::StartLoad()
+{
+    mLatencies.Clear();
+    mNextNode           = 0;
+    mAttemptedCount     = 0;
+    mSendFailureCount   = 0;
+    mSuccessCount       = 0;
+    mStatusFailureCount = 0;
+    mErrorCount         = 0;
+
+    mRunning   = true;
+    mStartTime = System::SystemClock().GetMonotonicTimestamp();
+    return DeviceLayer::SystemLayer().StartTimer(kSendInterval, OnSendTimer, this);
+}
+
+void PerfInvokeCommand::StopLoad()
+{
+    mRunning = false;
+    DeviceLayer::SystemLayer().CancelTimer(OnSendTimer, this);
+
+    // Destroying the command senders aborts their exchanges without calling OnDone.
+    mPendingInvokes.clear();
+}
+
+void PerfInvokeCommand::LogResults(System::Clock::Milliseconds64 elapsed)
+{
+    ChipLogProgress(chipTool, "  Invokes sent: %" PRIu64 " (" RateFormat ", target %u/s), send failures: %" PRIu32,
+                    mAttemptedCount, RateValue(mAttemptedCount, elapsed), mInvokesPerSecond, mSendFailureCount);
+    ChipLogProgress(chipTool,
+                    "  Responses: %" PRIu32 " successful, %" PRIu32 " with a failure status, errors: %" PRIu32
+                    ", in flight: %u",
+                    mSuccessCount, mStatusFailureCount, mErrorCount, static_cast<unsigned>(mPendingInvokes.size()));
+    mLatencies.Log("Invoke latency");
+}
+
+void PerfInvokeCommand::OnSendTimer(System::Layer * layer, void * context)
+{
+    auto * command = reinterpret_cast<PerfInvokeCommand *>(context);
+    VerifyOrReturn(command->mRunning);
+
+    command->SendDueInvokes();
+    DeviceLayer::SystemLayer().StartTimer(kSendInterval, OnSendTimer, command);
+}
+
+void PerfInvokeCommand::SendDueInvokes()
+{
+    // Catch up on the invokes due since the start, so that the rate does not drift with the timer latency.
+    System::Clock::Milliseconds64 elapsed = System::SystemClock().GetMonotonicTimestamp() - mStartTime;
+    uint64_t due                          = elapsed.count() * mInvokesPerSecond / 1000;
+
+    while (mAttemptedCount < due)
+    {
+        // Round-robin over the nodes that still have a session.
+        Optional<SessionHandle> session;
+        for (size_t i = 0; i < mNodes.size() && !session.HasValue(); i++)
+        {
+            session   = mNodes[mNextNode]->mSession.Get();
+            mNextNode = (mNextNode + 1) % mNodes.size();
+        }
+
+        mAttemptedCount++;
+        CHIP_ERROR err = session.HasValue() ? SendInvoke(session.Value()) : CHIP_ERROR_NOT_CONNECTED;
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(chipTool, "Failed to send invoke: %" CHIP_ERROR_FORMAT, err.Format());
+            mSendFailureCount++;
+        }
+    }
+}
+
+CHIP_ERROR PerfInvokeCommand::SendInvoke(const SessionHandle & session)
+{
+    app::CommandPathParams commandPath = { mEndpointId, mClusterId, mCommandId, (app::CommandPathFlags::kEndpointIdValid) };
+
+    auto commandSender = std::make_unique<app::CommandSender>(this, mExchangeMgr);
+    VerifyOrReturnError(commandSender != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    ReturnErrorOnFailure(commandSender->AddRequestData(commandPath, InvokePayload{ mPayload }));
+
+    System::Clock::Microseconds64 sendTime = System::SystemClock().GetMonotonicMicroseconds64();
+    ReturnErrorOnFailure(commandSender->SendCommandRequest(session));
+
+    app::CommandSender * key = commandSender.get();
+    mPendingInvokes[key]     = PendingInvoke{ std::move(commandSender), sendTime };
+    return CHIP_NO_ERROR;
+}
+
+void PerfInvokeCommand::OnResponse(app::CommandSender * commandSender, const app::CommandSender::ResponseData & responseData)
+{
+    auto it = mPendingInvokes.find(commandSender);
+    VerifyOrReturn(it != mPendingInvokes.end());
+
+    mLatencies.Record(System::SystemClock().GetMonotonicMicroseconds64() - it->second.mSendTime);
+    if (responseData.statusIB.IsSuccess())
+    {
+        mSuccessCount++;
+    }
+    else
+    {
+        mStatusFailureCount++;
+    }
+}
+
+void PerfInvokeCommand::OnError(const app::CommandSender * commandSender, const app::CommandSender::ErrorData & errorData)
+{
+    ChipLogError(chipTool, "Invoke error: %" CHIP_ERROR_FORMAT, errorData.error.Format());
+    mErrorCount++;
+}
+
+void PerfInvokeCommand::OnDone(app::CommandSender * commandSender)
+{
+    mPendingInvokes.erase(commandSender);
+}
@@ -0,0 +1,294 @@
+/*
+ *   Copyright (c) 2024 Project CHIP Authors
+ *   All rights reserved.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "../common/CHIPCommand.h"
+#include "commands/clusters/CustomArgument.h"
+
+#include <app/CommandSender.h>
+#include <app/OperationalSessionSetup.h>
+#include <app/ReadClient.h>
+#include <controller/CASEReconnectScheduler.h>
+#include <tracing/histogram/histogram_tracing.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+/**
+ * Collects the latencies measured during a load test, and logs them as percentiles.
+ */
+class LatencyRecorder
+{
+public:
+    void Record(chip::System::Clock::Microseconds64 latency) { mSamples.push_back(latency.count()); }
+    void Clear() { mSamples.clear(); }
+    size_t Count() const { return mSamples.size(); }
+
+    void Log(const char * label);
+
+private:
+    std::vector<uint64_t> mSamples;
+};
+
+/**
+ * Base class of the load testing commands.
+ *
+ * Establishes CASE sessions to `node-count` consecutive node ids starting at `first-node-id`,
+ * through a CASEReconnectScheduler that bounds the number of session setups in flight, then
+ * runs the load of the subclass against all the nodes that could be reached for
+ * `duration-seconds`, and logs the results along with the number of MRP retransmissions
+ * that took place during the run.
+ */
+class PerfCommand : public CHIPCommand, public chip::Controller::CASEReconnectScheduler::Delegate
+{
+public:
+    PerfCommand(const char * commandName, CredentialIssuerCommands * credIssuerCmds, const char * helpText) :
+        CHIPCommand(commandName, credIssuerCmds, helpText)
+    {
+        AddArgument("first-node-id", 0, UINT64_MAX, &mFirstNodeId, "Node id of the first node to load.");
+        AddArgument("node-count", 1, UINT16_MAX, &mNodeCount, "Number of nodes to load, with consecutive node ids.");
+        AddArgument("duration-seconds", 1, UINT16_MAX, &mDurationSeconds,
+                    "Duration of the load, once the sessions to the nodes are established. Defaults to 60 seconds.");
+        AddArgument("max-concurrent-connections", 1, chip::Controller::CASEReconnectScheduler::kMaxConcurrent,
+                    &mMaxConcurrentConnections,
+                    "Maximum number of CASE session setups in flight. Defaults to the number of CASE clients of the controller.");
+        AddArgument("prefetch-depth", 0, UINT16_MAX, &mPrefetchDepth,
+                    "Number of queued nodes whose operational discovery starts ahead of their session setup. Defaults to "
+                    "max-concurrent-connections.");
+    }
+
+    /////////// CHIPCommand Interface /////////
+    CHIP_ERROR RunCommand() override;
+    chip::System::Clock::Timeout GetWaitDuration() const override;
+    void Shutdown() override;
+
+    /////////// CASEReconnectScheduler::Delegate Interface /////////
+    void OnPeerConnected(const chip::ScopedNodeId & peerId, chip::Messaging::ExchangeManager & exchangeMgr,
+                         const chip::SessionHandle & sessionHandle) override;
+    void OnPeerConnectionFailure(const chip::ScopedNodeId & peerId, CHIP_ERROR error) override;
+    void OnReconnectComplete(const chip::Controller::CASEReconnectScheduler::Stats & stats) override;
+
+protected:
+    struct Node
+    {
+        Node(chip::NodeId nodeId) : mNodeId(nodeId) {}
+
+        chip::NodeId mNodeId;
+        chip::SessionHolder mSession;
+    };
+
+    /**
+     * Whether the command measures the establishment of the sessions rather than a load run over
+     * them. If so, the existing sessions to the nodes are expired first, so that every node goes
+     * through a full CASE handshake, and the command completes once all the session setups are done.
+     */
+    virtual bool MeasuresSessionEstablishment() const { return false; }
+
+    /**
+     * Starts the load against the nodes that have a session. Called once all the sessions
+     * have been established or have failed.
+     */
+    virtual CHIP_ERROR StartLoad() = 0;
+
+    /**
+     * Stops the load and releases all its resources. Might be called several times.
+     */
+    virtual void StopLoad() = 0;
+
+    /**
+     * Logs the results of the load, which ran for `elapsed`.
+     */
+    virtual void LogResults(chip::System::Clock::Milliseconds64 elapsed) = 0;
+
+    std::vector<std::unique_ptr<Node>> mNodes;
+    chip::Messaging::ExchangeManager * mExchangeMgr = nullptr;
+
+private:
+    static void OnLoadDurationElapsed(chip::System::Layer * layer, void * context);
+
+    Node * FindNode(const chip::ScopedNodeId & peerId);
+    void Finish(CHIP_ERROR error);
+
+    chip::NodeId mFirstNodeId;
+    uint16_t mNodeCount;
+    chip::Optional<uint16_t> mDurationSeconds;
+    chip::Optional<uint16_t> mMaxConcurrentConnections;
+    chip::Optional<uint16_t> mPrefetchDepth;
+
+    std::unique_ptr<chip::Controller::CASESessionManagerReconnectConnector> mConnector;
+    chip::Controller::CASEReconnectScheduler mScheduler;
+    LatencyRecorder mConnectionTimes;
+    chip::System::Clock::Timestamp mConnectStartTime;
+    chip::System::Clock::Timestamp mLoadStartTime;
+
+    // Aggregates the metric events of the SDK, for the MRP retransmit counts.
+    chip::Tracing::Histogram::HistogramBackend mMetrics;
+    bool mMetricsRegistered = false;
+};
+
+/**
+ * Measures how long it takes to establish CASE sessions to many nodes from scratch, e.g. when a
+ * controller restarts, for a given bound on the number of session setups in flight.
+ */
+class PerfReconnectCommand : public PerfCommand
+{
+public:
+    PerfReconnectCommand(CredentialIssuerCommands * credIssuerCmds) :
+        PerfCommand("reconnect", credIssuerCmds,
+                    "Establish new CASE sessions to many nodes and measure the time until all are established.")
+    {}
+
+protected:
+    bool MeasuresSessionEstablishment() const override { return true; }
+    CHIP_ERROR StartLoad() override { return CHIP_NO_ERROR; }
+    void StopLoad() override {}
+    void LogResults(chip::System::Clock::Milliseconds64 elapsed) override {}
+};
+
+class PerfSubscribeCommand : public PerfCommand
+{
+public:
+    PerfSubscribeCommand(CredentialIssuerCommands * credIssuerCmds) :
+        PerfCommand("subscribe-load", credIssuerCmds, "Open concurrent subscriptions to many nodes and measure their reports.")
+    {
+        AddArgument("endpoint-id", 0, UINT16_MAX, &mEndpointId);
+        AddArgument("cluster-id", 0, UINT32_MAX, &mClusterId);
+        AddArgument("attribute-id", 0, UINT32_MAX, &mAttributeId);
+        AddArgument("min-interval", 0, UINT16_MAX, &mMinInterval,
+                    "Server should not send a new report if less than this number of seconds has elapsed since the last report.");
+        AddArgument("max-interval", 0, UINT16_MAX, &mMaxInterval,
+                    "Server must send a report if this number of seconds has elapsed since the last report.");
+        AddArgument("subscriptions-per-node", 1, UINT16_MAX, &mSubscriptionsPerNode,
+                    "Number of concurrent subscriptions to open on each node. Defaults to 1.");
+    }
+
+protected:
+    CHIP_ERROR StartLoad() override;
+    void StopLoad() override;
+    void LogResults(chip::System::Clock::Milliseconds64 elapsed) override;
+
+private:
+    class Subscription : public chip::app::ReadClient::Callback
+    {
+    public:
+        Subscription(PerfSubscribeCommand & command) : mCommand(command) {}
+
+        CHIP_ERROR Start(chip::Messaging::ExchangeManager & exchangeMgr, const chip::SessionHandle & session);
+
+        // ReadClient::Callback implementation.
+        void OnAttributeData(const chip::app::ConcreteDataAttributePath & path, chip::TLV::TLVReader * data,
+                             const chip::app::StatusIB & status) override;
+        void OnReportEnd() override;
+        void OnSubscriptionEstablished(chip::SubscriptionId subscriptionId) override;
+        void OnError(CHIP_ERROR error) override;
+        void OnDone(chip::app::ReadClient * client) override;
+
+    private:
+        PerfSubscribeCommand & mCommand;
+        std::unique_ptr<chip::app::ReadClient> mClient;
+        chip::app::AttributePathParams mPath;
+        chip::System::Clock::Microseconds64 mRequestTime;
+        bool mEstablished = false;
+    };
+
+    chip::EndpointId mEndpointId;
+    chip::ClusterId mClusterId;
+    chip::AttributeId mAttributeId;
+    uint16_t mMinInterval;
+    uint16_t mMaxInterval;
+    chip::Optional<uint16_t> mSubscriptionsPerNode;
+
+    std::vector<std::unique_ptr<Subscription>> mSubscriptions;
+    LatencyRecorder mEstablishmentLatencies;
+    uint32_t mEstablishedCount = 0;
+    uint32_t mReportCount      = 0;
+    uint32_t mAttributeCount   = 0;
+    uint32_t mErrorCount       = 0;
+};
+
+class PerfInvokeCommand : public PerfCommand, public chip::app::CommandSender::ExtendableCallback
+{
+public:
+    PerfInvokeCommand(CredentialIssuerCommands * credIssuerCmds) :
+        PerfCommand("invoke-load", credIssuerCmds, "Send invokes to many nodes at a fixed rate and measure their latency.")
+    {
+        AddArgument("endpoint-id", 0, UINT16_MAX, &mEndpointId);
+        AddArgument("cluster-id", 0, UINT32_MAX, &mClusterId);
+        AddArgument("command-id", 0, UINT32_MAX, &mCommandId);
+        AddArgument("payload", &mPayload,
+                    "The command payload, as a JSON-encoded object with string representations of field ids as keys (e.g. "
+                    "'{}' for a command without fields). See the 'any command-by-id' command for the encoding of the values.");
+        AddArgument("invokes-per-second", 1, UINT16_MAX, &mInvokesPerSecond,
+                    "Total rate of the invokes, spread round-robin across the nodes.");
+    }
+
+protected:
+    CHIP_ERROR StartLoad() override;
+    void StopLoad() override;
+    void LogResults(chip::System::Clock::Milliseconds64 elapsed) override;
+
+    // CommandSender::ExtendableCallback implementation.
+    void OnResponse(chip::app::CommandSender * commandSender,
+                    const chip::app::CommandSender::ResponseData & responseData) override;
+    void OnError(const chip::app::CommandSender * commandSender,
+                 const chip::app::CommandSender::ErrorData & errorData) override;
+    void OnDone(chip::app::CommandSender * commandSender) override;
+
+private:
+    // Gives the payload argument the interface CommandSender::AddRequestData expects of command data. The invokes are
+    // never timed: a command that requires a timed invoke gets a NeedsTimedInteraction status, counted as a failure.
+    struct InvokePayload
+    {
+        static constexpr bool MustUseTimedInvoke() { return false; }
+        static constexpr bool kIsFabricScoped = false;
+
+        CHIP_ERROR Encode(chip::TLV::TLVWriter & writer, chip::TLV::Tag tag) const { return mPayload.Encode(writer, tag); }
+
+        const CustomArgument & mPayload;
+    };
+
+    struct PendingInvoke
+    {
+        std::unique_ptr<chip::app::CommandSender> mSender;
+        chip::System::Clock::Microseconds64 mSendTime;
+    };
+
+    static void OnSendTimer(chip::System::Layer * layer, void * context);
+
+    void SendDueInvokes();
+    CHIP_ERROR SendInvoke(const chip::SessionHandle & session);
+
+    chip::EndpointId mEndpointId;
+    chip::ClusterId mClusterId;
+    chip::CommandId mCommandId;
+    CustomArgument mPayload;
+    uint16_t mInvokesPerSecond;
+
+    std::map<chip::app::CommandSender *, PendingInvoke> mPendingInvokes;
+    chip::System::Clock::Timestamp mStartTime;
+    size_t mNextNode             = 0;
+    uint64_t mAttemptedCount     = 0;
+    uint32_t mSendFailureCount   = 0;
+    uint32_t mSuccessCount       = 0;
+    uint32_t mStatusFailureCount = 0;
+    uint32_t mErrorCount         = 0;
+    LatencyRecorder mLatencies;
+    bool mRunning = false;
+};
@@ -27,6 +27,7 @@
 #include "commands/interactive/Commands.h"
 #include "commands/pairing/Commands.h"
 #include "commands/payload/Commands.h"
+#include "commands/perf/Commands.h"
 #include "commands/session-management/Commands.h"
 #include "commands/storage/Commands.h"
 
@@ -50,6 +51,7 @@ int main(int argc, char * argv[])
     registerCommandsSubscriptions(commands, &credIssuerCommands);
     registerCommandsStorage(commands);
     registerCommandsSessionManagement(commands, &credIssuerCommands);
+    registerCommandsPerf(commands, &credIssuerCommands);
 
     return commands.Run(argc, argv);
 }
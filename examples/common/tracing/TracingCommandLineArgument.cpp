@@ -19,6 +19,7 @@
 
 #include <lib/support/StringSplitter.h>
 #include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceLayer.h>
 #include <tracing/json/json_tracing.h>
 #include <tracing/registry.h>
 
@@ -27,6 +28,7 @@
 #include <tracing/perfetto/simple_initialize.h> // nogncheck
 #endif
 
+#include <cstdlib>
 #include <memory>
 #include <string>
 
@@ -47,6 +49,12 @@ bool StartsWith(CharSpan argument, const char * prefix)
     return argument.data_equal(CharSpan(prefix, prefix_len));
 }
 
+// Default window for periodic histogram snapshots
+constexpr System::Clock::Seconds32 kDefaultHistogramSnapshotInterval = System::Clock::Seconds32(60);
+
+// How often the event loop lag probe samples the event loop
+constexpr System::Clock::Milliseconds32 kEventLoopLagProbePeriod = System::Clock::Milliseconds32(100);
+
 } // namespace
 
 void TracingSetup::EnableTracingFor(const char * cliArg)
@@ -74,6 +82,28 @@ void TracingSetup::EnableTracingFor(const char * cliArg)
             }
             chip::Tracing::Register(mJsonBackend);
         }
+        else if (value.data_equal(CharSpan::fromCharString("histogram")) || StartsWith(value, "histogram:"))
+        {
+            System::Clock::Seconds32 interval = kDefaultHistogramSnapshotInterval;
+            if (value.size() > 10)
+            {
+                std::string seconds(value.data() + 10, value.size() - 10);
+                interval = System::Clock::Seconds32(static_cast<uint32_t>(strtoul(seconds.c_str(), nullptr, 10)));
+            }
+
+            // Each periodic snapshot covers only the preceding window so regressions are not averaged away.
+            mHistogramBackend.SetSnapshotInterval(interval, /* resetAfterSnapshot = */ true);
+            chip::Tracing::Register(mHistogramBackend);
+
+            if (DeviceLayer::SystemLayer().IsInitialized() && !mEventLoopLagProbe.IsRunning())
+            {
+                CHIP_ERROR err = mEventLoopLagProbe.Start(DeviceLayer::SystemLayer(), kEventLoopLagProbePeriod);
+                if (err != CHIP_NO_ERROR)
+                {
+                    ChipLogError(AppServer, "Failed to start event loop lag probe: %" CHIP_ERROR_FORMAT, err.Format());
+                }
+            }
+        }
 #if ENABLE_PERFETTO_TRACING
         else if (value.data_equal(CharSpan::fromCharString("perfetto")))
         {
@@ -112,6 +142,14 @@ void TracingSetup::StopTracing()
 
 #endif
 
+    mEventLoopLagProbe.Stop();
+    if (mHistogramBackend.IsInList())
+    {
+        // Emit whatever was collected since the last periodic snapshot.
+        mHistogramBackend.Snapshot();
+    }
+    chip::Tracing::Unregister(mHistogramBackend);
+
     chip::Tracing::Unregister(mJsonBackend);
 }
 
@@ -19,6 +19,8 @@
 
 #include "tracing/enabled_features.h"
 
+#include <tracing/histogram/event_loop_lag_probe.h>
+#include <tracing/histogram/histogram_tracing.h>
 #include <tracing/json/json_tracing.h>
 
 #if ENABLE_PERFETTO_TRACING
@@ -29,9 +31,10 @@
 /// A string with supported command line tracing targets
 /// to be pretty-printed in help strings if needed
 #if ENABLE_PERFETTO_TRACING
-#define SUPPORTED_COMMAND_LINE_TRACING_TARGETS "json:log, json:<path>, perfetto, perfetto:<path>"
+#define SUPPORTED_COMMAND_LINE_TRACING_TARGETS                                                                                    \
+    "json:log, json:<path>, histogram, histogram:<seconds>, perfetto, perfetto:<path>"
 #else
-#define SUPPORTED_COMMAND_LINE_TRACING_TARGETS "json:log, json:<path>"
+#define SUPPORTED_COMMAND_LINE_TRACING_TARGETS "json:log, json:<path>, histogram, histogram:<seconds>"
 #endif
 
 namespace chip {
@@ -58,6 +61,8 @@ public:
 
 private:
     ::chip::Tracing::Json::JsonBackend mJsonBackend;
+    ::chip::Tracing::Histogram::HistogramBackend mHistogramBackend;
+    ::chip::Tracing::Histogram::EventLoopLagProbe mEventLoopLagProbe;
 
 #if ENABLE_PERFETTO_TRACING
     chip::Tracing::Perfetto::FileTraceOutput mPerfettoFileOutput;
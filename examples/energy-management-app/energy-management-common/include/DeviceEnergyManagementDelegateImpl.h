@@ -18,9 +18,14 @@
 
 #pragma once
 
+#include "app/clusters/device-energy-management-server/ForecastEngine.h"
+#include "app/clusters/device-energy-management-server/ForecastStore.h"
 #include "app/clusters/device-energy-management-server/device-energy-management-server.h"
 
 #include <app/util/config.h>
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+#include <lib/support/PersistedCounter.h>
+
 #include <cstring>
 
 using chip::Protocols::InteractionModel::Status;
@@ -35,6 +40,24 @@ namespace DeviceEnergyManagement {
 class DeviceEnergyManagementDelegate : public DeviceEnergyManagement::Delegate
 {
 public:
+    static constexpr size_t kMaxForecastSlots       = 10;
+    static constexpr size_t kMaxForecastConstraints = 10;
+    static constexpr size_t kMaxPowerAdjustments    = 8;
+    // ForecastIds are reserved in blocks of this size, so that the storage is only written once per block.
+    static constexpr uint16_t kForecastIdBlockSize = 32;
+
+    /**
+     * @brief Restores the Forecast and PowerAdjustmentCapability saved before the last restart,
+     *        and resumes the ForecastId sequence from `storage`.
+     *
+     * The forecast itself may be persisted late (e.g. through a DeferredAttributePersistenceProvider),
+     * so the ForecastIds are reserved in `storage` before they are used: after a restart, the
+     * sequence resumes past every ForecastId that could have been reported, even by a lost forecast.
+     *
+     * To be called once the endpoint is set, i.e. once the cluster instance exists.
+     */
+    void RestorePersistentState(PersistentStorageDelegate & storage);
+
     virtual Status PowerAdjustRequest(const int64_t power, const uint32_t duration, AdjustmentCauseEnum cause) override;
     virtual Status CancelPowerAdjustRequest() override;
     virtual Status StartTimeAdjustRequest(const uint32_t requestedStartTime, AdjustmentCauseEnum cause) override;
@@ -71,13 +94,25 @@ public:
     virtual CHIP_ERROR SetForecast(DataModel::Nullable<Structs::ForecastStruct::Type>) override;
 
 private:
+    void CommitForecast(size_t slotCount, ForecastUpdateReasonEnum reason);
+    uint16_t NextForecastId(uint16_t currentForecastId);
+    void SaveForecast();
+
     ESATypeEnum mEsaType;
     bool mEsaCanGenerate;
     ESAStateEnum mEsaState;
     int64_t mAbsMinPower;
     int64_t mAbsMaxPower;
     Attributes::PowerAdjustmentCapability::TypeInfo::Type mPowerAdjustmentCapability;
+    Structs::PowerAdjustStruct::Type mPowerAdjustments[kMaxPowerAdjustments];
     DataModel::Nullable<Structs::ForecastStruct::Type> mForecast;
+    // mForecast points at the slots of mSlots[mActiveSlots]. Revised forecasts are computed in
+    // the other buffer, so that a rejected request leaves the current forecast untouched.
+    Structs::SlotStruct::Type mSlots[2][kMaxForecastSlots];
+    size_t mActiveSlots = 0;
+    Structs::ConstraintsStruct::Type mConstraints[kMaxForecastConstraints];
+    PersistedCounter<uint16_t> mForecastIdCounter;
+    bool mForecastIdCounterReady = false;
     // Default to NoOptOut
     OptOutStateEnum mOptOutState = OptOutStateEnum::kNoOptOut;
 };
@@ -23,6 +23,8 @@
 #include <EnergyEvseManager.h>
 #include <PowerTopologyDelegate.h>
 
+#include <app/clusters/electrical-energy-measurement-server/EnergyTimeSeries.h>
+
 using chip::Protocols::InteractionModel::Status;
 namespace chip {
 namespace app {
@@ -47,6 +49,7 @@ public:
     EnergyEvseManager * GetEvseInstance() { return mEvseInstance; }
     ElectricalPowerMeasurement::ElectricalPowerMeasurementInstance * GetEPMInstance() { return mEPMInstance; }
     PowerTopology::PowerTopologyInstance * GetPTInstance() { return mPTInstance; }
+    const ElectricalEnergyMeasurement::EnergyTimeSeries & GetEnergyHistory() const { return mEnergyHistory; }
 
     EnergyEvseDelegate * GetEvseDelegate()
     {
@@ -175,6 +178,12 @@ private:
 
     int64_t mLastChargingEnergyMeter    = 0;
     int64_t mLastDischargingEnergyMeter = 0;
+
+    /* History of the periodic energy readings: the last 16 readings, the last hour
+     * per minute, and the last day per quarter of an hour and per hour */
+    ElectricalEnergyMeasurement::EnergyTimeSeriesWithStorage<16, 60, 96, 24> mEnergyHistory{
+        ElectricalEnergyMeasurement::EnergyTimeSeries::Source::kPeriodic
+    };
 };
 
 /** @brief Helper function to return the singleton EVSEManufacturer instance
@@ -21,7 +21,12 @@
 #include "app/clusters/energy-evse-server/energy-evse-server.h"
 #include <EVSECallbacks.h>
 
+#include <app/clusters/energy-evse-server/ChargingPlanner.h>
+#include <app/clusters/energy-evse-server/ChargingTargetsStore.h>
+#include <app/clusters/energy-evse-server/EvseLoadBalancer.h>
+#include <app/clusters/energy-evse-server/RandomizedStartScheduler.h>
 #include <app/util/config.h>
+#include <lib/core/CHIPPersistentStorageDelegate.h>
 #include <cstring>
 
 using chip::Protocols::InteractionModel::Status;
@@ -104,7 +109,9 @@ private:
  * The application delegate.
  */
 
-class EnergyEvseDelegate : public EnergyEvse::Delegate
+class EnergyEvseDelegate : public EnergyEvse::Delegate,
+                           public EvseLoadBalancer::Participant,
+                           public RandomizedStartScheduler::Transition
 {
 public:
     ~EnergyEvseDelegate();
@@ -138,6 +145,45 @@ public:
      */
     Status StartDiagnostics() override;
 
+    /**
+     * @brief    Called when EVSE cluster receives SetTargets command
+     */
+    Status SetTargets(
+        const DataModel::DecodableList<Structs::ChargingTargetScheduleStruct::DecodableType> & chargingTargetSchedules) override;
+
+    /**
+     * @brief    Called when EVSE cluster receives GetTargets command
+     */
+    Status GetTargets(DataModel::List<const Structs::ChargingTargetScheduleStruct::Type> & chargingTargetSchedules) override;
+
+    /**
+     * @brief    Called when EVSE cluster receives ClearTargets command
+     */
+    Status ClearTargets() override;
+
+    /**
+     * @brief    Loads the persisted charging targets and computes the first charging plan
+     *
+     * @param    storage - storage used to persist the charging targets
+     */
+    CHIP_ERROR LoadChargingTargets(PersistentStorageDelegate & storage);
+
+    /**
+     * @brief    Shares the circuit capacity of the site with the other EVSEs registered with `balancer`
+     *
+     * The MaximumChargeCurrent is then the current allocated by the balancer, rather than
+     * this EVSE's own limit. Passing nullptr leaves the balancer.
+     */
+    CHIP_ERROR SetLoadBalancer(EvseLoadBalancer * balancer);
+
+    /**
+     * @brief    Randomizes the start of charging over the RandomizationDelayWindow once charging is enabled
+     *
+     * Without a scheduler (the default), charging starts as soon as it is enabled. Passing nullptr
+     * cancels a pending start.
+     */
+    void SetStartScheduler(RandomizedStartScheduler * scheduler);
+
     /**
      * @brief    Called by EVSE Hardware to register a single callback handler
      */
@@ -277,6 +323,23 @@ private:
      */
     Status ComputeMaxChargeCurrentLimit();
 
+    /**
+     * @brief Updates the MaximumChargeCurrent attribute and notifies the hardware
+     */
+    void ApplyMaximumChargeCurrent(int64_t maximumChargeCurrent);
+
+    /* Randomized start of charging */
+    RandomizedStartScheduler * mStartScheduler = nullptr;
+    void StartCharging();
+    void OnRandomizedStart() override;
+
+    /* Site load balancing */
+    EvseLoadBalancer * mLoadBalancer = nullptr;
+    int64_t GetLocalCurrentLimit() override { return mActualChargingCurrentLimit; }
+    int64_t GetMinimumCurrent() override { return mMinimumChargeCurrent; }
+    bool IsDrawingCurrent() override { return mState == StateEnum::kPluggedInCharging; }
+    void OnCurrentAllocated(int64_t current) override { ApplyMaximumChargeCurrent(current); }
+
     /**
      * @brief This checks if the charging or discharging needs to be disabled
      *
@@ -285,6 +348,17 @@ private:
      */
     static void EvseCheckTimerExpiry(System::Layer * systemLayer, void * delegate);
 
+    /**
+     * @brief Brings the NextCharge* attributes up to date with the charging targets,
+     *        and schedules the next update for when the planned target passes
+     */
+    void UpdateChargingPlan();
+    static void ChargingPlanTimerExpiry(System::Layer * systemLayer, void * delegate);
+
+    /* Charging targets (PREF feature) and the plan derived from them */
+    ChargingTargetsStore mChargingTargets;
+    ChargingPlanner mChargingPlanner;
+
     /* Attributes */
     StateEnum mState             = StateEnum::kNotPluggedIn;
     SupplyStateEnum mSupplyState = SupplyStateEnum::kDisabled;
@@ -18,5 +18,12 @@
 
 #pragma once
 
+#include <app/clusters/energy-evse-server/EvseLoadBalancer.h>
+
 void EvseApplicationInit();
 void EvseApplicationShutdown();
+
+/**
+ * @brief   Balancer sharing the site circuit between all the EVSEs of the application
+ */
+chip::app::Clusters::EnergyEvse::EvseLoadBalancer & GetSiteLoadBalancer();
@@ -17,6 +17,7 @@
  */
 #pragma once
 
+#include <app/clusters/power-topology-server/PowerRollup.h>
 #include <app/clusters/power-topology-server/power-topology-server.h>
 
 #include <app/util/af-types.h>
@@ -34,6 +35,15 @@ public:
 
     CHIP_ERROR GetAvailableEndpointAtIndex(size_t index, EndpointId & endpointId) override;
     CHIP_ERROR GetActiveEndpointAtIndex(size_t index, EndpointId & endpointId) override;
+
+    /**
+     * @brief Lists the children of `node` as the available endpoints, and those drawing
+     *        or supplying power as the active endpoints. The lists are empty without a node.
+     */
+    void SetRollupNode(PowerRollup::Node * node) { mRollupNode = node; }
+
+private:
+    PowerRollup::Node * mRollupNode = nullptr;
 };
 
 class PowerTopologyInstance : public Instance
@@ -18,7 +18,11 @@
 
 #include "DeviceEnergyManagementDelegateImpl.h"
 
+#include <app/AttributePersistenceProvider.h>
 #include <app/EventLogging.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+
+#include <algorithm>
 
 using namespace chip;
 using namespace chip::app;
@@ -30,6 +34,16 @@ using chip::Optional;
 using namespace chip::app;
 using CostsList = DataModel::List<const Structs::CostStruct::Type>;
 
+namespace {
+
+ForecastUpdateReasonEnum ForecastUpdateReason(AdjustmentCauseEnum cause)
+{
+    return (cause == AdjustmentCauseEnum::kGridOptimization) ? ForecastUpdateReasonEnum::kGridOptimization
+                                                             : ForecastUpdateReasonEnum::kLocalOptimization;
+}
+
+} // namespace
+
 /**
  * @brief Delegate handler for PowerAdjustRequest
  *
@@ -182,10 +196,30 @@ Status DeviceEnergyManagementDelegate::ModifyForecastRequest(
     const uint32_t forecastId, const DataModel::DecodableList<Structs::SlotAdjustmentStruct::DecodableType> & slotAdjustments,
     AdjustmentCauseEnum cause)
 {
-    Status status = Status::UnsupportedCommand; // Status::Success;
+    if (mForecast.IsNull() || forecastId != mForecast.Value().forecastId)
+    {
+        ChipLogError(AppServer, "DEM: ModifyForecastRequest does not match the current forecast");
+        return Status::Failure;
+    }
 
-    // TODO: implement the behaviour above
-    return status;
+    // TODO: check with the appliance that the adjusted forecast is acceptable
+    const auto & slots                  = mForecast.Value().slots;
+    Structs::SlotStruct::Type * revised = mSlots[1 - mActiveSlots];
+    std::copy(slots.begin(), slots.end(), revised);
+
+    CHIP_ERROR err = ForecastEngine::ApplySlotAdjustments(slotAdjustments, Span<Structs::SlotStruct::Type>(revised, slots.size()));
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(AppServer, "DEM: Slot adjustments rejected: %" CHIP_ERROR_FORMAT, err.Format());
+        return Status::ConstraintError;
+    }
+
+    mForecast.Value().endTime =
+        mForecast.Value().startTime + ForecastEngine::GetDuration(Span<const Structs::SlotStruct::Type>(revised, slots.size()));
+    CommitForecast(slots.size(), ForecastUpdateReason(cause));
+
+    // TODO: notify the appliance to follow the revised schedule
+    return Status::Success;
 }
 
 /**
@@ -203,9 +237,39 @@ Status DeviceEnergyManagementDelegate::ModifyForecastRequest(
 Status DeviceEnergyManagementDelegate::RequestConstraintBasedForecast(
     const DataModel::DecodableList<Structs::ConstraintsStruct::DecodableType> & constraints, AdjustmentCauseEnum cause)
 {
-    Status status = Status::UnsupportedCommand; // Status::Success;
-    // TODO: implement the behaviour above
-    return status;
+    if (mForecast.IsNull())
+    {
+        return Status::Failure;
+    }
+
+    size_t constraintCount = 0;
+    CHIP_ERROR err =
+        ForecastEngine::DecodeConstraints(constraints, Span<Structs::ConstraintsStruct::Type>(mConstraints), constraintCount);
+    if (err == CHIP_ERROR_BUFFER_TOO_SMALL)
+    {
+        return Status::ResourceExhausted;
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(AppServer, "DEM: Invalid constraints: %" CHIP_ERROR_FORMAT, err.Format());
+        return Status::ConstraintError;
+    }
+
+    // TODO: a real appliance would also take tariff information and user preferences into account
+    size_t slotCount = 0;
+    err              = ForecastEngine::ApplyConstraints(mForecast.Value().startTime, mForecast.Value().slots,
+                                                        Span<const Structs::ConstraintsStruct::Type>(mConstraints, constraintCount),
+                                                        Span<Structs::SlotStruct::Type>(mSlots[1 - mActiveSlots]), slotCount);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(AppServer, "DEM: No forecast satisfies the constraints: %" CHIP_ERROR_FORMAT, err.Format());
+        return Status::Failure;
+    }
+
+    CommitForecast(slotCount, ForecastUpdateReason(cause));
+
+    // TODO: notify the appliance to follow the revised schedule
+    return Status::Success;
 }
 
 /**
@@ -354,13 +418,141 @@ CHIP_ERROR DeviceEnergyManagementDelegate::SetAbsMaxPower(int64_t newValue)
 CHIP_ERROR
 DeviceEnergyManagementDelegate::SetPowerAdjustmentCapability(PowerAdjustmentCapability::TypeInfo::Type powerAdjustmentCapability)
 {
-    // TODO see Issue #31147
+    if (powerAdjustmentCapability.IsNull())
+    {
+        mPowerAdjustmentCapability.SetNull();
+    }
+    else
+    {
+        const auto & adjustments = powerAdjustmentCapability.Value();
+        VerifyOrReturnError(adjustments.size() <= kMaxPowerAdjustments, CHIP_ERROR_BUFFER_TOO_SMALL);
+        std::copy(adjustments.begin(), adjustments.end(), mPowerAdjustments);
+        mPowerAdjustmentCapability.SetNonNull(
+            DataModel::List<const Structs::PowerAdjustStruct::Type>(mPowerAdjustments, adjustments.size()));
+    }
+    MatterReportingAttributeChangeCallback(mEndpointId, DeviceEnergyManagement::Id, PowerAdjustmentCapability::Id);
+
+    AttributePersistenceProvider * provider = GetAttributePersistenceProvider();
+    if (provider != nullptr)
+    {
+        CHIP_ERROR err = ForecastStore::SavePowerAdjustmentCapability(*provider, mEndpointId, mPowerAdjustmentCapability);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(AppServer, "DEM: Unable to persist PowerAdjustmentCapability: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    }
+
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DeviceEnergyManagementDelegate::SetForecast(DataModel::Nullable<Structs::ForecastStruct::Type> forecast)
 {
-    // TODO see Issue #31147
+    if (forecast.IsNull())
+    {
+        mForecast.SetNull();
+        MatterReportingAttributeChangeCallback(mEndpointId, DeviceEnergyManagement::Id, Forecast::Id);
+        SaveForecast();
+        return CHIP_NO_ERROR;
+    }
+
+    // The slots may point at the current forecast, so they are copied to the other buffer.
+    const auto & slots = forecast.Value().slots;
+    VerifyOrReturnError(slots.size() <= kMaxForecastSlots, CHIP_ERROR_BUFFER_TOO_SMALL);
+    std::copy(slots.begin(), slots.end(), mSlots[1 - mActiveSlots]);
+
+    mForecast = forecast;
+    CommitForecast(slots.size(), forecast.Value().forecastUpdateReason);
 
     return CHIP_NO_ERROR;
 }
+
+/**
+ * @brief Makes the slots computed in the inactive buffer the current forecast, and reports it.
+ */
+void DeviceEnergyManagementDelegate::CommitForecast(size_t slotCount, ForecastUpdateReasonEnum reason)
+{
+    mActiveSlots = 1 - mActiveSlots;
+
+    Structs::ForecastStruct::Type & forecast = mForecast.Value();
+    forecast.slots                           = DataModel::List<const Structs::SlotStruct::Type>(mSlots[mActiveSlots], slotCount);
+    forecast.forecastId                      = NextForecastId(forecast.forecastId);
+    forecast.forecastUpdateReason            = reason;
+
+    ChipLogDetail(AppServer, "Forecast %u updated, %u slots", forecast.forecastId, static_cast<unsigned>(slotCount));
+    MatterReportingAttributeChangeCallback(mEndpointId, DeviceEnergyManagement::Id, Forecast::Id);
+    SaveForecast();
+}
+
+/**
+ * @brief Returns the ForecastId of a new forecast, taken from the persisted reservation when there is one.
+ */
+uint16_t DeviceEnergyManagementDelegate::NextForecastId(uint16_t currentForecastId)
+{
+    VerifyOrReturnValue(mForecastIdCounterReady, static_cast<uint16_t>(currentForecastId + 1));
+
+    // The counter is ahead of a forecast restored from the storage, never behind it.
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    if (mForecastIdCounter.GetValue() <= currentForecastId)
+    {
+        err = mForecastIdCounter.AdvanceBy(static_cast<uint16_t>(currentForecastId - mForecastIdCounter.GetValue() + 1));
+    }
+    else
+    {
+        err = mForecastIdCounter.Advance();
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(AppServer, "DEM: Unable to reserve ForecastIds: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+    return mForecastIdCounter.GetValue();
+}
+
+/**
+ * @brief Persists the current forecast, so that it is restored with its ForecastId after a restart.
+ *
+ * A failure is only logged: the forecast in RAM stays valid, and is persisted again on the next update.
+ */
+void DeviceEnergyManagementDelegate::SaveForecast()
+{
+    AttributePersistenceProvider * provider = GetAttributePersistenceProvider();
+    VerifyOrReturn(provider != nullptr);
+
+    CHIP_ERROR err = ForecastStore::SaveForecast(*provider, mEndpointId, mForecast);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(AppServer, "DEM: Unable to persist forecast: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+void DeviceEnergyManagementDelegate::RestorePersistentState(PersistentStorageDelegate & storage)
+{
+    // Reserves the first block of ForecastIds right away: the storage is written before any of them is used.
+    CHIP_ERROR err =
+        mForecastIdCounter.Init(&storage, DefaultStorageKeyAllocator::DEMForecastIdCounter(mEndpointId), kForecastIdBlockSize);
+    mForecastIdCounterReady = (err == CHIP_NO_ERROR);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(AppServer, "DEM: Unable to restore the ForecastId sequence: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+
+    AttributePersistenceProvider * provider = GetAttributePersistenceProvider();
+    VerifyOrReturn(provider != nullptr);
+
+    // The restored forecast is the current one: its slots go to the active buffer.
+    err = ForecastStore::LoadForecast(*provider, mEndpointId, mForecast, Span<Structs::SlotStruct::Type>(mSlots[mActiveSlots]));
+    if (err == CHIP_NO_ERROR && !mForecast.IsNull())
+    {
+        ChipLogProgress(AppServer, "DEM: Restored forecast %u", mForecast.Value().forecastId);
+    }
+    else if (err != CHIP_NO_ERROR && err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+    {
+        ChipLogError(AppServer, "DEM: Unable to restore forecast: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+
+    err = ForecastStore::LoadPowerAdjustmentCapability(*provider, mEndpointId, mPowerAdjustmentCapability,
+                                                       Span<Structs::PowerAdjustStruct::Type>(mPowerAdjustments));
+    if (err != CHIP_NO_ERROR && err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+    {
+        ChipLogError(AppServer, "DEM: Unable to restore PowerAdjustmentCapability: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
@@ -18,13 +18,19 @@
 
 #include <DeviceEnergyManagementManager.h>
 
+#include <app/server/Server.h>
+
 using namespace chip::app;
 using namespace chip::app::Clusters;
 using namespace chip::app::Clusters::DeviceEnergyManagement;
 
 CHIP_ERROR DeviceEnergyManagementManager::Init()
 {
-    return Instance::Init();
+    ReturnErrorOnFailure(Instance::Init());
+
+    /* Resume the forecast the ESA was following before the restart */
+    mDelegate->RestorePersistentState(chip::Server::GetInstance().GetPersistentStorage());
+    return CHIP_NO_ERROR;
 }
 
 void DeviceEnergyManagementManager::Shutdown()
@@ -58,6 +58,13 @@ CHIP_ERROR EVSEManufacturer::Init()
     ReturnErrorOnFailure(InitializePowerMeasurementCluster());
 
     ReturnErrorOnFailure(InitializePowerSourceCluster());
+
+    /* Keep a history of the energy readings, which can be used for forecasting */
+    CHIP_ERROR err = SetEnergyTimeSeries(dg->GetEndpointId(), &mEnergyHistory);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(AppServer, "Unable to record the energy history: %" CHIP_ERROR_FORMAT, err.Format());
+    }
     /*
      * This is an example implementation for manufacturers to consider
      *
@@ -101,6 +108,11 @@ CHIP_ERROR EVSEManufacturer::Init()
 
 CHIP_ERROR EVSEManufacturer::Shutdown()
 {
+    EnergyEvseDelegate * dg = GetEvseDelegate();
+    if (dg != nullptr)
+    {
+        SetEnergyTimeSeries(dg->GetEndpointId(), nullptr);
+    }
     return CHIP_NO_ERROR;
 }
 
@@ -166,12 +178,18 @@ CHIP_ERROR EVSEManufacturer::SendPowerReading(EndpointId aEndpointId, int64_t aA
     EVSEManufacturer * mn = GetEvseManufacturer();
     VerifyOrReturnError(mn != nullptr, CHIP_ERROR_UNINITIALIZED);
 
-    ElectricalPowerMeasurementDelegate * dg = mn->GetEPMDelegate();
+    ElectricalPowerMeasurementInstance * epm = mn->GetEPMInstance();
+    VerifyOrReturnError(epm != nullptr, CHIP_ERROR_UNINITIALIZED);
+
+    ElectricalPowerMeasurementDelegate * dg = epm->GetDelegate();
     VerifyOrReturnError(dg != nullptr, CHIP_ERROR_UNINITIALIZED);
 
+    // Subscribers get the whole reading in one report
+    epm->BeginUpdate();
     dg->SetActivePower(MakeNullable(aActivePower_mW));
     dg->SetVoltage(MakeNullable(aVoltage_mV));
     dg->SetActiveCurrent(MakeNullable(aActiveCurrent_mA));
+    epm->CommitUpdate();
 
     return CHIP_NO_ERROR;
 }
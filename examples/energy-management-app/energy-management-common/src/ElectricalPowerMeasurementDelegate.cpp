@@ -347,7 +347,7 @@ CHIP_ERROR ElectricalPowerMeasurementDelegate::SetVoltage(DataModel::Nullable<in
     if (oldValue != newValue)
     {
         // We won't log raw values since these could change frequently
-        MatterReportingAttributeChangeCallback(mEndpointId, ElectricalPowerMeasurement::Id, Voltage::Id);
+        MeasurementChanged(Voltage::Id, newValue);
     }
 
     return CHIP_NO_ERROR;
@@ -361,7 +361,7 @@ CHIP_ERROR ElectricalPowerMeasurementDelegate::SetActiveCurrent(DataModel::Nulla
     if (oldValue != newValue)
     {
         // We won't log raw values since these could change frequently
-        MatterReportingAttributeChangeCallback(mEndpointId, ElectricalPowerMeasurement::Id, ActiveCurrent::Id);
+        MeasurementChanged(ActiveCurrent::Id, newValue);
     }
 
     return CHIP_NO_ERROR;
@@ -375,7 +375,7 @@ CHIP_ERROR ElectricalPowerMeasurementDelegate::SetReactiveCurrent(DataModel::Nul
     if (oldValue != newValue)
     {
         // We won't log raw values since these could change frequently
-        MatterReportingAttributeChangeCallback(mEndpointId, ElectricalPowerMeasurement::Id, ReactiveCurrent::Id);
+        MeasurementChanged(ReactiveCurrent::Id, newValue);
     }
 
     return CHIP_NO_ERROR;
@@ -388,7 +388,7 @@ CHIP_ERROR ElectricalPowerMeasurementDelegate::SetApparentCurrent(DataModel::Nul
     if (oldValue != newValue)
     {
         // We won't log raw values since these could change frequently
-        MatterReportingAttributeChangeCallback(mEndpointId, ElectricalPowerMeasurement::Id, ApparentCurrent::Id);
+        MeasurementChanged(ApparentCurrent::Id, newValue);
     }
 
     return CHIP_NO_ERROR;
@@ -401,7 +401,7 @@ CHIP_ERROR ElectricalPowerMeasurementDelegate::SetActivePower(DataModel::Nullabl
     if (oldValue != newValue)
     {
         // We won't log raw values since these could change frequently
-        MatterReportingAttributeChangeCallback(mEndpointId, ElectricalPowerMeasurement::Id, ActivePower::Id);
+        MeasurementChanged(ActivePower::Id, newValue);
     }
 
     return CHIP_NO_ERROR;
@@ -414,7 +414,7 @@ CHIP_ERROR ElectricalPowerMeasurementDelegate::SetReactivePower(DataModel::Nulla
     if (oldValue != newValue)
     {
         // We won't log raw values since these could change frequently
-        MatterReportingAttributeChangeCallback(mEndpointId, ElectricalPowerMeasurement::Id, ReactivePower::Id);
+        MeasurementChanged(ReactivePower::Id, newValue);
     }
 
     return CHIP_NO_ERROR;
@@ -427,7 +427,7 @@ CHIP_ERROR ElectricalPowerMeasurementDelegate::SetApparentPower(DataModel::Nulla
     if (oldValue != newValue)
     {
         // We won't log raw values since these could change frequently
-        MatterReportingAttributeChangeCallback(mEndpointId, ElectricalPowerMeasurement::Id, ApparentPower::Id);
+        MeasurementChanged(ApparentPower::Id, newValue);
     }
 
     return CHIP_NO_ERROR;
@@ -440,7 +440,7 @@ CHIP_ERROR ElectricalPowerMeasurementDelegate::SetRMSVoltage(DataModel::Nullable
     if (oldValue != newValue)
     {
         // We won't log raw values since these could change frequently
-        MatterReportingAttributeChangeCallback(mEndpointId, ElectricalPowerMeasurement::Id, RMSVoltage::Id);
+        MeasurementChanged(RMSVoltage::Id, newValue);
     }
 
     return CHIP_NO_ERROR;
@@ -453,7 +453,7 @@ CHIP_ERROR ElectricalPowerMeasurementDelegate::SetRMSCurrent(DataModel::Nullable
     if (oldValue != newValue)
     {
         // We won't log raw values since these could change frequently
-        MatterReportingAttributeChangeCallback(mEndpointId, ElectricalPowerMeasurement::Id, RMSCurrent::Id);
+        MeasurementChanged(RMSCurrent::Id, newValue);
     }
 
     return CHIP_NO_ERROR;
@@ -466,7 +466,7 @@ CHIP_ERROR ElectricalPowerMeasurementDelegate::SetRMSPower(DataModel::Nullable<i
     if (oldValue != newValue)
     {
         // We won't log raw values since these could change frequently
-        MatterReportingAttributeChangeCallback(mEndpointId, ElectricalPowerMeasurement::Id, RMSPower::Id);
+        MeasurementChanged(RMSPower::Id, newValue);
     }
 
     return CHIP_NO_ERROR;
@@ -479,7 +479,7 @@ CHIP_ERROR ElectricalPowerMeasurementDelegate::SetFrequency(DataModel::Nullable<
     if (oldValue != newValue)
     {
         // We won't log raw values since these could change frequently
-        MatterReportingAttributeChangeCallback(mEndpointId, ElectricalPowerMeasurement::Id, Frequency::Id);
+        MeasurementChanged(Frequency::Id, newValue);
     }
 
     return CHIP_NO_ERROR;
@@ -493,7 +493,7 @@ CHIP_ERROR ElectricalPowerMeasurementDelegate::SetPowerFactor(DataModel::Nullabl
     if (oldValue != newValue)
     {
         // We won't log raw values since these could change frequently
-        MatterReportingAttributeChangeCallback(mEndpointId, ElectricalPowerMeasurement::Id, PowerFactor::Id);
+        MeasurementChanged(PowerFactor::Id, newValue);
     }
 
     return CHIP_NO_ERROR;
@@ -507,7 +507,7 @@ CHIP_ERROR ElectricalPowerMeasurementDelegate::SetNeutralCurrent(DataModel::Null
     if (oldValue != newValue)
     {
         // We won't log raw values since these could change frequently
-        MatterReportingAttributeChangeCallback(mEndpointId, ElectricalPowerMeasurement::Id, NeutralCurrent::Id);
+        MeasurementChanged(NeutralCurrent::Id, newValue);
     }
 
     return CHIP_NO_ERROR;
@@ -40,6 +40,18 @@ EnergyEvseDelegate::~EnergyEvseDelegate()
         ChipLogDetail(AppServer, "Freeing VehicleID");
         delete[] mVehicleID.Value().data();
     }
+
+    DeviceLayer::SystemLayer().CancelTimer(ChargingPlanTimerExpiry, this);
+
+    if (mLoadBalancer != nullptr)
+    {
+        mLoadBalancer->Unregister(*this);
+    }
+
+    if (mStartScheduler != nullptr)
+    {
+        mStartScheduler->Cancel(*this);
+    }
 }
 
 /**
@@ -61,9 +73,10 @@ Status EnergyEvseDelegate::Disable()
     SetChargingEnabledUntil(disableTime);
     SetDischargingEnabledUntil(disableTime);
 
-    /* update MinimumChargeCurrent & MaximumChargeCurrent to 0 */
+    /* update MinimumChargeCurrent & MaximumChargeCurrent to 0 (this also returns any share of the site circuit) */
     SetMinimumChargeCurrent(0);
-    SetMaximumChargeCurrent(0);
+    mMaximumChargingCurrentLimitFromCommand = 0;
+    ComputeMaxChargeCurrentLimit();
 
     /* update MaximumDischargeCurrent to 0 */
     SetMaximumDischargeCurrent(0);
@@ -234,6 +247,185 @@ Status EnergyEvseDelegate::StartDiagnostics()
     return Status::Success;
 }
 
+/**
+ * @brief    Called when EVSE cluster receives SetTargets command
+ *
+ * @param chargingTargetSchedules - schedules to apply (already validated by the cluster)
+ */
+Status EnergyEvseDelegate::SetTargets(
+    const DataModel::DecodableList<Structs::ChargingTargetScheduleStruct::DecodableType> & chargingTargetSchedules)
+{
+    ChipLogProgress(AppServer, "EnergyEvseDelegate::SetTargets()");
+
+    CHIP_ERROR err = mChargingTargets.SetTargets(chargingTargetSchedules);
+    if (err == CHIP_ERROR_INVALID_ARGUMENT)
+    {
+        return Status::ConstraintError;
+    }
+    if (err == CHIP_ERROR_NO_MEMORY)
+    {
+        return Status::ResourceExhausted;
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(AppServer, "Unable to store charging targets: %" CHIP_ERROR_FORMAT, err.Format());
+        return Status::Failure;
+    }
+
+    UpdateChargingPlan();
+    return Status::Success;
+}
+
+/**
+ * @brief    Called when EVSE cluster receives GetTargets command
+ */
+Status EnergyEvseDelegate::GetTargets(DataModel::List<const Structs::ChargingTargetScheduleStruct::Type> & chargingTargetSchedules)
+{
+    ChipLogProgress(AppServer, "EnergyEvseDelegate::GetTargets()");
+
+    chargingTargetSchedules = mChargingTargets.GetTargets();
+    return Status::Success;
+}
+
+/**
+ * @brief    Called when EVSE cluster receives ClearTargets command
+ */
+Status EnergyEvseDelegate::ClearTargets()
+{
+    ChipLogProgress(AppServer, "EnergyEvseDelegate::ClearTargets()");
+
+    CHIP_ERROR err = mChargingTargets.ClearTargets();
+    UpdateChargingPlan();
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(AppServer, "Unable to clear persisted charging targets: %" CHIP_ERROR_FORMAT, err.Format());
+        return Status::Failure;
+    }
+    return Status::Success;
+}
+
+CHIP_ERROR EnergyEvseDelegate::LoadChargingTargets(PersistentStorageDelegate & storage)
+{
+    CHIP_ERROR err = mChargingTargets.Init(storage, mEndpointId);
+    UpdateChargingPlan();
+    return err;
+}
+
+CHIP_ERROR EnergyEvseDelegate::SetLoadBalancer(EvseLoadBalancer * balancer)
+{
+    if (mLoadBalancer != nullptr)
+    {
+        mLoadBalancer->Unregister(*this);
+    }
+
+    mLoadBalancer = balancer;
+    if (mLoadBalancer == nullptr)
+    {
+        /* Back to this EVSE's own limit */
+        ApplyMaximumChargeCurrent(mActualChargingCurrentLimit);
+        return CHIP_NO_ERROR;
+    }
+
+    /* Registering notifies the current allocated to this EVSE */
+    CHIP_ERROR err = mLoadBalancer->Register(*this);
+    if (err != CHIP_NO_ERROR)
+    {
+        mLoadBalancer = nullptr;
+    }
+    return err;
+}
+
+void EnergyEvseDelegate::SetStartScheduler(RandomizedStartScheduler * scheduler)
+{
+    if (mStartScheduler != nullptr)
+    {
+        mStartScheduler->Cancel(*this);
+    }
+    mStartScheduler = scheduler;
+}
+
+/**
+ * @brief    Starts charging if it was deferred, and is still enabled and demanded
+ */
+void EnergyEvseDelegate::OnRandomizedStart()
+{
+    if (mSupplyState == SupplyStateEnum::kChargingEnabled && mState == StateEnum::kPluggedInDemand)
+    {
+        StartCharging();
+    }
+}
+
+void EnergyEvseDelegate::StartCharging()
+{
+    ComputeMaxChargeCurrentLimit();
+    SetState(StateEnum::kPluggedInCharging);
+    SendEnergyTransferStartedEvent();
+}
+
+/**
+ * @brief    Recomputes the charging plan if any of its inputs changed
+ *
+ * The planner caches its result, so this is cheap to call whenever the
+ * targets, the charging current limit or the EV state may have changed.
+ */
+void EnergyEvseDelegate::UpdateChargingPlan()
+{
+    uint32_t chipEpoch = 0;
+    if (GetEpochTS(chipEpoch) != CHIP_NO_ERROR)
+    {
+        /* Targets are times of day - nothing can be planned until real time is known */
+        return;
+    }
+
+    /* This example has no local time information (e.g. Time Synchronization cluster), so targets are taken as UTC */
+    ChargingPlanner::Inputs inputs;
+    inputs.chargeCurrent   = mMaximumChargeCurrent;
+    inputs.stateOfCharge   = mStateOfCharge;
+    inputs.batteryCapacity = mBatteryCapacity;
+
+    if (mChargingPlanner.Update(mChargingTargets, inputs, chipEpoch))
+    {
+        const ChargingPlanner::Plan & plan = mChargingPlanner.GetPlan();
+
+        if (mNextChargeStartTime != plan.startTime)
+        {
+            mNextChargeStartTime = plan.startTime;
+            MatterReportingAttributeChangeCallback(mEndpointId, EnergyEvse::Id, NextChargeStartTime::Id);
+        }
+        if (mNextChargeTargetTime != plan.targetTime)
+        {
+            mNextChargeTargetTime = plan.targetTime;
+            MatterReportingAttributeChangeCallback(mEndpointId, EnergyEvse::Id, NextChargeTargetTime::Id);
+        }
+        if (mNextChargeRequiredEnergy != plan.requiredEnergy)
+        {
+            mNextChargeRequiredEnergy = plan.requiredEnergy;
+            MatterReportingAttributeChangeCallback(mEndpointId, EnergyEvse::Id, NextChargeRequiredEnergy::Id);
+        }
+        if (mNextChargeTargetSoC != plan.targetSoC)
+        {
+            mNextChargeTargetSoC = plan.targetSoC;
+            MatterReportingAttributeChangeCallback(mEndpointId, EnergyEvse::Id, NextChargeTargetSoC::Id);
+        }
+    }
+
+    /* Move on to the following target once this one has passed */
+    DeviceLayer::SystemLayer().CancelTimer(ChargingPlanTimerExpiry, this);
+    if (!mNextChargeTargetTime.IsNull())
+    {
+        DeviceLayer::SystemLayer().StartTimer(System::Clock::Seconds32(mNextChargeTargetTime.Value() - chipEpoch),
+                                              ChargingPlanTimerExpiry, this);
+    }
+}
+
+void EnergyEvseDelegate::ChargingPlanTimerExpiry(System::Layer * systemLayer, void * delegate)
+{
+    EnergyEvseDelegate * dg = reinterpret_cast<EnergyEvseDelegate *>(delegate);
+
+    dg->UpdateChargingPlan();
+}
+
 /* ---------------------------------------------------------------------------
  *  EVSE Hardware interface below
  */
@@ -646,9 +838,13 @@ Status EnergyEvseDelegate::HandleEVDemandEvent()
     switch (mSupplyState)
     {
     case SupplyStateEnum::kChargingEnabled:
-        ComputeMaxChargeCurrentLimit();
-        SetState(StateEnum::kPluggedInCharging);
-        SendEnergyTransferStartedEvent();
+        if (IsPending())
+        {
+            /* Charging starts once the randomized start time is reached */
+            SetState(StateEnum::kPluggedInDemand);
+            break;
+        }
+        StartCharging();
         break;
     case SupplyStateEnum::kDischargingEnabled:
         // TODO ComputeMaxDischargeCurrentLimit() - Needs to be implemented
@@ -702,9 +898,10 @@ Status EnergyEvseDelegate::HandleChargingEnabledEvent()
     case StateEnum::kPluggedInNoDemand:
         break;
     case StateEnum::kPluggedInDemand:
-        ComputeMaxChargeCurrentLimit();
-        SetState(StateEnum::kPluggedInCharging);
-        SendEnergyTransferStartedEvent();
+        if (!IsPending())
+        {
+            StartCharging();
+        }
         break;
     case StateEnum::kPluggedInCharging:
         break;
@@ -712,9 +909,12 @@ Status EnergyEvseDelegate::HandleChargingEnabledEvent()
         /* Switched from discharging to charging */
         SendEnergyTransferStoppedEvent(EnergyTransferStoppedReasonEnum::kEVSEStopped);
 
-        ComputeMaxChargeCurrentLimit();
-        SetState(StateEnum::kPluggedInCharging);
-        SendEnergyTransferStartedEvent();
+        if (IsPending())
+        {
+            SetState(StateEnum::kPluggedInDemand);
+            break;
+        }
+        StartCharging();
         break;
     default:
         break;
@@ -852,30 +1052,45 @@ Status EnergyEvseDelegate::HandleFaultCleared()
  *   - MaximumChargeCurrent (from charging command)
  *   - UserMaximumChargeCurrent (could dynamically change)
  *
+ * When the EVSE shares the site circuit with other EVSEs, the MaximumChargeCurrent
+ * is the part of this limit allocated by the load balancer.
  */
 Status EnergyEvseDelegate::ComputeMaxChargeCurrentLimit()
 {
-    int64_t oldValue;
-
-    oldValue                    = mActualChargingCurrentLimit;
     mActualChargingCurrentLimit = mMaxHardwareCurrentLimit;
     mActualChargingCurrentLimit = min(mActualChargingCurrentLimit, mCircuitCapacity);
     mActualChargingCurrentLimit = min(mActualChargingCurrentLimit, mCableAssemblyCurrentLimit);
     mActualChargingCurrentLimit = min(mActualChargingCurrentLimit, mMaximumChargingCurrentLimitFromCommand);
     mActualChargingCurrentLimit = min(mActualChargingCurrentLimit, mUserMaximumChargeCurrent);
 
+    if (mLoadBalancer != nullptr)
+    {
+        /* The balancer shares the site circuit and calls OnCurrentAllocated() if this EVSE's share changes */
+        mLoadBalancer->Update(*this);
+        return Status::Success;
+    }
+
     /* Set the actual max charging current attribute */
-    mMaximumChargeCurrent = mActualChargingCurrentLimit;
+    ApplyMaximumChargeCurrent(mActualChargingCurrentLimit);
+    return Status::Success;
+}
 
-    if (oldValue != mMaximumChargeCurrent)
+void EnergyEvseDelegate::ApplyMaximumChargeCurrent(int64_t maximumChargeCurrent)
+{
+    if (mMaximumChargeCurrent == maximumChargeCurrent)
     {
-        ChipLogDetail(AppServer, "MaximumChargeCurrent updated to %ld", static_cast<long>(mMaximumChargeCurrent));
-        MatterReportingAttributeChangeCallback(mEndpointId, EnergyEvse::Id, MaximumChargeCurrent::Id);
-
-        /* Call the EV Charger hardware current limit callback */
-        NotifyApplicationCurrentLimitChange(mMaximumChargeCurrent);
+        return;
     }
-    return Status::Success;
+
+    mMaximumChargeCurrent = maximumChargeCurrent;
+    ChipLogDetail(AppServer, "MaximumChargeCurrent updated to %ld", static_cast<long>(mMaximumChargeCurrent));
+    MatterReportingAttributeChangeCallback(mEndpointId, EnergyEvse::Id, MaximumChargeCurrent::Id);
+
+    /* Call the EV Charger hardware current limit callback */
+    NotifyApplicationCurrentLimitChange(mMaximumChargeCurrent);
+
+    /* The time needed to charge depends on the current limit */
+    UpdateChargingPlan();
 }
 
 Status EnergyEvseDelegate::NotifyApplicationCurrentLimitChange(int64_t maximumChargeCurrent)
@@ -1098,6 +1313,12 @@ CHIP_ERROR EnergyEvseDelegate::SetState(StateEnum newValue)
         ChipLogDetail(AppServer, "State updated to %d", static_cast<int>(mState));
         MatterReportingAttributeChangeCallback(mEndpointId, EnergyEvse::Id, State::Id);
         NotifyApplicationStateChange();
+
+        /* Plugging in, unplugging, starting or stopping a charge changes the share of the site circuit */
+        if (mLoadBalancer != nullptr)
+        {
+            mLoadBalancer->Update(*this);
+        }
     }
 
     return CHIP_NO_ERROR;
@@ -1121,6 +1342,23 @@ CHIP_ERROR EnergyEvseDelegate::SetSupplyState(SupplyStateEnum newValue)
     mSupplyState = newValue;
     if (oldValue != mSupplyState)
     {
+        /* Devices enabled by the same signal do not all start charging at once */
+        if (mStartScheduler != nullptr)
+        {
+            if (mSupplyState == SupplyStateEnum::kChargingEnabled && mRandomizationDelayWindow > 0)
+            {
+                if (mStartScheduler->Schedule(*this, System::Clock::Seconds32(mRandomizationDelayWindow)) != CHIP_NO_ERROR)
+                {
+                    ChipLogError(AppServer, "EVSE: Unable to randomize the start of charging");
+                    mStartScheduler->Cancel(*this);
+                }
+            }
+            else
+            {
+                mStartScheduler->Cancel(*this);
+            }
+        }
+
         ChipLogDetail(AppServer, "SupplyState updated to %d", static_cast<int>(mSupplyState));
         MatterReportingAttributeChangeCallback(mEndpointId, EnergyEvse::Id, SupplyState::Id);
         NotifyApplicationStateChange();
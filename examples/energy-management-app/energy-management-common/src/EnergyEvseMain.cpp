@@ -19,6 +19,7 @@
 #include <DeviceEnergyManagementManager.h>
 #include <EVSEManufacturerImpl.h>
 #include <ElectricalPowerMeasurementDelegate.h>
+#include <EnergyEvseMain.h>
 #include <EnergyEvseManager.h>
 #include <PowerTopologyDelegate.h>
 #include <device-energy-management-modes.h>
@@ -36,6 +37,9 @@
 
 #define ENERGY_EVSE_ENDPOINT 1
 
+/* Capacity of the site circuit shared by all the EVSEs, in mA */
+#define SITE_CIRCUIT_CAPACITY 80000
+
 using namespace chip;
 using namespace chip::app;
 using namespace chip::app::DataModel;
@@ -46,6 +50,9 @@ using namespace chip::app::Clusters::ElectricalPowerMeasurement;
 using namespace chip::app::Clusters::ElectricalEnergyMeasurement;
 using namespace chip::app::Clusters::PowerTopology;
 
+/* A site with several EVSE endpoints registers all their delegates with the same balancer */
+static EvseLoadBalancer gSiteLoadBalancer(SITE_CIRCUIT_CAPACITY);
+
 static std::unique_ptr<EnergyEvseDelegate> gEvseDelegate;
 static std::unique_ptr<EnergyEvseManager> gEvseInstance;
 static std::unique_ptr<DeviceEnergyManagementDelegate> gDEMDelegate;
@@ -59,6 +66,11 @@ static std::unique_ptr<ElectricalEnergyMeasurementAttrAccess> gEEMAttrAccess;
 static std::unique_ptr<PowerTopologyDelegate> gPTDelegate;
 static std::unique_ptr<PowerTopologyInstance> gPTInstance;
 
+EvseLoadBalancer & GetSiteLoadBalancer()
+{
+    return gSiteLoadBalancer;
+}
+
 EVSEManufacturer * EnergyEvse::GetEvseManufacturer()
 {
     return gEvseManufacturer.get();
@@ -180,6 +192,12 @@ CHIP_ERROR EnergyEvseInit()
         return err;
     }
 
+    err = gEvseDelegate->SetLoadBalancer(&gSiteLoadBalancer);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(AppServer, "Failed to register the EVSE with the site load balancer: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+
     return CHIP_NO_ERROR;
 }
 
@@ -334,6 +352,18 @@ CHIP_ERROR EnergyMeterInit()
         return err;
     }
 
+    /* Meters sample frequently: only report significant changes, and smaller drifts at most once a minute */
+    ElectricalPowerMeasurement::ReportableChange change;
+    change.maxInterval = System::Clock::Seconds32(60);
+
+    change.percentDelta = 2;
+    gEPMInstance->SetReportableChange(ElectricalPowerMeasurement::Attributes::ActivePower::Id, change);
+    gEPMInstance->SetReportableChange(ElectricalPowerMeasurement::Attributes::ActiveCurrent::Id, change);
+
+    change.percentDelta  = 0;
+    change.absoluteDelta = 1000; // 1 V
+    gEPMInstance->SetReportableChange(ElectricalPowerMeasurement::Attributes::Voltage::Id, change);
+
     return CHIP_NO_ERROR;
 }
 
@@ -462,15 +492,21 @@ void EvseApplicationShutdown()
 
 void emberAfElectricalEnergyMeasurementClusterInitCallback(chip::EndpointId endpointId)
 {
-    VerifyOrDie(endpointId == 1); // this cluster is only enabled for endpoint 1.
-    VerifyOrDie(!gEEMAttrAccess);
+    /* The cluster is enabled on endpoint 1, and on the dynamic endpoints of simulated devices which share its attribute access */
+    if (!gEEMAttrAccess)
+    {
+        gEEMAttrAccess = std::make_unique<ElectricalEnergyMeasurementAttrAccess>(
+            BitMask<ElectricalEnergyMeasurement::Feature, uint32_t>(
+                ElectricalEnergyMeasurement::Feature::kImportedEnergy, ElectricalEnergyMeasurement::Feature::kExportedEnergy,
+                ElectricalEnergyMeasurement::Feature::kCumulativeEnergy, ElectricalEnergyMeasurement::Feature::kPeriodicEnergy),
+            BitMask<ElectricalEnergyMeasurement::OptionalAttributes, uint32_t>(
+                ElectricalEnergyMeasurement::OptionalAttributes::kOptionalAttributeCumulativeEnergyReset));
 
-    gEEMAttrAccess = std::make_unique<ElectricalEnergyMeasurementAttrAccess>(
-        BitMask<ElectricalEnergyMeasurement::Feature, uint32_t>(
-            ElectricalEnergyMeasurement::Feature::kImportedEnergy, ElectricalEnergyMeasurement::Feature::kExportedEnergy,
-            ElectricalEnergyMeasurement::Feature::kCumulativeEnergy, ElectricalEnergyMeasurement::Feature::kPeriodicEnergy),
-        BitMask<ElectricalEnergyMeasurement::OptionalAttributes, uint32_t>(
-            ElectricalEnergyMeasurement::OptionalAttributes::kOptionalAttributeCumulativeEnergyReset));
+        if (gEEMAttrAccess)
+        {
+            gEEMAttrAccess->Init();
+        }
+    }
 
     // Create an accuracy entry which is between +/-0.5 and +/- 5% across the range of all possible energy readings
     ElectricalEnergyMeasurement::Structs::MeasurementAccuracyRangeStruct::Type energyAccuracyRanges[] = {
@@ -500,8 +536,6 @@ void emberAfElectricalEnergyMeasurementClusterInitCallback(chip::EndpointId endp
 
     if (gEEMAttrAccess)
     {
-        gEEMAttrAccess->Init();
-
         SetMeasurementAccuracy(endpointId, accuracy);
         SetCumulativeReset(endpointId, MakeOptional(resetStruct));
     }
@@ -18,6 +18,7 @@
 
 #include <EnergyEvseManager.h>
 #include <app/SafeAttributePersistenceProvider.h>
+#include <app/server/Server.h>
 
 using namespace chip::app;
 using namespace chip::app::Clusters;
@@ -111,6 +112,17 @@ CHIP_ERROR EnergyEvseManager::LoadPersistentAttributes()
         ChipLogError(AppServer, "EVSE: Unable to restore persisted ApproximateEVEfficiency value");
     }
 
+    // Restore the charging targets
+    err = mDelegate->LoadChargingTargets(Server::GetInstance().GetPersistentStorage());
+    if (err == CHIP_NO_ERROR)
+    {
+        ChipLogDetail(AppServer, "EVSE: successfully loaded charging targets from NVM");
+    }
+    else
+    {
+        ChipLogError(AppServer, "EVSE: Unable to restore persisted charging targets");
+    }
+
     return CHIP_NO_ERROR; // It is ok to have no value loaded here
 }
 
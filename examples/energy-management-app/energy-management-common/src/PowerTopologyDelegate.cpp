@@ -18,18 +18,22 @@
 
 #include <PowerTopologyDelegate.h>
 
+#include <lib/support/CodeUtils.h>
+
 using namespace chip;
 using namespace chip::app::Clusters;
 using namespace chip::app::Clusters::PowerTopology;
 
 CHIP_ERROR PowerTopologyDelegate::GetAvailableEndpointAtIndex(size_t index, EndpointId & endpointId)
 {
-    return CHIP_ERROR_PROVIDER_LIST_EXHAUSTED;
+    VerifyOrReturnError(mRollupNode != nullptr, CHIP_ERROR_PROVIDER_LIST_EXHAUSTED);
+    return mRollupNode->GetChildAtIndex(index, endpointId);
 }
 
 CHIP_ERROR PowerTopologyDelegate::GetActiveEndpointAtIndex(size_t index, EndpointId & endpointId)
 {
-    return CHIP_ERROR_PROVIDER_LIST_EXHAUSTED;
+    VerifyOrReturnError(mRollupNode != nullptr, CHIP_ERROR_PROVIDER_LIST_EXHAUSTED);
+    return mRollupNode->GetActiveChildAtIndex(index, endpointId);
 }
 
 CHIP_ERROR PowerTopologyInstance::Init()
@@ -0,0 +1,804 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <EnergyDeviceSimulator.h>
+
+#include <DeviceEnergyManagementManager.h>
+#include <EVSEManufacturerImpl.h>
+#include <ElectricalPowerMeasurementDelegate.h>
+#include <EnergyEvseMain.h>
+#include <EnergyEvseManager.h>
+#include <PowerTopologyDelegate.h>
+
+#include <app-common/zap-generated/ids/Attributes.h>
+#include <app-common/zap-generated/ids/Clusters.h>
+#include <app/InteractionModelEngine.h>
+#include <app/clusters/power-topology-server/PowerRollup.h>
+#include <app/reporting/reporting.h>
+#include <app/util/attribute-storage.h>
+#include <app/util/endpoint-config-api.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <system/SystemClock.h>
+
+#include <memory>
+#include <stdlib.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::DataModel;
+using namespace chip::app::Clusters;
+using namespace chip::app::Clusters::EnergyEvse;
+using namespace chip::app::Clusters::DeviceEnergyManagement;
+using namespace chip::app::Clusters::ElectricalPowerMeasurement;
+using namespace chip::app::Clusters::PowerTopology;
+using chip::Protocols::InteractionModel::Status;
+
+namespace {
+
+constexpr uint16_t kOptionSimulatedEvses     = 0x2000;
+constexpr uint16_t kOptionSimulationInterval = 0x2001;
+
+constexpr uint32_t kDefaultSimulationIntervalMs = 1000;
+constexpr uint32_t kSimulatedSecondsPerTick     = 60;
+constexpr uint32_t kPowerReadingsPerTick        = 3; /* voltage, current and power */
+constexpr uint32_t kEnergyReadingsPerTick       = 2; /* periodic and cumulative energy */
+constexpr System::Clock::Seconds32 kStatisticsInterval(10);
+constexpr System::Clock::Milliseconds32 kLatencyPollInterval(1);
+
+/* Device types of the simulated endpoints, as on endpoint 1 */
+constexpr DeviceTypeId kDeviceTypeEnergyEvse        = 0x050C;
+constexpr DeviceTypeId kDeviceTypeElectricalSensor  = 0x0510;
+constexpr uint8_t kDeviceTypeVersion                = 1;
+const EmberAfDeviceType kSimulatedEvseDeviceTypes[] = { { kDeviceTypeElectricalSensor, kDeviceTypeVersion },
+                                                        { kDeviceTypeEnergyEvse, kDeviceTypeVersion } };
+const EmberAfDeviceType kSiteMeterDeviceTypes[]     = { { kDeviceTypeElectricalSensor, kDeviceTypeVersion } };
+
+/* Cluster revisions, as on endpoint 1 */
+constexpr uint16_t kEnergyEvseClusterRevision                  = 2;
+constexpr uint16_t kDeviceEnergyManagementClusterRevision      = 3;
+constexpr uint16_t kElectricalPowerMeasurementClusterRevision  = 1;
+constexpr uint16_t kElectricalEnergyMeasurementClusterRevision = 1;
+constexpr uint16_t kPowerTopologyClusterRevision               = 1;
+
+/* EV and supply characteristics */
+constexpr int64_t kMaxHardwareCurrent_mA  = 32000;
+constexpr int64_t kMinimumChargeCurrent_mA = 6000;
+constexpr int64_t kNominalVoltage_mV       = 230000;
+constexpr uint32_t kVoltageRandomness_mV   = 2000;
+constexpr uint32_t kMinSessionEnergy_Wh    = 5000;
+constexpr uint32_t kMaxSessionEnergy_Wh    = 40000;
+constexpr uint32_t kMinIdleTime_s          = 10 * 60;
+constexpr uint32_t kMaxIdleTime_s          = 4 * 60 * 60;
+constexpr uint32_t kMinParkedTime_s        = 10 * 60;
+constexpr uint32_t kMaxParkedTime_s        = 2 * 60 * 60;
+constexpr uint8_t kTaperStartPercent       = 80; /* The EV reduces its current towards the end of the session */
+
+/* Real seconds, over which the start of charging is spread once enabled */
+constexpr uint32_t kRandomizationDelayWindow_s = 10;
+
+constexpr uint16_t kDescriptorAttributeArraySize = 254;
+
+// Descriptor cluster attributes
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(descriptorAttrs)
+DECLARE_DYNAMIC_ATTRIBUTE(Descriptor::Attributes::DeviceTypeList::Id, ARRAY, kDescriptorAttributeArraySize, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(Descriptor::Attributes::ServerList::Id, ARRAY, kDescriptorAttributeArraySize, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(Descriptor::Attributes::ClientList::Id, ARRAY, kDescriptorAttributeArraySize, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(Descriptor::Attributes::PartsList::Id, ARRAY, kDescriptorAttributeArraySize, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+// Energy EVSE cluster attributes, without optional features
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(energyEvseAttrs)
+DECLARE_DYNAMIC_ATTRIBUTE(EnergyEvse::Attributes::State::Id, ENUM8, 1, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(EnergyEvse::Attributes::SupplyState::Id, ENUM8, 1, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(EnergyEvse::Attributes::FaultState::Id, ENUM8, 1, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(EnergyEvse::Attributes::ChargingEnabledUntil::Id, INT32U, 4, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(EnergyEvse::Attributes::CircuitCapacity::Id, INT64S, 8, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(EnergyEvse::Attributes::MinimumChargeCurrent::Id, INT64S, 8, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(EnergyEvse::Attributes::MaximumChargeCurrent::Id, INT64S, 8, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(EnergyEvse::Attributes::SessionID::Id, INT32U, 4, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(EnergyEvse::Attributes::SessionDuration::Id, INT32U, 4, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(EnergyEvse::Attributes::SessionEnergyCharged::Id, INT64S, 8, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(EnergyEvse::Attributes::FeatureMap::Id, BITMAP32, 4, 0), DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+// Device Energy Management cluster attributes, with the PowerForecastReporting feature
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(deviceEnergyManagementAttrs)
+DECLARE_DYNAMIC_ATTRIBUTE(DeviceEnergyManagement::Attributes::ESAType::Id, ENUM8, 1, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(DeviceEnergyManagement::Attributes::ESACanGenerate::Id, BOOLEAN, 1, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(DeviceEnergyManagement::Attributes::ESAState::Id, ENUM8, 1, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(DeviceEnergyManagement::Attributes::AbsMinPower::Id, INT64S, 8, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(DeviceEnergyManagement::Attributes::AbsMaxPower::Id, INT64S, 8, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(DeviceEnergyManagement::Attributes::Forecast::Id, STRUCT, 0, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(DeviceEnergyManagement::Attributes::FeatureMap::Id, BITMAP32, 4, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+// Electrical Power Measurement cluster attributes, for an AC meter
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(electricalPowerMeasurementAttrs)
+DECLARE_DYNAMIC_ATTRIBUTE(ElectricalPowerMeasurement::Attributes::PowerMode::Id, ENUM8, 1, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(ElectricalPowerMeasurement::Attributes::NumberOfMeasurementTypes::Id, INT8U, 1, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(ElectricalPowerMeasurement::Attributes::Accuracy::Id, ARRAY, 0, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(ElectricalPowerMeasurement::Attributes::Voltage::Id, INT64S, 8, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(ElectricalPowerMeasurement::Attributes::ActiveCurrent::Id, INT64S, 8, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(ElectricalPowerMeasurement::Attributes::ActivePower::Id, INT64S, 8, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(ElectricalPowerMeasurement::Attributes::FeatureMap::Id, BITMAP32, 4, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+// Electrical Energy Measurement cluster attributes
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(electricalEnergyMeasurementAttrs)
+DECLARE_DYNAMIC_ATTRIBUTE(ElectricalEnergyMeasurement::Attributes::Accuracy::Id, STRUCT, 0, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(ElectricalEnergyMeasurement::Attributes::CumulativeEnergyImported::Id, STRUCT, 0, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(ElectricalEnergyMeasurement::Attributes::CumulativeEnergyExported::Id, STRUCT, 0, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(ElectricalEnergyMeasurement::Attributes::PeriodicEnergyImported::Id, STRUCT, 0, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(ElectricalEnergyMeasurement::Attributes::PeriodicEnergyExported::Id, STRUCT, 0, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(ElectricalEnergyMeasurement::Attributes::CumulativeEnergyReset::Id, STRUCT, 0, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(ElectricalEnergyMeasurement::Attributes::FeatureMap::Id, BITMAP32, 4, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+// Commands are handled, and enumerated, by the CommandHandlerInterface of each cluster instance
+DECLARE_DYNAMIC_CLUSTER_LIST_BEGIN(simulatedEvseClusters)
+DECLARE_DYNAMIC_CLUSTER(Descriptor::Id, descriptorAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr, nullptr),
+    DECLARE_DYNAMIC_CLUSTER(EnergyEvse::Id, energyEvseAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr, nullptr),
+    DECLARE_DYNAMIC_CLUSTER(DeviceEnergyManagement::Id, deviceEnergyManagementAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr, nullptr),
+    DECLARE_DYNAMIC_CLUSTER(ElectricalPowerMeasurement::Id, electricalPowerMeasurementAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr,
+                            nullptr),
+    DECLARE_DYNAMIC_CLUSTER(ElectricalEnergyMeasurement::Id, electricalEnergyMeasurementAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr,
+                            nullptr) DECLARE_DYNAMIC_CLUSTER_LIST_END;
+
+DECLARE_DYNAMIC_ENDPOINT(simulatedEvseEndpoint, simulatedEvseClusters);
+
+// Power Topology cluster attributes, with the SetTopology and DynamicPowerFlow features
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(powerTopologyAttrs)
+DECLARE_DYNAMIC_ATTRIBUTE(PowerTopology::Attributes::AvailableEndpoints::Id, ARRAY, 0, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(PowerTopology::Attributes::ActiveEndpoints::Id, ARRAY, 0, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(PowerTopology::Attributes::FeatureMap::Id, BITMAP32, 4, 0), DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+// Electrical Power Measurement cluster attributes of the site, which only measures the active power
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(siteElectricalPowerMeasurementAttrs)
+DECLARE_DYNAMIC_ATTRIBUTE(ElectricalPowerMeasurement::Attributes::PowerMode::Id, ENUM8, 1, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(ElectricalPowerMeasurement::Attributes::NumberOfMeasurementTypes::Id, INT8U, 1, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(ElectricalPowerMeasurement::Attributes::Accuracy::Id, ARRAY, 0, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(ElectricalPowerMeasurement::Attributes::ActivePower::Id, INT64S, 8, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(ElectricalPowerMeasurement::Attributes::FeatureMap::Id, BITMAP32, 4, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+DECLARE_DYNAMIC_CLUSTER_LIST_BEGIN(siteMeterClusters)
+DECLARE_DYNAMIC_CLUSTER(Descriptor::Id, descriptorAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr, nullptr),
+    DECLARE_DYNAMIC_CLUSTER(PowerTopology::Id, powerTopologyAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr, nullptr),
+    DECLARE_DYNAMIC_CLUSTER(ElectricalPowerMeasurement::Id, siteElectricalPowerMeasurementAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr,
+                            nullptr),
+    DECLARE_DYNAMIC_CLUSTER(ElectricalEnergyMeasurement::Id, electricalEnergyMeasurementAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr,
+                            nullptr) DECLARE_DYNAMIC_CLUSTER_LIST_END;
+
+DECLARE_DYNAMIC_ENDPOINT(siteMeterEndpoint, siteMeterClusters);
+
+/* Sums the readings of the simulated EVSEs into the site meter */
+PowerRollup gSiteRollup;
+
+uint32_t RandomInRange(uint32_t min, uint32_t max)
+{
+    return min + static_cast<uint32_t>(rand()) % (max - min + 1);
+}
+
+/**
+ * An EVSE on a dynamic endpoint, with its own cluster instances, charging
+ * a randomized sequence of EVs.
+ */
+class SimulatedEvse
+{
+public:
+    CHIP_ERROR Init(uint16_t index, EndpointId endpointId, PowerRollup::Node & site);
+    void Shutdown();
+
+    /**
+     * @brief Advances the charging session by `seconds` and sends the meter readings
+     *
+     * @return the number of readings sent
+     */
+    uint32_t Tick(uint32_t seconds);
+
+    bool IsInitialized() const { return mEvseInstance != nullptr; }
+    bool IsCharging() const { return mPhase == Phase::kCharging; }
+    EndpointId GetEndpointId() const { return mEndpointId; }
+
+private:
+    enum class Phase : uint8_t
+    {
+        kUnplugged, /* No EV */
+        kCharging,  /* EV plugged in and asking for energy */
+        kParked,    /* EV charged, but still plugged in */
+    };
+
+    void PlugIn();
+    void ChargeFor(uint32_t seconds, int64_t & power_mW, int64_t & voltage_mV, int64_t & current_mA);
+
+    EndpointId mEndpointId = kInvalidEndpointId;
+    uint16_t mIndex        = 0;
+    DataVersion mDataVersions[ArraySize(simulatedEvseClusters)];
+
+    std::unique_ptr<EnergyEvseDelegate> mEvseDelegate;
+    std::unique_ptr<EnergyEvseManager> mEvseInstance;
+    std::unique_ptr<DeviceEnergyManagementDelegate> mDEMDelegate;
+    std::unique_ptr<DeviceEnergyManagementManager> mDEMInstance;
+    std::unique_ptr<ElectricalPowerMeasurementDelegate> mEPMDelegate;
+    std::unique_ptr<ElectricalPowerMeasurementInstance> mEPMInstance;
+    std::unique_ptr<PowerRollup::Node> mRollupNode;
+
+    Phase mPhase                    = Phase::kUnplugged;
+    uint32_t mPhaseRemaining_s      = 0;
+    int64_t mSessionTarget_mWh      = 0;
+    int64_t mSessionEnergy_mWh      = 0;
+    int64_t mTotalEnergyImported_mWh = 0;
+};
+
+/**
+ * A virtual meter on a dynamic endpoint, reporting the total power and energy of the
+ * simulated EVSEs, and listing them in its PowerTopology cluster, so that a controller
+ * can follow the whole site from a single subscription.
+ */
+class SiteMeter : public PowerRollup::Node
+{
+public:
+    using PowerRollup::Node::Node;
+
+    CHIP_ERROR Init(uint16_t index);
+    void Shutdown();
+
+    void OnRollupChanged(BitFlags<PowerRollup::Change> changes) override;
+
+private:
+    uint16_t mIndex                     = 0;
+    bool mEndpointAdded                 = false;
+    int64_t mReportedEnergyImported_mWh = -1;
+    DataVersion mDataVersions[ArraySize(siteMeterClusters)];
+
+    std::unique_ptr<PowerTopologyDelegate> mPTDelegate;
+    std::unique_ptr<PowerTopologyInstance> mPTInstance;
+    std::unique_ptr<ElectricalPowerMeasurementDelegate> mEPMDelegate;
+    std::unique_ptr<ElectricalPowerMeasurementInstance> mEPMInstance;
+};
+
+struct SimulatorStatistics
+{
+    System::Clock::Microseconds64 periodStart;
+    uint64_t dirtyGenerationAtStart = 0;
+    uint32_t ticks                  = 0;
+    uint32_t readings               = 0;
+    uint64_t totalTickTime_us       = 0;
+    uint64_t maxTickTime_us         = 0;
+    uint32_t latencySamples         = 0;
+    uint64_t totalLatency_us        = 0;
+    uint64_t maxLatency_us          = 0;
+};
+
+uint16_t gSimulatedEvseCount    = 0;
+uint32_t gSimulationIntervalMs  = kDefaultSimulationIntervalMs;
+/* The site meter takes the dynamic endpoint following those of the simulated EVSEs */
+SimulatedEvse gSimulatedEvses[CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT - 1];
+std::unique_ptr<SiteMeter> gSiteMeter;
+SimulatorStatistics gStatistics;
+RandomizedStartScheduler::SystemLayerTimerDelegate gStartTimerDelegate(DeviceLayer::SystemLayer());
+RandomizedStartScheduler gStartScheduler(gStartTimerDelegate);
+/* Time of the oldest change that the subscribers have not all been sent yet, 0 if there is none */
+System::Clock::Microseconds64 gUndeliveredSince(0);
+
+bool HandleSimulatorOption(const char * aProgram, ArgParser::OptionSet * aOptions, int aIdentifier, const char * aName,
+                           const char * aValue)
+{
+    switch (aIdentifier)
+    {
+    case kOptionSimulatedEvses:
+        if (!ArgParser::ParseInt(aValue, gSimulatedEvseCount) || gSimulatedEvseCount > ArraySize(gSimulatedEvses))
+        {
+            ArgParser::PrintArgError("%s: ERROR: Invalid number of simulated EVSEs (at most %u): %s\n", aProgram,
+                                     static_cast<unsigned>(ArraySize(gSimulatedEvses)), aValue);
+            return false;
+        }
+        return true;
+    case kOptionSimulationInterval:
+        if (!ArgParser::ParseInt(aValue, gSimulationIntervalMs) || gSimulationIntervalMs == 0)
+        {
+            ArgParser::PrintArgError("%s: ERROR: Invalid simulation interval: %s\n", aProgram, aValue);
+            return false;
+        }
+        return true;
+    default:
+        ArgParser::PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", aProgram, aName);
+        return false;
+    }
+}
+
+ArgParser::OptionDef gSimulatorOptionDefs[] = {
+    { "simulated-evses", ArgParser::kArgumentRequired, kOptionSimulatedEvses },
+    { "simulation-interval", ArgParser::kArgumentRequired, kOptionSimulationInterval },
+    {},
+};
+
+/* ---------------------------------------------------------------------------
+ *  Simulated EVSE
+ */
+
+CHIP_ERROR SimulatedEvse::Init(uint16_t index, EndpointId endpointId, PowerRollup::Node & site)
+{
+    mIndex      = index;
+    mEndpointId = endpointId;
+
+    mEvseDelegate = std::make_unique<EnergyEvseDelegate>();
+    mEvseInstance = std::make_unique<EnergyEvseManager>(endpointId, *mEvseDelegate, BitMask<EnergyEvse::Feature, uint32_t>(),
+                                                        BitMask<EnergyEvse::OptionalAttributes, uint32_t>(),
+                                                        BitMask<EnergyEvse::OptionalCommands, uint32_t>());
+    ReturnErrorOnFailure(mEvseInstance->Init());
+
+    mDEMDelegate = std::make_unique<DeviceEnergyManagementDelegate>();
+    mDEMInstance = std::make_unique<DeviceEnergyManagementManager>(
+        endpointId, *mDEMDelegate,
+        BitMask<DeviceEnergyManagement::Feature, uint32_t>(DeviceEnergyManagement::Feature::kPowerForecastReporting));
+    ReturnErrorOnFailure(mDEMInstance->Init());
+
+    mEPMDelegate = std::make_unique<ElectricalPowerMeasurementDelegate>();
+    mEPMInstance = std::make_unique<ElectricalPowerMeasurementInstance>(
+        endpointId, *mEPMDelegate,
+        BitMask<ElectricalPowerMeasurement::Feature, uint32_t>(ElectricalPowerMeasurement::Feature::kAlternatingCurrent),
+        BitMask<ElectricalPowerMeasurement::OptionalAttributes, uint32_t>(
+            ElectricalPowerMeasurement::OptionalAttributes::kOptionalAttributeVoltage,
+            ElectricalPowerMeasurement::OptionalAttributes::kOptionalAttributeActiveCurrent));
+    ReturnErrorOnFailure(mEPMInstance->Init());
+    ReturnErrorOnFailure(mEPMDelegate->SetPowerMode(PowerModeEnum::kAc));
+
+    /* Report the small fluctuations of a real meter at most once a minute */
+    ElectricalPowerMeasurement::ReportableChange change;
+    change.maxInterval  = System::Clock::Seconds32(60);
+    change.percentDelta = 2;
+    mEPMInstance->SetReportableChange(ElectricalPowerMeasurement::Attributes::ActivePower::Id, change);
+    mEPMInstance->SetReportableChange(ElectricalPowerMeasurement::Attributes::ActiveCurrent::Id, change);
+    change.percentDelta  = 0;
+    change.absoluteDelta = 1000; // 1 V
+    mEPMInstance->SetReportableChange(ElectricalPowerMeasurement::Attributes::Voltage::Id, change);
+
+    /* The cluster instances must exist before the endpoint, whose cluster init callbacks may use them */
+    ReturnErrorOnFailure(emberAfSetDynamicEndpoint(index, endpointId, &simulatedEvseEndpoint, Span<DataVersion>(mDataVersions),
+                                                   Span<const EmberAfDeviceType>(kSimulatedEvseDeviceTypes)));
+
+    mEvseDelegate->HwSetMaxHardwareCurrentLimit(kMaxHardwareCurrent_mA);
+    mEvseDelegate->HwSetCircuitCapacity(kMaxHardwareCurrent_mA);
+    ReturnErrorOnFailure(mEvseDelegate->SetLoadBalancer(&GetSiteLoadBalancer()));
+    ReturnErrorOnFailure(mEvseDelegate->SetRandomizationDelayWindow(kRandomizationDelayWindow_s));
+    mEvseDelegate->SetStartScheduler(&gStartScheduler);
+
+    mRollupNode = std::make_unique<PowerRollup::Node>(endpointId);
+    ReturnErrorOnFailure(gSiteRollup.Add(*mRollupNode, &site));
+
+    /* Do not plug in all the EVs at the same time */
+    mPhase            = Phase::kUnplugged;
+    mPhaseRemaining_s = RandomInRange(0, kMaxIdleTime_s);
+    return CHIP_NO_ERROR;
+}
+
+void SimulatedEvse::Shutdown()
+{
+    if (mRollupNode)
+    {
+        gSiteRollup.Remove(*mRollupNode);
+        mRollupNode.reset();
+    }
+
+    if (mEndpointId != kInvalidEndpointId)
+    {
+        emberAfClearDynamicEndpoint(mIndex);
+        mEndpointId = kInvalidEndpointId;
+    }
+
+    if (mEPMInstance)
+    {
+        mEPMInstance->Shutdown();
+    }
+    if (mDEMInstance)
+    {
+        mDEMInstance->Shutdown();
+    }
+    if (mEvseInstance)
+    {
+        mEvseInstance->Shutdown();
+    }
+
+    /* Instances first, then their delegates */
+    mEPMInstance.reset();
+    mDEMInstance.reset();
+    mEvseInstance.reset();
+    mEPMDelegate.reset();
+    mDEMDelegate.reset();
+    mEvseDelegate.reset();
+}
+
+void SimulatedEvse::PlugIn()
+{
+    mEvseDelegate->HwSetState(StateEnum::kPluggedInNoDemand);
+    mEvseDelegate->HwSetCableAssemblyLimit(kMaxHardwareCurrent_mA);
+    mEvseDelegate->EnableCharging(NullNullable, kMinimumChargeCurrent_mA, kMaxHardwareCurrent_mA);
+    mEvseDelegate->HwSetState(StateEnum::kPluggedInDemand);
+
+    mSessionTarget_mWh = static_cast<int64_t>(RandomInRange(kMinSessionEnergy_Wh, kMaxSessionEnergy_Wh)) * 1000;
+    mSessionEnergy_mWh = 0;
+}
+
+void SimulatedEvse::ChargeFor(uint32_t seconds, int64_t & power_mW, int64_t & voltage_mV, int64_t & current_mA)
+{
+    /* Nothing is drawn until the randomized start of charging */
+    if (mEvseDelegate->GetState() != StateEnum::kPluggedInCharging)
+    {
+        return;
+    }
+
+    /* The EV draws what the site balancer allocated to this EVSE, less towards the end of the session */
+    current_mA = mEvseDelegate->GetMaximumChargeCurrent();
+    if (mSessionEnergy_mWh * 100 > mSessionTarget_mWh * kTaperStartPercent)
+    {
+        current_mA =
+            current_mA * (mSessionTarget_mWh - mSessionEnergy_mWh) * 100 / (mSessionTarget_mWh * (100 - kTaperStartPercent));
+        current_mA = std::max(current_mA, kMinimumChargeCurrent_mA);
+    }
+
+    power_mW = voltage_mV * current_mA / 1000;
+    mSessionEnergy_mWh += power_mW * seconds / 3600;
+}
+
+uint32_t SimulatedEvse::Tick(uint32_t seconds)
+{
+    int64_t voltage_mV = kNominalVoltage_mV + static_cast<int64_t>(RandomInRange(0, 2 * kVoltageRandomness_mV)) -
+        static_cast<int64_t>(kVoltageRandomness_mV);
+    int64_t current_mA = 0;
+    int64_t power_mW   = 0;
+
+    mPhaseRemaining_s = (mPhaseRemaining_s > seconds) ? mPhaseRemaining_s - seconds : 0;
+
+    switch (mPhase)
+    {
+    case Phase::kUnplugged:
+        if (mPhaseRemaining_s == 0)
+        {
+            PlugIn();
+            mPhase = Phase::kCharging;
+        }
+        break;
+    case Phase::kCharging:
+        ChargeFor(seconds, power_mW, voltage_mV, current_mA);
+        if (mSessionEnergy_mWh >= mSessionTarget_mWh)
+        {
+            mEvseDelegate->HwSetState(StateEnum::kPluggedInNoDemand);
+            mPhase            = Phase::kParked;
+            mPhaseRemaining_s = RandomInRange(kMinParkedTime_s, kMaxParkedTime_s);
+        }
+        break;
+    case Phase::kParked:
+        if (mPhaseRemaining_s == 0)
+        {
+            mEvseDelegate->HwSetState(StateEnum::kNotPluggedIn);
+            mPhase            = Phase::kUnplugged;
+            mPhaseRemaining_s = RandomInRange(kMinIdleTime_s, kMaxIdleTime_s);
+        }
+        break;
+    }
+
+    /* Send the readings as a meter would, whether or not they changed, as a single measurement frame */
+    mEPMInstance->BeginUpdate();
+    mEPMDelegate->SetVoltage(MakeNullable(voltage_mV));
+    mEPMDelegate->SetActiveCurrent(MakeNullable(current_mA));
+    mEPMDelegate->SetActivePower(MakeNullable(power_mW));
+    mEPMInstance->CommitUpdate();
+
+    const int64_t periodicEnergy_mWh = power_mW * seconds / 3600;
+    mTotalEnergyImported_mWh += periodicEnergy_mWh;
+
+    gSiteRollup.SetMeasurement(*mRollupNode, PowerRollup::Quantity::kActivePower, MakeNullable(power_mW));
+    gSiteRollup.SetMeasurement(*mRollupNode, PowerRollup::Quantity::kCumulativeEnergyImported,
+                               MakeNullable(mTotalEnergyImported_mWh));
+
+    EVSEManufacturer * mn = GetEvseManufacturer();
+    VerifyOrReturnValue(mn != nullptr, kPowerReadingsPerTick);
+    mn->SendPeriodicEnergyReading(mEndpointId, periodicEnergy_mWh, 0);
+    mn->SendCumulativeEnergyReading(mEndpointId, mTotalEnergyImported_mWh, 0);
+    return kPowerReadingsPerTick + kEnergyReadingsPerTick;
+}
+
+/* ---------------------------------------------------------------------------
+ *  Site meter
+ */
+
+CHIP_ERROR SiteMeter::Init(uint16_t index)
+{
+    mIndex = index;
+
+    mPTDelegate = std::make_unique<PowerTopologyDelegate>();
+    mPTDelegate->SetRollupNode(this);
+    mPTInstance = std::make_unique<PowerTopologyInstance>(
+        GetEndpointId(), *mPTDelegate,
+        BitMask<PowerTopology::Feature, uint32_t>(PowerTopology::Feature::kSetTopology, PowerTopology::Feature::kDynamicPowerFlow),
+        BitMask<PowerTopology::OptionalAttributes, uint32_t>(
+            PowerTopology::OptionalAttributes::kOptionalAttributeAvailableEndpoints,
+            PowerTopology::OptionalAttributes::kOptionalAttributeActiveEndpoints));
+    ReturnErrorOnFailure(mPTInstance->Init());
+
+    mEPMDelegate = std::make_unique<ElectricalPowerMeasurementDelegate>();
+    mEPMInstance = std::make_unique<ElectricalPowerMeasurementInstance>(
+        GetEndpointId(), *mEPMDelegate,
+        BitMask<ElectricalPowerMeasurement::Feature, uint32_t>(ElectricalPowerMeasurement::Feature::kAlternatingCurrent),
+        BitMask<ElectricalPowerMeasurement::OptionalAttributes, uint32_t>());
+    ReturnErrorOnFailure(mEPMInstance->Init());
+    ReturnErrorOnFailure(mEPMDelegate->SetPowerMode(PowerModeEnum::kAc));
+
+    ReturnErrorOnFailure(emberAfSetDynamicEndpoint(index, GetEndpointId(), &siteMeterEndpoint, Span<DataVersion>(mDataVersions),
+                                                   Span<const EmberAfDeviceType>(kSiteMeterDeviceTypes)));
+    mEndpointAdded = true;
+
+    return gSiteRollup.Add(*this);
+}
+
+void SiteMeter::Shutdown()
+{
+    /* Also detaches the simulated EVSEs, without notifying the site */
+    gSiteRollup.Remove(*this);
+
+    if (mEndpointAdded)
+    {
+        emberAfClearDynamicEndpoint(mIndex);
+        mEndpointAdded = false;
+    }
+
+    if (mEPMInstance)
+    {
+        mEPMInstance->Shutdown();
+    }
+    if (mPTInstance)
+    {
+        mPTInstance->Shutdown();
+    }
+
+    mEPMInstance.reset();
+    mPTInstance.reset();
+    mEPMDelegate.reset();
+    mPTDelegate.reset();
+}
+
+void SiteMeter::OnRollupChanged(BitFlags<PowerRollup::Change> changes)
+{
+    if (changes.Has(PowerRollup::Change::kTotals))
+    {
+        mEPMDelegate->SetActivePower(GetTotal(PowerRollup::Quantity::kActivePower));
+
+        /* Only send a reading when the energy changed, not on every change of power */
+        const Nullable<int64_t> imported = GetTotal(PowerRollup::Quantity::kCumulativeEnergyImported);
+        EVSEManufacturer * mn            = GetEvseManufacturer();
+        if (mn != nullptr && !imported.IsNull() && imported.Value() != mReportedEnergyImported_mWh)
+        {
+            mn->SendCumulativeEnergyReading(GetEndpointId(), imported.Value(), 0);
+            mReportedEnergyImported_mWh = imported.Value();
+        }
+    }
+    if (changes.Has(PowerRollup::Change::kChildren))
+    {
+        MatterReportingAttributeChangeCallback(GetEndpointId(), PowerTopology::Id,
+                                               PowerTopology::Attributes::AvailableEndpoints::Id);
+    }
+    if (changes.Has(PowerRollup::Change::kActiveChildren))
+    {
+        MatterReportingAttributeChangeCallback(GetEndpointId(), PowerTopology::Id, PowerTopology::Attributes::ActiveEndpoints::Id);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ *  Simulation and statistics
+ */
+
+System::Clock::Microseconds64 Now()
+{
+    return System::SystemClock().GetMonotonicMicroseconds64();
+}
+
+bool ReportsDelivered()
+{
+    reporting::Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    return !engine.HasDirtyAttributePaths() && engine.GetNumReportsInFlight() == 0;
+}
+
+void LatencyPollTimerExpiry(System::Layer * systemLayer, void * context)
+{
+    if (!ReportsDelivered())
+    {
+        DeviceLayer::SystemLayer().StartTimer(kLatencyPollInterval, LatencyPollTimerExpiry, nullptr);
+        return;
+    }
+
+    /* The latency includes the MinInterval of the subscriptions, as seen by the subscribers */
+    const uint64_t latency_us = (Now() - gUndeliveredSince).count();
+    gStatistics.latencySamples++;
+    gStatistics.totalLatency_us += latency_us;
+    gStatistics.maxLatency_us = std::max(gStatistics.maxLatency_us, latency_us);
+    gUndeliveredSince         = System::Clock::Microseconds64(0);
+}
+
+void ResetStatistics()
+{
+    gStatistics                        = SimulatorStatistics();
+    gStatistics.periodStart            = Now();
+    gStatistics.dirtyGenerationAtStart = InteractionModelEngine::GetInstance()->GetReportingEngine().GetDirtySetGeneration();
+}
+
+void LogStatistics()
+{
+    const uint64_t period_ms = std::max<uint64_t>((Now() - gStatistics.periodStart).count() / 1000, 1);
+    const uint64_t changes =
+        InteractionModelEngine::GetInstance()->GetReportingEngine().GetDirtySetGeneration() - gStatistics.dirtyGenerationAtStart;
+
+    uint16_t charging = 0;
+    for (uint16_t i = 0; i < gSimulatedEvseCount; i++)
+    {
+        charging = static_cast<uint16_t>(charging + (gSimulatedEvses[i].IsCharging() ? 1 : 0));
+    }
+
+    const EvseLoadBalancer & balancer = GetSiteLoadBalancer();
+    ChipLogProgress(AppServer, "Simulator: %u EVSEs, %u charging, %ld mA allocated of %ld mA", gSimulatedEvseCount, charging,
+                    static_cast<long>(balancer.GetAllocatedCurrent()), static_cast<long>(balancer.GetCapacity()));
+    ChipLogProgress(AppServer, "Simulator: %lu attribute changes/s, %lu readings/s, tick avg %lu us max %lu us",
+                    static_cast<unsigned long>(changes * 1000 / period_ms),
+                    static_cast<unsigned long>(gStatistics.readings * 1000ull / period_ms),
+                    static_cast<unsigned long>(gStatistics.ticks ? gStatistics.totalTickTime_us / gStatistics.ticks : 0),
+                    static_cast<unsigned long>(gStatistics.maxTickTime_us));
+    ChipLogProgress(AppServer, "Simulator: %u subscriptions, report latency avg %lu us max %lu us over %u ticks",
+                    static_cast<unsigned>(InteractionModelEngine::GetInstance()->GetNumActiveReadHandlers(
+                        ReadHandler::InteractionType::Subscribe)),
+                    static_cast<unsigned long>(gStatistics.latencySamples ? gStatistics.totalLatency_us / gStatistics.latencySamples
+                                                                          : 0),
+                    static_cast<unsigned long>(gStatistics.maxLatency_us), static_cast<unsigned>(gStatistics.latencySamples));
+}
+
+void SimulationTimerExpiry(System::Layer * systemLayer, void * context)
+{
+    const System::Clock::Microseconds64 start = Now();
+
+    /* The site meter is updated once per tick, not once per EVSE */
+    gSiteRollup.BeginUpdate();
+    for (uint16_t i = 0; i < gSimulatedEvseCount; i++)
+    {
+        gStatistics.readings += gSimulatedEvses[i].Tick(kSimulatedSecondsPerTick);
+    }
+    gSiteRollup.CommitUpdate();
+
+    const uint64_t tickTime_us = (Now() - start).count();
+    gStatistics.ticks++;
+    gStatistics.totalTickTime_us += tickTime_us;
+    gStatistics.maxTickTime_us = std::max(gStatistics.maxTickTime_us, tickTime_us);
+
+    /* Measure how long the subscribers wait for the changes, from the oldest undelivered one */
+    if (gUndeliveredSince.count() == 0 && !ReportsDelivered())
+    {
+        gUndeliveredSince = start;
+        DeviceLayer::SystemLayer().StartTimer(kLatencyPollInterval, LatencyPollTimerExpiry, nullptr);
+    }
+
+    if (Now() - gStatistics.periodStart >= kStatisticsInterval)
+    {
+        LogStatistics();
+        ResetStatistics();
+    }
+
+    DeviceLayer::SystemLayer().StartTimer(System::Clock::Milliseconds32(gSimulationIntervalMs), SimulationTimerExpiry, nullptr);
+}
+
+} // namespace
+
+ArgParser::OptionSet gEnergyDeviceSimulatorOptions = {
+    HandleSimulatorOption, gSimulatorOptionDefs, "SIMULATOR OPTIONS",
+    "  --simulated-evses <count>\n"
+    "       Number of simulated EVSEs, each on its own dynamic endpoint, sharing the site circuit with endpoint 1.\n"
+    "       A site meter, on the following dynamic endpoint, reports their total power and energy.\n"
+    "       Throughput and subscription latency statistics are logged every 10 seconds.\n"
+    "  --simulation-interval <ms>\n"
+    "       Period of the simulation, each period simulating a minute of charging. Defaults to 1000 ms.\n"
+};
+
+CHIP_ERROR EnergyDeviceSimulatorInit()
+{
+    VerifyOrReturnError(gSimulatedEvseCount > 0, CHIP_NO_ERROR);
+
+    /* Dynamic endpoints follow the fixed ones */
+    const EndpointId firstEndpointId =
+        static_cast<EndpointId>(emberAfEndpointFromIndex(static_cast<uint16_t>(emberAfFixedEndpointCount() - 1)) + 1);
+
+    gSiteMeter     = std::make_unique<SiteMeter>(static_cast<EndpointId>(firstEndpointId + gSimulatedEvseCount));
+    CHIP_ERROR err = gSiteMeter->Init(gSimulatedEvseCount);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(AppServer, "Failed to add the site meter: %" CHIP_ERROR_FORMAT, err.Format());
+        EnergyDeviceSimulatorShutdown();
+        return err;
+    }
+
+    for (uint16_t i = 0; i < gSimulatedEvseCount; i++)
+    {
+        err = gSimulatedEvses[i].Init(i, static_cast<EndpointId>(firstEndpointId + i), *gSiteMeter);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(AppServer, "Failed to add simulated EVSE %u: %" CHIP_ERROR_FORMAT, i, err.Format());
+            gSimulatedEvses[i].Shutdown();
+            EnergyDeviceSimulatorShutdown();
+            return err;
+        }
+    }
+    ChipLogProgress(AppServer, "Simulating %u EVSEs on endpoints %u to %u, site meter on endpoint %u", gSimulatedEvseCount,
+                    firstEndpointId, static_cast<unsigned>(firstEndpointId + gSimulatedEvseCount - 1), gSiteMeter->GetEndpointId());
+
+    ResetStatistics();
+    return DeviceLayer::SystemLayer().StartTimer(System::Clock::Milliseconds32(gSimulationIntervalMs), SimulationTimerExpiry,
+                                                 nullptr);
+}
+
+void EnergyDeviceSimulatorShutdown()
+{
+    DeviceLayer::SystemLayer().CancelTimer(SimulationTimerExpiry, nullptr);
+    DeviceLayer::SystemLayer().CancelTimer(LatencyPollTimerExpiry, nullptr);
+
+    if (gSiteMeter)
+    {
+        gSiteMeter->Shutdown();
+        gSiteMeter.reset();
+    }
+
+    for (auto & evse : gSimulatedEvses)
+    {
+        if (evse.IsInitialized())
+        {
+            evse.Shutdown();
+        }
+    }
+}
+
+/* The cluster revisions of the dynamic endpoints are not held by the cluster instances */
+Status emberAfExternalAttributeReadCallback(EndpointId endpoint, ClusterId clusterId,
+                                            const EmberAfAttributeMetadata * attributeMetadata, uint8_t * buffer,
+                                            uint16_t maxReadLength)
+{
+    VerifyOrReturnValue(attributeMetadata->attributeId == Globals::Attributes::ClusterRevision::Id, Status::Failure);
+    /* The simulated EVSEs, then the site meter */
+    VerifyOrReturnValue(emberAfGetDynamicIndexFromEndpoint(endpoint) <= gSimulatedEvseCount, Status::Failure);
+    VerifyOrReturnValue(maxReadLength >= sizeof(uint16_t), Status::ResourceExhausted);
+
+    uint16_t revision;
+    switch (clusterId)
+    {
+    case EnergyEvse::Id:
+        revision = kEnergyEvseClusterRevision;
+        break;
+    case DeviceEnergyManagement::Id:
+        revision = kDeviceEnergyManagementClusterRevision;
+        break;
+    case ElectricalPowerMeasurement::Id:
+        revision = kElectricalPowerMeasurementClusterRevision;
+        break;
+    case ElectricalEnergyMeasurement::Id:
+        revision = kElectricalEnergyMeasurementClusterRevision;
+        break;
+    case PowerTopology::Id:
+        revision = kPowerTopologyClusterRevision;
+        break;
+    default:
+        return Status::Failure;
+    }
+
+    memcpy(buffer, &revision, sizeof(revision));
+    return Status::Success;
+}
@@ -46,6 +46,9 @@
 
 #define CHIP_DEVICE_CONFIG_DEVICE_NAME "Test Energy Management"
 
+// Endpoints of the EVSEs added by --simulated-evses
+#define CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT 16
+
 #ifndef CHIP_DEVICE_CONFIG_DEVICE_SOFTWARE_VERSION
 #define CHIP_DEVICE_CONFIG_DEVICE_SOFTWARE_VERSION 1
 #endif
@@ -0,0 +1,45 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/CHIPArgParser.hpp>
+
+/**
+ * Command line options of the simulator:
+ *   --simulated-evses <count>       number of simulated EVSEs, each on its own dynamic endpoint
+ *   --simulation-interval <ms>      period of the simulation ticks
+ */
+extern chip::ArgParser::OptionSet gEnergyDeviceSimulatorOptions;
+
+/**
+ * @brief   Adds the simulated EVSEs requested on the command line and starts driving them
+ *
+ * Each simulated EVSE has its own EnergyEvse, DeviceEnergyManagement, ElectricalPowerMeasurement
+ * and ElectricalEnergyMeasurement clusters, and shares the site circuit with the EVSE of endpoint 1.
+ * Charging sessions follow randomized plug-in, charging and idle periods, each tick simulating a
+ * minute, and the power and energy readings are sent as a meter would. A site meter, on the
+ * following dynamic endpoint, reports their totals and lists them in its PowerTopology cluster.
+ *
+ * Throughput (attribute changes and readings per second), tick processing time and subscription
+ * report latency are logged periodically, to size hardware for multi-charger sites and to
+ * catch performance regressions. Does nothing if no simulated EVSEs were requested.
+ */
+CHIP_ERROR EnergyDeviceSimulatorInit();
+void EnergyDeviceSimulatorShutdown();
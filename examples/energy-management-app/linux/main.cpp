@@ -17,23 +17,54 @@
  */
 
 #include <AppMain.h>
+#include <EnergyDeviceSimulator.h>
 #include <EnergyEvseMain.h>
 
+#include <app/DeferredAttributePersistenceProvider.h>
+#include <app/server/Server.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr EndpointId kEvseEndpoint = 1;
+
+// The forecast is revised on every adjustment request, so it is only written to the
+// storage once it has remained constant for 5 seconds: a burst of revisions costs one
+// flash write, of the last forecast. The ForecastIds are reserved in the storage
+// without delay, so forecasts lost on a restart do not get their ForecastId reused.
+DeferredAttribute gForecastPersister(ConcreteAttributePath(kEvseEndpoint, Clusters::DeviceEnergyManagement::Id,
+                                                           Clusters::DeviceEnergyManagement::Attributes::Forecast::Id));
+DeferredAttributePersistenceProvider gDeferredAttributePersister(Server::GetInstance().GetAttributePersister(),
+                                                                 Span<DeferredAttribute>(&gForecastPersister, 1),
+                                                                 System::Clock::Milliseconds32(5000));
+
+} // namespace
+
 void ApplicationInit()
 {
     ChipLogDetail(AppServer, "Energy Management App: ApplicationInit()");
+    SetAttributePersistenceProvider(&gDeferredAttributePersister);
     EvseApplicationInit();
+
+    CHIP_ERROR err = EnergyDeviceSimulatorInit();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(AppServer, "Failed to start the energy device simulator: %" CHIP_ERROR_FORMAT, err.Format());
+    }
 }
 
 void ApplicationShutdown()
 {
     ChipLogDetail(AppServer, "Energy Management App: ApplicationShutdown()");
+    EnergyDeviceSimulatorShutdown();
     EvseApplicationShutdown();
 }
 
 int main(int argc, char * argv[])
 {
-    if (ChipLinuxAppInit(argc, argv) != 0)
+    if (ChipLinuxAppInit(argc, argv, &gEnergyDeviceSimulatorOptions) != 0)
     {
         return -1;
     }
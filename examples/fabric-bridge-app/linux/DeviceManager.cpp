@@ -32,6 +32,7 @@
 #include <lib/support/CHIPMem.h>
 #include <lib/support/ZclString.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <string>
 
@@ -55,6 +56,7 @@ DeviceManager DeviceManager::sInstance;
 void DeviceManager::Init()
 {
     memset(mDevices, 0, sizeof(mDevices));
+    mFirstFreeIndex = 0;
     mFirstDynamicEndpointId = static_cast<chip::EndpointId>(
         static_cast<int>(emberAfEndpointFromIndex(static_cast<uint16_t>(emberAfFixedEndpointCount() - 1))) + 1);
     mCurrentEndpointId = mFirstDynamicEndpointId;
@@ -64,12 +66,14 @@ int DeviceManager::AddDeviceEndpoint(Device * dev, EmberAfEndpointType * ep,
                                      const chip::Span<const EmberAfDeviceType> & deviceTypeList,
                                      const chip::Span<chip::DataVersion> & dataVersionStorage, chip::EndpointId parentEndpointId)
 {
-    uint8_t index = 0;
+    // There is no free index below mFirstFreeIndex, so adding devices does not rescan the occupied ones.
+    uint16_t index = mFirstFreeIndex;
     while (index < CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT)
     {
         if (nullptr == mDevices[index])
         {
             mDevices[index] = dev;
+            mFirstFreeIndex = static_cast<uint16_t>(index + 1);
             CHIP_ERROR err;
             int retryCount = 0;
             while (retryCount < kMaxRetries)
@@ -87,6 +91,7 @@ int DeviceManager::AddDeviceEndpoint(Device * dev, EmberAfEndpointType * ep,
                 }
                 if (err != CHIP_ERROR_ENDPOINT_EXISTS)
                 {
+                    ReleaseIndex(index);
                     return -1; // Return error as endpoint addition failed due to an error other than endpoint already exists
                 }
                 // Increment the endpoint ID and handle wrap condition
@@ -97,6 +102,7 @@ int DeviceManager::AddDeviceEndpoint(Device * dev, EmberAfEndpointType * ep,
                 retryCount++;
             }
             ChipLogError(NotSpecified, "Failed to add dynamic endpoint after %d retries", kMaxRetries);
+            ReleaseIndex(index);
             return -1; // Return error as all retries are exhausted
         }
         index++;
@@ -107,22 +113,27 @@ int DeviceManager::AddDeviceEndpoint(Device * dev, EmberAfEndpointType * ep,
 
 int DeviceManager::RemoveDeviceEndpoint(Device * dev)
 {
-    uint8_t index = 0;
-    while (index < CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT)
+    DeviceLayer::StackLock lock;
+
+    // The index of the device is that of its dynamic endpoint, found without scanning the devices.
+    uint16_t index = emberAfGetDynamicIndexFromEndpoint(dev->GetEndpointId());
+    if (index >= CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT || mDevices[index] != dev)
     {
-        if (mDevices[index] == dev)
-        {
-            DeviceLayer::StackLock lock;
-            // Silence complaints about unused ep when progress logging
-            // disabled.
-            [[maybe_unused]] EndpointId ep = emberAfClearDynamicEndpoint(index);
-            mDevices[index]                = nullptr;
-            ChipLogProgress(NotSpecified, "Removed device %s from dynamic endpoint %d (index=%d)", dev->GetName(), ep, index);
-            return index;
-        }
-        index++;
+        return -1;
     }
-    return -1;
+
+    // Silence complaints about unused ep when progress logging
+    // disabled.
+    [[maybe_unused]] EndpointId ep = emberAfClearDynamicEndpoint(index);
+    ReleaseIndex(index);
+    ChipLogProgress(NotSpecified, "Removed device %s from dynamic endpoint %d (index=%d)", dev->GetName(), ep, index);
+    return index;
+}
+
+void DeviceManager::ReleaseIndex(uint16_t index)
+{
+    mDevices[index] = nullptr;
+    mFirstFreeIndex = std::min(mFirstFreeIndex, index);
 }
 
 Device * DeviceManager::GetDevice(uint16_t index) const
@@ -51,10 +51,9 @@ public:
     /**
      * @brief Removes a device from a dynamic endpoint.
      *
-     * This function attempts to remove a device from a dynamic endpoint by iterating through the
-     * available endpoints and checking if the device matches. If the device is found, it clears the
-     * dynamic endpoint, logs the removal, and returns the index of the removed endpoint.
-     * If the device is not found, it returns -1.
+     * This function attempts to remove a device from a dynamic endpoint by looking up the index of
+     * the endpoint of the device. If the device is found, it clears the dynamic endpoint, logs the
+     * removal, and returns the index of the removed endpoint. If the device is not found, it returns -1.
      *
      * @param dev A pointer to the device to be removed.
      * @return int The index of the removed dynamic endpoint if successful, -1 otherwise.
@@ -68,8 +67,11 @@ private:
 
     static DeviceManager sInstance;
 
+    void ReleaseIndex(uint16_t index);
+
     chip::EndpointId mCurrentEndpointId;
     chip::EndpointId mFirstDynamicEndpointId;
+    uint16_t mFirstFreeIndex = 0; // No index below this one is free
     Device * mDevices[CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT + 1];
 };
 
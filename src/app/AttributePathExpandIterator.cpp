@@ -25,7 +25,9 @@
 #include <app/util/att-storage.h>
 #include <app/util/endpoint-config-api.h>
 #include <lib/core/CHIPCore.h>
+#include <lib/core/Global.h>
 #include <lib/core/TLVDebug.h>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/DLLUtil.h>
 #include <lib/support/logging/CHIPLogging.h>
@@ -53,7 +55,148 @@ extern bool emberAfEndpointIndexIsEnabled(uint16_t index);
 namespace chip {
 namespace app {
 
-AttributePathExpandIterator::AttributePathExpandIterator(SingleLinkedListNode<AttributePathParams> * aAttributePath)
+/**
+ * Expansions of wildcard attribute paths into the concrete paths they match, shared by all the AttributePathExpandIterator-s.
+ *
+ * Entries are only released by Invalidate(), so an iterator can keep using the entry it found while it iterates. An iterator
+ * notices that its entry was invalidated, or reused, from the generation of the entry.
+ */
+class AttributePathExpansionCache
+{
+public:
+    static constexpr size_t kSize = CHIP_CONFIG_ATTRIBUTE_PATH_EXPANSION_CACHE_SIZE;
+    static_assert(kSize < AttributePathExpandIterator::kNoCachedExpansion, "Cache entries are indexed with an uint8_t");
+
+    /**
+     * Returns the entry holding the expansion of the given wildcard path, expanding the path if it is not cached yet, or
+     * kNoCachedExpansion if the path cannot be cached.
+     */
+    uint8_t Find(const AttributePathParams & aAttributePath, uint32_t & aGeneration);
+
+    bool IsCurrent(uint8_t aEntry, uint32_t aGeneration) const
+    {
+        return aEntry < kSize && aGeneration != 0 && mEntries[aEntry].mGeneration == aGeneration;
+    }
+
+    // Returns the path at the given index of the expansion of a current entry, or nullptr past the end of the expansion.
+    const ConcreteAttributePath * GetPath(uint8_t aEntry, uint16_t aIndex) const
+    {
+        const Entry & entry = mEntries[aEntry];
+        return aIndex < entry.mPathCount ? &entry.mpPaths[aIndex] : nullptr;
+    }
+
+    void Invalidate();
+
+private:
+    struct Entry
+    {
+        AttributePathParams mAttributePath;
+        // Only released by Invalidate(), not when the cache is destroyed at exit, which can happen after the platform memory
+        // was shut down.
+        ConcreteAttributePath * mpPaths = nullptr;
+        uint16_t mPathCount             = 0;
+        // 0 when the entry is free.
+        uint32_t mGeneration = 0;
+    };
+
+    static bool Matches(const AttributePathParams & aCached, const AttributePathParams & aAttributePath)
+    {
+        return aCached.mEndpointId == aAttributePath.mEndpointId && aCached.mClusterId == aAttributePath.mClusterId &&
+            aCached.mAttributeId == aAttributePath.mAttributeId;
+    }
+
+    CHIP_ERROR Expand(const AttributePathParams & aAttributePath, Entry & aEntry);
+
+    Entry mEntries[kSize > 0 ? kSize : 1];
+    uint32_t mLastGeneration = 0;
+};
+
+namespace {
+Global<AttributePathExpansionCache> sExpansionCache;
+} // namespace
+
+uint8_t AttributePathExpansionCache::Find(const AttributePathParams & aAttributePath, uint32_t & aGeneration)
+{
+    Entry * freeEntry = nullptr;
+    for (uint8_t i = 0; i < kSize; i++)
+    {
+        Entry & entry = mEntries[i];
+        if (entry.mGeneration == 0)
+        {
+            freeEntry = (freeEntry == nullptr) ? &entry : freeEntry;
+            continue;
+        }
+        if (Matches(entry.mAttributePath, aAttributePath))
+        {
+            aGeneration = entry.mGeneration;
+            return i;
+        }
+    }
+
+    // Once the cache is full, the other wildcard paths are expanded from the attribute metadata.
+    VerifyOrReturnValue(freeEntry != nullptr, AttributePathExpandIterator::kNoCachedExpansion);
+    VerifyOrReturnValue(Expand(aAttributePath, *freeEntry) == CHIP_NO_ERROR, AttributePathExpandIterator::kNoCachedExpansion);
+
+    mLastGeneration        = (mLastGeneration == UINT32_MAX) ? 1 : mLastGeneration + 1;
+    freeEntry->mGeneration = mLastGeneration;
+    aGeneration            = freeEntry->mGeneration;
+    return static_cast<uint8_t>(freeEntry - mEntries);
+}
+
+CHIP_ERROR AttributePathExpansionCache::Expand(const AttributePathParams & aAttributePath, Entry & aEntry)
+{
+    SingleLinkedListNode<AttributePathParams> attributePath;
+    attributePath.mValue = aAttributePath;
+    attributePath.mpNext = nullptr;
+
+    size_t pathCount = 0;
+    for (AttributePathExpandIterator iterator(&attributePath, false /* aUseExpansionCache */); iterator.Valid(); iterator.Next())
+    {
+        pathCount++;
+    }
+    VerifyOrReturnError(pathCount <= UINT16_MAX, CHIP_ERROR_NO_MEMORY);
+
+    if (pathCount > 0)
+    {
+        aEntry.mpPaths = static_cast<ConcreteAttributePath *>(Platform::MemoryCalloc(pathCount, sizeof(ConcreteAttributePath)));
+        VerifyOrReturnError(aEntry.mpPaths != nullptr, CHIP_ERROR_NO_MEMORY);
+    }
+
+    uint16_t pathIndex = 0;
+    for (AttributePathExpandIterator iterator(&attributePath, false /* aUseExpansionCache */);
+         pathIndex < pathCount && iterator.Get(aEntry.mpPaths[pathIndex]); iterator.Next())
+    {
+        pathIndex++;
+    }
+
+    aEntry.mAttributePath = aAttributePath;
+    aEntry.mPathCount     = pathIndex;
+    return CHIP_NO_ERROR;
+}
+
+void AttributePathExpansionCache::Invalidate()
+{
+    for (auto & entry : mEntries)
+    {
+        Platform::MemoryFree(entry.mpPaths);
+        entry.mpPaths     = nullptr;
+        entry.mPathCount  = 0;
+        entry.mGeneration = 0;
+    }
+}
+
+void AttributePathExpandIterator::InvalidateExpansionCache()
+{
+    sExpansionCache->Invalidate();
+}
+
+AttributePathExpandIterator::AttributePathExpandIterator(SingleLinkedListNode<AttributePathParams> * aAttributePath) :
+    AttributePathExpandIterator(aAttributePath, true /* aUseExpansionCache */)
+{}
+
+AttributePathExpandIterator::AttributePathExpandIterator(SingleLinkedListNode<AttributePathParams> * aAttributePath,
+                                                         bool aUseExpansionCache) :
+    mUseExpansionCache(aUseExpansionCache && AttributePathExpansionCache::kSize > 0)
 {
     mpAttributePath = aAttributePath;
 
@@ -150,6 +293,94 @@ void AttributePathExpandIterator::PrepareAttributeIndexRange(const AttributePath
     }
 }
 
+void AttributePathExpandIterator::PositionAfter(const ConcreteAttributePath & aPath)
+{
+    const AttributePathParams & attributePath = mpAttributePath->mValue;
+
+    PrepareEndpointIndexRange(attributePath);
+    mClusterIndex         = UINT8_MAX;
+    mAttributeIndex       = UINT16_MAX;
+    mGlobalAttributeIndex = UINT8_MAX;
+
+    if (mEndpointIndex > mEndEndpointIndex)
+    {
+        // The concrete endpoint of the path is now disabled, there is nothing left to emit.
+        mEndpointIndex = mEndEndpointIndex = 0;
+        return;
+    }
+
+    // Disabled endpoints keep their index, but emberAfIndexFromEndpoint() ignores them, so look the endpoint up by index.
+    uint16_t endpointIndex = mEndpointIndex;
+    while (endpointIndex < mEndEndpointIndex && emberAfEndpointFromIndex(endpointIndex) != aPath.mEndpointId)
+    {
+        endpointIndex++;
+    }
+    if (endpointIndex >= mEndEndpointIndex)
+    {
+        // The endpoint is gone, carry on with the endpoints of higher ids, which usually follow it.
+        while (mEndpointIndex < mEndEndpointIndex && emberAfEndpointFromIndex(mEndpointIndex) < aPath.mEndpointId)
+        {
+            mEndpointIndex++;
+        }
+        return;
+    }
+    mEndpointIndex = endpointIndex;
+    // Next() skips the endpoint if it is disabled.
+    VerifyOrReturn(emberAfEndpointIndexIsEnabled(mEndpointIndex));
+
+    PrepareClusterIndexRange(attributePath, aPath.mEndpointId);
+    uint8_t clusterIndex = emberAfClusterIndex(aPath.mEndpointId, aPath.mClusterId, CLUSTER_MASK_SERVER);
+    if (clusterIndex < mClusterIndex || clusterIndex >= mEndClusterIndex)
+    {
+        // The cluster is gone, carry on with the next endpoint.
+        mClusterIndex = mEndClusterIndex;
+        return;
+    }
+    mClusterIndex = clusterIndex;
+
+    PrepareAttributeIndexRange(attributePath, aPath.mEndpointId, aPath.mClusterId);
+    uint16_t attributeIndex = emberAfGetServerAttributeIndexByAttributeId(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+    if (attributeIndex >= mAttributeIndex && attributeIndex < mEndAttributeIndex)
+    {
+        mAttributeIndex = static_cast<uint16_t>(attributeIndex + 1);
+        return;
+    }
+
+    // The global attributes not in the metadata follow the ones in the metadata. If the attribute is gone, the cluster is done.
+    mAttributeIndex = mEndAttributeIndex;
+    for (; mGlobalAttributeIndex < mGlobalAttributeEndIndex; mGlobalAttributeIndex++)
+    {
+        if (GlobalAttributesNotInMetadata[mGlobalAttributeIndex] == aPath.mAttributeId)
+        {
+            mGlobalAttributeIndex++;
+            return;
+        }
+    }
+}
+
+void AttributePathExpandIterator::ResumeAfterInvalidation()
+{
+    mCachedExpansion = sExpansionCache->Find(mpAttributePath->mValue, mCachedExpansionGeneration);
+    // Nothing was emitted for this path yet, start from the beginning of whichever expansion we use.
+    VerifyOrReturn(mCachedPathIndex > 0);
+
+    if (mCachedExpansion != kNoCachedExpansion)
+    {
+        const ConcreteAttributePath * path;
+        for (uint16_t pathIndex = 0; (path = sExpansionCache->GetPath(mCachedExpansion, pathIndex)) != nullptr; pathIndex++)
+        {
+            if (*path == mOutputPath)
+            {
+                mCachedPathIndex = static_cast<uint16_t>(pathIndex + 1);
+                return;
+            }
+        }
+        // The last emitted path is no longer part of the expansion, only the metadata tells what followed it.
+        mCachedExpansion = kNoCachedExpansion;
+    }
+    PositionAfter(mOutputPath);
+}
+
 void AttributePathExpandIterator::ResetCurrentCluster()
 {
     // If this is a null iterator, or the attribute id of current cluster info is not a wildcard attribute id, then this function
@@ -166,14 +397,54 @@ void AttributePathExpandIterator::ResetCurrentCluster()
     // - We have exhausted all paths
     // Only the second case will happen here since the above check will fail for 1 and 3, so the following Next() call must result
     // in a valid path, which is the first attribute id we will emit for the current cluster.
+    if (mCachedExpansion != kNoCachedExpansion && !sExpansionCache->IsCurrent(mCachedExpansion, mCachedExpansionGeneration))
+    {
+        // Find the path we just emitted again first, so that we rewind to the start of its cluster.
+        ResumeAfterInvalidation();
+    }
+    if (mCachedExpansion != kNoCachedExpansion)
+    {
+        // The expansion is ordered like the metadata, so the attributes of the cluster precede the one we just emitted.
+        while (mCachedPathIndex > 0)
+        {
+            const ConcreteAttributePath * path =
+                sExpansionCache->GetPath(mCachedExpansion, static_cast<uint16_t>(mCachedPathIndex - 1));
+            if (path->mEndpointId != mOutputPath.mEndpointId || path->mClusterId != mOutputPath.mClusterId)
+            {
+                break;
+            }
+            mCachedPathIndex--;
+        }
+    }
     mAttributeIndex       = UINT16_MAX;
     mGlobalAttributeIndex = UINT8_MAX;
     Next();
 }
 
+bool AttributePathExpandIterator::NextCachedPath()
+{
+    if (!sExpansionCache->IsCurrent(mCachedExpansion, mCachedExpansionGeneration))
+    {
+        // The cache was invalidated while we were expanding the path. The paths before the one we last emitted may have changed
+        // too, so carry on after that path rather than from the same index.
+        ResumeAfterInvalidation();
+        VerifyOrReturnValue(mCachedExpansion != kNoCachedExpansion, false);
+    }
+
+    const ConcreteAttributePath * path = sExpansionCache->GetPath(mCachedExpansion, mCachedPathIndex);
+    VerifyOrReturnValue(path != nullptr, false);
+
+    mOutputPath.mEndpointId  = path->mEndpointId;
+    mOutputPath.mClusterId   = path->mClusterId;
+    mOutputPath.mAttributeId = path->mAttributeId;
+    mCachedPathIndex++;
+    return true;
+}
+
 bool AttributePathExpandIterator::Next()
 {
-    for (; mpAttributePath != nullptr; (mpAttributePath = mpAttributePath->mpNext, mEndpointIndex = UINT16_MAX))
+    for (; mpAttributePath != nullptr;
+         (mpAttributePath = mpAttributePath->mpNext, mEndpointIndex = UINT16_MAX, mCachedExpansion = kNoCachedExpansion))
     {
         mOutputPath.mExpanded = mpAttributePath->mValue.IsWildcardPath();
 
@@ -191,10 +462,31 @@ bool AttributePathExpandIterator::Next()
                 return true;
             }
 
+            if (mUseExpansionCache)
+            {
+                mCachedExpansion = sExpansionCache->Find(mpAttributePath->mValue, mCachedExpansionGeneration);
+                mCachedPathIndex = 0;
+            }
+
             PrepareEndpointIndexRange(mpAttributePath->mValue);
             mClusterIndex = UINT8_MAX;
         }
 
+        if (mCachedExpansion != kNoCachedExpansion)
+        {
+            if (NextCachedPath())
+            {
+                return true;
+            }
+            if (mCachedExpansion != kNoCachedExpansion)
+            {
+                // We have exhausted the expansion, continue with the next cluster info item.
+                continue;
+            }
+            // The path could not be expanded again after the cache was invalidated, carry on with the metadata instead, from
+            // where ResumeAfterInvalidation() positioned it.
+        }
+
         for (; mEndpointIndex < mEndEndpointIndex;
              (mEndpointIndex++, mClusterIndex = UINT8_MAX, mAttributeIndex = UINT16_MAX, mGlobalAttributeIndex = UINT8_MAX))
         {
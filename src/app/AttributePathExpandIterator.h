@@ -104,7 +104,34 @@ public:
      */
     inline bool Valid() const { return mpAttributePath != nullptr; }
 
+    /**
+     * Drops the cached expansions of wildcard paths. Must be called whenever the set of endpoints, clusters, or attributes that
+     * are supported changes.
+     *
+     * Wildcard paths are expanded once, into a flat list of the concrete paths they match, and the expansion is shared by all
+     * the iterators that expand the same wildcard path, e.g. the reports of all the wildcard subscriptions. At most
+     * CHIP_CONFIG_ATTRIBUTE_PATH_EXPANSION_CACHE_SIZE distinct wildcard paths are cached, the others are expanded from the
+     * attribute metadata as they are iterated.
+     */
+    static void InvalidateExpansionCache();
+
 private:
+    friend class AttributePathExpansionCache;
+
+    static constexpr uint8_t kNoCachedExpansion = UINT8_MAX;
+
+    AttributePathExpandIterator(SingleLinkedListNode<AttributePathParams> * aAttributePath, bool aUseExpansionCache);
+
+    bool NextCachedPath();
+
+    // After the cache was invalidated, finds the last path emitted for the current wildcard path in its new expansion, or
+    // positions the metadata walk after it if the path cannot be expanded again or that path is no longer part of the expansion.
+    void ResumeAfterInvalidation();
+
+    // Positions the metadata walk of the current wildcard path right after aPath, a path it emitted before the set of
+    // endpoints, clusters, or attributes changed.
+    void PositionAfter(const ConcreteAttributePath & aPath);
+
     SingleLinkedListNode<AttributePathParams> * mpAttributePath;
 
     ConcreteAttributePath mOutputPath;
@@ -118,6 +145,14 @@ private:
     // metadata.
     uint8_t mGlobalAttributeIndex, mGlobalAttributeEndIndex;
 
+    // When the current wildcard path is expanded from the cache, the cache entry, the generation of the entry the iteration
+    // started with, and the index of the next path of the expansion.
+    uint8_t mCachedExpansion = kNoCachedExpansion;
+    uint32_t mCachedExpansionGeneration;
+    uint16_t mCachedPathIndex;
+
+    bool mUseExpansionCache;
+
     /**
      * Prepare*IndexRange will update mBegin*Index and mEnd*Index variables.
      * If AttributePathParams contains a wildcard field, it will set mBegin*Index to 0 and mEnd*Index to count.
@@ -20,12 +20,13 @@
 #include "lib/core/TLVTags.h"
 #include "lib/core/TLVTypes.h"
 #include "protocols/interaction_model/Constants.h"
-#include "system/SystemPacketBuffer.h"
-#include "system/TLVPacketBufferBackingStore.h"
 #include <app/BufferedReadCallback.h>
 #include <app/InteractionModelEngine.h>
 #include <lib/support/ScopedBuffer.h>
 
+#include <algorithm>
+#include <string.h>
+
 namespace chip {
 namespace app {
 
@@ -37,6 +38,7 @@ void BufferedReadCallback::OnReportBegin()
 void BufferedReadCallback::OnReportEnd()
 {
     CHIP_ERROR err = DispatchBufferedData(mBufferedPath, StatusIB(), true);
+    ReleaseBufferedList();
     if (err != CHIP_NO_ERROR)
     {
         mCallback.OnError(err);
@@ -46,91 +48,85 @@ void BufferedReadCallback::OnReportEnd()
     mCallback.OnReportEnd();
 }
 
-CHIP_ERROR BufferedReadCallback::GenerateListTLV(TLV::ScopedBufferTLVReader & aReader)
-{
-    TLV::TLVType outerType;
-    Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
+namespace {
 
-    //
-    // To generate the final reconstituted list, we need to allocate a contiguous
-    // buffer than can hold the entirety of its contents. To do so, we need to figure out
-    // how big a buffer to allocate. This requires walking the buffered list items and computing their TLV sizes,
-    // summing them all up and adding a bit of slop to account for the TLV array the list elements will go into.
-    //
-    // The alternative was to use a PacketBufferTLVWriter backed by chained packet buffers to
-    // write out the list - this would have removed the need for this first pass. However,
-    // we cannot actually back a TLVReader with a chained buffer since that violates the ability
-    // for us to create readers off-of readers. Each reader would assume exclusive ownership of the chained
-    // buffer and mutate the state within TLVPacketBufferBackingStore, preventing shared use.
-    //
-    // To avoid that, a single contiguous buffer is the best likely approach for now.
-    //
-    size_t totalBufSize = 0;
-    for (const auto & packetBuffer : mBufferedList)
-    {
-        totalBufSize += packetBuffer->TotalLength();
-    }
+// Control octets of the anonymous array the buffered list items are delivered in.
+constexpr uint8_t kListStart =
+    static_cast<uint8_t>(TLV::TLVTagControl::Anonymous) | static_cast<uint8_t>(TLV::TLVElementType::Array);
+constexpr uint8_t kListEnd = static_cast<uint8_t>(TLV::TLVElementType::EndOfContainer);
+
+} // namespace
 
+CHIP_ERROR BufferedReadCallback::ReserveBufferedListSpace(size_t aSize)
+{
     //
-    // Size of the start container and end container are just 1 byte each, but, let's just be safe.
+    // The list items are encoded back to back into a single buffer, after the head of the array they will be
+    // delivered in, and with room kept for the end of that array. The final list is then read in place instead of
+    // being re-encoded, and growing the buffer geometrically keeps the number of allocations per list logarithmic
+    // in its size rather than linear in its number of items.
     //
-    totalBufSize += 4;
+    const size_t used     = (mBufferedListLength == 0) ? sizeof(kListStart) : mBufferedListLength;
+    const size_t required = used + aSize + sizeof(kListEnd);
+    VerifyOrReturnError(required > used, CHIP_ERROR_BUFFER_TOO_SMALL);
 
-    backingBuffer.Calloc(totalBufSize);
-    VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+    if (required > mBufferedListCapacity)
+    {
+        const size_t capacity = std::max(required, 2 * mBufferedListCapacity);
+        Platform::ScopedMemoryBuffer<uint8_t> buffer;
 
-    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), totalBufSize);
-    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, outerType));
+        buffer.Alloc(capacity);
+        VerifyOrReturnError(buffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
 
-    for (auto & bufHandle : mBufferedList)
-    {
-        System::PacketBufferTLVReader reader;
+        if (mBufferedListLength > 0)
+        {
+            memcpy(buffer.Get(), mBufferedList.Get(), mBufferedListLength);
+        }
 
-        reader.Init(std::move(bufHandle));
+        mBufferedList         = std::move(buffer);
+        mBufferedListCapacity = capacity;
+    }
 
-        ReturnErrorOnFailure(reader.Next());
-        ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
+    if (mBufferedListLength == 0)
+    {
+        mBufferedList[0]    = kListStart;
+        mBufferedListLength = sizeof(kListStart);
     }
 
-    ReturnErrorOnFailure(writer.EndContainer(outerType));
+    return CHIP_NO_ERROR;
+}
 
-    writer.Finalize(backingBuffer);
+void BufferedReadCallback::ReleaseBufferedList()
+{
+    mBufferedList.Free();
+    mBufferedListCapacity = 0;
+    mBufferedListLength   = 0;
+}
 
-    aReader.Init(std::move(backingBuffer), totalBufSize);
+CHIP_ERROR BufferedReadCallback::GenerateListTLV(TLV::TLVReader & aReader)
+{
+    ReturnErrorOnFailure(ReserveBufferedListSpace(0));
+
+    mBufferedList[mBufferedListLength++] = kListEnd;
+    aReader.Init(mBufferedList.Get(), mBufferedListLength);
 
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR BufferedReadCallback::BufferListItem(TLV::TLVReader & reader)
 {
-    System::PacketBufferTLVWriter writer;
-    System::PacketBufferHandle handle;
+    TLV::TLVWriter writer;
 
     //
-    // We conservatively allocate a packet buffer as big as an IPv6 MTU (since we're buffering
-    // data received over the wire, which should always fit within that).
-    //
-    // We could have snapshotted the reader at its current position, advanced it past the current element
-    // and computed the delta in its read point to figure out the size of the element before allocating
-    // our target buffer. However, the reader's current position is already set past the control octet
-    // and the tag. Consequently, the computed size is always going to omit the sizes of these two parts of the
-    // TLV element. Since the tag can vary in size, for now, let's just do the safe thing. In the future, if this is a problem,
-    // we can improve this.
+    // We conservatively reserve as much room as an IPv6 MTU (since we're buffering data received over the wire,
+    // which should always fit within that), as the size of the element, tag and control octet included, is only
+    // known once copied. Once the buffer has grown, this does not allocate anymore.
     //
-    handle = System::PacketBufferHandle::New(chip::app::kMaxSecureSduLengthBytes);
-    VerifyOrReturnError(!handle.IsNull(), CHIP_ERROR_NO_MEMORY);
-
-    writer.Init(std::move(handle), false);
+    ReturnErrorOnFailure(ReserveBufferedListSpace(chip::app::kMaxSecureSduLengthBytes));
 
+    writer.Init(mBufferedList.Get() + mBufferedListLength, mBufferedListCapacity - mBufferedListLength - sizeof(kListEnd));
     ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
-    ReturnErrorOnFailure(writer.Finalize(&handle));
-
-    // Compact the buffer down to a more reasonably sized packet buffer
-    // if we can.
-    //
-    handle.RightSize();
 
-    mBufferedList.push_back(std::move(handle));
+    mBufferedListLength += writer.GetLengthWritten();
 
     return CHIP_NO_ERROR;
 }
@@ -143,7 +139,7 @@ CHIP_ERROR BufferedReadCallback::BufferData(const ConcreteDataAttributePath & aP
         TLV::TLVType outerContainer;
 
         VerifyOrReturnError(apData->GetType() == TLV::kTLVType_Array, CHIP_ERROR_INVALID_TLV_ELEMENT);
-        mBufferedList.clear();
+        mBufferedListLength = 0;
 
         ReturnErrorOnFailure(apData->EnterContainer(outerContainer));
 
@@ -202,7 +198,7 @@ CHIP_ERROR BufferedReadCallback::DispatchBufferedData(const ConcreteAttributePat
     }
 
     StatusIB statusIB;
-    TLV::ScopedBufferTLVReader reader;
+    TLV::TLVReader reader;
 
     ReturnErrorOnFailure(GenerateListTLV(reader));
 
@@ -220,10 +216,10 @@ CHIP_ERROR BufferedReadCallback::DispatchBufferedData(const ConcreteAttributePat
     mCallback.OnAttributeData(mBufferedPath, &reader, statusIB);
 
     //
-    // Clear out our buffered contents to free up allocated buffers, and reset the buffered path.
+    // Clear out our buffered contents, keeping the buffer for the next list of this report, and reset the buffered path.
     //
-    mBufferedList.clear();
-    mBufferedPath = ConcreteDataAttributePath();
+    mBufferedListLength = 0;
+    mBufferedPath       = ConcreteDataAttributePath();
     return CHIP_NO_ERROR;
 }
 
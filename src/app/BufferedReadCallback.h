@@ -19,12 +19,10 @@
 #pragma once
 
 #include "lib/core/TLV.h"
-#include "system/SystemPacketBuffer.h"
-#include "system/TLVPacketBufferBackingStore.h"
 #include <app/AppConfig.h>
 #include <app/AttributePathParams.h>
 #include <app/ReadClient.h>
-#include <vector>
+#include <lib/support/ScopedBuffer.h>
 
 #if CHIP_CONFIG_ENABLE_READ_CLIENT
 namespace chip {
@@ -44,9 +42,10 @@ public:
 
 private:
     /*
-     * Generates the reconsistuted TLV array from the stored individual list elements
+     * Terminates the TLV array of the buffered list elements and initializes reader to read it in place.
+     * The reader is only valid until the buffered list changes.
      */
-    CHIP_ERROR GenerateListTLV(TLV::ScopedBufferTLVReader & reader);
+    CHIP_ERROR GenerateListTLV(TLV::TLVReader & reader);
 
     /*
      * Dispatch any buffered list data if we need to. Buffered data will only be dispatched if:
@@ -73,7 +72,7 @@ private:
     void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override;
     void OnError(CHIP_ERROR aError) override
     {
-        mBufferedList.clear();
+        ReleaseBufferedList();
         return mCallback.OnError(aError);
     }
 
@@ -121,15 +120,26 @@ private:
     }
 
     /*
-     * Given a reader positioned at a list element, allocate a packet buffer, copy the list item where
-     * the reader is positioned into that buffer and add it to our buffered list for tracking.
+     * Given a reader positioned at a list element, copy the list item where the reader is positioned
+     * at the end of our buffered list.
      *
      * This should be called in list index order starting from the lowest index that needs to be buffered.
      *
      */
     CHIP_ERROR BufferListItem(TLV::TLVReader & reader);
+
+    /*
+     * Makes sure the buffered list has room for aSize more bytes, in addition to the head and the end of
+     * the array it is delivered in, growing it if needed.
+     */
+    CHIP_ERROR ReserveBufferedListSpace(size_t aSize);
+    void ReleaseBufferedList();
+
     ConcreteDataAttributePath mBufferedPath;
-    std::vector<System::PacketBufferHandle> mBufferedList;
+    // The buffered list items, encoded back to back after the head of their array.
+    Platform::ScopedMemoryBuffer<uint8_t> mBufferedList;
+    size_t mBufferedListCapacity = 0;
+    size_t mBufferedListLength   = 0;
     Callback & mCallback;
 };
 
@@ -117,13 +117,13 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteD
         mCache[aPath.mEndpointId][aPath.mClusterId].mCommittedDataVersion.ClearValue();
 
         // This commits a pending data version if the last report path is valid and it is different from the current path.
-        if (mLastReportDataPath.IsValidConcreteClusterPath() && mLastReportDataPath != aPath)
+        if (mpReportState->mLastReportDataPath.IsValidConcreteClusterPath() && mpReportState->mLastReportDataPath != aPath)
         {
             CommitPendingDataVersion();
         }
 
         bool foundEncompassingWildcardPath = false;
-        for (const auto & path : mRequestPathSet)
+        for (const auto & path : mpReportState->mRequestPathSet)
         {
             if (path.IncludesAllAttributesInCluster(aPath))
             {
@@ -138,7 +138,7 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteD
             mCache[aPath.mEndpointId][aPath.mClusterId].mPendingDataVersion = aPath.mDataVersion;
         }
 
-        mLastReportDataPath = aPath;
+        mpReportState->mLastReportDataPath = aPath;
     }
     else
     {
@@ -165,14 +165,14 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteD
     //
     if (endpointIsNew)
     {
-        mAddedEndpoints.push_back(aPath.mEndpointId);
+        mpReportState->mAddedEndpoints.push_back(aPath.mEndpointId);
     }
 
     mCache[aPath.mEndpointId][aPath.mClusterId].mAttributes[aPath.mAttributeId] = std::move(state);
 
     if (mCacheData)
     {
-        mChangedAttributeSet.insert(aPath);
+        mpReportState->mChangedAttributeSet.insert(aPath);
     }
 
     return CHIP_NO_ERROR;
@@ -230,21 +230,22 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateEventCache(const Even
 template <bool CanEnableDataCaching>
 void ClusterStateCacheT<CanEnableDataCaching>::OnReportBegin()
 {
-    mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
-    mChangedAttributeSet.clear();
-    mAddedEndpoints.clear();
+    mpReportState->mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
+    mpReportState->mChangedAttributeSet.clear();
+    mpReportState->mAddedEndpoints.clear();
     mCallback.OnReportBegin();
 }
 
 template <bool CanEnableDataCaching>
 void ClusterStateCacheT<CanEnableDataCaching>::CommitPendingDataVersion()
 {
-    if (!mLastReportDataPath.IsValidConcreteClusterPath())
+    if (!mpReportState->mLastReportDataPath.IsValidConcreteClusterPath())
     {
         return;
     }
 
-    auto & lastClusterInfo = mCache[mLastReportDataPath.mEndpointId][mLastReportDataPath.mClusterId];
+    const auto & lastPath  = mpReportState->mLastReportDataPath;
+    auto & lastClusterInfo = mCache[lastPath.mEndpointId][lastPath.mClusterId];
     if (lastClusterInfo.mPendingDataVersion.HasValue())
     {
         lastClusterInfo.mCommittedDataVersion = lastClusterInfo.mPendingDataVersion;
@@ -256,14 +257,14 @@ template <bool CanEnableDataCaching>
 void ClusterStateCacheT<CanEnableDataCaching>::OnReportEnd()
 {
     CommitPendingDataVersion();
-    mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
+    mpReportState->mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
     std::set<std::tuple<EndpointId, ClusterId>> changedClusters;
 
     //
     // Add the EndpointId and ClusterId into a set so that we only
     // convey unique combinations in the subsequent OnClusterChanged callback.
     //
-    for (auto & path : mChangedAttributeSet)
+    for (auto & path : mpReportState->mChangedAttributeSet)
     {
         mCallback.OnAttributeChanged(this, path);
         changedClusters.insert(std::make_tuple(path.mEndpointId, path.mClusterId));
@@ -274,7 +275,7 @@ void ClusterStateCacheT<CanEnableDataCaching>::OnReportEnd()
         mCallback.OnClusterChanged(this, std::get<0>(item), std::get<1>(item));
     }
 
-    for (auto endpoint : mAddedEndpoints)
+    for (auto endpoint : mpReportState->mAddedEndpoints)
     {
         mCallback.OnEndpointAdded(this, endpoint);
     }
@@ -598,7 +599,7 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::OnUpdateDataVersionFilterLi
 
             if (!intersected)
             {
-                mRequestPathSet.insert(attribute1);
+                mpReportState->mRequestPathSet.insert(attribute1);
             }
         }
     }
@@ -648,12 +649,103 @@ exit:
     return err;
 }
 
+template <bool CanEnableDataCaching>
+CHIP_ERROR
+ClusterStateCacheT<CanEnableDataCaching>::SplitAttributePaths(const Span<AttributePathParams> & aPaths,
+                                                              const SplitParameters & aParams,
+                                                              std::vector<std::vector<AttributePathParams>> & aGroups) const
+{
+    static_assert(SplitParameters().mMaxPathsPerGroup == InteractionModelEngine::kMinSupportedPathsPerSubscription,
+                  "Groups must fit into the subscriptions of any node by default");
+    static_assert(SplitParameters().mMaxGroups == InteractionModelEngine::kMinSupportedSubscriptionsPerFabric,
+                  "Groups must fit into the subscriptions of any node by default");
+    static_assert(SplitParameters().mMaxFiltersPerGroup > 0, "The default groups must have room for filters");
+
+    VerifyOrReturnError(aParams.mMaxFiltersPerGroup > 0 && aParams.mMaxPathsPerGroup > 0 && aParams.mMaxGroups > 0,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+    aGroups.clear();
+
+    bool withinLimits       = true;
+    size_t groupFilterCount = 0;
+    for (auto const & endpointIter : mCache)
+    {
+        const EndpointId endpointId = endpointIter.first;
+
+        std::vector<AttributePathParams> endpointPaths;
+        for (const auto & path : aPaths)
+        {
+            if (path.HasWildcardEndpointId() || path.mEndpointId == endpointId)
+            {
+                AttributePathParams endpointPath = path;
+                endpointPath.mEndpointId         = endpointId;
+                endpointPaths.push_back(endpointPath);
+            }
+        }
+        if (endpointPaths.empty())
+        {
+            continue;
+        }
+
+        // Same filters as OnUpdateDataVersionFilterList would send for the paths of the endpoint.
+        size_t endpointFilterCount = 0;
+        for (auto const & clusterIter : endpointIter.second)
+        {
+            if (!clusterIter.second.mCommittedDataVersion.HasValue())
+            {
+                continue;
+            }
+            DataVersionFilter filter(endpointId, clusterIter.first, clusterIter.second.mCommittedDataVersion.Value());
+            for (const auto & path : endpointPaths)
+            {
+                if (path.IncludesAttributesInCluster(filter))
+                {
+                    endpointFilterCount++;
+                    break;
+                }
+            }
+        }
+
+        if (aGroups.empty() || groupFilterCount + endpointFilterCount > aParams.mMaxFiltersPerGroup ||
+            aGroups.back().size() + endpointPaths.size() > aParams.mMaxPathsPerGroup)
+        {
+            aGroups.emplace_back();
+            groupFilterCount = 0;
+        }
+        aGroups.back().insert(aGroups.back().end(), endpointPaths.begin(), endpointPaths.end());
+        groupFilterCount += endpointFilterCount;
+        withinLimits = withinLimits && aGroups.back().size() <= aParams.mMaxPathsPerGroup;
+    }
+
+    if (!aGroups.empty())
+    {
+        // Paths to endpoints the cache has no data for go with the last group, or a group of their own if it is full.
+        for (const auto & path : aPaths)
+        {
+            if (!path.HasWildcardEndpointId() && mCache.find(path.mEndpointId) == mCache.end())
+            {
+                if (aGroups.back().size() >= aParams.mMaxPathsPerGroup)
+                {
+                    aGroups.emplace_back();
+                }
+                aGroups.back().push_back(path);
+            }
+        }
+    }
+
+    if (aGroups.empty() || !withinLimits || aGroups.size() > aParams.mMaxGroups)
+    {
+        aGroups.clear();
+        aGroups.emplace_back(aPaths.begin(), aPaths.end());
+    }
+    return CHIP_NO_ERROR;
+}
+
 template <bool CanEnableDataCaching>
 CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetLastReportDataPath(ConcreteClusterPath & aPath)
 {
-    if (mLastReportDataPath.IsValidConcreteClusterPath())
+    if (mpReportState->mLastReportDataPath.IsValidConcreteClusterPath())
     {
-        aPath = mLastReportDataPath;
+        aPath = mpReportState->mLastReportDataPath;
         return CHIP_NO_ERROR;
     }
     return CHIP_ERROR_INCORRECT_STATE;
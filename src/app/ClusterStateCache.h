@@ -28,6 +28,7 @@
 #include <app/data-model/DecodableList.h>
 #include <app/data-model/Decode.h>
 #include <lib/support/Variant.h>
+#include <transport/raw/MessageHeader.h>
 #include <list>
 #include <map>
 #include <queue>
@@ -63,7 +64,7 @@ namespace app {
  *
  * **NOTE**
  * 1. This already includes the BufferedReadCallback, so there is no need to add that to the ReadClient callback chain.
- * 2. The same cache cannot be used by multiple subscribe/read interactions at the same time.
+ * 2. The same cache cannot be used by multiple subscribe/read interactions at the same time, except through Partitions.
  *
  */
 template <bool CanEnableDataCaching>
@@ -137,6 +138,58 @@ public:
      */
     ReadClient::Callback & GetBufferedCallback() { return mBufferedReader; }
 
+    class Partition;
+
+    /*
+     * Limits of the groups of SplitAttributePaths().
+     *
+     * The defaults are the minimums that every node supports (InteractionModelEngine::kMinSupportedPathsPerSubscription
+     * and kMinSupportedSubscriptionsPerFabric). Larger limits are only safe for nodes known to support them, and
+     * mMaxGroups has to leave room for the other subscriptions the controller keeps on the fabric of the node.
+     *
+     * The default mMaxFiltersPerGroup is the number of filters of the largest encoding that fit into a SubscribeRequest
+     * with mMaxPathsPerGroup paths. Each additional path takes up to kMaxAttributePathSize bytes of that room.
+     */
+    struct SplitParameters
+    {
+        // DataVersionFilterIB: structure (1), ClusterPathIB with an uint16_t endpoint and an uint32_t cluster (2 + 4 + 6 + 1),
+        // uint32_t DataVersion (6), end of structure (1).
+        static constexpr size_t kMaxDataVersionFilterSize = 21;
+        // AttributePathIB with all of its fields: list (1), node (10), endpoint (4), cluster (6), attribute (6), list index
+        // (4), end of list (1).
+        static constexpr size_t kMaxAttributePathSize = 32;
+        // The other fields of a SubscribeRequest: structure, KeepSubscriptions, the interval bounds, IsFabricFiltered,
+        // InteractionModelRevision and the attribute path and data version filter lists, besides their elements.
+        static constexpr size_t kMaxSubscribeRequestOverhead = 32;
+        static constexpr size_t kDefaultMaxPathsPerGroup     = 3;
+
+        size_t mMaxFiltersPerGroup = (kMaxAppMessageLen - kMaxSubscribeRequestOverhead -
+                                      kDefaultMaxPathsPerGroup * kMaxAttributePathSize) /
+            kMaxDataVersionFilterSize;
+        size_t mMaxPathsPerGroup = kDefaultMaxPathsPerGroup;
+        size_t mMaxGroups        = 3;
+    };
+
+    /*
+     * Splits the attribute paths of a subscription into groups of paths for several subscriptions that share this cache
+     * through Partitions, so that the data version filters of the clusters cached for each group fit into its
+     * SubscribeRequest. A single subscription only sends the filters that fit into one message when it resumes, and the
+     * clusters whose filters were dropped are reported again in their entirety.
+     *
+     * Splitting is opt-in: a controller that wants it subscribes with the groups and Partitions instead of a single
+     * subscription with this cache.
+     *
+     * Paths with a wildcard endpoint are expanded into the endpoints that the cache has data for, and the endpoints are
+     * grouped so that each group has at most mMaxFiltersPerGroup filters, unless a single endpoint has more than that.
+     * Endpoints that are added to the node afterwards are not covered by the groups, so a controller that splits its
+     * subscription needs to watch the parts list of the node, and subscribe again when it changes.
+     *
+     * If the cache has no data for any of the paths yet, or if the groups would not fit into mMaxPathsPerGroup paths
+     * and mMaxGroups groups, there is a single group with all the paths, as if the subscription were not split.
+     */
+    CHIP_ERROR SplitAttributePaths(const Span<AttributePathParams> & aPaths, const SplitParameters & aParams,
+                                   std::vector<std::vector<AttributePathParams>> & aGroups) const;
+
     /*
      * Retrieve the value of an attribute from the cache (if present) given a concrete path by decoding
      * it using DataModel::Decode into the in-out argument 'value'.
@@ -570,6 +623,30 @@ private:
         }
     };
 
+    // The state of the reports of one of the interactions that feed the cache: the cache itself, or a Partition.
+    struct ReportState
+    {
+        std::set<ConcreteAttributePath> mChangedAttributeSet;
+        std::set<AttributePathParams, Comparator> mRequestPathSet; // wildcard attribute request path only
+        std::vector<EndpointId> mAddedEndpoints;
+        ConcreteClusterPath mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
+    };
+
+    // Makes the cache use the report state of a Partition while it forwards a callback to the cache.
+    class ScopedReportState
+    {
+    public:
+        ScopedReportState(ClusterStateCacheT & cache, ReportState & state) : mCache(cache), mPreviousState(cache.mpReportState)
+        {
+            mCache.mpReportState = &state;
+        }
+        ~ScopedReportState() { mCache.mpReportState = mPreviousState; }
+
+    private:
+        ClusterStateCacheT & mCache;
+        ReportState * mPreviousState;
+    };
+
     using EventData = std::pair<EventHeader, System::PacketBufferHandle>;
 
     //
@@ -630,7 +707,7 @@ private:
 
     void OnDone(ReadClient * apReadClient) override
     {
-        mRequestPathSet.clear();
+        mpReportState->mRequestPathSet.clear();
         return mCallback.OnDone(apReadClient);
     }
 
@@ -675,16 +752,111 @@ private:
 
     Callback & mCallback;
     NodeState mCache;
-    std::set<ConcreteAttributePath> mChangedAttributeSet;
-    std::set<AttributePathParams, Comparator> mRequestPathSet; // wildcard attribute request path only
-    std::vector<EndpointId> mAddedEndpoints;
+    ReportState mReportState;
+    ReportState * mpReportState = &mReportState;
 
     std::set<EventData, EventDataCompare> mEventDataCache;
     Optional<EventNumber> mHighestReceivedEventNumber;
     std::map<ConcreteEventPath, StatusIB> mEventStatusCache;
     BufferedReadCallback mBufferedReader;
-    ConcreteClusterPath mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
-    const bool mCacheData                   = CanEnableDataCaching;
+    const bool mCacheData = CanEnableDataCaching;
+};
+
+/*
+ * Feeds the cache from one of several subscriptions that share it, each of which covers some of the paths the cache is
+ * used for, typically one of the groups of SplitAttributePaths(). The subscriptions can be established concurrently.
+ *
+ * The reports of the subscriptions can interleave, so each one needs its own partition, and the ReadClient of the
+ * subscription is given the buffered callback of the partition instead of the one of the cache.
+ */
+template <bool CanEnableDataCaching>
+class ClusterStateCacheT<CanEnableDataCaching>::Partition : protected ReadClient::Callback
+{
+public:
+    Partition(ClusterStateCacheT & cache) : mCache(cache), mBufferedReader(*this) {}
+
+    Partition(const Partition &)             = delete;
+    Partition(Partition &&)                  = delete;
+    Partition & operator=(const Partition &) = delete;
+    Partition & operator=(Partition &&)      = delete;
+
+    ReadClient::Callback & GetBufferedCallback() { return mBufferedReader; }
+
+protected:
+    //
+    // ReadClient::Callback
+    //
+    void OnReportBegin() override
+    {
+        ScopedReportState scope(mCache, mState);
+        mCache.OnReportBegin();
+    }
+
+    void OnReportEnd() override
+    {
+        ScopedReportState scope(mCache, mState);
+        mCache.OnReportEnd();
+    }
+
+    void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override
+    {
+        ScopedReportState scope(mCache, mState);
+        mCache.OnAttributeData(aPath, apData, aStatus);
+    }
+
+    void OnEventData(const EventHeader & aEventHeader, TLV::TLVReader * apData, const StatusIB * apStatus) override
+    {
+        ScopedReportState scope(mCache, mState);
+        mCache.OnEventData(aEventHeader, apData, apStatus);
+    }
+
+    void OnError(CHIP_ERROR aError) override { mCache.OnError(aError); }
+
+    void OnDone(ReadClient * apReadClient) override
+    {
+        ScopedReportState scope(mCache, mState);
+        mCache.OnDone(apReadClient);
+    }
+
+    void OnSubscriptionEstablished(SubscriptionId aSubscriptionId) override { mCache.OnSubscriptionEstablished(aSubscriptionId); }
+
+    CHIP_ERROR OnResubscriptionNeeded(ReadClient * apReadClient, CHIP_ERROR aTerminationCause) override
+    {
+        return mCache.OnResubscriptionNeeded(apReadClient, aTerminationCause);
+    }
+
+    void OnDeallocatePaths(ReadPrepareParams && aReadPrepareParams) override
+    {
+        mCache.OnDeallocatePaths(std::move(aReadPrepareParams));
+    }
+
+    CHIP_ERROR OnUpdateDataVersionFilterList(DataVersionFilterIBs::Builder & aDataVersionFilterIBsBuilder,
+                                             const Span<AttributePathParams> & aAttributePaths,
+                                             bool & aEncodedDataVersionList) override
+    {
+        ScopedReportState scope(mCache, mState);
+        return mCache.OnUpdateDataVersionFilterList(aDataVersionFilterIBsBuilder, aAttributePaths, aEncodedDataVersionList);
+    }
+
+    CHIP_ERROR GetHighestReceivedEventNumber(Optional<EventNumber> & aEventNumber) override
+    {
+        return mCache.GetHighestReceivedEventNumber(aEventNumber);
+    }
+
+    void OnUnsolicitedMessageFromPublisher(ReadClient * apReadClient) override
+    {
+        mCache.OnUnsolicitedMessageFromPublisher(apReadClient);
+    }
+
+    void OnCASESessionEstablished(const SessionHandle & aSession, ReadPrepareParams & aSubscriptionParams) override
+    {
+        mCache.OnCASESessionEstablished(aSession, aSubscriptionParams);
+    }
+
+private:
+    ClusterStateCacheT & mCache;
+    ReportState mState;
+    BufferedReadCallback mBufferedReader;
 };
 
 using ClusterStateCache       = ClusterStateCacheT<true>;
@@ -68,6 +68,10 @@ public:
      *
      * The Invoke Response will not be sent until all outstanding Handles have
      * been destroyed or have had Release called.
+     *
+     * The commands of a batched InvokeRequest may all be processed asynchronously
+     * at the same time: their responses are sent in the order of the requests,
+     * whatever the order in which the commands complete.
      */
     class Handle : public IntrusiveListNodeBase<>
     {
@@ -26,11 +26,15 @@
 #include <lib/core/CHIPConfig.h>
 #include <lib/core/TLVData.h>
 #include <lib/core/TLVUtilities.h>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/IntrusiveList.h>
 #include <lib/support/TypeTraits.h>
 #include <messaging/ExchangeContext.h>
 #include <platform/LockTracker.h>
 #include <protocols/secure_channel/Constants.h>
+#include <tracing/metric_event.h>
+
+#include <algorithm>
 
 namespace chip {
 namespace app {
@@ -54,6 +58,7 @@ CommandHandlerImpl::CommandHandlerImpl(TestOnlyOverrides & aTestOverride, Callba
 CommandHandlerImpl::~CommandHandlerImpl()
 {
     InvalidateHandles();
+    ReleaseDeferredResponses();
 }
 
 CHIP_ERROR CommandHandlerImpl::AllocateBuffer()
@@ -138,8 +143,131 @@ CHIP_ERROR CommandHandlerImpl::AddResponseData(const ConcreteCommandPath & aRequ
 {
     // Return early when response should not be sent out.
     VerifyOrReturnValue(ResponsesAccepted(), CHIP_NO_ERROR);
-    return TryAddingResponse(
-        [&]() -> CHIP_ERROR { return TryAddResponseData(aRequestCommandPath, aResponseCommandId, aEncodable); });
+
+    size_t index;
+    if (ShouldDeferResponse(aRequestCommandPath, index))
+    {
+        CHIP_ERROR err = DeferResponse(index, [&](InvokeResponseIB::Builder & invokeResponse) -> CHIP_ERROR {
+            auto commandPathRegistryEntry = GetCommandPathRegistry().Find(aRequestCommandPath);
+            VerifyOrReturnError(commandPathRegistryEntry.has_value(), CHIP_ERROR_INCORRECT_STATE);
+
+            ConcreteCommandPath responseCommandPath = { aRequestCommandPath.mEndpointId, aRequestCommandPath.mClusterId,
+                                                        aResponseCommandId };
+
+            ReturnErrorOnFailure(StartCommandData(invokeResponse, responseCommandPath));
+            CommandDataIB::Builder & commandData = invokeResponse.GetCommand();
+            ReturnErrorOnFailure(aEncodable.EncodeTo(*commandData.GetWriter(), TLV::ContextTag(CommandDataIB::Tag::kFields)));
+            return EndCommandData(commandData, commandPathRegistryEntry->ref);
+        });
+        if (err == CHIP_NO_ERROR)
+        {
+            return CHIP_NO_ERROR;
+        }
+        // Rather than dropping the response, add it out of order.
+        ChipLogError(DataManagement, "Failed to defer command response: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+
+    ReturnErrorOnFailure(TryAddingResponse(
+        [&]() -> CHIP_ERROR { return TryAddResponseData(aRequestCommandPath, aResponseCommandId, aEncodable); }));
+    OnResponseAdded(aRequestCommandPath);
+    return CHIP_NO_ERROR;
+}
+
+bool CommandHandlerImpl::ShouldDeferResponse(const ConcreteCommandPath & aRequestCommandPath, size_t & aIndex)
+{
+    VerifyOrReturnValue(mOrderResponses, false);
+
+    auto index = GetCommandPathRegistry().FindIndex(aRequestCommandPath);
+    VerifyOrReturnValue(index.has_value(), false);
+
+    aIndex = *index;
+    return aIndex > mNextResponseIndex;
+}
+
+CHIP_ERROR CommandHandlerImpl::StoreDeferredResponse(size_t aIndex,
+                                                      Platform::ScopedMemoryBufferWithSize<uint8_t> && aEncodedResponse)
+{
+    DeferredResponse * deferredResponse = Platform::New<DeferredResponse>();
+    VerifyOrReturnError(deferredResponse != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    deferredResponse->mEncodedResponse = std::move(aEncodedResponse);
+    deferredResponse->mIndex           = aIndex;
+    mDeferredResponses.PushBack(deferredResponse);
+    return CHIP_NO_ERROR;
+}
+
+void CommandHandlerImpl::OnResponseAdded(const ConcreteCommandPath & aRequestCommandPath)
+{
+    VerifyOrReturn(mOrderResponses);
+
+    auto index = GetCommandPathRegistry().FindIndex(aRequestCommandPath);
+    VerifyOrReturn(index.has_value() && *index == mNextResponseIndex);
+
+    mNextResponseIndex++;
+    AddDeferredResponses(/* aSkipUnanswered = */ false);
+}
+
+void CommandHandlerImpl::AddDeferredResponses(bool aSkipUnanswered)
+{
+    while (!mDeferredResponses.Empty())
+    {
+        DeferredResponse * deferredResponse = nullptr;
+        for (auto & candidate : mDeferredResponses)
+        {
+            if (deferredResponse == nullptr || candidate.mIndex < deferredResponse->mIndex)
+            {
+                deferredResponse = &candidate;
+            }
+        }
+
+        if (!aSkipUnanswered && deferredResponse->mIndex > mNextResponseIndex)
+        {
+            // The next command in the request has not been responded to yet.
+            return;
+        }
+
+        const auto & encodedResponse = deferredResponse->mEncodedResponse;
+        const ByteSpan response(encodedResponse.Get(), encodedResponse.AllocatedSize());
+        CHIP_ERROR err = TryAddingResponse([&]() -> CHIP_ERROR { return TryAddEncodedResponse(response); });
+        if (err != CHIP_NO_ERROR)
+        {
+            // The command was responded to, but its response cannot be sent: carry on with the next ones.
+            ChipLogError(DataManagement, "Failed to add deferred command response: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+
+        mNextResponseIndex = std::max(mNextResponseIndex, deferredResponse->mIndex + 1);
+        mDeferredResponses.Remove(deferredResponse);
+        Platform::Delete(deferredResponse);
+    }
+}
+
+void CommandHandlerImpl::ReleaseDeferredResponses()
+{
+    while (!mDeferredResponses.Empty())
+    {
+        DeferredResponse * deferredResponse = &*mDeferredResponses.begin();
+        mDeferredResponses.Remove(deferredResponse);
+        Platform::Delete(deferredResponse);
+    }
+}
+
+CHIP_ERROR CommandHandlerImpl::TryAddEncodedResponse(const ByteSpan & aEncodedResponse)
+{
+    ReturnErrorOnFailure(AllocateBuffer());
+    //
+    // We must not be in the middle of preparing a command, or having prepared or sent one.
+    //
+    VerifyOrReturnError(mState == State::NewResponseMessage || mState == State::AddedCommand, CHIP_ERROR_INCORRECT_STATE);
+    CreateBackupForResponseRollback();
+
+    TLV::TLVReader reader;
+    reader.Init(aEncodedResponse);
+    ReturnErrorOnFailure(reader.Next());
+
+    MoveToState(State::Preparing);
+    ReturnErrorOnFailure(mInvokeResponseBuilder.GetInvokeResponses().GetWriter()->CopyElement(TLV::AnonymousTag(), reader));
+    MoveToState(State::AddedCommand);
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR CommandHandlerImpl::ValidateInvokeRequestMessageAndBuildRegistry(InvokeRequestMessage::Parser & invokeRequestMessage)
@@ -250,6 +378,7 @@ Status CommandHandlerImpl::ProcessInvokeRequest(System::PacketBufferHandle && pa
     if (commandCount > 1)
     {
         mReserveSpaceForMoreChunkMessages = true;
+        mOrderResponses                   = !IsGroupRequest();
     }
 
     while (CHIP_NO_ERROR == (err = invokeRequestsReader.Next()))
@@ -347,6 +476,9 @@ void CommandHandlerImpl::DecrementHoldOff(Handle * apHandle)
     }
     else if (!IsGroupRequest())
     {
+        // Commands that were never responded to must not hold back the responses that follow them.
+        AddDeferredResponses(/* aSkipUnanswered = */ true);
+
         CHIP_ERROR err = FinalizeLastInvokeResponseMessage();
         if (err != CHIP_NO_ERROR)
         {
@@ -447,7 +579,9 @@ Status CommandHandlerImpl::ProcessCommandDataIB(CommandDataIB::Parser & aCommand
         ChipLogDetail(DataManagement, "Received command for Endpoint=%u Cluster=" ChipLogFormatMEI " Command=" ChipLogFormatMEI,
                       concretePath.mEndpointId, ChipLogValueMEI(concretePath.mClusterId), ChipLogValueMEI(concretePath.mCommandId));
         SuccessOrExit(err = DataModelCallbacks::GetInstance()->PreCommandReceived(concretePath, GetSubjectDescriptor()));
+        MATTER_LOG_METRIC_BEGIN(Tracing::kMetricIMCommandDispatch);
         mpCallback->DispatchCommand(*this, concretePath, commandDataReader);
+        MATTER_LOG_METRIC_END(Tracing::kMetricIMCommandDispatch);
         DataModelCallbacks::GetInstance()->PostCommandReceived(concretePath, GetSubjectDescriptor());
     }
 
@@ -557,7 +691,9 @@ Status CommandHandlerImpl::ProcessGroupCommandDataIB(CommandDataIB::Parser & aCo
         if ((err = DataModelCallbacks::GetInstance()->PreCommandReceived(concretePath, GetSubjectDescriptor())) == CHIP_NO_ERROR)
         {
             TLV::TLVReader dataReader(commandDataReader);
+            MATTER_LOG_METRIC_BEGIN(Tracing::kMetricIMCommandDispatch);
             mpCallback->DispatchCommand(*this, concretePath, dataReader);
+            MATTER_LOG_METRIC_END(Tracing::kMetricIMCommandDispatch);
             DataModelCallbacks::GetInstance()->PostCommandReceived(concretePath, GetSubjectDescriptor());
         }
         else
@@ -579,17 +715,39 @@ CHIP_ERROR CommandHandlerImpl::TryAddStatusInternal(const ConcreteCommandPath &
     VerifyOrReturnValue(ResponsesAccepted(), CHIP_NO_ERROR);
 
     ReturnErrorOnFailure(PrepareStatus(aCommandPath));
-    CommandStatusIB::Builder & commandStatus = mInvokeResponseBuilder.GetInvokeResponses().GetInvokeResponse().GetStatus();
-    StatusIB::Builder & statusIBBuilder      = commandStatus.CreateErrorStatus();
-    ReturnErrorOnFailure(commandStatus.GetError());
-    statusIBBuilder.EncodeStatusIB(aStatus);
-    ReturnErrorOnFailure(statusIBBuilder.GetError());
+    ReturnErrorOnFailure(
+        EncodeCommandStatus(mInvokeResponseBuilder.GetInvokeResponses().GetInvokeResponse().GetStatus(), aStatus));
     return FinishStatus();
 }
 
 CHIP_ERROR CommandHandlerImpl::AddStatusInternal(const ConcreteCommandPath & aCommandPath, const StatusIB & aStatus)
 {
-    return TryAddingResponse([&]() -> CHIP_ERROR { return TryAddStatusInternal(aCommandPath, aStatus); });
+    // Return early when response should not be sent out.
+    VerifyOrReturnValue(ResponsesAccepted(), CHIP_NO_ERROR);
+
+    size_t index;
+    if (ShouldDeferResponse(aCommandPath, index))
+    {
+        CHIP_ERROR err = DeferResponse(index, [&](InvokeResponseIB::Builder & invokeResponse) -> CHIP_ERROR {
+            auto commandPathRegistryEntry = GetCommandPathRegistry().Find(aCommandPath);
+            VerifyOrReturnError(commandPathRegistryEntry.has_value(), CHIP_ERROR_INCORRECT_STATE);
+
+            ReturnErrorOnFailure(StartCommandStatus(invokeResponse, aCommandPath));
+            CommandStatusIB::Builder & commandStatus = invokeResponse.GetStatus();
+            ReturnErrorOnFailure(EncodeCommandStatus(commandStatus, aStatus));
+            return EndCommandStatus(commandStatus, commandPathRegistryEntry->ref);
+        });
+        if (err == CHIP_NO_ERROR)
+        {
+            return CHIP_NO_ERROR;
+        }
+        // Rather than dropping the response, add it out of order.
+        ChipLogError(DataManagement, "Failed to defer command response: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+
+    ReturnErrorOnFailure(TryAddingResponse([&]() -> CHIP_ERROR { return TryAddStatusInternal(aCommandPath, aStatus); }));
+    OnResponseAdded(aCommandPath);
+    return CHIP_NO_ERROR;
 }
 
 void CommandHandlerImpl::AddStatus(const ConcreteCommandPath & aCommandPath, const Protocols::InteractionModel::Status aStatus,
@@ -682,13 +840,10 @@ CHIP_ERROR CommandHandlerImpl::PrepareInvokeResponseCommand(const CommandPathReg
     InvokeResponseIB::Builder & invokeResponse   = invokeResponses.CreateInvokeResponse();
     ReturnErrorOnFailure(invokeResponses.GetError());
 
-    CommandDataIB::Builder & commandData = invokeResponse.CreateCommand();
-    ReturnErrorOnFailure(commandData.GetError());
-    CommandPathIB::Builder & path = commandData.CreatePath();
-    ReturnErrorOnFailure(commandData.GetError());
-    ReturnErrorOnFailure(path.Encode(aCommandPath));
+    ReturnErrorOnFailure(StartCommandData(invokeResponse, aCommandPath));
     if (aStartDataStruct)
     {
+        CommandDataIB::Builder & commandData = invokeResponse.GetCommand();
         ReturnErrorOnFailure(commandData.GetWriter()->StartContainer(TLV::ContextTag(CommandDataIB::Tag::kFields),
                                                                      TLV::kTLVType_Structure, mDataElementContainerType));
     }
@@ -708,12 +863,7 @@ CHIP_ERROR CommandHandlerImpl::FinishCommand(bool aStartDataStruct)
         ReturnErrorOnFailure(commandData.GetWriter()->EndContainer(mDataElementContainerType));
     }
 
-    if (mRefForResponse.has_value())
-    {
-        ReturnErrorOnFailure(commandData.Ref(*mRefForResponse));
-    }
-
-    ReturnErrorOnFailure(commandData.EndOfCommandDataIB());
+    ReturnErrorOnFailure(EndCommandData(commandData, mRefForResponse));
     ReturnErrorOnFailure(mInvokeResponseBuilder.GetInvokeResponses().GetInvokeResponse().EndOfInvokeResponseIB());
     MoveToState(State::AddedCommand);
     return CHIP_NO_ERROR;
@@ -739,11 +889,7 @@ CHIP_ERROR CommandHandlerImpl::PrepareStatus(const ConcreteCommandPath & aComman
     InvokeResponseIBs::Builder & invokeResponses = mInvokeResponseBuilder.GetInvokeResponses();
     InvokeResponseIB::Builder & invokeResponse   = invokeResponses.CreateInvokeResponse();
     ReturnErrorOnFailure(invokeResponses.GetError());
-    CommandStatusIB::Builder & commandStatus = invokeResponse.CreateStatus();
-    ReturnErrorOnFailure(commandStatus.GetError());
-    CommandPathIB::Builder & path = commandStatus.CreatePath();
-    ReturnErrorOnFailure(commandStatus.GetError());
-    ReturnErrorOnFailure(path.Encode(aCommandPath));
+    ReturnErrorOnFailure(StartCommandStatus(invokeResponse, aCommandPath));
     MoveToState(State::AddingCommand);
     return CHIP_NO_ERROR;
 }
@@ -753,17 +899,58 @@ CHIP_ERROR CommandHandlerImpl::FinishStatus()
     VerifyOrReturnError(mState == State::AddingCommand, CHIP_ERROR_INCORRECT_STATE);
 
     CommandStatusIB::Builder & commandStatus = mInvokeResponseBuilder.GetInvokeResponses().GetInvokeResponse().GetStatus();
-    if (mRefForResponse.has_value())
-    {
-        ReturnErrorOnFailure(commandStatus.Ref(*mRefForResponse));
-    }
-
-    ReturnErrorOnFailure(mInvokeResponseBuilder.GetInvokeResponses().GetInvokeResponse().GetStatus().EndOfCommandStatusIB());
+    ReturnErrorOnFailure(EndCommandStatus(commandStatus, mRefForResponse));
     ReturnErrorOnFailure(mInvokeResponseBuilder.GetInvokeResponses().GetInvokeResponse().EndOfInvokeResponseIB());
     MoveToState(State::AddedCommand);
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR CommandHandlerImpl::StartCommandData(InvokeResponseIB::Builder & aInvokeResponse,
+                                                const ConcreteCommandPath & aCommandPath)
+{
+    CommandDataIB::Builder & commandData = aInvokeResponse.CreateCommand();
+    ReturnErrorOnFailure(aInvokeResponse.GetError());
+    CommandPathIB::Builder & path = commandData.CreatePath();
+    ReturnErrorOnFailure(commandData.GetError());
+    return path.Encode(aCommandPath);
+}
+
+CHIP_ERROR CommandHandlerImpl::EndCommandData(CommandDataIB::Builder & aCommandData, const std::optional<uint16_t> & aRef)
+{
+    if (aRef.has_value())
+    {
+        ReturnErrorOnFailure(aCommandData.Ref(*aRef));
+    }
+    return aCommandData.EndOfCommandDataIB();
+}
+
+CHIP_ERROR CommandHandlerImpl::StartCommandStatus(InvokeResponseIB::Builder & aInvokeResponse,
+                                                  const ConcreteCommandPath & aCommandPath)
+{
+    CommandStatusIB::Builder & commandStatus = aInvokeResponse.CreateStatus();
+    ReturnErrorOnFailure(aInvokeResponse.GetError());
+    CommandPathIB::Builder & path = commandStatus.CreatePath();
+    ReturnErrorOnFailure(commandStatus.GetError());
+    return path.Encode(aCommandPath);
+}
+
+CHIP_ERROR CommandHandlerImpl::EncodeCommandStatus(CommandStatusIB::Builder & aCommandStatus, const StatusIB & aStatus)
+{
+    StatusIB::Builder & statusIBBuilder = aCommandStatus.CreateErrorStatus();
+    ReturnErrorOnFailure(aCommandStatus.GetError());
+    statusIBBuilder.EncodeStatusIB(aStatus);
+    return statusIBBuilder.GetError();
+}
+
+CHIP_ERROR CommandHandlerImpl::EndCommandStatus(CommandStatusIB::Builder & aCommandStatus, const std::optional<uint16_t> & aRef)
+{
+    if (aRef.has_value())
+    {
+        ReturnErrorOnFailure(aCommandStatus.Ref(*aRef));
+    }
+    return aCommandStatus.EndOfCommandStatusIB();
+}
+
 void CommandHandlerImpl::CreateBackupForResponseRollback()
 {
     VerifyOrReturn(mState == State::NewResponseMessage || mState == State::AddedCommand);
@@ -21,10 +21,12 @@
 #include <app/CommandPathRegistry.h>
 #include <app/MessageDef/InvokeRequestMessage.h>
 #include <app/MessageDef/InvokeResponseMessage.h>
+#include <app/StatusResponse.h>
 #include <lib/core/TLV.h>
 #include <lib/core/TLVDebug.h>
 #include <lib/support/BitFlags.h>
 #include <lib/support/Scoped.h>
+#include <lib/support/ScopedBuffer.h>
 #include <messaging/ExchangeHolder.h>
 #include <messaging/Flags.h>
 #include <protocols/Protocols.h>
@@ -395,6 +397,111 @@ private:
      */
     Protocols::InteractionModel::Status ProcessGroupCommandDataIB(CommandDataIB::Parser & aCommandElement);
 
+    /**
+     * Responses to the commands of a batch are encoded in the order of the requests, even though the
+     * commands may complete asynchronously in any order: the response to a command that follows a
+     * command still awaiting its response is encoded aside, and added to the InvokeResponses once all
+     * the commands before it have been responded to.
+     *
+     * Returns true if the response to aRequestCommandPath has to be encoded aside, in which case
+     * aIndex is set to the position of the command in the request.
+     */
+    bool ShouldDeferResponse(const ConcreteCommandPath & aRequestCommandPath, size_t & aIndex);
+
+    /**
+     * TLV backing store that only measures what is written to it: every chunk goes to the same scratch buffer.
+     */
+    class LengthMeasuringBackingStore : public TLV::TLVBackingStore
+    {
+    public:
+        CHIP_ERROR OnInit(TLV::TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+        {
+            return CHIP_ERROR_NOT_IMPLEMENTED;
+        }
+        CHIP_ERROR GetNextBuffer(TLV::TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+        {
+            return CHIP_ERROR_NOT_IMPLEMENTED;
+        }
+        CHIP_ERROR OnInit(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+        {
+            return GetNewBuffer(writer, bufStart, bufLen);
+        }
+        CHIP_ERROR GetNewBuffer(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+        {
+            bufStart = mScratch;
+            bufLen   = sizeof(mScratch);
+            return CHIP_NO_ERROR;
+        }
+        CHIP_ERROR FinalizeBuffer(TLV::TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override { return CHIP_NO_ERROR; }
+
+    private:
+        uint8_t mScratch[32];
+    };
+
+    /**
+     * Encodes aside, as a standalone InvokeResponseIB, the response to the command at position aIndex
+     * in the request.
+     *
+     * The response is encoded twice: first only to measure it, then into a buffer of exactly that size,
+     * which is stored as is.
+     *
+     * @param [in] encodeResponseFunction A lambda function responsible for encoding the response into the
+     *             InvokeResponseIB::Builder it is given.
+     */
+    template <typename Function>
+    CHIP_ERROR DeferResponse(size_t aIndex, Function && encodeResponseFunction)
+    {
+        LengthMeasuringBackingStore lengthMeasurer;
+        TLV::TLVWriter writer;
+        writer.Init(lengthMeasurer, kMaxSecureSduLengthBytes);
+        ReturnErrorOnFailure(EncodeStandaloneResponse(writer, encodeResponseFunction));
+
+        Platform::ScopedMemoryBufferWithSize<uint8_t> encodedResponse;
+        VerifyOrReturnError(encodedResponse.Alloc(writer.GetLengthWritten()), CHIP_ERROR_NO_MEMORY);
+        writer.Init(encodedResponse.Get(), encodedResponse.AllocatedSize());
+        ReturnErrorOnFailure(EncodeStandaloneResponse(writer, encodeResponseFunction));
+        return StoreDeferredResponse(aIndex, std::move(encodedResponse));
+    }
+
+    template <typename Function>
+    static CHIP_ERROR EncodeStandaloneResponse(TLV::TLVWriter & writer, Function && encodeResponseFunction)
+    {
+        InvokeResponseIB::Builder invokeResponse;
+        ReturnErrorOnFailure(invokeResponse.Init(&writer));
+        ReturnErrorOnFailure(encodeResponseFunction(invokeResponse));
+        ReturnErrorOnFailure(invokeResponse.EndOfInvokeResponseIB());
+        return writer.Finalize();
+    }
+
+    CHIP_ERROR StoreDeferredResponse(size_t aIndex, Platform::ScopedMemoryBufferWithSize<uint8_t> && aEncodedResponse);
+
+    /**
+     * Records that the command at aRequestCommandPath has been responded to, and adds the deferred
+     * responses to the commands that follow it, up to the next command still awaiting its response.
+     */
+    void OnResponseAdded(const ConcreteCommandPath & aRequestCommandPath);
+
+    /**
+     * Adds the deferred responses in the order of the requests, starting from mNextResponseIndex.
+     *
+     * @param [in] aSkipUnanswered whether to carry on past the commands that have not been responded to.
+     */
+    void AddDeferredResponses(bool aSkipUnanswered);
+
+    void ReleaseDeferredResponses();
+
+    CHIP_ERROR TryAddEncodedResponse(const ByteSpan & aEncodedResponse);
+
+    /**
+     * Helpers encoding the CommandDataIB and CommandStatusIB of an InvokeResponseIB, shared by the responses
+     * added in place to the InvokeResponseMessage and the ones encoded aside by DeferResponse.
+     */
+    static CHIP_ERROR StartCommandData(InvokeResponseIB::Builder & aInvokeResponse, const ConcreteCommandPath & aCommandPath);
+    static CHIP_ERROR EndCommandData(CommandDataIB::Builder & aCommandData, const std::optional<uint16_t> & aRef);
+    static CHIP_ERROR StartCommandStatus(InvokeResponseIB::Builder & aInvokeResponse, const ConcreteCommandPath & aCommandPath);
+    static CHIP_ERROR EncodeCommandStatus(CommandStatusIB::Builder & aCommandStatus, const StatusIB & aStatus);
+    static CHIP_ERROR EndCommandStatus(CommandStatusIB::Builder & aCommandStatus, const std::optional<uint16_t> & aRef);
+
     CHIP_ERROR TryAddStatusInternal(const ConcreteCommandPath & aCommandPath, const StatusIB & aStatus);
 
     CHIP_ERROR AddStatusInternal(const ConcreteCommandPath & aCommandPath, const StatusIB & aStatus);
@@ -471,6 +578,17 @@ private:
     // incoming invoke.  After this point, our session could go away at any
     // time.
     bool mGoneAsync = false;
+
+    struct DeferredResponse : public IntrusiveListNodeBase<>
+    {
+        size_t mIndex = 0;
+        Platform::ScopedMemoryBufferWithSize<uint8_t> mEncodedResponse;
+    };
+
+    // Whether responses are encoded in the order of the requests, see ShouldDeferResponse.
+    bool mOrderResponses      = false;
+    size_t mNextResponseIndex = 0;
+    IntrusiveList<DeferredResponse> mDeferredResponses;
 };
 } // namespace app
 } // namespace chip
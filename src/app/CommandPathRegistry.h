@@ -45,6 +45,12 @@ public:
     virtual CHIP_ERROR Add(const ConcreteCommandPath & requestPath, const std::optional<uint16_t> & ref) = 0;
     virtual size_t Count() const                                                                         = 0;
     virtual size_t MaxSize() const                                                                       = 0;
+
+    /**
+     * Returns the position of requestPath among the added paths, which is its position
+     * in the InvokeRequests of the request.
+     */
+    virtual std::optional<size_t> FindIndex(const ConcreteCommandPath & requestPath) const = 0;
 };
 
 /**
@@ -73,6 +79,18 @@ public:
         return std::nullopt;
     }
 
+    std::optional<size_t> FindIndex(const ConcreteCommandPath & requestPath) const override
+    {
+        for (size_t i = 0; i < mCount; i++)
+        {
+            if (mTable[i].requestPath == requestPath)
+            {
+                return std::make_optional(i);
+            }
+        }
+        return std::nullopt;
+    }
+
     std::optional<CommandPathRegistryEntry> GetFirstEntry() const override
     {
         if (mCount > 0)
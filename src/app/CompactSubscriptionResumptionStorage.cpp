@@ -0,0 +1,264 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines an implementation of SubscriptionResumptionStorage that
+ *      persists all the subscriptions in a single record.
+ */
+
+#include <app/CompactSubscriptionResumptionStorage.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/SafeInt.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace app {
+
+CompactSubscriptionResumptionStorage::CompactSubscriptionInfoIterator::CompactSubscriptionInfoIterator(
+    CompactSubscriptionResumptionStorage & storage) :
+    mStorage(storage)
+{
+    CHIP_ERROR err = mStorage.LoadRecord(mReader);
+    if (err != CHIP_NO_ERROR)
+    {
+        // The record is kept if it could not be read, as the next attempt may succeed.
+        if (err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+        {
+            ChipLogError(DataManagement, "Failed to read subscriptions error %" CHIP_ERROR_FORMAT, err.Format());
+        }
+        return;
+    }
+
+    err = EnterRecord(mReader, mOuterType);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = mReader.CountRemainingInContainer(&mCount);
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Discarding subscriptions that cannot be decoded error %" CHIP_ERROR_FORMAT, err.Format());
+        mStorage.mStorage->SyncDeleteKeyValue(DefaultStorageKeyAllocator::SubscriptionResumptionRecord().KeyName());
+        mCount = 0;
+        return;
+    }
+    mHasRecord = true;
+}
+
+size_t CompactSubscriptionResumptionStorage::CompactSubscriptionInfoIterator::Count()
+{
+    return mCount;
+}
+
+bool CompactSubscriptionResumptionStorage::CompactSubscriptionInfoIterator::Next(SubscriptionInfo & output)
+{
+    VerifyOrReturnValue(mHasRecord, false);
+    VerifyOrReturnValue(mReader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag()) == CHIP_NO_ERROR, false);
+
+    CHIP_ERROR err = mStorage.SimpleSubscriptionResumptionStorage::Load(mReader, output);
+    if (err != CHIP_NO_ERROR)
+    {
+        // The rest of the record cannot be trusted either.
+        ChipLogError(DataManagement, "Failed to load subscription error %" CHIP_ERROR_FORMAT, err.Format());
+        mHasRecord = false;
+        return false;
+    }
+    return true;
+}
+
+void CompactSubscriptionResumptionStorage::CompactSubscriptionInfoIterator::Release()
+{
+    mStorage.mCompactSubscriptionInfoIterators.ReleaseObject(this);
+}
+
+CHIP_ERROR CompactSubscriptionResumptionStorage::Init(PersistentStorageDelegate * storage)
+{
+    VerifyOrReturnError(storage != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The max count key is only written by SimpleSubscriptionResumptionStorage, so there is nothing to move if it is not there.
+    if (!storage->SyncDoesKeyExist(DefaultStorageKeyAllocator::SubscriptionResumptionMaxCount().KeyName()))
+    {
+        mStorage = storage;
+        return CHIP_NO_ERROR;
+    }
+
+    // This cleans up the subscriptions beyond CHIP_IM_MAX_NUM_SUBSCRIPTIONS.
+    ReturnErrorOnFailure(SimpleSubscriptionResumptionStorage::Init(storage));
+
+    uint16_t movedCount = 0;
+    for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
+    {
+        SubscriptionInfo subscriptionInfo;
+        CHIP_ERROR err = SimpleSubscriptionResumptionStorage::Load(subscriptionIndex, subscriptionInfo);
+        if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+        {
+            continue;
+        }
+
+        // Failing to save leaves the subscriptions that are not moved yet, and the max count key, for the next Init().
+        VerifyOrReturnError(err != CHIP_ERROR_NO_MEMORY, err);
+        if (err == CHIP_NO_ERROR)
+        {
+            ReturnErrorOnFailure(Save(subscriptionInfo));
+            movedCount++;
+        }
+        else
+        {
+            ChipLogError(DataManagement, "Failed to move subscription at index %u error %" CHIP_ERROR_FORMAT,
+                         static_cast<unsigned>(subscriptionIndex), err.Format());
+        }
+        SimpleSubscriptionResumptionStorage::Delete(subscriptionIndex);
+    }
+    ChipLogProgress(DataManagement, "Moved %u subscriptions into the subscription resumption record", movedCount);
+
+    return DeleteMaxCount();
+}
+
+SubscriptionResumptionStorage::SubscriptionInfoIterator * CompactSubscriptionResumptionStorage::IterateSubscriptions()
+{
+    return mCompactSubscriptionInfoIterators.CreateObject(*this);
+}
+
+CHIP_ERROR CompactSubscriptionResumptionStorage::LoadRecord(TLV::ScopedBufferTLVReader & reader)
+{
+    static_assert(MaxRecordSize() <= UINT16_MAX, "The subscription resumption record does not fit into a storage value");
+
+    Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
+    backingBuffer.Calloc(MaxRecordSize());
+    ReturnErrorCodeIf(backingBuffer.Get() == nullptr, CHIP_ERROR_NO_MEMORY);
+
+    uint16_t len = static_cast<uint16_t>(MaxRecordSize());
+    ReturnErrorOnFailure(mStorage->SyncGetKeyValue(DefaultStorageKeyAllocator::SubscriptionResumptionRecord().KeyName(),
+                                                   backingBuffer.Get(), len));
+
+    reader.Init(std::move(backingBuffer), len);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CompactSubscriptionResumptionStorage::EnterRecord(TLV::TLVReader & reader, TLV::TLVType & outerType)
+{
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_List, TLV::AnonymousTag()));
+    return reader.EnterContainer(outerType);
+}
+
+template <typename Predicate>
+CHIP_ERROR CompactSubscriptionResumptionStorage::Rewrite(Predicate shouldRemove, SubscriptionInfo * newSubscription,
+                                                         size_t & removedCount)
+{
+    removedCount = 0;
+
+    TLV::ScopedBufferTLVReader reader;
+    TLV::TLVType readerListType = TLV::kTLVType_NotSpecified;
+    CHIP_ERROR err              = LoadRecord(reader);
+    VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND, err);
+
+    bool hasRecord = (err == CHIP_NO_ERROR);
+    if (hasRecord && (err = EnterRecord(reader, readerListType)) != CHIP_NO_ERROR)
+    {
+        // Start over rather than keep a record that cannot be decoded.
+        ChipLogError(DataManagement, "Discarding subscriptions that cannot be decoded error %" CHIP_ERROR_FORMAT, err.Format());
+        hasRecord = false;
+    }
+
+    Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
+    backingBuffer.Calloc(MaxRecordSize());
+    ReturnErrorCodeIf(backingBuffer.Get() == nullptr, CHIP_ERROR_NO_MEMORY);
+    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), MaxRecordSize());
+
+    TLV::TLVType writerListType;
+    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_List, writerListType));
+
+    size_t subscriptionCount = 0;
+    while (hasRecord && (err = reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag())) == CHIP_NO_ERROR)
+    {
+        SubscriptionInfo subscriptionInfo;
+        err = SimpleSubscriptionResumptionStorage::Load(reader, subscriptionInfo);
+        VerifyOrReturnError(err != CHIP_ERROR_NO_MEMORY, err);
+        if (err != CHIP_NO_ERROR)
+        {
+            // The subscriptions that follow cannot be decoded either.
+            ChipLogError(DataManagement, "Discarding subscriptions that cannot be decoded error %" CHIP_ERROR_FORMAT, err.Format());
+            break;
+        }
+
+        if (shouldRemove(subscriptionInfo))
+        {
+            removedCount++;
+            continue;
+        }
+
+        ReturnErrorOnFailure(SimpleSubscriptionResumptionStorage::Save(writer, subscriptionInfo));
+        subscriptionCount++;
+    }
+
+    if (newSubscription != nullptr)
+    {
+        VerifyOrReturnError(subscriptionCount < CHIP_IM_MAX_NUM_SUBSCRIPTIONS, CHIP_ERROR_NO_MEMORY);
+        ReturnErrorOnFailure(SimpleSubscriptionResumptionStorage::Save(writer, *newSubscription));
+        subscriptionCount++;
+    }
+
+    if (subscriptionCount == 0)
+    {
+        err = mStorage->SyncDeleteKeyValue(DefaultStorageKeyAllocator::SubscriptionResumptionRecord().KeyName());
+        return (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND) ? CHIP_NO_ERROR : err;
+    }
+
+    ReturnErrorOnFailure(writer.EndContainer(writerListType));
+
+    const auto len = writer.GetLengthWritten();
+    VerifyOrReturnError(CanCastTo<uint16_t>(len), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    ReturnErrorOnFailure(writer.Finalize(backingBuffer));
+
+    return mStorage->SyncSetKeyValue(DefaultStorageKeyAllocator::SubscriptionResumptionRecord().KeyName(), backingBuffer.Get(),
+                                     static_cast<uint16_t>(len));
+}
+
+CHIP_ERROR CompactSubscriptionResumptionStorage::Save(SubscriptionInfo & subscriptionInfo)
+{
+    size_t removedCount = 0;
+    return Rewrite(
+        [&subscriptionInfo](const SubscriptionInfo & info) {
+            return (info.mNodeId == subscriptionInfo.mNodeId) && (info.mFabricIndex == subscriptionInfo.mFabricIndex) &&
+                (info.mSubscriptionId == subscriptionInfo.mSubscriptionId);
+        },
+        &subscriptionInfo, removedCount);
+}
+
+CHIP_ERROR CompactSubscriptionResumptionStorage::Delete(NodeId nodeId, FabricIndex fabricIndex, SubscriptionId subscriptionId)
+{
+    size_t removedCount = 0;
+    ReturnErrorOnFailure(Rewrite(
+        [&](const SubscriptionInfo & info) {
+            return (info.mNodeId == nodeId) && (info.mFabricIndex == fabricIndex) && (info.mSubscriptionId == subscriptionId);
+        },
+        nullptr, removedCount));
+
+    return (removedCount > 0) ? CHIP_NO_ERROR : CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
+}
+
+CHIP_ERROR CompactSubscriptionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
+{
+    size_t removedCount = 0;
+    return Rewrite([fabricIndex](const SubscriptionInfo & info) { return info.mFabricIndex == fabricIndex; }, nullptr,
+                   removedCount);
+}
+
+} // namespace app
+} // namespace chip
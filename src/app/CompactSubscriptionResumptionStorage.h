@@ -0,0 +1,97 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines an implementation of SubscriptionResumptionStorage that
+ *      persists all the subscriptions in a single record.
+ */
+
+#pragma once
+
+#include <app/SimpleSubscriptionResumptionStorage.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * A SubscriptionResumptionStorage that persists all the subscriptions in a single record, as a list of the
+ * subscription structures of SimpleSubscriptionResumptionStorage.
+ *
+ * Iterating the subscriptions, which the device does when it boots, reads a single key instead of probing the
+ * key of every possible subscription, and the record only has to be sized for the paths that the subscriptions
+ * of the device can have in total.
+ *
+ * Init() moves the subscriptions persisted by SimpleSubscriptionResumptionStorage into the record.
+ */
+class CompactSubscriptionResumptionStorage : public SimpleSubscriptionResumptionStorage
+{
+public:
+    CHIP_ERROR Init(PersistentStorageDelegate * storage);
+
+    SubscriptionInfoIterator * IterateSubscriptions() override;
+
+    CHIP_ERROR Save(SubscriptionInfo & subscriptionInfo) override;
+
+    CHIP_ERROR Delete(NodeId nodeId, FabricIndex fabricIndex, SubscriptionId subscriptionId) override;
+
+    CHIP_ERROR DeleteAll(FabricIndex fabricIndex) override;
+
+protected:
+    class CompactSubscriptionInfoIterator : public SubscriptionInfoIterator
+    {
+    public:
+        CompactSubscriptionInfoIterator(CompactSubscriptionResumptionStorage & storage);
+        size_t Count() override;
+        bool Next(SubscriptionInfo & output) override;
+        void Release() override;
+
+    private:
+        CompactSubscriptionResumptionStorage & mStorage;
+        TLV::ScopedBufferTLVReader mReader;
+        TLV::TLVType mOuterType = TLV::kTLVType_NotSpecified;
+        size_t mCount           = 0;
+        bool mHasRecord         = false;
+    };
+
+    static constexpr size_t MaxRecordSize()
+    {
+        // The subscriptions, without their paths, and all the paths the subscriptions of the IM engine can have.
+        return TLV::EstimateStructOverhead(TLV::EstimateStructOverhead(MaxScopedNodeIdSize(), sizeof(SubscriptionId),
+                                                                       sizeof(uint16_t), sizeof(uint16_t), sizeof(bool),
+                                                                       sizeof(uint32_t), TLV::EstimateStructOverhead(),
+                                                                       TLV::EstimateStructOverhead()) *
+                                               CHIP_IM_MAX_NUM_SUBSCRIPTIONS,
+                                           MaxSubscriptionPathsSize());
+    }
+
+    // Reads the record. Only fails if the record cannot be read from the storage, or with CHIP_ERROR_NO_MEMORY.
+    CHIP_ERROR LoadRecord(TLV::ScopedBufferTLVReader & reader);
+
+    // Enters the list of subscriptions of a record read by LoadRecord(). Fails if the record cannot be decoded.
+    static CHIP_ERROR EnterRecord(TLV::TLVReader & reader, TLV::TLVType & outerType);
+
+    // Writes the record again, without the subscriptions for which shouldRemove returns true, and with newSubscription
+    // at the end if it is not null. The record is deleted if no subscription is left. Subscriptions that cannot be
+    // decoded are dropped, but the record is left untouched if it cannot be read.
+    template <typename Predicate>
+    CHIP_ERROR Rewrite(Predicate shouldRemove, SubscriptionInfo * newSubscription, size_t & removedCount);
+
+    ObjectPool<CompactSubscriptionInfoIterator, kIteratorsMax> mCompactSubscriptionInfoIterators;
+};
+} // namespace app
+} // namespace chip
@@ -40,6 +40,7 @@
 #include <lib/support/CHIPFaultInjection.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/FibonacciUtils.h>
+#include <tracing/metric_event.h>
 
 namespace chip {
 namespace app {
@@ -94,6 +95,9 @@ CHIP_ERROR InteractionModelEngine::Init(Messaging::ExchangeManager * apExchangeM
 void InteractionModelEngine::Shutdown()
 {
     mpExchangeMgr->GetSessionManager()->SystemLayer()->CancelTimer(ResumeSubscriptionsTimerCallback, this);
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    ReleaseQueuedSubscriptionResumptions();
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
 
     CommandHandlerInterface * handlerIter = mCommandHandlerList;
 
@@ -159,6 +163,7 @@ void InteractionModelEngine::Shutdown()
     }
 
     mReportingEngine.Shutdown();
+    AttributePathExpandIterator::InvalidateExpansionCache();
     mAttributePathPool.ReleaseAll();
     mEventPathPool.ReleaseAll();
     mDataVersionFilterPool.ReleaseAll();
@@ -1925,6 +1930,7 @@ CHIP_ERROR InteractionModelEngine::ResumeSubscriptions()
     // to do for now because it's both simple and avoids the timer resource and multiple-wake problems. This issue is to track
     // future improvements: https://github.com/project-chip/connectedhomeip/issues/25439
 
+    MATTER_LOG_METRIC_BEGIN(Tracing::kMetricIMSubscriptionResumptionLoad);
     SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
     auto * iterator             = mpSubscriptionResumptionStorage->IterateSubscriptions();
     mNumOfSubscriptionsToResume = 0;
@@ -1935,6 +1941,7 @@ CHIP_ERROR InteractionModelEngine::ResumeSubscriptions()
         minInterval = std::max(minInterval, subscriptionInfo.mMinInterval);
     }
     iterator->Release();
+    MATTER_LOG_METRIC_END(Tracing::kMetricIMSubscriptionResumptionLoad);
 
     if (mNumOfSubscriptionsToResume)
     {
@@ -1982,25 +1989,36 @@ void InteractionModelEngine::ResumeSubscriptionsTimerCallback(System::Layer * ap
             continue;
         }
 
+        // The previous resumption of the subscription is still going on.
+        if (imEngine->IsSubscriptionResumptionQueued(subscriptionInfo))
+        {
+            ChipLogProgress(InteractionModel, "Skip resuming queued subscriptionId %" PRIu32, subscriptionInfo.mSubscriptionId);
+#if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
+            resumedSubscriptions = true;
+#endif // CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
+            continue;
+        }
+
         auto subscriptionResumptionSessionEstablisher = Platform::MakeUnique<SubscriptionResumptionSessionEstablisher>();
         if (subscriptionResumptionSessionEstablisher == nullptr)
         {
             ChipLogProgress(InteractionModel, "Failed to create SubscriptionResumptionSessionEstablisher");
-            return;
+            break;
         }
 
-        if (subscriptionResumptionSessionEstablisher->ResumeSubscription(*imEngine->mpCASESessionMgr, subscriptionInfo) !=
-            CHIP_NO_ERROR)
+        if (subscriptionResumptionSessionEstablisher->SetSubscriptionInfo(subscriptionInfo) != CHIP_NO_ERROR)
         {
             ChipLogProgress(InteractionModel, "Failed to ResumeSubscription 0x%" PRIx32, subscriptionInfo.mSubscriptionId);
-            return;
+            break;
         }
-        subscriptionResumptionSessionEstablisher.release();
+        imEngine->QueueSubscriptionResumption(subscriptionResumptionSessionEstablisher.release());
 #if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
         resumedSubscriptions = true;
 #endif // CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
     }
 
+    imEngine->StartQueuedSubscriptionResumptions();
+
 #if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
     // If no persisted subscriptions needed resumption then all resumption retries are done
     if (!resumedSubscriptions)
@@ -2080,6 +2098,114 @@ void InteractionModelEngine::DecrementNumSubscriptionsToResume()
     }
 #endif // CHIP_CONFIG_ENABLE_ICD_CIP && !CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
 }
+
+void InteractionModelEngine::QueueSubscriptionResumption(SubscriptionResumptionSessionEstablisher * establisher)
+{
+    if (mpSubscriptionResumptionQueue == nullptr)
+    {
+        mNumSubscriptionResumptionsQueued = 0;
+        mSubscriptionResumptionStartTime  = System::SystemClock().GetMonotonicTimestamp();
+        MATTER_LOG_METRIC_BEGIN(Tracing::kMetricIMSubscriptionResumption);
+    }
+    mNumSubscriptionResumptionsQueued++;
+
+    // Append, so that the subscriptions are resumed in the order of the storage.
+    SubscriptionResumptionSessionEstablisher ** link = &mpSubscriptionResumptionQueue;
+    while (*link != nullptr)
+    {
+        link = &(*link)->mpNext;
+    }
+    establisher->mpNext = nullptr;
+    *link               = establisher;
+}
+
+bool InteractionModelEngine::IsSubscriptionResumptionQueued(
+    const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo) const
+{
+    for (auto * establisher = mpSubscriptionResumptionQueue; establisher != nullptr; establisher = establisher->mpNext)
+    {
+        const auto & queuedInfo = establisher->mSubscriptionInfo;
+        if (queuedInfo.mSubscriptionId == subscriptionInfo.mSubscriptionId && queuedInfo.mNodeId == subscriptionInfo.mNodeId &&
+            queuedInfo.mFabricIndex == subscriptionInfo.mFabricIndex)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void InteractionModelEngine::StartQueuedSubscriptionResumptions()
+{
+    VerifyOrReturn(mpCASESessionMgr != nullptr);
+
+    while (true)
+    {
+        // The queue is walked again after each session establishment is started, as the establisher is done, and removed from
+        // the queue, by the time EstablishSession() returns if the session is already there.
+        size_t numInProgress                                = 0;
+        SubscriptionResumptionSessionEstablisher * toStart = nullptr;
+        for (auto * establisher = mpSubscriptionResumptionQueue; establisher != nullptr; establisher = establisher->mpNext)
+        {
+            if (establisher->mSessionEstablishmentStarted)
+            {
+                numInProgress++;
+            }
+            else if (toStart == nullptr)
+            {
+                toStart = establisher;
+            }
+        }
+
+        VerifyOrReturn(toStart != nullptr && numInProgress < CHIP_CONFIG_MAX_CONCURRENT_SUBSCRIPTION_RESUMPTIONS);
+        toStart->EstablishSession(*mpCASESessionMgr);
+    }
+}
+
+void InteractionModelEngine::StartQueuedSubscriptionResumptionsCallback(System::Layer * apSystemLayer, void * apAppState)
+{
+    VerifyOrReturn(apAppState != nullptr);
+    static_cast<InteractionModelEngine *>(apAppState)->StartQueuedSubscriptionResumptions();
+}
+
+void InteractionModelEngine::OnSubscriptionResumptionSessionDone(SubscriptionResumptionSessionEstablisher & establisher)
+{
+    SubscriptionResumptionSessionEstablisher ** link = &mpSubscriptionResumptionQueue;
+    while (*link != nullptr && *link != &establisher)
+    {
+        link = &(*link)->mpNext;
+    }
+    // Establishers created with ResumeSubscription() are not queued.
+    VerifyOrReturn(*link != nullptr);
+    *link              = establisher.mpNext;
+    establisher.mpNext = nullptr;
+
+    if (mpSubscriptionResumptionQueue == nullptr)
+    {
+        MATTER_LOG_METRIC_END(Tracing::kMetricIMSubscriptionResumption);
+        const System::Clock::Milliseconds64 elapsed =
+            System::SystemClock().GetMonotonicTimestamp() - mSubscriptionResumptionStartTime;
+        ChipLogProgress(InteractionModel, "Processed the resumption of %u subscriptions in %" PRIu64 " ms",
+                        mNumSubscriptionResumptionsQueued, static_cast<uint64_t>(elapsed.count()));
+        return;
+    }
+
+    // Not from within the callback of the session establishment of the establisher.
+    mpExchangeMgr->GetSessionManager()->SystemLayer()->StartTimer(System::Clock::kZero, StartQueuedSubscriptionResumptionsCallback,
+                                                                  this);
+}
+
+void InteractionModelEngine::ReleaseQueuedSubscriptionResumptions()
+{
+    mpExchangeMgr->GetSessionManager()->SystemLayer()->CancelTimer(StartQueuedSubscriptionResumptionsCallback, this);
+
+    // Deleting an establisher cancels the callbacks of its session establishment.
+    while (mpSubscriptionResumptionQueue != nullptr)
+    {
+        auto * establisher            = mpSubscriptionResumptionQueue;
+        mpSubscriptionResumptionQueue = establisher->mpNext;
+        Platform::Delete(establisher);
+    }
+}
 #endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
 
 } // namespace app
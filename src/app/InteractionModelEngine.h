@@ -329,6 +329,12 @@ public:
      *        was succesful or not.
      */
     void DecrementNumSubscriptionsToResume();
+
+    /**
+     * @brief Called by a SubscriptionResumptionSessionEstablisher once its session was established or failed to, before it is
+     *        destroyed, so that the next queued subscription can start its resumption.
+     */
+    void OnSubscriptionResumptionSessionDone(SubscriptionResumptionSessionEstablisher & establisher);
 #endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
 
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
@@ -607,6 +613,18 @@ private:
 
     static void ResumeSubscriptionsTimerCallback(System::Layer * apSystemLayer, void * apAppState);
 
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    /**
+     * The subscriptions to resume are queued, and at most CHIP_CONFIG_MAX_CONCURRENT_SUBSCRIPTION_RESUMPTIONS of them establish
+     * their session at once, so that resuming many subscriptions does not start as many CASE sessions at the same time.
+     */
+    void QueueSubscriptionResumption(SubscriptionResumptionSessionEstablisher * establisher);
+    bool IsSubscriptionResumptionQueued(const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo) const;
+    void StartQueuedSubscriptionResumptions();
+    void ReleaseQueuedSubscriptionResumptions();
+    static void StartQueuedSubscriptionResumptionsCallback(System::Layer * apSystemLayer, void * apAppState);
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+
     template <typename T, size_t N>
     void ReleasePool(SingleLinkedListNode<T> *& aObjectList, ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool);
     template <typename T, size_t N>
@@ -686,6 +704,12 @@ private:
      * by ComputeTimeSecondsTillNextSubscriptionResumption.
      */
     int8_t mNumOfSubscriptionsToResume = 0;
+
+    // Subscriptions being resumed, in the order they are resumed, whether their session establishment started or not.
+    SubscriptionResumptionSessionEstablisher * mpSubscriptionResumptionQueue = nullptr;
+    // Number of subscriptions, and start time, of the resumptions that are still being processed.
+    uint16_t mNumSubscriptionResumptionsQueued                = 0;
+    System::Clock::Timestamp mSubscriptionResumptionStartTime = System::Clock::kZero;
 #if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
     bool HasSubscriptionsToResume();
     uint32_t ComputeTimeSecondsTillNextSubscriptionResumption();
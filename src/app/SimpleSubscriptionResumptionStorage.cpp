@@ -153,6 +153,11 @@ CHIP_ERROR SimpleSubscriptionResumptionStorage::Load(uint16_t subscriptionIndex,
 
     ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag()));
 
+    return Load(reader, subscriptionInfo);
+}
+
+CHIP_ERROR SimpleSubscriptionResumptionStorage::Load(TLV::TLVReader & reader, SubscriptionInfo & subscriptionInfo)
+{
     TLV::TLVType subscriptionContainerType;
     ReturnErrorOnFailure(reader.EnterContainer(subscriptionContainerType));
 
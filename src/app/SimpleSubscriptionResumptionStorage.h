@@ -53,6 +53,8 @@ public:
 protected:
     CHIP_ERROR Save(TLV::TLVWriter & writer, SubscriptionInfo & subscriptionInfo);
     CHIP_ERROR Load(uint16_t subscriptionIndex, SubscriptionInfo & subscriptionInfo);
+    // Loads the subscription structure the reader is positioned on.
+    CHIP_ERROR Load(TLV::TLVReader & reader, SubscriptionInfo & subscriptionInfo);
     CHIP_ERROR Delete(uint16_t subscriptionIndex);
     uint16_t Count();
     CHIP_ERROR DeleteMaxCount();
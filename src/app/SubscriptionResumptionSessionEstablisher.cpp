@@ -43,6 +43,14 @@ SubscriptionResumptionSessionEstablisher::SubscriptionResumptionSessionEstablish
 CHIP_ERROR
 SubscriptionResumptionSessionEstablisher::ResumeSubscription(
     CASESessionManager & caseSessionManager, const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo)
+{
+    ReturnErrorOnFailure(SetSubscriptionInfo(subscriptionInfo));
+    EstablishSession(caseSessionManager);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR SubscriptionResumptionSessionEstablisher::SetSubscriptionInfo(
+    const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo)
 {
     mSubscriptionInfo.mNodeId         = subscriptionInfo.mNodeId;
     mSubscriptionInfo.mFabricIndex    = subscriptionInfo.mFabricIndex;
@@ -78,10 +86,15 @@ SubscriptionResumptionSessionEstablisher::ResumeSubscription(
             mSubscriptionInfo.mEventPaths[i] = subscriptionInfo.mEventPaths[i];
         }
     }
+    return CHIP_NO_ERROR;
+}
+
+void SubscriptionResumptionSessionEstablisher::EstablishSession(CASESessionManager & caseSessionManager)
+{
+    mSessionEstablishmentStarted = true;
 
     ScopedNodeId peerNode = ScopedNodeId(mSubscriptionInfo.mNodeId, mSubscriptionInfo.mFabricIndex);
     caseSessionManager.FindOrEstablishSession(peerNode, &mOnConnectedCallback, &mOnConnectionFailureCallback);
-    return CHIP_NO_ERROR;
 }
 
 void SubscriptionResumptionSessionEstablisher::HandleDeviceConnected(void * context, Messaging::ExchangeManager & exchangeMgr,
@@ -91,6 +104,9 @@ void SubscriptionResumptionSessionEstablisher::HandleDeviceConnected(void * cont
     SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo = establisher->mSubscriptionInfo;
     InteractionModelEngine * imEngine                                  = InteractionModelEngine::GetInstance();
 
+    // Lets the next queued subscription start its resumption.
+    imEngine->OnSubscriptionResumptionSessionDone(*establisher);
+
     // Decrement the number of subscriptions to resume since we have completed our retry attempt for a given subscription.
     // We do this before the readHandler creation since we do not care if the subscription has successfully been resumed or
     // not. Counter only tracks the number of individual subscriptions we will try to resume.
@@ -131,6 +147,8 @@ void SubscriptionResumptionSessionEstablisher::HandleDeviceConnectionFailure(voi
     ChipLogError(DataManagement, "Failed to establish CASE for subscription-resumption with error '%" CHIP_ERROR_FORMAT "'",
                  error.Format());
 
+    imEngine->OnSubscriptionResumptionSessionDone(*establisher);
+
     // Decrement the number of subscriptions to resume since we have completed our retry attempt for a given subscription.
     // We do this here since we were not able to connect to the subscriber thus we have completed our resumption attempt.
     // Counter only tracks the number of individual subscriptions we will try to resume.
@@ -39,9 +39,20 @@ public:
     CHIP_ERROR ResumeSubscription(CASESessionManager & caseSessionManager,
                                   const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo);
 
+    /**
+     * Copies the subscription to resume, so that the session can be established later with EstablishSession(). This lets
+     * the InteractionModelEngine queue the resumptions and only establish a bounded number of sessions at once.
+     */
+    CHIP_ERROR SetSubscriptionInfo(const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo);
+
+    void EstablishSession(CASESessionManager & caseSessionManager);
+
     SubscriptionResumptionStorage::SubscriptionInfo mSubscriptionInfo;
 
 private:
+    friend class InteractionModelEngine;
+    friend class TestInteractionModelEngine;
+
     // Callback funstions for continuing the subscription resumption
     static void HandleDeviceConnected(void * context, Messaging::ExchangeManager & exchangeMgr,
                                       const SessionHandle & sessionHandle);
@@ -50,6 +61,10 @@ private:
     // Callbacks to handle server-initiated session success/failure
     chip::Callback::Callback<OnDeviceConnected> mOnConnectedCallback;
     chip::Callback::Callback<OnDeviceConnectionFailure> mOnConnectionFailureCallback;
+
+    // Links the establishers queued by the InteractionModelEngine.
+    SubscriptionResumptionSessionEstablisher * mpNext = nullptr;
+    bool mSessionEstablishmentStarted                 = false;
 };
 } // namespace app
 } // namespace chip
@@ -0,0 +1,224 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/WriteBehindAttributePersistenceProvider.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceLayer.h>
+
+#include <string.h>
+
+namespace chip {
+namespace app {
+
+WriteBehindAttributePersistenceProvider::~WriteBehindAttributePersistenceProvider()
+{
+    DeviceLayer::SystemLayer().CancelTimer(OnFlushTimer, this);
+}
+
+CHIP_ERROR WriteBehindAttributePersistenceProvider::WriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue)
+{
+    return BufferWrite(KeySpace::kAttribute, aPath, aValue);
+}
+
+CHIP_ERROR WriteBehindAttributePersistenceProvider::ReadValue(const ConcreteAttributePath & aPath,
+                                                              const EmberAfAttributeMetadata * aMetadata, MutableByteSpan & aValue)
+{
+    const PendingWrite * write = FindPendingWrite(KeySpace::kAttribute, aPath);
+    if (write != nullptr)
+    {
+        return CopySpanToMutableSpan(write->Value(), aValue);
+    }
+    return mPersister.ReadValue(aPath, aMetadata, aValue);
+}
+
+CHIP_ERROR WriteBehindAttributePersistenceProvider::SafeWriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue)
+{
+    return BufferWrite(KeySpace::kSafeAttribute, aPath, aValue);
+}
+
+CHIP_ERROR WriteBehindAttributePersistenceProvider::SafeReadValue(const ConcreteAttributePath & aPath, MutableByteSpan & aValue)
+{
+    const PendingWrite * write = FindPendingWrite(KeySpace::kSafeAttribute, aPath);
+    if (write != nullptr)
+    {
+        return CopySpanToMutableSpan(write->Value(), aValue);
+    }
+    return mPersister.SafeReadValue(aPath, aValue);
+}
+
+CHIP_ERROR WriteBehindAttributePersistenceProvider::Flush()
+{
+    CHIP_ERROR firstError = CHIP_NO_ERROR;
+
+    DeviceLayer::SystemLayer().CancelTimer(OnFlushTimer, this);
+
+    for (PendingWrite & write : mPendingWrites)
+    {
+        if (!write.IsPending())
+        {
+            continue;
+        }
+
+        CHIP_ERROR err = PersistValue(write.mKeySpace, write.mPath, write.Value());
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DataManagement, "Failed to persist attribute " ChipLogFormatMEI " of cluster " ChipLogFormatMEI
+                                         " on endpoint %u: %" CHIP_ERROR_FORMAT,
+                         ChipLogValueMEI(write.mPath.mAttributeId), ChipLogValueMEI(write.mPath.mClusterId),
+                         write.mPath.mEndpointId, err.Format());
+            if (firstError == CHIP_NO_ERROR)
+            {
+                firstError = err;
+            }
+            continue;
+        }
+
+        write.mValue.Free();
+    }
+
+    if (HasPendingWrites())
+    {
+        // Retry the writes that failed at the end of the next window.
+        DeviceLayer::SystemLayer().StartTimer(mFlushWindow, OnFlushTimer, this);
+    }
+
+    return firstError;
+}
+
+void WriteBehindAttributePersistenceProvider::Discard()
+{
+    DeviceLayer::SystemLayer().CancelTimer(OnFlushTimer, this);
+
+    for (PendingWrite & write : mPendingWrites)
+    {
+        write.mValue.Free();
+    }
+}
+
+bool WriteBehindAttributePersistenceProvider::HasPendingWrites() const
+{
+    for (const PendingWrite & write : mPendingWrites)
+    {
+        if (write.IsPending())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+CHIP_ERROR WriteBehindAttributePersistenceProvider::BufferWrite(KeySpace aKeySpace, const ConcreteAttributePath & aPath,
+                                                                const ByteSpan & aValue)
+{
+    PendingWrite * write = FindPendingWrite(aKeySpace, aPath);
+
+    // An empty value cannot be told apart from the absence of a pending value: it is written through,
+    // and the value it replaces is dropped so that a later flush does not overwrite it.
+    if (aValue.empty())
+    {
+        if (write != nullptr)
+        {
+            write->mValue.Free();
+        }
+        return PersistValue(aKeySpace, aPath, aValue);
+    }
+
+    if (write == nullptr)
+    {
+        write = AllocatePendingWrite();
+        if (write == nullptr)
+        {
+            // Make room by writing everything now, rather than keeping an unbounded number of values in RAM.
+            Flush();
+            write = AllocatePendingWrite();
+        }
+        if (write == nullptr)
+        {
+            // The storage keeps failing: fall back to writing through.
+            return PersistValue(aKeySpace, aPath, aValue);
+        }
+
+        write->mPath     = aPath;
+        write->mKeySpace = aKeySpace;
+    }
+
+    if (write->mValue.AllocatedSize() != aValue.size())
+    {
+        write->mValue.Alloc(aValue.size());
+        if (!write->mValue)
+        {
+            return PersistValue(aKeySpace, aPath, aValue);
+        }
+    }
+    memcpy(write->mValue.Get(), aValue.data(), aValue.size());
+
+    if (!DeviceLayer::SystemLayer().IsTimerActive(OnFlushTimer, this))
+    {
+        CHIP_ERROR err = DeviceLayer::SystemLayer().StartTimer(mFlushWindow, OnFlushTimer, this);
+        if (err != CHIP_NO_ERROR)
+        {
+            // Without a timer the value might never be written.
+            return Flush();
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR WriteBehindAttributePersistenceProvider::PersistValue(KeySpace aKeySpace, const ConcreteAttributePath & aPath,
+                                                                 const ByteSpan & aValue)
+{
+    if (aKeySpace == KeySpace::kSafeAttribute)
+    {
+        return mPersister.SafeWriteValue(aPath, aValue);
+    }
+    return mPersister.WriteValue(aPath, aValue);
+}
+
+WriteBehindAttributePersistenceProvider::PendingWrite *
+WriteBehindAttributePersistenceProvider::FindPendingWrite(KeySpace aKeySpace, const ConcreteAttributePath & aPath)
+{
+    for (PendingWrite & write : mPendingWrites)
+    {
+        if (write.IsPending() && write.mKeySpace == aKeySpace && write.mPath == aPath)
+        {
+            return &write;
+        }
+    }
+    return nullptr;
+}
+
+WriteBehindAttributePersistenceProvider::PendingWrite * WriteBehindAttributePersistenceProvider::AllocatePendingWrite()
+{
+    for (PendingWrite & write : mPendingWrites)
+    {
+        if (!write.IsPending())
+        {
+            return &write;
+        }
+    }
+    return nullptr;
+}
+
+void WriteBehindAttributePersistenceProvider::OnFlushTimer(System::Layer *, void * aAppState)
+{
+    static_cast<WriteBehindAttributePersistenceProvider *>(aAppState)->Flush();
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,109 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/AttributePersistenceProvider.h>
+#include <app/DefaultAttributePersistenceProvider.h>
+#include <app/SafeAttributePersistenceProvider.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/support/ScopedBuffer.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Decorator class for DefaultAttributePersistenceProvider that batches the writes
+ * of all persisted attributes, in both the AttributePersistenceProvider and the
+ * SafeAttributePersistenceProvider key spaces.
+ *
+ * Written values are kept in RAM, and all of them are written to storage at the
+ * end of a flush window that starts with the first write following the previous
+ * flush. An attribute that changes several times within a window is only written
+ * once, with its last value. Unlike DeferredAttributePersistenceProvider, which
+ * waits for an attribute to stop changing, an attribute that keeps changing (such
+ * as an energy counter) is still written once per window.
+ *
+ * Reads return the pending value of an attribute, if any. Pending values are lost
+ * if the device loses power: Flush() must be called before a controlled shutdown.
+ */
+class WriteBehindAttributePersistenceProvider : public AttributePersistenceProvider, public SafeAttributePersistenceProvider
+{
+public:
+    WriteBehindAttributePersistenceProvider(DefaultAttributePersistenceProvider & persister,
+                                            System::Clock::Milliseconds32 flushWindow) :
+        mPersister(persister),
+        mFlushWindow(flushWindow)
+    {}
+    ~WriteBehindAttributePersistenceProvider() override;
+
+    // AttributePersistenceProvider implementation.
+    CHIP_ERROR WriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue) override;
+    CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
+                         MutableByteSpan & aValue) override;
+
+    // SafeAttributePersistenceProvider implementation.
+    CHIP_ERROR SafeWriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue) override;
+    CHIP_ERROR SafeReadValue(const ConcreteAttributePath & aPath, MutableByteSpan & aValue) override;
+
+    /*
+     * Write all the pending values to storage now. Values that could not be written
+     * remain pending and are retried at the next flush.
+     *
+     * Returns the first error encountered, if any.
+     */
+    CHIP_ERROR Flush();
+
+    /*
+     * Drop the pending values without writing them, for instance because the storage
+     * is about to be erased.
+     */
+    void Discard();
+
+    bool HasPendingWrites() const;
+
+private:
+    enum class KeySpace : uint8_t
+    {
+        kAttribute,
+        kSafeAttribute,
+    };
+
+    struct PendingWrite
+    {
+        bool IsPending() const { return static_cast<bool>(mValue); }
+        ByteSpan Value() const { return ByteSpan(mValue.Get(), mValue.AllocatedSize()); }
+
+        ConcreteAttributePath mPath;
+        KeySpace mKeySpace = KeySpace::kAttribute;
+        Platform::ScopedMemoryBufferWithSize<uint8_t> mValue;
+    };
+
+    CHIP_ERROR BufferWrite(KeySpace aKeySpace, const ConcreteAttributePath & aPath, const ByteSpan & aValue);
+    CHIP_ERROR PersistValue(KeySpace aKeySpace, const ConcreteAttributePath & aPath, const ByteSpan & aValue);
+    PendingWrite * FindPendingWrite(KeySpace aKeySpace, const ConcreteAttributePath & aPath);
+    PendingWrite * AllocatePendingWrite();
+
+    static void OnFlushTimer(System::Layer * aLayer, void * aAppState);
+
+    DefaultAttributePersistenceProvider & mPersister;
+    const System::Clock::Milliseconds32 mFlushWindow;
+    PendingWrite mPendingWrites[CHIP_CONFIG_MAX_PENDING_ATTRIBUTE_WRITES];
+};
+
+} // namespace app
+} // namespace chip
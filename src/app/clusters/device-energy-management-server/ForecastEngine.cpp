@@ -0,0 +1,261 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "ForecastEngine.h"
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace DeviceEnergyManagement {
+
+namespace {
+
+constexpr int64_t kSecondsPerHour = 3600;
+constexpr int64_t kNoPowerLimit   = std::numeric_limits<int64_t>::max();
+
+uint64_t EndTime(const ForecastEngine::Constraint & constraint)
+{
+    return static_cast<uint64_t>(constraint.startTime) + constraint.duration;
+}
+
+/**
+ * Power limit (mW) imposed by a constraint: its nominal power, and the
+ * average power that would use up its maximum energy over its duration.
+ */
+int64_t PowerLimit(const ForecastEngine::Constraint & constraint)
+{
+    int64_t limit = kNoPowerLimit;
+    if (constraint.nominalPower.HasValue())
+    {
+        limit = constraint.nominalPower.Value();
+    }
+    if (constraint.maximumEnergy.HasValue() && constraint.duration > 0)
+    {
+        int64_t energy = std::min(constraint.maximumEnergy.Value(), kNoPowerLimit / kSecondsPerHour);
+        limit          = std::min(limit, energy * kSecondsPerHour / static_cast<int64_t>(constraint.duration));
+    }
+    return limit;
+}
+
+/**
+ * Power the slot is expected to run at: its nominal power, or its maximum
+ * power if it has no nominal power.
+ */
+Optional<int64_t> ExpectedPower(const ForecastEngine::Slot & slot)
+{
+    return slot.nominalPower.HasValue() ? slot.nominalPower : slot.maxPower;
+}
+
+} // namespace
+
+CHIP_ERROR
+ForecastEngine::DecodeConstraints(const DataModel::DecodableList<Structs::ConstraintsStruct::DecodableType> & constraints,
+                                  Span<Constraint> buffer, size_t & count)
+{
+    count = 0;
+
+    auto iter = constraints.begin();
+    while (iter.Next())
+    {
+        VerifyOrReturnError(count < buffer.size(), CHIP_ERROR_BUFFER_TOO_SMALL);
+        buffer[count++] = iter.GetValue();
+    }
+    ReturnErrorOnFailure(iter.GetStatus());
+
+    // Constraints are normally sent in order already, making this a linear pass.
+    std::stable_sort(buffer.data(), buffer.data() + count,
+                     [](const Constraint & a, const Constraint & b) { return a.startTime < b.startTime; });
+
+    for (size_t i = 1; i < count; i++)
+    {
+        VerifyOrReturnError(EndTime(buffer[i - 1]) <= buffer[i].startTime, CHIP_ERROR_INVALID_ARGUMENT);
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ForecastEngine::ApplyConstraints(uint32_t startTime, Span<const Slot> slots, Span<const Constraint> constraints,
+                                            Span<Slot> output, size_t & count)
+{
+    count = 0;
+
+    size_t constraintIndex = 0;
+    uint64_t slotStart     = startTime;
+
+    for (size_t slotIndex = 0; slotIndex < slots.size(); slotIndex++)
+    {
+        const Slot & slot        = slots[slotIndex];
+        const uint64_t slotEnd   = slotStart + slot.defaultDuration;
+        const size_t firstOutput = count;
+
+        uint64_t segmentStart = slotStart;
+        do
+        {
+            // Skip the constraints that ended before this segment.
+            while (constraintIndex < constraints.size() && EndTime(constraints[constraintIndex]) <= segmentStart)
+            {
+                constraintIndex++;
+            }
+
+            // The segment lasts until the slot ends or the next constraint boundary, whichever comes first.
+            uint64_t segmentEnd = slotEnd;
+            int64_t powerLimit  = kNoPowerLimit;
+            if (constraintIndex < constraints.size())
+            {
+                const Constraint & constraint = constraints[constraintIndex];
+                if (constraint.startTime <= segmentStart)
+                {
+                    segmentEnd = std::min(segmentEnd, EndTime(constraint));
+                    powerLimit = PowerLimit(constraint);
+                }
+                else
+                {
+                    segmentEnd = std::min<uint64_t>(segmentEnd, constraint.startTime);
+                }
+            }
+
+            Optional<int64_t> power = ExpectedPower(slot);
+            if (power.HasValue() && power.Value() > powerLimit)
+            {
+                if (slot.minPower.HasValue() && slot.minPower.Value() > powerLimit)
+                {
+                    ChipLogError(Zcl, "DEM: slot %u cannot run below %" PRId64 " mW", static_cast<unsigned>(slotIndex),
+                                 slot.minPower.Value());
+                    return CHIP_ERROR_INCORRECT_STATE;
+                }
+                power.SetValue(powerLimit);
+            }
+
+            const uint32_t segmentDuration = static_cast<uint32_t>(segmentEnd - segmentStart);
+
+            Slot segment = slot;
+            if (slot.nominalPower.HasValue())
+            {
+                segment.nominalPower = power;
+            }
+            // The slot may not run above the limit either, whatever its nominal power.
+            if (slot.maxPower.HasValue())
+            {
+                segment.maxPower.SetValue(std::min(slot.maxPower.Value(), powerLimit));
+            }
+            segment.defaultDuration = segmentDuration;
+
+            // Consecutive segments of a slot running at the same power stay one slot.
+            if (count > firstOutput && ExpectedPower(output[count - 1]) == power && output[count - 1].maxPower == segment.maxPower)
+            {
+                output[count - 1].defaultDuration += segmentDuration;
+            }
+            else
+            {
+                VerifyOrReturnError(count < output.size(), CHIP_ERROR_BUFFER_TOO_SMALL);
+                output[count++] = segment;
+            }
+
+            segmentStart = segmentEnd;
+        } while (segmentStart < slotEnd);
+
+        // Split slots get durations and energies of their own.
+        if (count - firstOutput > 1 || output[firstOutput].defaultDuration != slot.defaultDuration ||
+            ExpectedPower(output[firstOutput]) != ExpectedPower(slot))
+        {
+            uint32_t remaining = slot.remainingSlotTime;
+            uint32_t elapsed   = slot.elapsedSlotTime;
+            for (size_t i = firstOutput; i < count; i++)
+            {
+                Slot & segment = output[i];
+                if (count - firstOutput > 1)
+                {
+                    segment.minDuration       = std::min(segment.minDuration, segment.defaultDuration);
+                    segment.maxDuration       = std::max(segment.maxDuration, segment.defaultDuration);
+                    segment.elapsedSlotTime   = std::min(elapsed, segment.defaultDuration);
+                    segment.remainingSlotTime = std::min(remaining, segment.defaultDuration - segment.elapsedSlotTime);
+                    elapsed -= segment.elapsedSlotTime;
+                    remaining -= segment.remainingSlotTime;
+                }
+                if (segment.nominalEnergy.HasValue() && ExpectedPower(segment).HasValue())
+                {
+                    segment.nominalEnergy.SetValue(ExpectedPower(segment).Value() * segment.defaultDuration / kSecondsPerHour);
+                }
+            }
+        }
+
+        slotStart = slotEnd;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR
+ForecastEngine::ApplySlotAdjustments(const DataModel::DecodableList<Structs::SlotAdjustmentStruct::DecodableType> & adjustments,
+                                     Span<Slot> slots)
+{
+    // Validate everything first, so that a rejected request leaves the forecast untouched.
+    auto check = adjustments.begin();
+    while (check.Next())
+    {
+        const SlotAdjustment & adjustment = check.GetValue();
+        VerifyOrReturnError(adjustment.slotIndex < slots.size(), CHIP_ERROR_INVALID_ARGUMENT);
+
+        const Slot & slot = slots[adjustment.slotIndex];
+        VerifyOrReturnError(slot.minPowerAdjustment.HasValue() && slot.maxPowerAdjustment.HasValue() &&
+                                slot.minDurationAdjustment.HasValue() && slot.maxDurationAdjustment.HasValue(),
+                            CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(adjustment.nominalPower >= slot.minPowerAdjustment.Value() &&
+                                adjustment.nominalPower <= slot.maxPowerAdjustment.Value(),
+                            CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(adjustment.duration >= slot.minDurationAdjustment.Value() &&
+                                adjustment.duration <= slot.maxDurationAdjustment.Value(),
+                            CHIP_ERROR_INVALID_ARGUMENT);
+    }
+    ReturnErrorOnFailure(check.GetStatus());
+
+    auto iter = adjustments.begin();
+    while (iter.Next())
+    {
+        const SlotAdjustment & adjustment = iter.GetValue();
+        Slot & slot                       = slots[adjustment.slotIndex];
+
+        slot.nominalPower.SetValue(adjustment.nominalPower);
+        slot.defaultDuration = adjustment.duration;
+        if (slot.nominalEnergy.HasValue())
+        {
+            slot.nominalEnergy.SetValue(adjustment.nominalPower * adjustment.duration / kSecondsPerHour);
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
+uint32_t ForecastEngine::GetDuration(Span<const Slot> slots)
+{
+    uint32_t duration = 0;
+    for (const auto & slot : slots)
+    {
+        duration += slot.defaultDuration;
+    }
+    return duration;
+}
+
+} // namespace DeviceEnergyManagement
+} // namespace Clusters
+} // namespace app
+} // namespace chip
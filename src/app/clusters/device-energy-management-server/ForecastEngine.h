@@ -0,0 +1,100 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app-common/zap-generated/cluster-objects.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/Span.h>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace DeviceEnergyManagement {
+
+/**
+ * @brief Computes revised power forecasts for the ForecastAdjustment and
+ *        ConstraintBasedAdjustment features.
+ *
+ * The engine only operates on caller-provided slot arrays, so that delegates
+ * keep control over how many slots they support and where they are stored.
+ * Slots are laid out back to back from the forecast start time, each lasting
+ * its defaultDuration.
+ */
+class ForecastEngine
+{
+public:
+    using Slot           = Structs::SlotStruct::Type;
+    using Constraint     = Structs::ConstraintsStruct::Type;
+    using SlotAdjustment = Structs::SlotAdjustmentStruct::Type;
+
+    /**
+     * @brief Decodes the constraints of a RequestConstraintBasedForecast command into `buffer`,
+     *        sorted by start time.
+     *
+     * @param[out] count  Number of constraints written to `buffer`
+     *
+     * @return CHIP_ERROR_INVALID_ARGUMENT if constraints overlap, CHIP_ERROR_BUFFER_TOO_SMALL if
+     *         `buffer` cannot hold all of them, or a decoding error.
+     */
+    static CHIP_ERROR DecodeConstraints(const DataModel::DecodableList<Structs::ConstraintsStruct::DecodableType> & constraints,
+                                        Span<Constraint> buffer, size_t & count);
+
+    /**
+     * @brief Computes a forecast that satisfies the power and energy limits of `constraints`.
+     *
+     * The slots and constraints are swept once, in time order. Slots crossing
+     * a constraint boundary are split, so that each resulting slot is subject
+     * to at most one constraint, and the nominal and maximum power of slots
+     * exceeding the limit of their constraint are reduced to that limit. Slot
+     * durations, and hence the forecast end time, are not changed.
+     *
+     * @param startTime    Start time of the forecast (Matter epoch seconds)
+     * @param slots        Current forecast slots
+     * @param constraints  Constraints sorted by start time, not overlapping (see DecodeConstraints)
+     * @param output       Buffer for the revised slots; must not overlap `slots`
+     * @param[out] count   Number of slots written to `output`
+     *
+     * @return CHIP_ERROR_INCORRECT_STATE if a constraint would require a slot to run
+     *         below its minimum power, CHIP_ERROR_BUFFER_TOO_SMALL if `output` cannot
+     *         hold the revised forecast.
+     */
+    static CHIP_ERROR ApplyConstraints(uint32_t startTime, Span<const Slot> slots, Span<const Constraint> constraints,
+                                       Span<Slot> output, size_t & count);
+
+    /**
+     * @brief Applies the slot adjustments of a ModifyForecastRequest command to `slots`.
+     *
+     * Either all adjustments are applied, or none of them: CHIP_ERROR_INVALID_ARGUMENT is
+     * returned if an adjustment refers to an unknown slot, to a slot that cannot be adjusted,
+     * or is outside of the adjustment limits of the slot.
+     */
+    static CHIP_ERROR
+    ApplySlotAdjustments(const DataModel::DecodableList<Structs::SlotAdjustmentStruct::DecodableType> & adjustments,
+                         Span<Slot> slots);
+
+    /**
+     * @brief Returns the total duration of `slots`, in seconds.
+     */
+    static uint32_t GetDuration(Span<const Slot> slots);
+};
+
+} // namespace DeviceEnergyManagement
+} // namespace Clusters
+} // namespace app
+} // namespace chip
@@ -0,0 +1,277 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "ForecastStore.h"
+
+#include <app-common/zap-generated/attribute-type.h>
+#include <app/data-model/Decode.h>
+#include <app/data-model/Encode.h>
+#include <app/data-model/WrappedStructEncoder.h>
+#include <lib/core/CHIPEncoding.h>
+#include <lib/core/TLV.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/SafeInt.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/TypeTraits.h>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace DeviceEnergyManagement {
+
+namespace {
+
+// Records are long octet strings: a little-endian length, followed by the TLV encoding of the value.
+constexpr size_t kLengthPrefixSize = 2;
+
+constexpr size_t kSlotMaxSerializedSize = TLV::EstimateStructOverhead(
+    sizeof(uint32_t), sizeof(uint32_t), sizeof(uint32_t), sizeof(uint32_t), sizeof(uint32_t), sizeof(bool), sizeof(uint32_t),
+    sizeof(uint32_t), sizeof(uint16_t), sizeof(int64_t), sizeof(int64_t), sizeof(int64_t), sizeof(int64_t), sizeof(int64_t),
+    sizeof(int64_t), sizeof(uint32_t), sizeof(uint32_t));
+constexpr size_t kPowerAdjustmentMaxSerializedSize =
+    TLV::EstimateStructOverhead(sizeof(int64_t), sizeof(int64_t), sizeof(uint32_t), sizeof(uint32_t));
+
+constexpr size_t ForecastMaxSerializedSize(size_t slotCount)
+{
+    return TLV::EstimateStructOverhead(sizeof(uint16_t), sizeof(uint16_t), sizeof(uint32_t), sizeof(uint32_t), sizeof(uint32_t),
+                                       sizeof(uint32_t), sizeof(bool),
+                                       kSlotMaxSerializedSize * slotCount + TLV::EstimateStructOverhead(), sizeof(uint8_t));
+}
+
+constexpr size_t PowerAdjustmentCapabilityMaxSerializedSize(size_t count)
+{
+    return kPowerAdjustmentMaxSerializedSize * count + TLV::EstimateStructOverhead();
+}
+
+ConcreteAttributePath ForecastPath(EndpointId endpoint)
+{
+    return ConcreteAttributePath(endpoint, DeviceEnergyManagement::Id, Attributes::Forecast::Id);
+}
+
+ConcreteAttributePath PowerAdjustmentCapabilityPath(EndpointId endpoint)
+{
+    return ConcreteAttributePath(endpoint, DeviceEnergyManagement::Id, Attributes::PowerAdjustmentCapability::Id);
+}
+
+template <typename T>
+CHIP_ERROR WriteRecord(AttributePersistenceProvider & provider, const ConcreteAttributePath & path, const T & value,
+                       size_t maxSize)
+{
+    VerifyOrReturnError(CanCastTo<uint16_t>(kLengthPrefixSize + maxSize), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    Platform::ScopedMemoryBuffer<uint8_t> buffer;
+    VerifyOrReturnError(buffer.Alloc(kLengthPrefixSize + maxSize), CHIP_ERROR_NO_MEMORY);
+
+    TLV::TLVWriter writer;
+    writer.Init(buffer.Get() + kLengthPrefixSize, maxSize);
+    ReturnErrorOnFailure(DataModel::Encode(writer, TLV::AnonymousTag(), value));
+
+    const uint16_t length = static_cast<uint16_t>(writer.GetLengthWritten());
+    Encoding::LittleEndian::Put16(buffer.Get(), length);
+    return provider.WriteValue(path, ByteSpan(buffer.Get(), kLengthPrefixSize + length));
+}
+
+/**
+ * Reads a record of at most `maxSize` bytes into `buffer`, and positions `reader` on its value.
+ */
+CHIP_ERROR ReadRecord(AttributePersistenceProvider & provider, const ConcreteAttributePath & path, size_t maxSize,
+                      Platform::ScopedMemoryBuffer<uint8_t> & buffer, TLV::TLVReader & reader)
+{
+    VerifyOrReturnError(CanCastTo<uint16_t>(kLengthPrefixSize + maxSize), CHIP_ERROR_BUFFER_TOO_SMALL);
+    VerifyOrReturnError(buffer.Alloc(kLengthPrefixSize + maxSize), CHIP_ERROR_NO_MEMORY);
+
+    EmberAfAttributeMetadata metadata = { .defaultValue  = EmberAfDefaultOrMinMaxAttributeValue(uint32_t(0)),
+                                          .attributeId   = path.mAttributeId,
+                                          .size          = static_cast<uint16_t>(kLengthPrefixSize + maxSize),
+                                          .attributeType = ZCL_LONG_OCTET_STRING_ATTRIBUTE_TYPE,
+                                          .mask          = 0 };
+    MutableByteSpan record(buffer.Get(), kLengthPrefixSize + maxSize);
+    ReturnErrorOnFailure(provider.ReadValue(path, &metadata, record));
+    VerifyOrReturnError(record.size() >= kLengthPrefixSize, CHIP_ERROR_INCORRECT_STATE);
+
+    const uint16_t length = Encoding::LittleEndian::Get16(buffer.Get());
+    VerifyOrReturnError(length <= record.size() - kLengthPrefixSize, CHIP_ERROR_INCORRECT_STATE);
+
+    reader.Init(buffer.Get() + kLengthPrefixSize, length);
+    return reader.Next();
+}
+
+/**
+ * Encodes slots as a SlotStruct list, leaving their costs out.
+ */
+struct PersistedSlots
+{
+    const DataModel::List<const ForecastStore::Slot> & slots;
+
+    CHIP_ERROR Encode(TLV::TLVWriter & writer, TLV::Tag tag) const
+    {
+        TLV::TLVType outerType;
+        ReturnErrorOnFailure(writer.StartContainer(tag, TLV::kTLVType_Array, outerType));
+        for (const auto & slot : slots)
+        {
+            ForecastStore::Slot persisted = slot;
+            persisted.costs.ClearValue();
+            ReturnErrorOnFailure(persisted.Encode(writer, TLV::AnonymousTag()));
+        }
+        return writer.EndContainer(outerType);
+    }
+};
+
+/**
+ * Encodes a forecast as the Forecast attribute is, except for the slot costs.
+ */
+struct PersistedForecast
+{
+    const ForecastStore::Forecast & forecast;
+
+    CHIP_ERROR Encode(TLV::TLVWriter & writer, TLV::Tag tag) const
+    {
+        using Fields = Structs::ForecastStruct::Fields;
+
+        if (forecast.IsNull())
+        {
+            return writer.PutNull(tag);
+        }
+        const Structs::ForecastStruct::Type & value = forecast.Value();
+
+        DataModel::WrappedStructEncoder encoder{ writer, tag };
+        encoder.Encode(to_underlying(Fields::kForecastId), value.forecastId);
+        encoder.Encode(to_underlying(Fields::kActiveSlotNumber), value.activeSlotNumber);
+        encoder.Encode(to_underlying(Fields::kStartTime), value.startTime);
+        encoder.Encode(to_underlying(Fields::kEndTime), value.endTime);
+        encoder.Encode(to_underlying(Fields::kEarliestStartTime), value.earliestStartTime);
+        encoder.Encode(to_underlying(Fields::kLatestEndTime), value.latestEndTime);
+        encoder.Encode(to_underlying(Fields::kIsPauseable), value.isPauseable);
+        encoder.Encode(to_underlying(Fields::kSlots), PersistedSlots{ value.slots });
+        encoder.Encode(to_underlying(Fields::kForecastUpdateReason), value.forecastUpdateReason);
+        return encoder.Finalize();
+    }
+};
+
+ForecastStore::Slot ToSlot(const Structs::SlotStruct::DecodableType & decoded)
+{
+    ForecastStore::Slot slot;
+    slot.minDuration           = decoded.minDuration;
+    slot.maxDuration           = decoded.maxDuration;
+    slot.defaultDuration       = decoded.defaultDuration;
+    slot.elapsedSlotTime       = decoded.elapsedSlotTime;
+    slot.remainingSlotTime     = decoded.remainingSlotTime;
+    slot.slotIsPauseable       = decoded.slotIsPauseable;
+    slot.minPauseDuration      = decoded.minPauseDuration;
+    slot.maxPauseDuration      = decoded.maxPauseDuration;
+    slot.manufacturerESAState  = decoded.manufacturerESAState;
+    slot.nominalPower          = decoded.nominalPower;
+    slot.minPower              = decoded.minPower;
+    slot.maxPower              = decoded.maxPower;
+    slot.nominalEnergy         = decoded.nominalEnergy;
+    slot.minPowerAdjustment    = decoded.minPowerAdjustment;
+    slot.maxPowerAdjustment    = decoded.maxPowerAdjustment;
+    slot.minDurationAdjustment = decoded.minDurationAdjustment;
+    slot.maxDurationAdjustment = decoded.maxDurationAdjustment;
+    return slot;
+}
+
+} // namespace
+
+CHIP_ERROR ForecastStore::SaveForecast(AttributePersistenceProvider & provider, EndpointId endpoint, const Forecast & forecast)
+{
+    const size_t slotCount = forecast.IsNull() ? 0 : forecast.Value().slots.size();
+    return WriteRecord(provider, ForecastPath(endpoint), PersistedForecast{ forecast }, ForecastMaxSerializedSize(slotCount));
+}
+
+CHIP_ERROR ForecastStore::LoadForecast(AttributePersistenceProvider & provider, EndpointId endpoint, Forecast & forecast,
+                                       Span<Slot> slotBuffer)
+{
+    Platform::ScopedMemoryBuffer<uint8_t> buffer;
+    TLV::TLVReader reader;
+    ReturnErrorOnFailure(
+        ReadRecord(provider, ForecastPath(endpoint), ForecastMaxSerializedSize(slotBuffer.size()), buffer, reader));
+
+    DataModel::Nullable<Structs::ForecastStruct::DecodableType> decoded;
+    ReturnErrorOnFailure(DataModel::Decode(reader, decoded));
+    if (decoded.IsNull())
+    {
+        forecast.SetNull();
+        return CHIP_NO_ERROR;
+    }
+
+    size_t slotCount = 0;
+    auto iter        = decoded.Value().slots.begin();
+    while (iter.Next())
+    {
+        VerifyOrReturnError(slotCount < slotBuffer.size(), CHIP_ERROR_BUFFER_TOO_SMALL);
+        slotBuffer[slotCount++] = ToSlot(iter.GetValue());
+    }
+    ReturnErrorOnFailure(iter.GetStatus());
+
+    Structs::ForecastStruct::Type restored;
+    restored.forecastId           = decoded.Value().forecastId;
+    restored.activeSlotNumber     = decoded.Value().activeSlotNumber;
+    restored.startTime            = decoded.Value().startTime;
+    restored.endTime              = decoded.Value().endTime;
+    restored.earliestStartTime    = decoded.Value().earliestStartTime;
+    restored.latestEndTime        = decoded.Value().latestEndTime;
+    restored.isPauseable          = decoded.Value().isPauseable;
+    restored.slots                = DataModel::List<const Slot>(slotBuffer.data(), slotCount);
+    restored.forecastUpdateReason = decoded.Value().forecastUpdateReason;
+
+    forecast.SetNonNull(restored);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ForecastStore::SavePowerAdjustmentCapability(AttributePersistenceProvider & provider, EndpointId endpoint,
+                                                        const PowerAdjustmentCapability & capability)
+{
+    const size_t count = capability.IsNull() ? 0 : capability.Value().size();
+    return WriteRecord(provider, PowerAdjustmentCapabilityPath(endpoint), capability,
+                       PowerAdjustmentCapabilityMaxSerializedSize(count));
+}
+
+CHIP_ERROR ForecastStore::LoadPowerAdjustmentCapability(AttributePersistenceProvider & provider, EndpointId endpoint,
+                                                        PowerAdjustmentCapability & capability, Span<PowerAdjustment> buffer)
+{
+    Platform::ScopedMemoryBuffer<uint8_t> record;
+    TLV::TLVReader reader;
+    ReturnErrorOnFailure(ReadRecord(provider, PowerAdjustmentCapabilityPath(endpoint),
+                                    PowerAdjustmentCapabilityMaxSerializedSize(buffer.size()), record, reader));
+
+    Attributes::PowerAdjustmentCapability::TypeInfo::DecodableType decoded;
+    ReturnErrorOnFailure(DataModel::Decode(reader, decoded));
+    if (decoded.IsNull())
+    {
+        capability.SetNull();
+        return CHIP_NO_ERROR;
+    }
+
+    size_t count = 0;
+    auto iter    = decoded.Value().begin();
+    while (iter.Next())
+    {
+        VerifyOrReturnError(count < buffer.size(), CHIP_ERROR_BUFFER_TOO_SMALL);
+        buffer[count++] = iter.GetValue();
+    }
+    ReturnErrorOnFailure(iter.GetStatus());
+
+    capability.SetNonNull(DataModel::List<const PowerAdjustment>(buffer.data(), count));
+    return CHIP_NO_ERROR;
+}
+
+} // namespace DeviceEnergyManagement
+} // namespace Clusters
+} // namespace app
+} // namespace chip
@@ -0,0 +1,85 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app-common/zap-generated/cluster-objects.h>
+#include <app/AttributePersistenceProvider.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/Span.h>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace DeviceEnergyManagement {
+
+/**
+ * @brief Persists the Forecast and PowerAdjustmentCapability attributes of an ESA,
+ *        so that they survive a restart.
+ *
+ * Each attribute is written through an AttributePersistenceProvider, under its own
+ * attribute path, as a long octet string holding the TLV encoding of the value:
+ * integers take the fewest bytes their value needs and absent optional fields take
+ * none, so a forecast of a few slots fits in a couple of hundred bytes. Applications
+ * expecting frequent forecast updates can defer the Forecast path with a
+ * DeferredAttributePersistenceProvider, so that only the last of a burst of updates
+ * reaches the flash. A restart may then lose the last forecasts, so the ForecastId
+ * sequence cannot be resumed from the stored forecast: it has to be persisted on its
+ * own, before the ForecastIds are used.
+ *
+ * Slot costs refer to memory the store does not own, and are not persisted.
+ */
+class ForecastStore
+{
+public:
+    using Slot                      = Structs::SlotStruct::Type;
+    using PowerAdjustment           = Structs::PowerAdjustStruct::Type;
+    using Forecast                  = DataModel::Nullable<Structs::ForecastStruct::Type>;
+    using PowerAdjustmentCapability = Attributes::PowerAdjustmentCapability::TypeInfo::Type;
+
+    static CHIP_ERROR SaveForecast(AttributePersistenceProvider & provider, EndpointId endpoint, const Forecast & forecast);
+
+    /**
+     * @brief Restores the forecast last saved for `endpoint`.
+     *
+     * The slots are copied into `slotBuffer`, which the restored forecast refers to;
+     * `slotBuffer` may be modified even if restoring fails. `forecast` is only
+     * modified on success.
+     *
+     * @return CHIP_ERROR_BUFFER_TOO_SMALL if the saved forecast has more slots than
+     *         `slotBuffer` can hold, or the error of the provider if nothing was saved.
+     */
+    static CHIP_ERROR LoadForecast(AttributePersistenceProvider & provider, EndpointId endpoint, Forecast & forecast,
+                                   Span<Slot> slotBuffer);
+
+    static CHIP_ERROR SavePowerAdjustmentCapability(AttributePersistenceProvider & provider, EndpointId endpoint,
+                                                    const PowerAdjustmentCapability & capability);
+
+    /**
+     * @brief Restores the PowerAdjustmentCapability last saved for `endpoint`, its
+     *        entries being copied into `buffer`. Same contract as LoadForecast().
+     */
+    static CHIP_ERROR LoadPowerAdjustmentCapability(AttributePersistenceProvider & provider, EndpointId endpoint,
+                                                    PowerAdjustmentCapability & capability, Span<PowerAdjustment> buffer);
+};
+
+} // namespace DeviceEnergyManagement
+} // namespace Clusters
+} // namespace app
+} // namespace chip
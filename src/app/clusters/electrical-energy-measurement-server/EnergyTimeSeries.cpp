@@ -0,0 +1,229 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include "EnergyTimeSeries.h"
+
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace ElectricalEnergyMeasurement {
+
+using namespace chip::app::Clusters::ElectricalEnergyMeasurement::Structs;
+
+namespace {
+
+// Bucket periods of the resolutions coarser than kRaw, in seconds.
+constexpr uint32_t kBucketPeriods[EnergyTimeSeries::kNumResolutions - 1] = { 60, 15 * 60, 60 * 60 };
+
+constexpr uint32_t kMillisecondsPerSecond = 1000;
+
+Optional<uint32_t> ToSeconds(const Optional<uint32_t> & timestamp, const Optional<uint64_t> & systime)
+{
+    if (timestamp.HasValue())
+    {
+        return timestamp;
+    }
+    if (systime.HasValue())
+    {
+        return MakeOptional(static_cast<uint32_t>(systime.Value() / kMillisecondsPerSecond));
+    }
+    return NullOptional;
+}
+
+} // namespace
+
+void EnergyTimeSeries::Ring::Init(Span<Sample> buffer)
+{
+    mBuffer = buffer;
+    Clear();
+}
+
+void EnergyTimeSeries::Ring::Push(const Sample & sample)
+{
+    if (mBuffer.empty())
+    {
+        return;
+    }
+    if (mCount < mBuffer.size())
+    {
+        mBuffer[(mHead + mCount++) % mBuffer.size()] = sample;
+        return;
+    }
+    mBuffer[mHead] = sample;
+    mHead          = (mHead + 1) % mBuffer.size();
+}
+
+size_t EnergyTimeSeries::Ring::UpperBound(uint32_t time) const
+{
+    size_t low  = 0;
+    size_t high = mCount;
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (At(middle).endTime <= time)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+EnergyTimeSeries::EnergyTimeSeries(Source source, Span<Sample> raw, Span<Sample> oneMinute, Span<Sample> fifteenMinutes,
+                                   Span<Sample> oneHour) :
+    mSource(source)
+{
+    mRings[static_cast<size_t>(Resolution::kRaw)].Init(raw);
+    mRings[static_cast<size_t>(Resolution::kOneMinute)].Init(oneMinute);
+    mRings[static_cast<size_t>(Resolution::kFifteenMinutes)].Init(fifteenMinutes);
+    mRings[static_cast<size_t>(Resolution::kOneHour)].Init(oneHour);
+}
+
+CHIP_ERROR EnergyTimeSeries::Append(const Sample & sample)
+{
+    VerifyOrReturnError(!mHasSamples || sample.endTime >= mLastEndTime, CHIP_ERROR_INVALID_ARGUMENT);
+    mLastEndTime = sample.endTime;
+    mHasSamples  = true;
+
+    mRings[static_cast<size_t>(Resolution::kRaw)].Push(sample);
+
+    // A sample is added to the buckets containing its end time; a new bucket completes the previous one.
+    for (size_t i = 0; i < ArraySize(mBuckets); i++)
+    {
+        const uint32_t period      = kBucketPeriods[i];
+        const uint32_t bucketStart = (sample.endTime == 0) ? 0 : (sample.endTime - 1) / period * period;
+
+        Bucket & bucket = mBuckets[i];
+        if (bucket.open && bucket.sample.startTime != bucketStart)
+        {
+            mRings[i + 1].Push(bucket.sample);
+            bucket.open = false;
+        }
+        if (!bucket.open)
+        {
+            bucket.sample           = Sample();
+            bucket.sample.startTime = bucketStart;
+            bucket.sample.endTime   = bucketStart + period;
+            bucket.open             = true;
+        }
+        bucket.sample.imported += sample.imported;
+        bucket.sample.exported += sample.exported;
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EnergyTimeSeries::AppendMeasurement(const Optional<EnergyMeasurementStruct::Type> & energyImported,
+                                               const Optional<EnergyMeasurementStruct::Type> & energyExported)
+{
+    const Optional<EnergyMeasurementStruct::Type> & timed = energyImported.HasValue() ? energyImported : energyExported;
+    VerifyOrReturnError(timed.HasValue(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    Optional<uint32_t> endTime = ToSeconds(timed.Value().endTimestamp, timed.Value().endSystime);
+    VerifyOrReturnError(endTime.HasValue(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    Sample sample;
+    sample.endTime = endTime.Value();
+
+    if (mSource == Source::kPeriodic)
+    {
+        sample.startTime = ToSeconds(timed.Value().startTimestamp, timed.Value().startSystime).ValueOr(sample.endTime);
+        sample.imported  = energyImported.HasValue() ? energyImported.Value().energy : 0;
+        sample.exported  = energyExported.HasValue() ? energyExported.Value().energy : 0;
+        return Append(sample);
+    }
+
+    // Cumulative values are turned into the energy measured since the previous value.
+    VerifyOrReturnError(!mHasSamples || sample.endTime >= mLastEndTime, CHIP_ERROR_INVALID_ARGUMENT);
+
+    const int64_t imported = energyImported.HasValue() ? energyImported.Value().energy : mLastCumulativeImported;
+    const int64_t exported = energyExported.HasValue() ? energyExported.Value().energy : mLastCumulativeExported;
+    const bool hadBaseline = mHasCumulative;
+
+    sample.startTime        = mLastCumulativeTime;
+    sample.imported         = (imported >= mLastCumulativeImported) ? imported - mLastCumulativeImported : imported;
+    sample.exported         = (exported >= mLastCumulativeExported) ? exported - mLastCumulativeExported : exported;
+    mLastCumulativeImported = imported;
+    mLastCumulativeExported = exported;
+    mLastCumulativeTime     = sample.endTime;
+    mHasCumulative          = true;
+
+    return hadBaseline ? Append(sample) : CHIP_NO_ERROR;
+}
+
+template <typename Function>
+void EnergyTimeSeries::ForEachInRange(Resolution resolution, uint32_t from, uint32_t to, Function && function) const
+{
+    const Ring & ring = mRings[static_cast<size_t>(resolution)];
+    for (size_t i = ring.UpperBound(from); i < ring.Size() && ring.At(i).endTime <= to; i++)
+    {
+        if (!function(ring.At(i)))
+        {
+            return;
+        }
+    }
+}
+
+size_t EnergyTimeSeries::Query(Resolution resolution, uint32_t from, uint32_t to, Span<Sample> output) const
+{
+    size_t count = 0;
+    ForEachInRange(resolution, from, to, [&](const Sample & sample) {
+        if (count >= output.size())
+        {
+            return false;
+        }
+        output[count++] = sample;
+        return true;
+    });
+    return count;
+}
+
+EnergyTimeSeries::Sample EnergyTimeSeries::Total(Resolution resolution, uint32_t from, uint32_t to) const
+{
+    Sample total;
+    total.startTime = from;
+    total.endTime   = to;
+    ForEachInRange(resolution, from, to, [&](const Sample & sample) {
+        total.imported += sample.imported;
+        total.exported += sample.exported;
+        return true;
+    });
+    return total;
+}
+
+void EnergyTimeSeries::Clear()
+{
+    for (auto & ring : mRings)
+    {
+        ring.Clear();
+    }
+    for (auto & bucket : mBuckets)
+    {
+        bucket.open = false;
+    }
+    mHasSamples    = false;
+    mHasCumulative = false;
+}
+
+} // namespace ElectricalEnergyMeasurement
+} // namespace Clusters
+} // namespace app
+} // namespace chip
@@ -0,0 +1,185 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app-common/zap-generated/cluster-objects.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/Optional.h>
+#include <lib/support/Span.h>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace ElectricalEnergyMeasurement {
+
+/**
+ * @brief Fixed-memory history of the energy measured on an endpoint.
+ *
+ * Every measurement is kept as a raw sample, and is also added to the
+ * current one minute, fifteen minute and one hour bucket. Each resolution
+ * is a ring buffer in caller-provided storage, so that the oldest samples
+ * are overwritten once it is full and coarser resolutions cover a longer
+ * history in the same memory. Appending is O(1); queries binary search the
+ * start of the range.
+ *
+ * Times are in seconds, taken from the timestamps of the measurements, or
+ * from their systimes if they have no timestamps. Measurements must be
+ * appended in time order.
+ */
+class EnergyTimeSeries
+{
+public:
+    enum class Resolution : uint8_t
+    {
+        kRaw            = 0,
+        kOneMinute      = 1,
+        kFifteenMinutes = 2,
+        kOneHour        = 3,
+    };
+    static constexpr size_t kNumResolutions = 4;
+
+    /**
+     * Which measurements feed the series. Devices often report both cumulative and
+     * periodic energy, so only one kind is used to avoid counting energy twice.
+     */
+    enum class Source : uint8_t
+    {
+        kCumulative,
+        kPeriodic,
+    };
+
+    struct Sample
+    {
+        uint32_t startTime = 0; // Seconds
+        uint32_t endTime   = 0; // Seconds
+        int64_t imported   = 0; // mWh imported during the sample
+        int64_t exported   = 0; // mWh exported during the sample
+    };
+
+    EnergyTimeSeries(Source source, Span<Sample> raw, Span<Sample> oneMinute, Span<Sample> fifteenMinutes, Span<Sample> oneHour);
+
+    Source GetSource() const { return mSource; }
+
+    /**
+     * @brief Appends the energy measured during an interval.
+     *
+     * @return CHIP_ERROR_INVALID_ARGUMENT if the sample ends before the previous one.
+     */
+    CHIP_ERROR Append(const Sample & sample);
+
+    /**
+     * @brief Appends a cumulative or periodic measurement, as given to NotifyCumulativeEnergyMeasured
+     *        or NotifyPeriodicEnergyMeasured, depending on the source of the series.
+     *
+     * The first cumulative measurement only sets the baseline. A cumulative value lower than the
+     * previous one is taken as a counter reset.
+     *
+     * @return CHIP_ERROR_INVALID_ARGUMENT if the measurements have no end time, or end before the
+     *         previous sample.
+     */
+    CHIP_ERROR AppendMeasurement(const Optional<Structs::EnergyMeasurementStruct::Type> & energyImported,
+                                 const Optional<Structs::EnergyMeasurementStruct::Type> & energyExported);
+
+    /**
+     * @brief Copies the samples of `resolution` that end within (from, to] to `output`, oldest first.
+     *
+     * Only completed buckets are returned for the coarser resolutions.
+     *
+     * @return the number of samples copied, at most output.size().
+     */
+    size_t Query(Resolution resolution, uint32_t from, uint32_t to, Span<Sample> output) const;
+
+    /**
+     * @brief Returns the energy of the samples of `resolution` that end within (from, to].
+     */
+    Sample Total(Resolution resolution, uint32_t from, uint32_t to) const;
+
+    /**
+     * @brief Returns the number of samples currently held for `resolution`.
+     */
+    size_t Size(Resolution resolution) const { return mRings[static_cast<size_t>(resolution)].Size(); }
+
+    void Clear();
+
+private:
+    class Ring
+    {
+    public:
+        void Init(Span<Sample> buffer);
+        void Push(const Sample & sample);
+        void Clear() { mHead = mCount = 0; }
+        size_t Size() const { return mCount; }
+        const Sample & At(size_t index) const { return mBuffer[(mHead + index) % mBuffer.size()]; }
+        // Index of the first sample ending after `time`.
+        size_t UpperBound(uint32_t time) const;
+
+    private:
+        Span<Sample> mBuffer;
+        size_t mHead  = 0; // Oldest sample
+        size_t mCount = 0;
+    };
+
+    struct Bucket
+    {
+        Sample sample;
+        bool open = false;
+    };
+
+    template <typename Function>
+    void ForEachInRange(Resolution resolution, uint32_t from, uint32_t to, Function && function) const;
+
+    Source mSource;
+    Ring mRings[kNumResolutions];
+    Bucket mBuckets[kNumResolutions - 1];
+    uint32_t mLastEndTime = 0;
+    bool mHasSamples      = false;
+
+    // Last cumulative values and end time, for Source::kCumulative.
+    int64_t mLastCumulativeImported = 0;
+    int64_t mLastCumulativeExported = 0;
+    uint32_t mLastCumulativeTime    = 0;
+    bool mHasCumulative             = false;
+};
+
+/**
+ * @brief An EnergyTimeSeries with its own storage.
+ *
+ * For instance, EnergyTimeSeriesWithStorage<60, 60, 96, 168> keeps the last
+ * 60 measurements, the last hour per minute, the last day per quarter of an
+ * hour and the last week per hour, in about 9 KB.
+ */
+template <size_t kRawCount, size_t kOneMinuteCount, size_t kFifteenMinutesCount, size_t kOneHourCount>
+class EnergyTimeSeriesWithStorage : public EnergyTimeSeries
+{
+public:
+    explicit EnergyTimeSeriesWithStorage(Source source) :
+        EnergyTimeSeries(source, Span<Sample>(mRaw), Span<Sample>(mOneMinute), Span<Sample>(mFifteenMinutes),
+                         Span<Sample>(mOneHour))
+    {}
+
+private:
+    Sample mRaw[kRawCount];
+    Sample mOneMinute[kOneMinuteCount];
+    Sample mFifteenMinutes[kFifteenMinutesCount];
+    Sample mOneHour[kOneHourCount];
+};
+
+} // namespace ElectricalEnergyMeasurement
+} // namespace Clusters
+} // namespace app
+} // namespace chip
@@ -186,6 +186,37 @@ CHIP_ERROR SetCumulativeReset(EndpointId endpointId, const Optional<CumulativeEn
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR SetEnergyTimeSeries(EndpointId endpointId, EnergyTimeSeries * timeSeries)
+{
+    MeasurementData * data = MeasurementDataForEndpoint(endpointId);
+    VerifyOrReturnError(data != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    data->timeSeries = timeSeries;
+
+    return CHIP_NO_ERROR;
+}
+
+namespace {
+
+void RecordEnergyMeasured(EndpointId endpointId, MeasurementData * data, EnergyTimeSeries::Source source,
+                          const Optional<EnergyMeasurementStruct::Type> & energyImported,
+                          const Optional<EnergyMeasurementStruct::Type> & energyExported)
+{
+    if (data == nullptr || data->timeSeries == nullptr || data->timeSeries->GetSource() != source)
+    {
+        return;
+    }
+
+    CHIP_ERROR error = data->timeSeries->AppendMeasurement(energyImported, energyExported);
+    if (CHIP_NO_ERROR != error)
+    {
+        ChipLogError(Zcl, "Unable to record energy measurement: %" CHIP_ERROR_FORMAT " [endpointId=%d]", error.Format(),
+                     endpointId);
+    }
+}
+
+} // namespace
+
 bool NotifyCumulativeEnergyMeasured(EndpointId endpointId, const Optional<EnergyMeasurementStruct::Type> & energyImported,
                                     const Optional<EnergyMeasurementStruct::Type> & energyExported)
 {
@@ -195,6 +226,7 @@ bool NotifyCumulativeEnergyMeasured(EndpointId endpointId, const Optional<Energy
         data->cumulativeImported = energyImported;
         data->cumulativeExported = energyExported;
     }
+    RecordEnergyMeasured(endpointId, data, EnergyTimeSeries::Source::kCumulative, energyImported, energyExported);
 
     Events::CumulativeEnergyMeasured::Type event;
 
@@ -224,6 +256,7 @@ bool NotifyPeriodicEnergyMeasured(EndpointId endpointId, const Optional<EnergyMe
         data->periodicImported = energyImported;
         data->periodicExported = energyExported;
     }
+    RecordEnergyMeasured(endpointId, data, EnergyTimeSeries::Source::kPeriodic, energyImported, energyExported);
 
     Events::PeriodicEnergyMeasured::Type event;
 
@@ -17,6 +17,8 @@
  */
 #pragma once
 
+#include "EnergyTimeSeries.h"
+
 #include <lib/core/Optional.h>
 
 #include <app-common/zap-generated/cluster-objects.h>
@@ -35,6 +37,7 @@ struct MeasurementData
     Optional<Structs::EnergyMeasurementStruct::Type> periodicImported;
     Optional<Structs::EnergyMeasurementStruct::Type> periodicExported;
     Optional<Structs::CumulativeEnergyResetStruct::Type> cumulativeReset;
+    EnergyTimeSeries * timeSeries = nullptr;
 };
 
 enum class OptionalAttributes : uint32_t
@@ -77,6 +80,15 @@ CHIP_ERROR SetCumulativeReset(EndpointId endpointId, const Optional<Structs::Cum
 
 MeasurementData * MeasurementDataForEndpoint(EndpointId endpointId);
 
+/**
+ * @brief Keeps a history of the energy measured on an endpoint in `timeSeries`, in addition
+ *        to the latest measurements. Pass nullptr to stop recording.
+ *
+ * The series is fed by NotifyCumulativeEnergyMeasured or NotifyPeriodicEnergyMeasured,
+ * depending on its source. It is owned by the caller and must outlive its use.
+ */
+CHIP_ERROR SetEnergyTimeSeries(EndpointId endpointId, EnergyTimeSeries * timeSeries);
+
 } // namespace ElectricalEnergyMeasurement
 } // namespace Clusters
 } // namespace app
@@ -0,0 +1,86 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include "ReportableChangeFilter.h"
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace ElectricalPowerMeasurement {
+
+namespace {
+
+// |a - b|, without overflowing for values of opposite signs.
+uint64_t Distance(int64_t a, int64_t b)
+{
+    return (a > b) ? static_cast<uint64_t>(a) - static_cast<uint64_t>(b) : static_cast<uint64_t>(b) - static_cast<uint64_t>(a);
+}
+
+} // namespace
+
+bool ReportableChangeFilter::ShouldReport(const DataModel::Nullable<int64_t> & aValue, System::Clock::Timestamp aNow)
+{
+    bool report;
+    if (!mHasReported || aValue.IsNull() || mLastReported.IsNull())
+    {
+        report = !mHasReported || aValue != mLastReported;
+    }
+    else if (aValue.Value() == mLastReported.Value())
+    {
+        report = false;
+    }
+    else
+    {
+        report = IsSignificant(aValue.Value(), mLastReported.Value()) ||
+            (mChange.maxInterval > System::Clock::kZero && aNow - mLastReportTime >= mChange.maxInterval);
+    }
+
+    if (report)
+    {
+        mLastReported   = aValue;
+        mLastReportTime = aNow;
+        mHasReported    = true;
+    }
+    return report;
+}
+
+bool ReportableChangeFilter::IsSignificant(int64_t aValue, int64_t aLastReported) const
+{
+    if (mChange.absoluteDelta <= 0 && mChange.percentDelta == 0)
+    {
+        return true;
+    }
+
+    const uint64_t delta = Distance(aValue, aLastReported);
+    if (mChange.absoluteDelta > 0 && delta >= static_cast<uint64_t>(mChange.absoluteDelta))
+    {
+        return true;
+    }
+    if (mChange.percentDelta > 0)
+    {
+        // Split to avoid overflowing on large values.
+        const uint64_t base      = Distance(aLastReported, 0);
+        const uint64_t threshold = base / 100 * mChange.percentDelta + base % 100 * mChange.percentDelta / 100;
+        return delta >= threshold;
+    }
+    return false;
+}
+
+} // namespace ElectricalPowerMeasurement
+} // namespace Clusters
+} // namespace app
+} // namespace chip
@@ -0,0 +1,75 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/data-model/Nullable.h>
+#include <system/SystemClock.h>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace ElectricalPowerMeasurement {
+
+/**
+ * Describes which changes of a measurement are worth reporting to subscribers.
+ *
+ * A change is reported once it reaches absoluteDelta or percentDelta (either
+ * one is enough, a zero value disables the check). If neither is set, every
+ * change is reported. Smaller changes are still reported once the last
+ * report is older than maxInterval, so that subscribers do not see a value
+ * drift away indefinitely.
+ */
+struct ReportableChange
+{
+    int64_t absoluteDelta                     = 0; // In the unit of the attribute
+    uint8_t percentDelta                      = 0; // Percent of the last reported value
+    System::Clock::Milliseconds32 maxInterval = System::Clock::kZero;
+};
+
+/**
+ * @brief Decides, sample by sample, whether a measurement changed enough to be reported.
+ *
+ * The filter does not run a timer: maxInterval is only evaluated when a new
+ * sample arrives, which suits measurements that are sampled continuously.
+ */
+class ReportableChangeFilter
+{
+public:
+    void SetReportableChange(const ReportableChange & aChange) { mChange = aChange; }
+    const ReportableChange & GetReportableChange() const { return mChange; }
+
+    /**
+     * @brief Returns whether `aValue` should be reported, and if so records it as the last reported value.
+     *
+     * The first sample, and changes from or to null, are always reported.
+     */
+    bool ShouldReport(const DataModel::Nullable<int64_t> & aValue, System::Clock::Timestamp aNow);
+
+private:
+    bool IsSignificant(int64_t aValue, int64_t aLastReported) const;
+
+    ReportableChange mChange;
+    DataModel::Nullable<int64_t> mLastReported;
+    System::Clock::Timestamp mLastReportTime = System::Clock::kZero;
+    bool mHasReported                        = false;
+};
+
+} // namespace ElectricalPowerMeasurement
+} // namespace Clusters
+} // namespace app
+} // namespace chip
@@ -40,14 +40,29 @@ namespace app {
 namespace Clusters {
 namespace ElectricalPowerMeasurement {
 
+void Delegate::MeasurementChanged(AttributeId aAttributeId, const DataModel::Nullable<int64_t> & aValue)
+{
+    if (mInstance != nullptr)
+    {
+        mInstance->MeasurementChanged(aAttributeId, aValue);
+        return;
+    }
+    MatterReportingAttributeChangeCallback(mEndpointId, ElectricalPowerMeasurement::Id, Span<const AttributeId>(&aAttributeId, 1));
+}
+
 CHIP_ERROR Instance::Init()
 {
     VerifyOrReturnError(registerAttributeAccessOverride(this), CHIP_ERROR_INCORRECT_STATE);
+    mDelegate.mInstance = this;
     return CHIP_NO_ERROR;
 }
 
 void Instance::Shutdown()
 {
+    if (mDelegate.mInstance == this)
+    {
+        mDelegate.mInstance = nullptr;
+    }
     unregisterAttributeAccessOverride(this);
 }
 
@@ -61,6 +76,74 @@ bool Instance::SupportsOptAttr(OptionalAttributes aOptionalAttrs) const
     return mOptionalAttrs.Has(aOptionalAttrs);
 }
 
+ReportableChangeFilter * Instance::GetFilter(AttributeId aAttributeId)
+{
+    if (aAttributeId < Voltage::Id || aAttributeId > NeutralCurrent::Id || aAttributeId == HarmonicCurrents::Id ||
+        aAttributeId == HarmonicPhases::Id)
+    {
+        return nullptr;
+    }
+    return &mFilters[aAttributeId - Voltage::Id];
+}
+
+CHIP_ERROR Instance::SetReportableChange(AttributeId aAttributeId, const ReportableChange & aChange)
+{
+    ReportableChangeFilter * filter = GetFilter(aAttributeId);
+    VerifyOrReturnError(filter != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    filter->SetReportableChange(aChange);
+    return CHIP_NO_ERROR;
+}
+
+void Instance::MeasurementChanged(AttributeId aAttributeId, const DataModel::Nullable<int64_t> & aValue)
+{
+    ReportableChangeFilter * filter = GetFilter(aAttributeId);
+    if (filter == nullptr)
+    {
+        MatterReportingAttributeChangeCallback(mDelegate.mEndpointId, ElectricalPowerMeasurement::Id,
+                                               Span<const AttributeId>(&aAttributeId, 1));
+        return;
+    }
+    VerifyOrReturn(filter->ShouldReport(aValue, System::SystemClock().GetMonotonicTimestamp()));
+
+    mPendingChanges |= static_cast<uint32_t>(1u << (aAttributeId - Voltage::Id));
+    if (mUpdateDepth == 0)
+    {
+        ReportPendingChanges();
+    }
+}
+
+void Instance::BeginUpdate()
+{
+    VerifyOrDie(mUpdateDepth < UINT8_MAX);
+    mUpdateDepth++;
+}
+
+void Instance::CommitUpdate()
+{
+    VerifyOrReturn(mUpdateDepth > 0);
+    VerifyOrReturn(--mUpdateDepth == 0);
+
+    ReportPendingChanges();
+}
+
+void Instance::ReportPendingChanges()
+{
+    AttributeId changes[kNumMeasurementAttributes];
+    size_t count = 0;
+    for (size_t i = 0; i < kNumMeasurementAttributes; i++)
+    {
+        if ((mPendingChanges & (1u << i)) != 0)
+        {
+            changes[count++] = static_cast<AttributeId>(Voltage::Id + i);
+        }
+    }
+    mPendingChanges = 0;
+
+    // A single data version increase for the whole frame, but only the changed measurements are reported.
+    MatterReportingAttributeChangeCallback(mDelegate.mEndpointId, ElectricalPowerMeasurement::Id,
+                                           Span<const AttributeId>(changes, count));
+}
+
 // AttributeAccessInterface
 CHIP_ERROR Instance::Read(const ConcreteReadAttributePath & aPath, AttributeValueEncoder & aEncoder)
 {
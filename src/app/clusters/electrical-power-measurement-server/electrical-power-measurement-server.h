@@ -17,6 +17,8 @@
  */
 #pragma once
 
+#include "ReportableChangeFilter.h"
+
 #include <lib/core/Optional.h>
 
 #include <app-common/zap-generated/cluster-objects.h>
@@ -29,6 +31,8 @@ namespace app {
 namespace Clusters {
 namespace ElectricalPowerMeasurement {
 
+class Instance;
+
 class Delegate
 {
 public:
@@ -78,7 +82,19 @@ public:
     virtual DataModel::Nullable<int64_t> GetNeutralCurrent()  = 0;
 
 protected:
+    /**
+     * @brief To be called by the delegate when a numeric measurement (Voltage to NeutralCurrent)
+     *        changed. The change is only reported if it is significant enough for the
+     *        ReportableChange configured on the Instance.
+     */
+    void MeasurementChanged(AttributeId aAttributeId, const DataModel::Nullable<int64_t> & aValue);
+
     EndpointId mEndpointId = 0;
+
+private:
+    friend class Instance;
+
+    Instance * mInstance = nullptr;
 };
 
 enum class OptionalAttributes : uint32_t
@@ -117,10 +133,46 @@ public:
     bool HasFeature(Feature aFeature) const;
     bool SupportsOptAttr(OptionalAttributes aOptionalAttrs) const;
 
+    /**
+     * @brief Sets how much a numeric measurement (Voltage to NeutralCurrent) has to change
+     *        before the change is reported to subscribers. By default, every change is reported.
+     *
+     * @return CHIP_ERROR_INVALID_ARGUMENT if the attribute is not a numeric measurement.
+     */
+    CHIP_ERROR SetReportableChange(AttributeId aAttributeId, const ReportableChange & aChange);
+
+    /**
+     * @brief Marks a numeric measurement dirty if `aValue` differs enough from the value last reported.
+     */
+    void MeasurementChanged(AttributeId aAttributeId, const DataModel::Nullable<int64_t> & aValue);
+
+    /**
+     * @brief Starts a measurement frame. Until the matching CommitUpdate(), the numeric measurements
+     *        changed by the delegate are recorded instead of being reported one by one.
+     *
+     * Frames can be nested, only the outermost CommitUpdate() reports the changes.
+     */
+    void BeginUpdate();
+
+    /**
+     * @brief Ends a measurement frame. The measurements that changed significantly are marked
+     *        dirty together, with a single data version increase.
+     */
+    void CommitUpdate();
+
 private:
+    static constexpr size_t kNumMeasurementAttributes = Attributes::NeutralCurrent::Id - Attributes::Voltage::Id + 1;
+    static_assert(kNumMeasurementAttributes <= 32, "Pending changes do not fit in mPendingChanges");
+
+    ReportableChangeFilter * GetFilter(AttributeId aAttributeId);
+    void ReportPendingChanges();
+
     Delegate & mDelegate;
     BitMask<Feature> mFeature;
     BitMask<OptionalAttributes> mOptionalAttrs;
+    ReportableChangeFilter mFilters[kNumMeasurementAttributes];
+    uint32_t mPendingChanges = 0; // One bit per measurement attribute, from Voltage
+    uint8_t mUpdateDepth     = 0;
 
     // AttributeAccessInterface
     CHIP_ERROR Read(const ConcreteReadAttributePath & aPath, AttributeValueEncoder & aEncoder) override;
@@ -0,0 +1,150 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "ChargingPlanner.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace EnergyEvse {
+
+namespace {
+
+constexpr int64_t kSecondsPerDay    = 24 * 60 * 60;
+constexpr int64_t kSecondsPerHour   = 60 * 60;
+constexpr int64_t kSecondsPerMinute = 60;
+
+// 1 January 2000 (day 0 of the Matter epoch) was a Saturday.
+constexpr int64_t kEpochDayOfWeek = 6;
+
+} // namespace
+
+bool ChargingPlanner::Inputs::operator==(const Inputs & other) const
+{
+    return localTimeOffset == other.localTimeOffset && chargeCurrent == other.chargeCurrent &&
+        stateOfCharge == other.stateOfCharge && batteryCapacity == other.batteryCapacity;
+}
+
+bool ChargingPlanner::Plan::operator==(const Plan & other) const
+{
+    return startTime == other.startTime && targetTime == other.targetTime && requiredEnergy == other.requiredEnergy &&
+        targetSoC == other.targetSoC;
+}
+
+size_t ChargingPlanner::DayOfWeek(int64_t epochDay)
+{
+    int64_t dayOfWeek = (epochDay + kEpochDayOfWeek) % 7;
+    return static_cast<size_t>(dayOfWeek < 0 ? dayOfWeek + 7 : dayOfWeek);
+}
+
+bool ChargingPlanner::Update(const ChargingTargetsStore & store, const Inputs & inputs, uint32_t now)
+{
+    if (mValid && mGeneration == store.GetGeneration() && mInputs == inputs &&
+        (mPlan.targetTime.IsNull() || now < mPlan.targetTime.Value()))
+    {
+        return false;
+    }
+
+    Plan plan   = Compute(store, inputs, now);
+    bool change = !mValid || plan != mPlan;
+
+    mPlan       = plan;
+    mInputs     = inputs;
+    mGeneration = store.GetGeneration();
+    mValid      = true;
+    return change;
+}
+
+ChargingPlanner::Plan ChargingPlanner::Compute(const ChargingTargetsStore & store, const Inputs & inputs, uint32_t now) const
+{
+    Plan plan;
+
+    const int64_t localNow   = static_cast<int64_t>(now) + inputs.localTimeOffset;
+    const int64_t today      = (localNow >= 0) ? localNow / kSecondsPerDay : (localNow - kSecondsPerDay + 1) / kSecondsPerDay;
+    const int64_t timeOfDay  = localNow - today * kSecondsPerDay;
+    const size_t todayOfWeek = DayOfWeek(today);
+
+    // Look at the rest of today, the next six days, and the earlier part of today next week.
+    const ChargingTargetsStore::ChargingTarget * target = nullptr;
+    int64_t targetLocalTime                             = 0;
+    for (int64_t dayOffset = 0; dayOffset <= static_cast<int64_t>(ChargingTargetsStore::kDaysPerWeek) && target == nullptr;
+         dayOffset++)
+    {
+        for (auto & candidate : store.GetTargetsForDay((todayOfWeek + static_cast<size_t>(dayOffset)) % 7))
+        {
+            int64_t candidateTime = candidate.targetTimeMinutesPastMidnight * kSecondsPerMinute;
+            if (dayOffset == 0 && candidateTime <= timeOfDay)
+            {
+                continue;
+            }
+            target          = &candidate;
+            targetLocalTime = (today + dayOffset) * kSecondsPerDay + candidateTime;
+            break;
+        }
+    }
+
+    if (target == nullptr)
+    {
+        return plan;
+    }
+
+    const int64_t targetTime = targetLocalTime - inputs.localTimeOffset;
+    if (targetTime <= now || targetTime > std::numeric_limits<uint32_t>::max())
+    {
+        return plan;
+    }
+    plan.targetTime.SetNonNull(static_cast<uint32_t>(targetTime));
+
+    // A target SoC is only usable if the EV reports its SoC and capacity, otherwise fall back to the added energy.
+    if (target->targetSoC.HasValue())
+    {
+        plan.targetSoC.SetNonNull(target->targetSoC.Value());
+    }
+    if (target->targetSoC.HasValue() && !inputs.stateOfCharge.IsNull() && !inputs.batteryCapacity.IsNull())
+    {
+        int64_t missing = static_cast<int64_t>(target->targetSoC.Value()) - inputs.stateOfCharge.Value();
+        plan.requiredEnergy.SetNonNull(std::max<int64_t>(missing, 0) * inputs.batteryCapacity.Value() / 100);
+    }
+    else if (target->addedEnergy.HasValue())
+    {
+        plan.requiredEnergy.SetNonNull(target->addedEnergy.Value());
+    }
+
+    // Start as late as possible while still reaching the target in time. If the
+    // energy or the power are unknown, start right away.
+    int64_t startTime = now;
+    if (!plan.requiredEnergy.IsNull() && inputs.chargeCurrent > 0 && mNominalVoltage > 0)
+    {
+        // mWh / (mA * V) = h; the energy is capped so that the conversion to seconds cannot overflow.
+        int64_t energy   = std::min(plan.requiredEnergy.Value(), std::numeric_limits<int64_t>::max() / (2 * kSecondsPerHour));
+        int64_t power    = inputs.chargeCurrent * mNominalVoltage;
+        int64_t duration = (energy * kSecondsPerHour + power - 1) / power;
+        startTime        = std::max(startTime, targetTime - std::min(duration, targetTime));
+    }
+    plan.startTime.SetNonNull(static_cast<uint32_t>(startTime));
+
+    return plan;
+}
+
+} // namespace EnergyEvse
+} // namespace Clusters
+} // namespace app
+} // namespace chip
@@ -0,0 +1,108 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include "ChargingTargetsStore.h"
+
+#include <app/data-model/Nullable.h>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace EnergyEvse {
+
+/**
+ * @brief Computes the NextChargeStartTime, NextChargeTargetTime, NextChargeRequiredEnergy
+ *        and NextChargeTargetSoC attributes from the stored charging targets.
+ *
+ * The plan is cached: Update() only recomputes it when one of its inputs (the
+ * targets, the charge current, the EV's state of charge or battery capacity,
+ * or the local time offset) changed, or once the planned target time passed.
+ * Calling Update() on every change of the EVSE state is therefore cheap.
+ */
+class ChargingPlanner
+{
+public:
+    static constexpr uint32_t kDefaultNominalVoltage = 230; // V
+
+    struct Inputs
+    {
+        int32_t localTimeOffset = 0; // Offset of local time from UTC, in seconds (time zone and DST)
+        int64_t chargeCurrent   = 0; // Current the EV can be charged at, in mA
+        DataModel::Nullable<Percent> stateOfCharge;
+        DataModel::Nullable<int64_t> batteryCapacity; // mWh
+
+        bool operator==(const Inputs & other) const;
+    };
+
+    struct Plan
+    {
+        DataModel::Nullable<uint32_t> startTime;  // Matter epoch seconds
+        DataModel::Nullable<uint32_t> targetTime; // Matter epoch seconds
+        DataModel::Nullable<int64_t> requiredEnergy;
+        DataModel::Nullable<Percent> targetSoC;
+
+        bool operator==(const Plan & other) const;
+        bool operator!=(const Plan & other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief Brings the plan up to date with `store` and `inputs`.
+     *
+     * @param now  Current time, in Matter epoch seconds (UTC)
+     *
+     * @return true if the plan changed.
+     */
+    bool Update(const ChargingTargetsStore & store, const Inputs & inputs, uint32_t now);
+
+    /**
+     * @brief Forces the next Update() to recompute the plan.
+     */
+    void Invalidate() { mValid = false; }
+
+    const Plan & GetPlan() const { return mPlan; }
+
+    /**
+     * @brief Sets the supply voltage used to estimate charging durations.
+     */
+    void SetNominalVoltage(uint32_t volts)
+    {
+        mNominalVoltage = volts;
+        Invalidate();
+    }
+
+    /**
+     * @brief Returns the day of week (0 = Sunday) of a Matter epoch day number.
+     */
+    static size_t DayOfWeek(int64_t epochDay);
+
+private:
+    Plan Compute(const ChargingTargetsStore & store, const Inputs & inputs, uint32_t now) const;
+
+    Plan mPlan;
+    Inputs mInputs;
+    uint32_t mGeneration     = 0;
+    uint32_t mNominalVoltage = kDefaultNominalVoltage;
+    bool mValid              = false;
+};
+
+} // namespace EnergyEvse
+} // namespace Clusters
+} // namespace app
+} // namespace chip
@@ -0,0 +1,306 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "ChargingTargetsStore.h"
+
+#include <app/data-model/Decode.h>
+#include <lib/core/TLV.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace EnergyEvse {
+
+using Protocols::InteractionModel::Status;
+
+namespace {
+
+constexpr uint16_t kMinutesPerDay = 24 * 60;
+constexpr uint8_t kMaxTargetSoC   = 100;
+
+constexpr size_t kChargingTargetMaxSerializedSize = TLV::EstimateStructOverhead(sizeof(uint16_t), sizeof(Percent), sizeof(int64_t));
+constexpr size_t kScheduleMaxSerializedSize       = TLV::EstimateStructOverhead(
+    sizeof(uint8_t), kChargingTargetMaxSerializedSize * ChargingTargetsStore::kMaxTargetsPerDay + TLV::EstimateStructOverhead());
+// At most one schedule per day, plus the start and end of the outer array.
+constexpr size_t kTargetsMaxSerializedSize =
+    kScheduleMaxSerializedSize * ChargingTargetsStore::kDaysPerWeek + TLV::EstimateStructOverhead();
+
+bool SameTarget(const Structs::ChargingTargetStruct::Type & a, const Structs::ChargingTargetStruct::Type & b)
+{
+    return a.targetTimeMinutesPastMidnight == b.targetTimeMinutesPastMidnight && a.targetSoC == b.targetSoC &&
+        a.addedEnergy == b.addedEnergy;
+}
+
+} // namespace
+
+CHIP_ERROR ChargingTargetsStore::Init(PersistentStorageDelegate & storage, EndpointId endpoint)
+{
+    mStorage  = &storage;
+    mEndpoint = endpoint;
+
+    for (auto & day : mDays)
+    {
+        day.count = 0;
+    }
+    mGeneration++;
+
+    CHIP_ERROR err = Load();
+    if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+    {
+        return CHIP_NO_ERROR;
+    }
+    return err;
+}
+
+CHIP_ERROR ChargingTargetsStore::SetTargets(const DecodableChargingSchedules & schedules)
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    Status status = ValidateSchedules(schedules);
+    VerifyOrReturnError(status != Status::ResourceExhausted, CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(status == Status::Success, CHIP_ERROR_INVALID_ARGUMENT);
+
+    ApplySchedules(schedules);
+    mGeneration++;
+
+    CHIP_ERROR err = Save();
+    if (err != CHIP_NO_ERROR)
+    {
+        // Keep what is in RAM consistent with what would be restored after a reboot.
+        ChipLogError(Zcl, "EVSE: Unable to persist charging targets: %" CHIP_ERROR_FORMAT, err.Format());
+        for (auto & day : mDays)
+        {
+            day.count = 0;
+        }
+        Load();
+    }
+    return err;
+}
+
+CHIP_ERROR ChargingTargetsStore::ClearTargets()
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    for (auto & day : mDays)
+    {
+        day.count = 0;
+    }
+    mGeneration++;
+
+    CHIP_ERROR err = mStorage->SyncDeleteKeyValue(DefaultStorageKeyAllocator::EVSEChargingTargets(mEndpoint).KeyName());
+    if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+    {
+        return CHIP_NO_ERROR;
+    }
+    return err;
+}
+
+DataModel::List<const ChargingTargetsStore::ChargingTargetSchedule> ChargingTargetsStore::GetTargets()
+{
+    size_t scheduleCount = 0;
+    // Index of the schedule each day belongs to, for days that have targets.
+    size_t scheduleOfDay[kDaysPerWeek];
+
+    for (size_t day = 0; day < kDaysPerWeek; day++)
+    {
+        if (mDays[day].count == 0)
+        {
+            continue;
+        }
+
+        size_t earlierDay = 0;
+        while (earlierDay < day && (mDays[earlierDay].count == 0 || !SameTargets(earlierDay, day)))
+        {
+            earlierDay++;
+        }
+
+        if (earlierDay < day)
+        {
+            scheduleOfDay[day] = scheduleOfDay[earlierDay];
+            mSchedules[scheduleOfDay[day]].dayOfWeekForSequence.Set(static_cast<TargetDayOfWeekBitmap>(1u << day));
+            continue;
+        }
+
+        auto & schedule               = mSchedules[scheduleCount];
+        schedule.dayOfWeekForSequence = BitMask<TargetDayOfWeekBitmap>(static_cast<TargetDayOfWeekBitmap>(1u << day));
+        schedule.chargingTargets      = DataModel::List<const ChargingTarget>(mDays[day].targets, mDays[day].count);
+        scheduleOfDay[day]            = scheduleCount++;
+    }
+
+    return DataModel::List<const ChargingTargetSchedule>(mSchedules, scheduleCount);
+}
+
+Span<const ChargingTargetsStore::ChargingTarget> ChargingTargetsStore::GetTargetsForDay(size_t dayIndex) const
+{
+    VerifyOrReturnValue(dayIndex < kDaysPerWeek, Span<const ChargingTarget>());
+    return Span<const ChargingTarget>(mDays[dayIndex].targets, mDays[dayIndex].count);
+}
+
+Status ChargingTargetsStore::ValidateSchedules(const DecodableChargingSchedules & schedules)
+{
+    uint8_t daysSeen = 0;
+
+    auto scheduleIter = schedules.begin();
+    while (scheduleIter.Next())
+    {
+        auto & schedule = scheduleIter.GetValue();
+        uint8_t days    = schedule.dayOfWeekForSequence.Raw();
+
+        // Every schedule must apply to at least one day, and each day may only appear once.
+        if (days == 0 || days >= (1u << kDaysPerWeek))
+        {
+            ChipLogError(Zcl, "EVSE: DayOfWeekForSequence is invalid: 0x%02x", days);
+            return Status::ConstraintError;
+        }
+        if ((days & daysSeen) != 0)
+        {
+            ChipLogError(Zcl, "EVSE: DayOfWeekForSequence has a day that is already set: 0x%02x", days);
+            return Status::ConstraintError;
+        }
+        daysSeen |= days;
+
+        size_t targetCount = 0;
+        auto targetIter    = schedule.chargingTargets.begin();
+        while (targetIter.Next())
+        {
+            auto & target = targetIter.GetValue();
+
+            if (++targetCount > kMaxTargetsPerDay)
+            {
+                ChipLogError(Zcl, "EVSE: Too many targets for day(s) 0x%02x", days);
+                return Status::ResourceExhausted;
+            }
+            if (target.targetTimeMinutesPastMidnight >= kMinutesPerDay)
+            {
+                ChipLogError(Zcl, "EVSE: TargetTimeMinutesPastMidnight outside range");
+                return Status::ConstraintError;
+            }
+            if (target.targetSoC.HasValue() && target.targetSoC.Value() > kMaxTargetSoC)
+            {
+                ChipLogError(Zcl, "EVSE: TargetSoC outside range");
+                return Status::ConstraintError;
+            }
+            if (target.addedEnergy.HasValue() && target.addedEnergy.Value() < 0)
+            {
+                ChipLogError(Zcl, "EVSE: AddedEnergy outside range");
+                return Status::ConstraintError;
+            }
+        }
+        VerifyOrReturnValue(targetIter.GetStatus() == CHIP_NO_ERROR, Status::InvalidCommand);
+    }
+    VerifyOrReturnValue(scheduleIter.GetStatus() == CHIP_NO_ERROR, Status::InvalidCommand);
+
+    return Status::Success;
+}
+
+void ChargingTargetsStore::ApplySchedules(const DecodableChargingSchedules & schedules)
+{
+    // Only called with schedules that passed ValidateSchedules(), so decoding cannot fail here.
+    auto scheduleIter = schedules.begin();
+    while (scheduleIter.Next())
+    {
+        auto & schedule = scheduleIter.GetValue();
+
+        DayTargets targets;
+        auto targetIter = schedule.chargingTargets.begin();
+        while (targetIter.Next() && targets.count < kMaxTargetsPerDay)
+        {
+            targets.targets[targets.count++] = targetIter.GetValue();
+        }
+        std::stable_sort(targets.targets, targets.targets + targets.count, [](const ChargingTarget & a, const ChargingTarget & b) {
+            return a.targetTimeMinutesPastMidnight < b.targetTimeMinutesPastMidnight;
+        });
+
+        for (size_t day = 0; day < kDaysPerWeek; day++)
+        {
+            if (schedule.dayOfWeekForSequence.Has(static_cast<TargetDayOfWeekBitmap>(1u << day)))
+            {
+                mDays[day] = targets;
+            }
+        }
+    }
+}
+
+bool ChargingTargetsStore::SameTargets(size_t dayA, size_t dayB) const
+{
+    const DayTargets & a = mDays[dayA];
+    const DayTargets & b = mDays[dayB];
+
+    VerifyOrReturnValue(a.count == b.count, false);
+    for (size_t i = 0; i < a.count; i++)
+    {
+        VerifyOrReturnValue(SameTarget(a.targets[i], b.targets[i]), false);
+    }
+    return true;
+}
+
+CHIP_ERROR ChargingTargetsStore::Load()
+{
+    Platform::ScopedMemoryBuffer<uint8_t> buffer;
+    VerifyOrReturnError(buffer.Alloc(kTargetsMaxSerializedSize), CHIP_ERROR_NO_MEMORY);
+
+    uint16_t size = static_cast<uint16_t>(kTargetsMaxSerializedSize);
+    ReturnErrorOnFailure(
+        mStorage->SyncGetKeyValue(DefaultStorageKeyAllocator::EVSEChargingTargets(mEndpoint).KeyName(), buffer.Get(), size));
+
+    TLV::TLVReader reader;
+    reader.Init(buffer.Get(), size);
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()));
+
+    DecodableChargingSchedules schedules;
+    ReturnErrorOnFailure(DataModel::Decode(reader, schedules));
+
+    Status status = ValidateSchedules(schedules);
+    VerifyOrReturnError(status != Status::ResourceExhausted, CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(status == Status::Success, CHIP_ERROR_INVALID_ARGUMENT);
+
+    ApplySchedules(schedules);
+    mGeneration++;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChargingTargetsStore::Save()
+{
+    Platform::ScopedMemoryBuffer<uint8_t> buffer;
+    VerifyOrReturnError(buffer.Alloc(kTargetsMaxSerializedSize), CHIP_ERROR_NO_MEMORY);
+
+    TLV::TLVWriter writer;
+    TLV::TLVType outerType;
+    writer.Init(buffer.Get(), kTargetsMaxSerializedSize);
+
+    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, outerType));
+    for (auto & schedule : GetTargets())
+    {
+        ReturnErrorOnFailure(schedule.Encode(writer, TLV::AnonymousTag()));
+    }
+    ReturnErrorOnFailure(writer.EndContainer(outerType));
+
+    return mStorage->SyncSetKeyValue(DefaultStorageKeyAllocator::EVSEChargingTargets(mEndpoint).KeyName(), buffer.Get(),
+                                     static_cast<uint16_t>(writer.GetLengthWritten()));
+}
+
+} // namespace EnergyEvse
+} // namespace Clusters
+} // namespace app
+} // namespace chip
@@ -0,0 +1,125 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app-common/zap-generated/cluster-objects.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/Span.h>
+#include <protocols/interaction_model/StatusCode.h>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace EnergyEvse {
+
+/**
+ * @brief Stores the charging targets (ChargingPreferences feature) of an EVSE endpoint.
+ *
+ * Targets are kept per weekday, sorted by time of day, so that the charging
+ * planner can find the next target without decoding anything. Schedules
+ * received in a SetTargets command only replace the days they cover.
+ *
+ * All targets are persisted as a single record, in which days with identical
+ * targets are grouped into one schedule (the same form GetTargets returns).
+ */
+class ChargingTargetsStore
+{
+public:
+    using ChargingTarget             = Structs::ChargingTargetStruct::Type;
+    using ChargingTargetSchedule     = Structs::ChargingTargetScheduleStruct::Type;
+    using DecodableChargingSchedules = DataModel::DecodableList<Structs::ChargingTargetScheduleStruct::DecodableType>;
+
+    static constexpr size_t kDaysPerWeek      = 7;
+    static constexpr size_t kMaxTargetsPerDay = 10; // Spec-defined maximum of ChargingTargets per schedule
+
+    /**
+     * @brief Sets the storage used for the targets of `endpoint` and loads any
+     *        previously persisted targets from it.
+     */
+    CHIP_ERROR Init(PersistentStorageDelegate & storage, EndpointId endpoint);
+
+    /**
+     * @brief Checks the schedules of a SetTargets command against the spec-defined constraints.
+     *
+     * Returns ConstraintError if a day is covered by more than one schedule or
+     * a target is out of range, ResourceExhausted if a schedule has more than
+     * kMaxTargetsPerDay targets, and InvalidCommand if the schedules cannot be decoded.
+     */
+    static Protocols::InteractionModel::Status ValidateSchedules(const DecodableChargingSchedules & schedules);
+
+    /**
+     * @brief Replaces the targets of every day covered by `schedules` and persists the result.
+     *
+     * Returns CHIP_ERROR_INVALID_ARGUMENT, without modifying anything, if the
+     * schedules fail ValidateSchedules(), or CHIP_ERROR_NO_MEMORY if that is
+     * because a schedule has more than kMaxTargetsPerDay targets.
+     */
+    CHIP_ERROR SetTargets(const DecodableChargingSchedules & schedules);
+
+    /**
+     * @brief Removes all targets, including the persisted ones.
+     */
+    CHIP_ERROR ClearTargets();
+
+    /**
+     * @brief Returns the targets as schedules, days with identical targets being grouped.
+     *
+     * The returned list refers to memory owned by the store, and is only valid
+     * until the targets are next modified.
+     */
+    DataModel::List<const ChargingTargetSchedule> GetTargets();
+
+    /**
+     * @brief Returns the targets of a day (0 = Sunday), sorted by time of day.
+     */
+    Span<const ChargingTarget> GetTargetsForDay(size_t dayIndex) const;
+
+    /**
+     * @brief Incremented on every change of the targets, so that users can
+     *        cheaply tell whether anything derived from them is stale.
+     */
+    uint32_t GetGeneration() const { return mGeneration; }
+
+private:
+    struct DayTargets
+    {
+        ChargingTarget targets[kMaxTargetsPerDay];
+        uint8_t count = 0;
+    };
+
+    void ApplySchedules(const DecodableChargingSchedules & schedules);
+    bool SameTargets(size_t dayA, size_t dayB) const;
+
+    CHIP_ERROR Load();
+    CHIP_ERROR Save();
+
+    PersistentStorageDelegate * mStorage = nullptr;
+    EndpointId mEndpoint                 = kInvalidEndpointId;
+    uint32_t mGeneration                 = 0;
+
+    DayTargets mDays[kDaysPerWeek];
+    ChargingTargetSchedule mSchedules[kDaysPerWeek]; // backing memory of the GetTargets() list
+};
+
+} // namespace EnergyEvse
+} // namespace Clusters
+} // namespace app
+} // namespace chip
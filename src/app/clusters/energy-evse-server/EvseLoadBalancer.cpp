@@ -0,0 +1,200 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "EvseLoadBalancer.h"
+
+#include <lib/support/CodeUtils.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace EnergyEvse {
+
+EvseLoadBalancer::~EvseLoadBalancer()
+{
+    while (mParticipants.begin() != mParticipants.end())
+    {
+        Participant & participant = *mParticipants.begin();
+        participant.mRegistered   = false;
+        mParticipants.Remove(&participant);
+    }
+}
+
+void EvseLoadBalancer::SetCapacity(int64_t capacity)
+{
+    VerifyOrReturn(capacity != mCapacity);
+    mCapacity = capacity;
+    Rebalance();
+}
+
+CHIP_ERROR EvseLoadBalancer::Register(Participant & participant)
+{
+    VerifyOrReturnError(!participant.mRegistered && !mRebalancing, CHIP_ERROR_INCORRECT_STATE);
+
+    participant.mLimit      = std::max<int64_t>(participant.GetLocalCurrentLimit(), 0);
+    participant.mMinimum    = participant.GetMinimumCurrent();
+    participant.mDrawing    = participant.IsDrawingCurrent();
+    participant.mAdmitted   = false;
+    participant.mAllocated  = -1; // Always notify the first allocation
+    participant.mRegistered = true;
+    mParticipants.PushBack(&participant);
+
+    Rebalance();
+    return CHIP_NO_ERROR;
+}
+
+void EvseLoadBalancer::Unregister(Participant & participant)
+{
+    VerifyOrReturn(participant.mRegistered);
+    // The participants cannot be removed while they are being notified.
+    VerifyOrDie(!mRebalancing);
+
+    participant.mRegistered = false;
+    mParticipants.Remove(&participant);
+    if (participant.mDrawing)
+    {
+        Rebalance();
+    }
+}
+
+void EvseLoadBalancer::Update(Participant & participant)
+{
+    VerifyOrReturn(participant.mRegistered);
+
+    const int64_t limit   = std::max<int64_t>(participant.GetLocalCurrentLimit(), 0);
+    const int64_t minimum = participant.GetMinimumCurrent();
+    const bool drawing    = participant.IsDrawingCurrent();
+    VerifyOrReturn(limit != participant.mLimit || minimum != participant.mMinimum || drawing != participant.mDrawing);
+
+    const bool wasDrawing = participant.mDrawing;
+    participant.mLimit    = limit;
+    participant.mMinimum  = minimum;
+    participant.mDrawing  = drawing;
+
+    if (!wasDrawing && !drawing)
+    {
+        // Idle EVSEs do not take anything from the others, only the headroom they are offered changes.
+        Allocate(participant, std::max<int64_t>(std::min(limit, mCapacity - mDrawingAllocated), 0));
+        return;
+    }
+
+    if (!wasDrawing && !mRebalancing)
+    {
+        // Served after the EVSEs already drawing current.
+        mParticipants.Remove(&participant);
+        mParticipants.PushBack(&participant);
+    }
+    Rebalance();
+}
+
+int64_t EvseLoadBalancer::SumAtLevel(int64_t level)
+{
+    int64_t sum = 0;
+    for (Participant & participant : mParticipants)
+    {
+        if (participant.mAdmitted)
+        {
+            sum += std::min(std::max(level, participant.mMinimum), participant.mLimit);
+        }
+    }
+    return sum;
+}
+
+void EvseLoadBalancer::Rebalance()
+{
+    // Allocating notifies the participants, which may update their inputs from the callback.
+    if (mRebalancing)
+    {
+        mRebalancePending = true;
+        return;
+    }
+    mRebalancing = true;
+
+    do
+    {
+        mRebalancePending = false;
+
+        // Reserve the minimum current of the EVSEs drawing current, in the order they started to.
+        int64_t reserved = 0;
+        int64_t highest  = 0;
+        for (Participant & participant : mParticipants)
+        {
+            participant.mAdmitted = participant.mDrawing && participant.mLimit >= participant.mMinimum &&
+                participant.mMinimum <= mCapacity - reserved;
+            if (participant.mAdmitted)
+            {
+                reserved += participant.mMinimum;
+                highest = std::max(highest, participant.mLimit);
+            }
+        }
+
+        // Find the highest level for which sum(clamp(level, minimum, limit)) fits in the capacity.
+        int64_t low  = 0;
+        int64_t high = highest;
+        while (low < high)
+        {
+            const int64_t middle = low + (high - low + 1) / 2;
+            if (SumAtLevel(middle) <= mCapacity)
+            {
+                low = middle;
+            }
+            else
+            {
+                high = middle - 1;
+            }
+        }
+
+        mDrawingAllocated = 0;
+        for (Participant & participant : mParticipants)
+        {
+            if (participant.mAdmitted)
+            {
+                mDrawingAllocated += std::min(std::max(low, participant.mMinimum), participant.mLimit);
+            }
+        }
+
+        const int64_t headroom = std::max<int64_t>(mCapacity - mDrawingAllocated, 0);
+        for (Participant & participant : mParticipants)
+        {
+            if (participant.mAdmitted)
+            {
+                Allocate(participant, std::min(std::max(low, participant.mMinimum), participant.mLimit));
+            }
+            else
+            {
+                Allocate(participant, participant.mDrawing ? 0 : std::min(participant.mLimit, headroom));
+            }
+        }
+    } while (mRebalancePending);
+
+    mRebalancing = false;
+}
+
+void EvseLoadBalancer::Allocate(Participant & participant, int64_t current)
+{
+    VerifyOrReturn(current != participant.mAllocated);
+    participant.mAllocated = current;
+    participant.OnCurrentAllocated(current);
+}
+
+} // namespace EnergyEvse
+} // namespace Clusters
+} // namespace app
+} // namespace chip
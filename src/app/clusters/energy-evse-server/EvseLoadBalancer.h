@@ -0,0 +1,146 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/IntrusiveList.h>
+
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace EnergyEvse {
+
+/**
+ * @brief Shares the capacity of a site circuit between the EVSEs it supplies.
+ *
+ * Each EVSE endpoint registers a Participant, and calls Update() whenever its
+ * own current limit or its demand changes (plug in, unplug, state changes...).
+ * The EVSEs drawing current get an equal share of the capacity, capped to
+ * their own limit, with the unused share of the others redistributed (max-min
+ * fairness). An EVSE that would get less than its minimum charge current is
+ * not allocated anything rather than starting a charge that cannot be
+ * sustained; when the circuit cannot supply all of them, the EVSEs which
+ * started to draw current first are served first.
+ *
+ * EVSEs that are not drawing current are offered what is left of the capacity,
+ * without reserving it, so that a single EVSE behaves as if it had no balancer.
+ *
+ * Inputs are cached, so updates that do not change them are ignored, and only
+ * the participants whose allocation changed are notified. Currents are in mA.
+ */
+class EvseLoadBalancer
+{
+public:
+    class Participant : public IntrusiveListNodeBase<>
+    {
+    public:
+        virtual ~Participant() = default;
+
+        /**
+         * @brief The highest current this EVSE could deliver without the balancer
+         *        (hardware, circuit, cable, command and user limits).
+         */
+        virtual int64_t GetLocalCurrentLimit() = 0;
+
+        /**
+         * @brief The lowest current an EV can be charged with.
+         */
+        virtual int64_t GetMinimumCurrent() = 0;
+
+        /**
+         * @brief Whether the EVSE is drawing, or about to draw, current.
+         */
+        virtual bool IsDrawingCurrent() = 0;
+
+        /**
+         * @brief Called when the current allocated to this EVSE changes.
+         *
+         * Update() may be called from here, but not Register() or Unregister().
+         */
+        virtual void OnCurrentAllocated(int64_t current) = 0;
+
+        /**
+         * @brief The current last allocated to this EVSE.
+         */
+        int64_t GetAllocatedCurrent() const { return mAllocated; }
+
+    private:
+        friend class EvseLoadBalancer;
+
+        int64_t mLimit     = 0;
+        int64_t mMinimum   = 0;
+        int64_t mAllocated = 0;
+        bool mDrawing      = false;
+        bool mAdmitted     = false; // Drawing and allocated at least its minimum
+        bool mRegistered   = false;
+    };
+
+    explicit EvseLoadBalancer(int64_t capacity) : mCapacity(capacity) {}
+    ~EvseLoadBalancer();
+
+    int64_t GetCapacity() const { return mCapacity; }
+
+    /**
+     * @brief Changes the capacity of the circuit and redistributes it.
+     */
+    void SetCapacity(int64_t capacity);
+
+    /**
+     * @brief Adds an EVSE to the circuit and notifies its allocation.
+     *
+     * @return CHIP_ERROR_INCORRECT_STATE if the participant is already registered, or if
+     *         called while participants are being notified.
+     */
+    CHIP_ERROR Register(Participant & participant);
+
+    /**
+     * @brief Removes an EVSE from the circuit and redistributes its share to the others.
+     */
+    void Unregister(Participant & participant);
+
+    /**
+     * @brief Reads the limit, minimum current and demand of `participant` again
+     *        and redistributes the capacity if they changed.
+     */
+    void Update(Participant & participant);
+
+    /**
+     * @brief The sum of the currents allocated to the EVSEs drawing current, never above the capacity.
+     */
+    int64_t GetAllocatedCurrent() const { return mDrawingAllocated; }
+
+private:
+    void Rebalance();
+    int64_t SumAtLevel(int64_t level);
+    void Allocate(Participant & participant, int64_t current);
+
+    // Participants are kept in the order they started drawing current, which is the order they are served in.
+    IntrusiveList<Participant> mParticipants;
+    int64_t mCapacity;
+    int64_t mDrawingAllocated = 0;
+    bool mRebalancing         = false;
+    bool mRebalancePending    = false;
+};
+
+} // namespace EnergyEvse
+} // namespace Clusters
+} // namespace app
+} // namespace chip
@@ -0,0 +1,175 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "RandomizedStartScheduler.h"
+
+#include <crypto/RandUtils.h>
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+
+CHIP_ERROR RandomizedStartScheduler::SystemLayerTimerDelegate::StartTimer(RandomizedStartScheduler & scheduler,
+                                                                          System::Clock::Timeout aTimeout)
+{
+    return mSystemLayer.StartTimer(aTimeout, TimerExpired, &scheduler);
+}
+
+void RandomizedStartScheduler::SystemLayerTimerDelegate::CancelTimer(RandomizedStartScheduler & scheduler)
+{
+    mSystemLayer.CancelTimer(TimerExpired, &scheduler);
+}
+
+System::Clock::Timestamp RandomizedStartScheduler::SystemLayerTimerDelegate::GetCurrentMonotonicTimestamp()
+{
+    return System::SystemClock().GetMonotonicTimestamp();
+}
+
+void RandomizedStartScheduler::SystemLayerTimerDelegate::TimerExpired(System::Layer * aSystemLayer, void * aScheduler)
+{
+    static_cast<RandomizedStartScheduler *>(aScheduler)->OnTimerExpired();
+}
+
+RandomizedStartScheduler::~RandomizedStartScheduler()
+{
+    if (mTimerArmed)
+    {
+        mTimerDelegate.CancelTimer(*this);
+    }
+    while (mPending.begin() != mPending.end())
+    {
+        Transition & transition = *mPending.begin();
+        transition.mPending     = false;
+        mPending.Remove(&transition);
+    }
+}
+
+CHIP_ERROR RandomizedStartScheduler::Schedule(Transition & transition, System::Clock::Milliseconds32 window)
+{
+    System::Clock::Milliseconds64 delay(0);
+    if (window.count() > 0)
+    {
+        delay = System::Clock::Milliseconds64(Crypto::GetRandU32() % window.count());
+    }
+    return ScheduleAt(transition, mTimerDelegate.GetCurrentMonotonicTimestamp() + delay);
+}
+
+CHIP_ERROR RandomizedStartScheduler::ScheduleAt(Transition & transition, System::Clock::Timestamp startTime)
+{
+    if (transition.mPending)
+    {
+        mPending.Remove(&transition);
+        mPendingCount--;
+    }
+
+    // Linear in the number of pending transitions, which is bounded by the endpoints sharing the scheduler.
+    auto position = mPending.end();
+    while (position != mPending.begin())
+    {
+        auto previous = position;
+        --previous;
+        if (previous->mStartTime <= startTime)
+        {
+            break;
+        }
+        position = previous;
+    }
+    mPending.InsertBefore(position, &transition);
+    mPendingCount++;
+
+    transition.mStartTime = startTime;
+    transition.mPending   = true;
+
+    return ArmTimer();
+}
+
+void RandomizedStartScheduler::Cancel(Transition & transition)
+{
+    VerifyOrReturn(transition.mPending);
+
+    transition.mPending = false;
+    mPending.Remove(&transition);
+    mPendingCount--;
+
+    // The timer is left armed if other transitions are pending: it only costs an early wake-up.
+    if (mPendingCount == 0 && mTimerArmed)
+    {
+        mTimerDelegate.CancelTimer(*this);
+        mTimerArmed = false;
+    }
+}
+
+void RandomizedStartScheduler::OnTimerExpired()
+{
+    mTimerArmed = false;
+
+    // Transitions scheduled from OnRandomizedStart() are only started on a later expiry.
+    VerifyOrReturn(!mProcessing);
+    mProcessing = true;
+
+    // The due transitions are set apart first, so that one rescheduled with an empty window, while the
+    // clock does not move, is left for the next expiry instead of being started again in this loop.
+    // They stay pending until started: Cancel() and ScheduleAt() take them out of the due list.
+    IntrusiveList<Transition> due;
+    const System::Clock::Timestamp now = mTimerDelegate.GetCurrentMonotonicTimestamp();
+    while (mPending.begin() != mPending.end() && mPending.begin()->mStartTime <= now)
+    {
+        Transition & transition = *mPending.begin();
+        mPending.Remove(&transition);
+        due.PushBack(&transition);
+    }
+
+    while (due.begin() != due.end())
+    {
+        Transition & transition = *due.begin();
+        transition.mPending     = false;
+        due.Remove(&transition);
+        mPendingCount--;
+        transition.OnRandomizedStart();
+    }
+
+    mProcessing = false;
+
+    if (ArmTimer() != CHIP_NO_ERROR)
+    {
+        ChipLogError(Zcl, "Unable to arm the randomized start timer");
+    }
+}
+
+CHIP_ERROR RandomizedStartScheduler::ArmTimer()
+{
+    // The timer is armed once the due transitions have been started.
+    VerifyOrReturnError(!mProcessing && mPending.begin() != mPending.end(), CHIP_NO_ERROR);
+
+    const System::Clock::Timestamp startTime = mPending.begin()->mStartTime;
+    VerifyOrReturnError(!mTimerArmed || startTime < mTimerStartTime, CHIP_NO_ERROR);
+
+    const System::Clock::Timestamp now = mTimerDelegate.GetCurrentMonotonicTimestamp();
+    const System::Clock::Timeout timeout =
+        (startTime > now) ? std::chrono::duration_cast<System::Clock::Timeout>(startTime - now) : System::Clock::kZero;
+
+    ReturnErrorOnFailure(mTimerDelegate.StartTimer(*this, timeout));
+    mTimerStartTime = startTime;
+    mTimerArmed     = true;
+    return CHIP_NO_ERROR;
+}
+
+} // namespace Clusters
+} // namespace app
+} // namespace chip
@@ -0,0 +1,146 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/IntrusiveList.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+
+/**
+ * @brief Defers transitions (start of charging, start of a load control event...)
+ *        by a random delay, so that devices receiving the same signal at the same
+ *        time do not all start at once.
+ *
+ * The scheduler is not specific to a cluster: all the endpoints of a device, or
+ * all the simulated devices of an application, can share one. Pending transitions
+ * are kept sorted by start time and a single timer is armed, for the earliest one,
+ * so the cost of a pending transition is its list node.
+ */
+class RandomizedStartScheduler
+{
+public:
+    class Transition : public IntrusiveListNodeBase<>
+    {
+    public:
+        /* A pending transition must be cancelled before it is destroyed */
+        virtual ~Transition() = default;
+
+        /**
+         * @brief Called once the randomized start time is reached.
+         *
+         * The transition is no longer pending, and may be scheduled again from here.
+         */
+        virtual void OnRandomizedStart() = 0;
+
+        bool IsPending() const { return mPending; }
+        System::Clock::Timestamp GetStartTime() const { return mStartTime; }
+
+    private:
+        friend class RandomizedStartScheduler;
+
+        System::Clock::Timestamp mStartTime = System::Clock::kZero;
+        bool mPending                       = false;
+    };
+
+    /**
+     * Arms the single timer of the scheduler, and provides the time, so that tests
+     * can run the scheduler without a system layer.
+     */
+    class TimerDelegate
+    {
+    public:
+        virtual ~TimerDelegate() = default;
+
+        /* Starts, or restarts, the timer; on expiry, RandomizedStartScheduler::OnTimerExpired() must be called */
+        virtual CHIP_ERROR StartTimer(RandomizedStartScheduler & scheduler, System::Clock::Timeout aTimeout) = 0;
+        virtual void CancelTimer(RandomizedStartScheduler & scheduler)                                     = 0;
+        virtual System::Clock::Timestamp GetCurrentMonotonicTimestamp()                                   = 0;
+    };
+
+    /**
+     * Timer delegate running the scheduler on a system layer.
+     */
+    class SystemLayerTimerDelegate : public TimerDelegate
+    {
+    public:
+        explicit SystemLayerTimerDelegate(System::Layer & aSystemLayer) : mSystemLayer(aSystemLayer) {}
+
+        CHIP_ERROR StartTimer(RandomizedStartScheduler & scheduler, System::Clock::Timeout aTimeout) override;
+        void CancelTimer(RandomizedStartScheduler & scheduler) override;
+        System::Clock::Timestamp GetCurrentMonotonicTimestamp() override;
+
+    private:
+        static void TimerExpired(System::Layer * aSystemLayer, void * aScheduler);
+
+        System::Layer & mSystemLayer;
+    };
+
+    explicit RandomizedStartScheduler(TimerDelegate & aTimerDelegate) : mTimerDelegate(aTimerDelegate) {}
+    ~RandomizedStartScheduler();
+
+    /**
+     * @brief Schedules `transition` after a random delay in [0, window[, with millisecond resolution.
+     *
+     * A transition already pending is rescheduled. With an empty window, the transition
+     * still starts from the timer, never from this call.
+     */
+    CHIP_ERROR Schedule(Transition & transition, System::Clock::Milliseconds32 window);
+
+    /**
+     * @brief Schedules `transition` at `startTime`, a monotonic timestamp.
+     */
+    CHIP_ERROR ScheduleAt(Transition & transition, System::Clock::Timestamp startTime);
+
+    /**
+     * @brief Removes `transition` from the pending transitions, if it is pending.
+     */
+    void Cancel(Transition & transition);
+
+    size_t GetPendingCount() const { return mPendingCount; }
+
+    /**
+     * @brief Starts the transitions whose start time was reached, then arms the timer for the next one.
+     */
+    void OnTimerExpired();
+
+private:
+    CHIP_ERROR ArmTimer();
+
+    TimerDelegate & mTimerDelegate;
+    // Pending transitions, by increasing start time; transitions with the same start time are kept in scheduling order.
+    // While OnTimerExpired() starts the due transitions, those are in a list of their own.
+    IntrusiveList<Transition> mPending;
+    size_t mPendingCount = 0;
+    // Start time the timer is armed for, if mTimerArmed.
+    System::Clock::Timestamp mTimerStartTime = System::Clock::kZero;
+    bool mTimerArmed                         = false;
+    bool mProcessing                         = false;
+};
+
+} // namespace Clusters
+} // namespace app
+} // namespace chip
@@ -15,6 +15,7 @@
  */
 
 #include "energy-evse-server.h"
+#include "ChargingTargetsStore.h"
 
 #include <app/AttributeAccessInterface.h>
 #include <app/AttributeAccessInterfaceRegistry.h>
@@ -360,28 +361,40 @@ void Instance::HandleStartDiagnostics(HandlerContext & ctx, const Commands::Star
 
 void Instance::HandleSetTargets(HandlerContext & ctx, const Commands::SetTargets::DecodableType & commandData)
 {
+    auto & chargingTargetSchedules = commandData.chargingTargetSchedules;
+
+    Status status = ChargingTargetsStore::ValidateSchedules(chargingTargetSchedules);
+    if (status != Status::Success)
+    {
+        ctx.mCommandHandler.AddStatus(ctx.mRequestPath, status);
+        return;
+    }
+
     // Call the delegate
-    // TODO
-    // Status status = mDelegate.SetTargets();
-    Status status = Status::UnsupportedCommand;
+    status = mDelegate.SetTargets(chargingTargetSchedules);
 
     ctx.mCommandHandler.AddStatus(ctx.mRequestPath, status);
 }
+
 void Instance::HandleGetTargets(HandlerContext & ctx, const Commands::GetTargets::DecodableType & commandData)
 {
+    Commands::GetTargetsResponse::Type response;
+
     // Call the delegate
-    // TODO
-    // Status status = mDelegate.GetTargets();
-    Status status = Status::UnsupportedCommand;
+    Status status = mDelegate.GetTargets(response.chargingTargetSchedules);
+    if (status != Status::Success)
+    {
+        ctx.mCommandHandler.AddStatus(ctx.mRequestPath, status);
+        return;
+    }
 
-    ctx.mCommandHandler.AddStatus(ctx.mRequestPath, status);
+    ctx.mCommandHandler.AddResponse(ctx.mRequestPath, response);
 }
+
 void Instance::HandleClearTargets(HandlerContext & ctx, const Commands::ClearTargets::DecodableType & commandData)
 {
     // Call the delegate
-    // TODO
-    // Status status = mDelegate.ClearTargets();
-    Status status = Status::UnsupportedCommand;
+    Status status = mDelegate.ClearTargets();
 
     ctx.mCommandHandler.AddStatus(ctx.mRequestPath, status);
 }
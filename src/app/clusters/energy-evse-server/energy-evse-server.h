@@ -81,6 +81,33 @@ public:
      */
     virtual Protocols::InteractionModel::Status StartDiagnostics() = 0;
 
+    /**
+     * @brief Delegate should implement a handler for the SetTargets command.
+     * The schedules have already been validated by the cluster server. Days
+     * not covered by any schedule must keep their current targets.
+     * It should report Status::Success if successful and may
+     * return other Status codes if it fails
+     */
+    virtual Protocols::InteractionModel::Status
+    SetTargets(const DataModel::DecodableList<Structs::ChargingTargetScheduleStruct::DecodableType> & chargingTargetSchedules) = 0;
+
+    /**
+     * @brief Delegate should implement a handler for the GetTargets command.
+     * The list returned in chargingTargetSchedules only needs to remain valid
+     * until the response has been encoded.
+     * It should report Status::Success if successful and may
+     * return other Status codes if it fails
+     */
+    virtual Protocols::InteractionModel::Status
+    GetTargets(DataModel::List<const Structs::ChargingTargetScheduleStruct::Type> & chargingTargetSchedules) = 0;
+
+    /**
+     * @brief Delegate should implement a handler for the ClearTargets command.
+     * It should report Status::Success if successful and may
+     * return other Status codes if it fails
+     */
+    virtual Protocols::InteractionModel::Status ClearTargets() = 0;
+
     // ------------------------------------------------------------------
     // Get attribute methods
     virtual StateEnum GetState()                                       = 0;
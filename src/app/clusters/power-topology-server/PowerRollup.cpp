@@ -0,0 +1,265 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "PowerRollup.h"
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TypeTraits.h>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace PowerTopology {
+
+namespace {
+
+uint8_t QuantityBit(PowerRollup::Quantity quantity)
+{
+    return static_cast<uint8_t>(1u << to_underlying(quantity));
+}
+
+} // namespace
+
+DataModel::Nullable<int64_t> PowerRollup::Node::GetMeasurement(Quantity quantity) const
+{
+    VerifyOrReturnValue((mHasMeasurement & QuantityBit(quantity)) != 0, DataModel::NullNullable);
+    return DataModel::MakeNullable(mMeasurements[to_underlying(quantity)]);
+}
+
+DataModel::Nullable<int64_t> PowerRollup::Node::GetTotal(Quantity quantity) const
+{
+    VerifyOrReturnValue(mMeasured[to_underlying(quantity)] > 0, DataModel::NullNullable);
+    return DataModel::MakeNullable(mTotals[to_underlying(quantity)]);
+}
+
+CHIP_ERROR PowerRollup::Node::GetChildAtIndex(size_t index, EndpointId & endpointId)
+{
+    for (auto & child : mChildren)
+    {
+        if (index-- == 0)
+        {
+            endpointId = child.mEndpointId;
+            return CHIP_NO_ERROR;
+        }
+    }
+    return CHIP_ERROR_PROVIDER_LIST_EXHAUSTED;
+}
+
+CHIP_ERROR PowerRollup::Node::GetActiveChildAtIndex(size_t index, EndpointId & endpointId)
+{
+    for (auto & child : mChildren)
+    {
+        if (child.mActive && index-- == 0)
+        {
+            endpointId = child.mEndpointId;
+            return CHIP_NO_ERROR;
+        }
+    }
+    return CHIP_ERROR_PROVIDER_LIST_EXHAUSTED;
+}
+
+PowerRollup::~PowerRollup()
+{
+    while (!mRoots.Empty())
+    {
+        Release(*mRoots.begin());
+    }
+}
+
+CHIP_ERROR PowerRollup::Add(Node & node, Node * parent)
+{
+    VerifyOrReturnError(node.mRollup == nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(parent == nullptr || parent->mRollup == this, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // A new node has no measurement yet, so the totals of its ancestors do not change.
+    node.mRollup = this;
+    node.mParent = parent;
+    if (parent == nullptr)
+    {
+        mRoots.PushBack(&node);
+        return CHIP_NO_ERROR;
+    }
+
+    parent->mChildren.PushBack(&node);
+    MarkChanged(*parent, Change::kChildren);
+    if (mUpdateDepth == 0)
+    {
+        BeginUpdate();
+        CommitUpdate();
+    }
+    return CHIP_NO_ERROR;
+}
+
+void PowerRollup::Remove(Node & node)
+{
+    VerifyOrReturn(node.mRollup == this);
+
+    BeginUpdate();
+
+    // Descendants first, so that the totals of the node are down to its own measurements.
+    while (!node.mChildren.Empty())
+    {
+        Remove(*node.mChildren.begin());
+    }
+
+    for (uint8_t i = 0; i < kQuantityCount; i++)
+    {
+        const Quantity quantity = static_cast<Quantity>(i);
+        if ((node.mHasMeasurement & QuantityBit(quantity)) != 0)
+        {
+            Propagate(node.mParent, quantity, -node.mMeasurements[i], -1);
+        }
+    }
+
+    if (node.mParent != nullptr)
+    {
+        MarkChanged(*node.mParent, Change::kChildren);
+        if (node.mActive)
+        {
+            MarkChanged(*node.mParent, Change::kActiveChildren);
+        }
+    }
+    Release(node);
+
+    CommitUpdate();
+}
+
+void PowerRollup::SetMeasurement(Node & node, Quantity quantity, const DataModel::Nullable<int64_t> & value)
+{
+    VerifyOrReturn(node.mRollup == this);
+
+    const uint8_t bit       = QuantityBit(quantity);
+    const bool hadValue     = (node.mHasMeasurement & bit) != 0;
+    int64_t & measurement   = node.mMeasurements[to_underlying(quantity)];
+    const int64_t oldValue  = hadValue ? measurement : 0;
+    const int64_t newValue  = value.IsNull() ? 0 : value.Value();
+    const int measuredDelta = (value.IsNull() ? 0 : 1) - (hadValue ? 1 : 0);
+    VerifyOrReturn(measuredDelta != 0 || newValue != oldValue);
+
+    measurement          = newValue;
+    node.mHasMeasurement = static_cast<uint8_t>(value.IsNull() ? (node.mHasMeasurement & ~bit) : (node.mHasMeasurement | bit));
+
+    BeginUpdate();
+    Propagate(&node, quantity, newValue - oldValue, measuredDelta);
+    CommitUpdate();
+}
+
+void PowerRollup::BeginUpdate()
+{
+    VerifyOrDie(mUpdateDepth < UINT8_MAX);
+    mUpdateDepth++;
+}
+
+void PowerRollup::CommitUpdate()
+{
+    VerifyOrReturn(mUpdateDepth > 0);
+    VerifyOrReturn(--mUpdateDepth == 0);
+
+    for (auto & root : mRoots)
+    {
+        Notify(root);
+    }
+}
+
+void PowerRollup::Propagate(Node * from, Quantity quantity, int64_t delta, int measuredDelta)
+{
+    const uint8_t index = to_underlying(quantity);
+
+    for (Node * node = from; node != nullptr; node = node->mParent)
+    {
+        node->mTotals[index] += delta;
+        node->mMeasured[index] = static_cast<uint16_t>(node->mMeasured[index] + measuredDelta);
+        MarkChanged(*node, Change::kTotals);
+
+        if (quantity == Quantity::kActivePower)
+        {
+            const bool active = node->mMeasured[index] > 0 && node->mTotals[index] != 0;
+            if (active != node->mActive && node->mParent != nullptr)
+            {
+                MarkChanged(*node->mParent, Change::kActiveChildren);
+            }
+            node->mActive = active;
+        }
+    }
+}
+
+void PowerRollup::MarkChanged(Node & node, Change change)
+{
+    node.mPendingChanges.Set(change);
+
+    // Ancestors of a node flagged as having pending descendants are flagged as well.
+    for (Node * ancestor = node.mParent; ancestor != nullptr && !ancestor->mPendingDescendants; ancestor = ancestor->mParent)
+    {
+        ancestor->mPendingDescendants = true;
+    }
+}
+
+void PowerRollup::Notify(Node & node)
+{
+    // Only the subtrees with pending changes are visited, children before their parent.
+    if (node.mPendingDescendants)
+    {
+        node.mPendingDescendants = false;
+        for (auto & child : node.mChildren)
+        {
+            Notify(child);
+        }
+    }
+
+    if (node.mPendingChanges.HasAny())
+    {
+        const BitFlags<Change> changes = node.mPendingChanges;
+        node.mPendingChanges.ClearAll();
+        node.OnRollupChanged(changes);
+    }
+}
+
+void PowerRollup::Release(Node & node)
+{
+    while (!node.mChildren.Empty())
+    {
+        Release(*node.mChildren.begin());
+    }
+
+    if (node.mParent != nullptr)
+    {
+        node.mParent->mChildren.Remove(&node);
+    }
+    else
+    {
+        mRoots.Remove(&node);
+    }
+
+    node.mRollup         = nullptr;
+    node.mParent         = nullptr;
+    node.mHasMeasurement = 0;
+    node.mActive         = false;
+    node.mPendingChanges.ClearAll();
+    node.mPendingDescendants = false;
+    for (uint8_t i = 0; i < kQuantityCount; i++)
+    {
+        node.mMeasurements[i] = 0;
+        node.mTotals[i]       = 0;
+        node.mMeasured[i]     = 0;
+    }
+}
+
+} // namespace PowerTopology
+} // namespace Clusters
+} // namespace app
+} // namespace chip
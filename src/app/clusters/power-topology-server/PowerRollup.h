@@ -0,0 +1,170 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/data-model/Nullable.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/BitFlags.h>
+#include <lib/support/IntrusiveList.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace PowerTopology {
+
+/**
+ * @brief Rolls the measurements of endpoints up into their parent endpoints (site meter,
+ *        sub-panel...), so that a controller can subscribe to the parent only instead of
+ *        subscribing to every child and summing client-side.
+ *
+ * Endpoints are the nodes of a forest. The total of a node is the sum of its own
+ * measurement and of the totals of its children, and is null if neither the node nor
+ * any of its descendants has a value. Totals are maintained incrementally: a new
+ * measurement only updates the totals of the node and of its ancestors, so its cost
+ * depends on the depth of the tree, not on the number of endpoints.
+ *
+ * Parents are typically not metered themselves, and only report the totals of their
+ * children on their ElectricalPowerMeasurement and ElectricalEnergyMeasurement clusters.
+ * The children list also provides the AvailableEndpoints and ActiveEndpoints attributes
+ * of their PowerTopology cluster.
+ */
+class PowerRollup
+{
+public:
+    enum class Quantity : uint8_t
+    {
+        kActivePower = 0,          // mW
+        kCumulativeEnergyImported, // mWh
+        kCumulativeEnergyExported, // mWh
+    };
+    static constexpr size_t kQuantityCount = 3;
+
+    enum class Change : uint8_t
+    {
+        kTotals         = 0x1, // A total of the node changed
+        kChildren       = 0x2, // A child was added or removed
+        kActiveChildren = 0x4, // A child started or stopped drawing or supplying power
+    };
+
+    class Node : public IntrusiveListNodeBase<>
+    {
+    public:
+        explicit Node(EndpointId endpointId) : mEndpointId(endpointId) {}
+
+        /* A node must be removed from the rollup before it is destroyed */
+        virtual ~Node() = default;
+
+        /**
+         * @brief Called once per update frame when the totals or the children of the node changed.
+         *
+         * The rollup must not be modified from here.
+         */
+        virtual void OnRollupChanged(BitFlags<Change> changes) {}
+
+        EndpointId GetEndpointId() const { return mEndpointId; }
+        Node * GetParent() const { return mParent; }
+
+        DataModel::Nullable<int64_t> GetMeasurement(Quantity quantity) const;
+        DataModel::Nullable<int64_t> GetTotal(Quantity quantity) const;
+
+        /**
+         * @brief Whether the total active power of the node is known and not zero.
+         */
+        bool IsActive() const { return mActive; }
+
+        /**
+         * @brief Get the endpoint of the Nth child, or of the Nth active child, in the order they were added.
+         *
+         * @return CHIP_ERROR_PROVIDER_LIST_EXHAUSTED if the index is greater than or equal to the number of
+         *         (active) children, as the PowerTopology delegate expects.
+         */
+        CHIP_ERROR GetChildAtIndex(size_t index, EndpointId & endpointId);
+        CHIP_ERROR GetActiveChildAtIndex(size_t index, EndpointId & endpointId);
+
+    private:
+        friend class PowerRollup;
+
+        EndpointId mEndpointId;
+        PowerRollup * mRollup = nullptr;
+        Node * mParent        = nullptr;
+        IntrusiveList<Node> mChildren;
+
+        int64_t mMeasurements[kQuantityCount] = {};
+        int64_t mTotals[kQuantityCount]       = {};
+        // Number of nodes of the subtree, this one included, that have a measurement of each quantity.
+        uint16_t mMeasured[kQuantityCount] = {};
+        uint8_t mHasMeasurement            = 0; // One bit per quantity
+        bool mActive                       = false;
+
+        BitFlags<Change> mPendingChanges;
+        bool mPendingDescendants = false; // Some descendant has pending changes
+    };
+
+    PowerRollup() = default;
+    ~PowerRollup();
+
+    PowerRollup(const PowerRollup &)             = delete;
+    PowerRollup & operator=(const PowerRollup &) = delete;
+
+    /**
+     * @brief Adds `node` under `parent`, or as a root if `parent` is null.
+     *
+     * @return CHIP_ERROR_INCORRECT_STATE if the node was already added, CHIP_ERROR_INVALID_ARGUMENT
+     *         if the parent was not added to this rollup.
+     */
+    CHIP_ERROR Add(Node & node, Node * parent = nullptr);
+
+    /**
+     * @brief Removes `node` and its descendants, and takes their measurements out of the totals of its ancestors.
+     */
+    void Remove(Node & node);
+
+    /**
+     * @brief Sets the measurement of a quantity of `node`, null if it is unknown, and updates the totals.
+     */
+    void SetMeasurement(Node & node, Quantity quantity, const DataModel::Nullable<int64_t> & value);
+
+    /**
+     * @brief Starts an update frame: until the matching CommitUpdate(), nodes are not notified of
+     *        changes, so that a node whose children all changed is only notified once.
+     *
+     * Frames can be nested, only the outermost CommitUpdate() notifies the nodes.
+     */
+    void BeginUpdate();
+    void CommitUpdate();
+
+private:
+    void Propagate(Node * from, Quantity quantity, int64_t delta, int measuredDelta);
+    void MarkChanged(Node & node, Change change);
+    void Notify(Node & node);
+    void Release(Node & node);
+
+    // Nodes without a parent
+    IntrusiveList<Node> mRoots;
+    uint8_t mUpdateDepth = 0;
+};
+
+} // namespace PowerTopology
+} // namespace Clusters
+} // namespace app
+} // namespace chip
@@ -33,6 +33,7 @@
 #include <app/reporting/Engine.h>
 #include <app/util/MatterCallbacks.h>
 #include <app/util/ember-compatibility-functions.h>
+#include <tracing/metric_event.h>
 
 using namespace chip::Access;
 
@@ -270,6 +271,12 @@ exit:
         attributeDataWritten = true;
     }
 
+    if (attributeDataWritten)
+    {
+        MATTER_LOG_METRIC(Tracing::kMetricIMAttributeEncodeBytes,
+                          static_cast<uint32_t>(attributeReportIBs.GetWriter()->GetLengthWritten() - emptyReportDataLength));
+    }
+
     if (apHasEncodedData != nullptr)
     {
         *apHasEncodedData = attributeDataWritten;
@@ -511,6 +518,8 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
     const uint32_t kReservedSizeForEventReportIBs = 3; // type, tag, end of container
 
     VerifyOrExit(apReadHandler != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
+    MATTER_LOG_METRIC_BEGIN(apReadHandler->IsType(ReadHandler::InteractionType::Subscribe) ? Tracing::kMetricIMSubscribeReportBuild
+                                                                                          : Tracing::kMetricIMReadReportBuild);
     VerifyOrExit(apReadHandler->GetSession() != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
     VerifyOrExit(!bufHandle.IsNull(), err = CHIP_ERROR_NO_MEMORY);
 
@@ -611,6 +620,10 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
                   mCurReadHandlerIdx, hasMoreChunks ? "more messages" : "no more messages");
 
 exit:
+    MATTER_LOG_METRIC_END(apReadHandler->IsType(ReadHandler::InteractionType::Subscribe) ? Tracing::kMetricIMSubscribeReportBuild
+                                                                                        : Tracing::kMetricIMReadReportBuild,
+                          err);
+
     if (err != CHIP_NO_ERROR || (apReadHandler->IsType(ReadHandler::InteractionType::Read) && !hasMoreChunks) ||
         needCloseReadHandler)
     {
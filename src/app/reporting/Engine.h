@@ -126,6 +126,12 @@ public:
 
     uint32_t GetNumReportsInFlight() const { return mNumReportsInFlight; }
 
+    /**
+     * Returns whether some attribute changes still have to be reported. Dirty paths
+     * are kept until every ReadHandler has reported all the changes it is interested in.
+     */
+    bool HasDirtyAttributePaths() const { return mGlobalDirtySet.Allocated() != 0; }
+
     uint64_t GetDirtySetGeneration() const { return mDirtyGeneration; }
 
     /**
@@ -64,6 +64,26 @@ void MatterReportingAttributeChangeCallback(const ConcreteAttributePath & aPath)
     return MatterReportingAttributeChangeCallback(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
 }
 
+void MatterReportingAttributeChangeCallback(EndpointId endpoint, ClusterId clusterId, Span<const AttributeId> attributeIds)
+{
+    // Attribute writes have asserted this already, but this assert should catch
+    // applications notifying about changes from their end.
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturn(!attributeIds.empty());
+
+    IncreaseClusterDataVersion(ConcreteClusterPath(endpoint, clusterId));
+    for (AttributeId attributeId : attributeIds)
+    {
+        AttributePathParams info;
+        info.mClusterId   = clusterId;
+        info.mAttributeId = attributeId;
+        info.mEndpointId  = endpoint;
+
+        InteractionModelEngine::GetInstance()->GetReportingEngine().SetDirty(info);
+    }
+}
+
 void MatterReportingAttributeChangeCallback(EndpointId endpoint)
 {
     // Attribute writes have asserted this already, but this assert should catch
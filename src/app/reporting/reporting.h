@@ -18,6 +18,7 @@
 #pragma once
 
 #include <app/ConcreteAttributePath.h>
+#include <lib/support/Span.h>
 
 /** @brief Reporting Attribute Change
  *
@@ -33,6 +34,13 @@ void MatterReportingAttributeChangeCallback(chip::EndpointId endpoint, chip::Clu
  */
 void MatterReportingAttributeChangeCallback(const chip::app::ConcreteAttributePath & aPath);
 
+/*
+ * Same but for several attributes of a cluster that changed at once: the cluster data version is
+ * increased once, and each of the attributes is marked dirty.
+ */
+void MatterReportingAttributeChangeCallback(chip::EndpointId endpoint, chip::ClusterId clusterId,
+                                            chip::Span<const chip::AttributeId> attributeIds);
+
 /*
  * Same but only with an EndpointId, this is used when adding / enabling an endpoint during runtime.
  */
@@ -157,8 +157,13 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
     // Set up attribute persistence before we try to bring up the data model
     // handler.
     SuccessOrExit(err = mAttributePersister.Init(mDeviceStorage));
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS > 0
+    SetAttributePersistenceProvider(&mWriteBehindAttributePersister);
+    SetSafeAttributePersistenceProvider(&mWriteBehindAttributePersister);
+#else
     SetAttributePersistenceProvider(&mAttributePersister);
     SetSafeAttributePersistenceProvider(&mAttributePersister);
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS > 0
 
     {
         FabricTable::InitParams fabricTableInitParams;
@@ -472,6 +477,12 @@ void Server::OnPlatformEvent(const DeviceLayer::ChipDeviceEvent & event)
         ResumeSubscriptions();
 #endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
         break;
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS > 0
+    case DeviceEventType::kFailSafeTimerExpired:
+        // Reverting the configuration may end with a restart of the device: do not lose attribute values.
+        mWriteBehindAttributePersister.Flush();
+        break;
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS > 0
 #if CHIP_SYSTEM_CONFIG_USE_OPEN_THREAD_ENDPOINT
     case DeviceEventType::kThreadConnectivityChange:
         if (event.ThreadConnectivityChange.Result == kConnectivity_Established)
@@ -559,6 +570,10 @@ void Server::GenerateShutDownEvent()
 void Server::ScheduleFactoryReset()
 {
     PlatformMgr().ScheduleWork([](intptr_t) {
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS > 0
+        // Pending attribute writes must not land in the storage after it is erased.
+        GetInstance().mWriteBehindAttributePersister.Discard();
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS > 0
         // Delete all fabrics and emit Leave event.
         GetInstance().GetFabricTable().DeleteAllFabrics();
         PlatformMgr().HandleServerShuttingDown();
@@ -609,6 +624,9 @@ void Server::Shutdown()
     mTestEventTriggerDelegate->RemoveHandler(&mICDManager);
     mICDManager.Shutdown();
 #endif // CHIP_CONFIG_ENABLE_ICD_SERVER
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS > 0
+    mWriteBehindAttributePersister.Flush();
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS > 0
     mAttributePersister.Shutdown();
     // TODO(16969): Remove chip::Platform::MemoryInit() call from Server class, it belongs to outer code
     chip::Platform::MemoryShutdown();
@@ -749,8 +767,12 @@ app::reporting::ReportSchedulerImpl
 SimpleSessionResumptionStorage CommonCaseDeviceServerInitParams::sSessionResumptionStorage;
 #endif
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+#if CHIP_CONFIG_COMPACT_SUBSCRIPTION_RESUMPTION_STORAGE
+app::CompactSubscriptionResumptionStorage CommonCaseDeviceServerInitParams::sSubscriptionResumptionStorage;
+#else
 app::SimpleSubscriptionResumptionStorage CommonCaseDeviceServerInitParams::sSubscriptionResumptionStorage;
 #endif
+#endif
 app::DefaultAclStorage CommonCaseDeviceServerInitParams::sAclStorage;
 Crypto::DefaultSessionKeystore CommonCaseDeviceServerInitParams::sSessionKeystore;
 
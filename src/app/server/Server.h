@@ -27,7 +27,11 @@
 #include <app/DefaultAttributePersistenceProvider.h>
 #include <app/FailSafeContext.h>
 #include <app/OperationalSessionSetupPool.h>
+#if CHIP_CONFIG_COMPACT_SUBSCRIPTION_RESUMPTION_STORAGE
+#include <app/CompactSubscriptionResumptionStorage.h>
+#else
 #include <app/SimpleSubscriptionResumptionStorage.h>
+#endif
 #include <app/TestEventTriggerDelegate.h>
 #include <app/server/AclStorage.h>
 #include <app/server/AppDelegate.h>
@@ -73,6 +77,10 @@
 #include <app/icd/server/ICDManager.h> // nogncheck
 #endif
 
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS > 0
+#include <app/WriteBehindAttributePersistenceProvider.h>
+#endif
+
 namespace chip {
 
 inline constexpr size_t kMaxBlePendingPackets = 1;
@@ -293,7 +301,11 @@ private:
     static SimpleSessionResumptionStorage sSessionResumptionStorage;
 #endif
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+#if CHIP_CONFIG_COMPACT_SUBSCRIPTION_RESUMPTION_STORAGE
+    static app::CompactSubscriptionResumptionStorage sSubscriptionResumptionStorage;
+#else
     static app::SimpleSubscriptionResumptionStorage sSubscriptionResumptionStorage;
+#endif
 #endif
     static app::DefaultAclStorage sAclStorage;
     static Crypto::DefaultSessionKeystore sSessionKeystore;
@@ -375,6 +387,20 @@ public:
 
     app::DefaultAttributePersistenceProvider & GetDefaultAttributePersister() { return mAttributePersister; }
 
+    /**
+     * The provider the server persists attributes through: the write-behind one if
+     * CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS is set, else the default one.
+     * Applications wrapping the attribute persistence should wrap this one.
+     */
+    app::AttributePersistenceProvider & GetAttributePersister()
+    {
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS > 0
+        return mWriteBehindAttributePersister;
+#else
+        return mAttributePersister;
+#endif
+    }
+
     app::reporting::ReportScheduler * GetReportScheduler() { return mReportScheduler; }
 
 #if CHIP_CONFIG_ENABLE_ICD_SERVER
@@ -647,6 +673,11 @@ private:
     Credentials::GroupDataProvider * mGroupsProvider;
     Crypto::SessionKeystore * mSessionKeystore;
     app::DefaultAttributePersistenceProvider mAttributePersister;
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS > 0
+    app::WriteBehindAttributePersistenceProvider mWriteBehindAttributePersister{
+        mAttributePersister, System::Clock::Milliseconds32(CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS)
+    };
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS > 0
     GroupDataProviderListener mListener;
     ServerFabricDelegate mFabricDelegate;
     app::reporting::ReportScheduler * mReportScheduler;
@@ -21,8 +21,11 @@
 #include <app/ConcreteAttributePath.h>
 #include <app/EventManagement.h>
 #include <app/util/mock/Constants.h>
+#include <app/util/mock/Functions.h>
+#include <app/util/mock/MockNodeConfig.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/TLVDebug.h>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/DLLUtil.h>
 #include <lib/support/LinkedList.h>
@@ -39,7 +42,18 @@ namespace {
 
 using P = app::ConcreteAttributePath;
 
-TEST(TestAttributePathExpandIterator, TestAllWildcard)
+class TestAttributePathExpandIterator : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite()
+    {
+        app::AttributePathExpandIterator::InvalidateExpansionCache();
+        chip::Platform::MemoryShutdown();
+    }
+};
+
+TEST_F(TestAttributePathExpandIterator, TestAllWildcard)
 {
     SingleLinkedListNode<app::AttributePathParams> clusInfo;
 
@@ -143,7 +157,7 @@ TEST(TestAttributePathExpandIterator, TestAllWildcard)
     EXPECT_EQ(index, ArraySize(paths));
 }
 
-TEST(TestAttributePathExpandIterator, TestWildcardEndpoint)
+TEST_F(TestAttributePathExpandIterator, TestWildcardEndpoint)
 {
     SingleLinkedListNode<app::AttributePathParams> clusInfo;
     clusInfo.mValue.mClusterId   = chip::Test::MockClusterId(3);
@@ -167,7 +181,7 @@ TEST(TestAttributePathExpandIterator, TestWildcardEndpoint)
     EXPECT_EQ(index, ArraySize(paths));
 }
 
-TEST(TestAttributePathExpandIterator, TestWildcardCluster)
+TEST_F(TestAttributePathExpandIterator, TestWildcardCluster)
 {
     SingleLinkedListNode<app::AttributePathParams> clusInfo;
     clusInfo.mValue.mEndpointId  = chip::Test::kMockEndpoint3;
@@ -194,7 +208,7 @@ TEST(TestAttributePathExpandIterator, TestWildcardCluster)
     EXPECT_EQ(index, ArraySize(paths));
 }
 
-TEST(TestAttributePathExpandIterator, TestWildcardClusterGlobalAttributeNotInMetadata)
+TEST_F(TestAttributePathExpandIterator, TestWildcardClusterGlobalAttributeNotInMetadata)
 {
     SingleLinkedListNode<app::AttributePathParams> clusInfo;
     clusInfo.mValue.mEndpointId  = chip::Test::kMockEndpoint3;
@@ -221,7 +235,7 @@ TEST(TestAttributePathExpandIterator, TestWildcardClusterGlobalAttributeNotInMet
     EXPECT_EQ(index, ArraySize(paths));
 }
 
-TEST(TestAttributePathExpandIterator, TestWildcardAttribute)
+TEST_F(TestAttributePathExpandIterator, TestWildcardAttribute)
 {
     SingleLinkedListNode<app::AttributePathParams> clusInfo;
     clusInfo.mValue.mEndpointId = chip::Test::kMockEndpoint2;
@@ -255,7 +269,7 @@ TEST(TestAttributePathExpandIterator, TestWildcardAttribute)
     EXPECT_EQ(index, ArraySize(paths));
 }
 
-TEST(TestAttributePathExpandIterator, TestNoWildcard)
+TEST_F(TestAttributePathExpandIterator, TestNoWildcard)
 {
     SingleLinkedListNode<app::AttributePathParams> clusInfo;
     clusInfo.mValue.mEndpointId  = chip::Test::kMockEndpoint2;
@@ -280,7 +294,7 @@ TEST(TestAttributePathExpandIterator, TestNoWildcard)
     EXPECT_EQ(index, ArraySize(paths));
 }
 
-TEST(TestAttributePathExpandIterator, TestMultipleClusInfo)
+TEST_F(TestAttributePathExpandIterator, TestMultipleClusInfo)
 {
 
     SingleLinkedListNode<app::AttributePathParams> clusInfo1;
@@ -424,4 +438,197 @@ TEST(TestAttributePathExpandIterator, TestMultipleClusInfo)
     EXPECT_EQ(index, ArraySize(paths));
 }
 
+TEST_F(TestAttributePathExpandIterator, TestResetCurrentCluster)
+{
+    SingleLinkedListNode<app::AttributePathParams> clusInfo;
+    clusInfo.mValue.mEndpointId = chip::Test::kMockEndpoint2;
+    clusInfo.mValue.mClusterId  = chip::Test::MockClusterId(3);
+
+    app::ConcreteAttributePath path;
+    app::AttributePathExpandIterator iter(&clusInfo);
+    EXPECT_TRUE(iter.Next());
+    EXPECT_TRUE(iter.Next());
+    EXPECT_TRUE(iter.Get(path));
+    EXPECT_EQ(P(kMockEndpoint2, MockClusterId(3), MockAttributeId(1)), path);
+
+    // The iterator goes back to the first attribute of the cluster.
+    iter.ResetCurrentCluster();
+    EXPECT_TRUE(iter.Get(path));
+    EXPECT_EQ(P(kMockEndpoint2, MockClusterId(3), Clusters::Globals::Attributes::ClusterRevision::Id), path);
+    EXPECT_TRUE(iter.Next());
+    EXPECT_TRUE(iter.Get(path));
+    EXPECT_EQ(P(kMockEndpoint2, MockClusterId(3), Clusters::Globals::Attributes::FeatureMap::Id), path);
+}
+
+TEST_F(TestAttributePathExpandIterator, TestExpansionCacheInvalidation)
+{
+    SingleLinkedListNode<app::AttributePathParams> clusInfo;
+    clusInfo.mValue.mClusterId = chip::Test::MockClusterId(3);
+
+    P paths[] = {
+        { kMockEndpoint2, MockClusterId(3), Clusters::Globals::Attributes::ClusterRevision::Id },
+        { kMockEndpoint2, MockClusterId(3), Clusters::Globals::Attributes::FeatureMap::Id },
+        { kMockEndpoint2, MockClusterId(3), MockAttributeId(1) },
+        { kMockEndpoint2, MockClusterId(3), MockAttributeId(2) },
+        { kMockEndpoint2, MockClusterId(3), MockAttributeId(3) },
+        { kMockEndpoint2, MockClusterId(3), Clusters::Globals::Attributes::GeneratedCommandList::Id },
+        { kMockEndpoint2, MockClusterId(3), Clusters::Globals::Attributes::AcceptedCommandList::Id },
+#if CHIP_CONFIG_ENABLE_EVENTLIST_ATTRIBUTE
+        { kMockEndpoint2, MockClusterId(3), Clusters::Globals::Attributes::EventList::Id },
+#endif
+        { kMockEndpoint2, MockClusterId(3), Clusters::Globals::Attributes::AttributeList::Id },
+        { kMockEndpoint3, MockClusterId(3), Clusters::Globals::Attributes::ClusterRevision::Id },
+        { kMockEndpoint3, MockClusterId(3), Clusters::Globals::Attributes::FeatureMap::Id },
+        { kMockEndpoint3, MockClusterId(3), Clusters::Globals::Attributes::GeneratedCommandList::Id },
+        { kMockEndpoint3, MockClusterId(3), Clusters::Globals::Attributes::AcceptedCommandList::Id },
+#if CHIP_CONFIG_ENABLE_EVENTLIST_ATTRIBUTE
+        { kMockEndpoint3, MockClusterId(3), Clusters::Globals::Attributes::EventList::Id },
+#endif
+        { kMockEndpoint3, MockClusterId(3), Clusters::Globals::Attributes::AttributeList::Id },
+    };
+
+    // Iterators expanding the same wildcard path, one of them interrupted by the expansions being invalidated, all see the
+    // same paths.
+    app::ConcreteAttributePath path;
+    app::AttributePathExpandIterator iter1(&clusInfo);
+    app::AttributePathExpandIterator iter2(&clusInfo);
+    for (size_t index = 0; index < ArraySize(paths); index++)
+    {
+        if (index == ArraySize(paths) / 2)
+        {
+            app::AttributePathExpandIterator::InvalidateExpansionCache();
+        }
+
+        EXPECT_TRUE(iter1.Get(path));
+        EXPECT_EQ(paths[index], path);
+        EXPECT_TRUE(path.mExpanded);
+        EXPECT_TRUE(iter2.Get(path));
+        EXPECT_EQ(paths[index], path);
+        iter1.Next();
+        iter2.Next();
+    }
+    EXPECT_FALSE(iter1.Get(path));
+    EXPECT_FALSE(iter2.Get(path));
+
+    size_t index = 0;
+    for (app::AttributePathExpandIterator iter(&clusInfo); iter.Get(path); iter.Next())
+    {
+        EXPECT_LT(index, ArraySize(paths));
+        EXPECT_EQ(paths[index], path);
+        index++;
+    }
+    EXPECT_EQ(index, ArraySize(paths));
+}
+
+#if CHIP_CONFIG_ATTRIBUTE_PATH_EXPANSION_CACHE_SIZE > 0
+TEST_F(TestAttributePathExpandIterator, TestEarlierEndpointDisabled)
+{
+    using namespace Clusters::Globals::Attributes;
+
+    // The default configuration with kMockEndpoint1 disabled, which shifts the indexes of the other endpoints, and only the
+    // cluster we expand, which shifts the cluster indexes too.
+    // clang-format off
+    static const MockNodeConfig config({
+        MockEndpointConfig(kMockEndpoint2, {
+            MockClusterConfig(MockClusterId(2), {
+                ClusterRevision::Id, FeatureMap::Id, MockAttributeId(1), MockAttributeId(2),
+            }),
+        }),
+        MockEndpointConfig(kMockEndpoint3, {
+            MockClusterConfig(MockClusterId(2), {
+                ClusterRevision::Id, FeatureMap::Id, MockAttributeId(1), MockAttributeId(2), MockAttributeId(3), MockAttributeId(4),
+            }),
+        }),
+    });
+    // clang-format on
+
+    SingleLinkedListNode<app::AttributePathParams> clusInfo;
+    clusInfo.mValue.mClusterId = chip::Test::MockClusterId(2);
+
+    P paths[] = {
+        { kMockEndpoint1, MockClusterId(2), ClusterRevision::Id },
+        { kMockEndpoint1, MockClusterId(2), FeatureMap::Id },
+        { kMockEndpoint1, MockClusterId(2), MockAttributeId(1) },
+        { kMockEndpoint1, MockClusterId(2), GeneratedCommandList::Id },
+        { kMockEndpoint1, MockClusterId(2), AcceptedCommandList::Id },
+#if CHIP_CONFIG_ENABLE_EVENTLIST_ATTRIBUTE
+        { kMockEndpoint1, MockClusterId(2), EventList::Id },
+#endif
+        { kMockEndpoint1, MockClusterId(2), AttributeList::Id },
+        { kMockEndpoint2, MockClusterId(2), ClusterRevision::Id },
+        { kMockEndpoint2, MockClusterId(2), FeatureMap::Id },
+        { kMockEndpoint2, MockClusterId(2), MockAttributeId(1) },
+        { kMockEndpoint2, MockClusterId(2), MockAttributeId(2) },
+        { kMockEndpoint2, MockClusterId(2), GeneratedCommandList::Id },
+        { kMockEndpoint2, MockClusterId(2), AcceptedCommandList::Id },
+#if CHIP_CONFIG_ENABLE_EVENTLIST_ATTRIBUTE
+        { kMockEndpoint2, MockClusterId(2), EventList::Id },
+#endif
+        { kMockEndpoint2, MockClusterId(2), AttributeList::Id },
+        { kMockEndpoint3, MockClusterId(2), ClusterRevision::Id },
+        { kMockEndpoint3, MockClusterId(2), FeatureMap::Id },
+        { kMockEndpoint3, MockClusterId(2), MockAttributeId(1) },
+        { kMockEndpoint3, MockClusterId(2), MockAttributeId(2) },
+        { kMockEndpoint3, MockClusterId(2), MockAttributeId(3) },
+        { kMockEndpoint3, MockClusterId(2), MockAttributeId(4) },
+        { kMockEndpoint3, MockClusterId(2), GeneratedCommandList::Id },
+        { kMockEndpoint3, MockClusterId(2), AcceptedCommandList::Id },
+#if CHIP_CONFIG_ENABLE_EVENTLIST_ATTRIBUTE
+        { kMockEndpoint3, MockClusterId(2), EventList::Id },
+#endif
+        { kMockEndpoint3, MockClusterId(2), AttributeList::Id },
+    };
+
+    // iter1 carries on with the new expansion of the path, iter2 with the metadata, as the cache is full when it notices the
+    // change. reset1 and reset2 are in the same states, but go back to the start of the cluster instead.
+    app::ConcreteAttributePath path;
+    app::AttributePathExpandIterator iter1(&clusInfo);
+    app::AttributePathExpandIterator iter2(&clusInfo);
+    size_t index = 0;
+    for (; !(paths[index] == P(kMockEndpoint2, MockClusterId(2), MockAttributeId(1))); index++)
+    {
+        iter1.Next();
+        iter2.Next();
+    }
+    EXPECT_TRUE(iter1.Get(path));
+    EXPECT_EQ(paths[index], path);
+    EXPECT_TRUE(iter2.Get(path));
+    EXPECT_EQ(paths[index], path);
+    app::AttributePathExpandIterator reset1 = iter1;
+    app::AttributePathExpandIterator reset2 = iter2;
+
+    SetMockNodeConfig(config);
+    SingleLinkedListNode<app::AttributePathParams> otherClusInfos[CHIP_CONFIG_ATTRIBUTE_PATH_EXPANSION_CACHE_SIZE];
+    for (uint32_t i = 0; i < ArraySize(otherClusInfos); i++)
+    {
+        otherClusInfos[i].mValue.mAttributeId = MockAttributeId(i + 1);
+        app::AttributePathExpandIterator other(&otherClusInfos[i]);
+    }
+    iter2.Next();
+    reset2.ResetCurrentCluster();
+    app::AttributePathExpandIterator::InvalidateExpansionCache();
+    iter1.Next();
+    reset1.ResetCurrentCluster();
+
+    for (index++; index < ArraySize(paths); index++)
+    {
+        EXPECT_TRUE(iter1.Get(path));
+        EXPECT_EQ(paths[index], path);
+        EXPECT_TRUE(iter2.Get(path));
+        EXPECT_EQ(paths[index], path);
+        iter1.Next();
+        iter2.Next();
+    }
+    EXPECT_FALSE(iter1.Get(path));
+    EXPECT_FALSE(iter2.Get(path));
+
+    EXPECT_TRUE(reset1.Get(path));
+    EXPECT_EQ(P(kMockEndpoint2, MockClusterId(2), ClusterRevision::Id), path);
+    EXPECT_TRUE(reset2.Get(path));
+    EXPECT_EQ(P(kMockEndpoint2, MockClusterId(2), ClusterRevision::Id), path);
+
+    ResetMockNodeConfig();
+}
+#endif // CHIP_CONFIG_ATTRIBUTE_PATH_EXPANSION_CACHE_SIZE > 0
+
 } // namespace
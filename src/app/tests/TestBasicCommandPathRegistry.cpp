@@ -114,6 +114,27 @@ TEST(TestBasicCommandPathRegistry, TestAddingTooManyEntries)
     EXPECT_EQ(basicCommandPathRegistry.Count(), kQuickTestSize);
 }
 
+TEST(TestBasicCommandPathRegistry, TestFindIndex)
+{
+    BasicCommandPathRegistry<kQuickTestSize> basicCommandPathRegistry;
+
+    // Paths are added in the order of the InvokeRequests, with command refs in any order.
+    for (uint16_t endpoint = 0; endpoint < kQuickTestSize; endpoint++)
+    {
+        ConcreteCommandPath concretePath(endpoint, 0, 0);
+        std::optional<uint16_t> commandRef(static_cast<uint16_t>(kQuickTestSize - endpoint));
+        ASSERT_EQ(basicCommandPathRegistry.Add(concretePath, commandRef), CHIP_NO_ERROR);
+    }
+
+    for (uint16_t endpoint = 0; endpoint < kQuickTestSize; endpoint++)
+    {
+        auto index = basicCommandPathRegistry.FindIndex(ConcreteCommandPath(endpoint, 0, 0));
+        ASSERT_TRUE(index.has_value());
+        EXPECT_EQ(*index, endpoint);
+    }
+    EXPECT_FALSE(basicCommandPathRegistry.FindIndex(ConcreteCommandPath(kQuickTestSize, 0, 0)).has_value());
+}
+
 } // namespace TestBasicCommandPathRegistry
 } // namespace app
 } // namespace chip
@@ -684,10 +684,147 @@ void TestCache(nlTestSuite * apSuite, void * apContext)
                              AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData) });
 }
 
+class NoopCacheCallback : public ClusterStateCache::Callback
+{
+    void OnDone(ReadClient *) override {}
+};
+
+// Lets the cache know about the paths of a subscription, as a ReadClient does when it builds its request.
+void SetRequestPaths(ReadClient::Callback & callback, const Span<AttributePathParams> & paths)
+{
+    uint8_t buf[20];
+    TLV::TLVWriter writer;
+    writer.Init(buf);
+    DataVersionFilterIBs::Builder builder;
+    NL_TEST_ASSERT(gSuite, builder.Init(&writer) == CHIP_NO_ERROR);
+    bool encodedDataVersionList = false;
+    NL_TEST_ASSERT(gSuite, callback.OnUpdateDataVersionFilterList(builder, paths, encodedDataVersionList) == CHIP_NO_ERROR);
+}
+
+void ReportValue(ReadClient::Callback & callback, EndpointId endpoint, ClusterId cluster, DataVersion version)
+{
+    uint8_t buf[8];
+    TLV::TLVWriter writer;
+    writer.Init(buf);
+    NL_TEST_ASSERT(gSuite, writer.Put(TLV::AnonymousTag(), static_cast<uint16_t>(version)) == CHIP_NO_ERROR);
+
+    TLV::TLVReader reader;
+    reader.Init(buf, writer.GetLengthWritten());
+    NL_TEST_ASSERT(gSuite, reader.Next() == CHIP_NO_ERROR);
+    ConcreteDataAttributePath path(endpoint, cluster, 0, MakeOptional(version));
+    callback.OnAttributeData(path, &reader, StatusIB());
+}
+
+void TestSplitAttributePaths(nlTestSuite * apSuite, void * apContext)
+{
+    NoopCacheCallback callback;
+    ClusterStateCache cache(callback);
+
+    AttributePathParams paths[] = { AttributePathParams(), AttributePathParams(7, Clusters::UnitTesting::Id, 0) };
+    std::vector<std::vector<AttributePathParams>> groups;
+    ClusterStateCache::SplitParameters params;
+    params.mMaxFiltersPerGroup = 4;
+
+    // Nothing to split before the cache has data.
+    NL_TEST_ASSERT(apSuite, cache.SplitAttributePaths(Span<AttributePathParams>(paths), params, groups) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, groups.size() == 1);
+    NL_TEST_ASSERT(apSuite, groups[0].size() == 2);
+
+    SetRequestPaths(cache.GetBufferedCallback(), Span<AttributePathParams>(paths, 1));
+    cache.GetBufferedCallback().OnReportBegin();
+    for (EndpointId endpoint = 1; endpoint <= 3; endpoint++)
+    {
+        ReportValue(cache.GetBufferedCallback(), endpoint, Clusters::UnitTesting::Id, 1);
+        ReportValue(cache.GetBufferedCallback(), endpoint, Clusters::Identify::Id, 1);
+    }
+    cache.GetBufferedCallback().OnReportEnd();
+
+    // With the default limits, the filters of all the endpoints fit into a single group, which has no room for the path to
+    // the unknown endpoint.
+    NL_TEST_ASSERT(apSuite,
+                   cache.SplitAttributePaths(Span<AttributePathParams>(paths), ClusterStateCache::SplitParameters(), groups) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, groups.size() == 2);
+    NL_TEST_ASSERT(apSuite, groups[0].size() == 3);
+    NL_TEST_ASSERT(apSuite, groups[0][0].mEndpointId == 1 && groups[0][1].mEndpointId == 2 && groups[0][2].mEndpointId == 3);
+    NL_TEST_ASSERT(apSuite, groups[1].size() == 1 && groups[1][0].mEndpointId == 7);
+
+    // Two endpoints with two filters each per group, and the path to the unknown endpoint with the last group.
+    NL_TEST_ASSERT(apSuite, cache.SplitAttributePaths(Span<AttributePathParams>(paths), params, groups) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, groups.size() == 2);
+    NL_TEST_ASSERT(apSuite, groups[0].size() == 2);
+    NL_TEST_ASSERT(apSuite, groups[0][0].mEndpointId == 1 && groups[0][0].HasWildcardClusterId());
+    NL_TEST_ASSERT(apSuite, groups[0][1].mEndpointId == 2 && groups[0][1].HasWildcardClusterId());
+    NL_TEST_ASSERT(apSuite, groups[1].size() == 2);
+    NL_TEST_ASSERT(apSuite, groups[1][0].mEndpointId == 3);
+    NL_TEST_ASSERT(apSuite, groups[1][1].mEndpointId == 7);
+
+    // An endpoint with more filters than the limit gets a group of its own.
+    params.mMaxFiltersPerGroup = 1;
+    NL_TEST_ASSERT(apSuite, cache.SplitAttributePaths(Span<AttributePathParams>(paths), params, groups) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, groups.size() == 3);
+
+    // Without room for that many subscriptions, the paths are not split.
+    params.mMaxGroups = 2;
+    NL_TEST_ASSERT(apSuite, cache.SplitAttributePaths(Span<AttributePathParams>(paths), params, groups) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, groups.size() == 1);
+    NL_TEST_ASSERT(apSuite, groups[0].size() == 2);
+    NL_TEST_ASSERT(apSuite, groups[0][0].HasWildcardEndpointId());
+
+    // The paths per group are limited as well, the path to the unknown endpoint getting a group of its own.
+    params.mMaxFiltersPerGroup = 4;
+    params.mMaxPathsPerGroup   = 1;
+    params.mMaxGroups          = 4;
+    NL_TEST_ASSERT(apSuite, cache.SplitAttributePaths(Span<AttributePathParams>(paths), params, groups) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, groups.size() == 4);
+    for (const auto & group : groups)
+    {
+        NL_TEST_ASSERT(apSuite, group.size() == 1);
+    }
+    NL_TEST_ASSERT(apSuite, groups[3][0].mEndpointId == 7);
+}
+
+void TestPartitions(nlTestSuite * apSuite, void * apContext)
+{
+    NoopCacheCallback callback;
+    ClusterStateCache cache(callback);
+    ClusterStateCache::Partition partition1(cache);
+    ClusterStateCache::Partition partition2(cache);
+
+    AttributePathParams paths1[] = { AttributePathParams(1, kInvalidClusterId, kInvalidAttributeId) };
+    AttributePathParams paths2[] = { AttributePathParams(2, kInvalidClusterId, kInvalidAttributeId) };
+    SetRequestPaths(partition1.GetBufferedCallback(), Span<AttributePathParams>(paths1));
+    SetRequestPaths(partition2.GetBufferedCallback(), Span<AttributePathParams>(paths2));
+
+    // The report of the second subscription comes in the middle of the first cluster of the report of the first one.
+    partition1.GetBufferedCallback().OnReportBegin();
+    ReportValue(partition1.GetBufferedCallback(), 1, Clusters::UnitTesting::Id, 5);
+    partition2.GetBufferedCallback().OnReportBegin();
+    ReportValue(partition2.GetBufferedCallback(), 2, Clusters::UnitTesting::Id, 7);
+    ReportValue(partition2.GetBufferedCallback(), 2, Clusters::Identify::Id, 8);
+    partition2.GetBufferedCallback().OnReportEnd();
+
+    Optional<DataVersion> version;
+    NL_TEST_ASSERT(apSuite, cache.GetVersion(ConcreteClusterPath(2, Clusters::UnitTesting::Id), version) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, version.ValueOr(0) == 7);
+    NL_TEST_ASSERT(apSuite, cache.GetVersion(ConcreteClusterPath(2, Clusters::Identify::Id), version) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, version.ValueOr(0) == 8);
+
+    // The cluster of the first subscription is still incomplete.
+    NL_TEST_ASSERT(apSuite, cache.GetVersion(ConcreteClusterPath(1, Clusters::UnitTesting::Id), version) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, !version.HasValue());
+
+    partition1.GetBufferedCallback().OnReportEnd();
+    NL_TEST_ASSERT(apSuite, cache.GetVersion(ConcreteClusterPath(1, Clusters::UnitTesting::Id), version) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, version.ValueOr(0) == 5);
+}
+
 // clang-format off
 const nlTest sTests[] =
 {
     NL_TEST_DEF("TestCache", TestCache),
+    NL_TEST_DEF("TestSplitAttributePaths", TestSplitAttributePaths),
+    NL_TEST_DEF("TestPartitions", TestPartitions),
     NL_TEST_SENTINEL()
 };
 
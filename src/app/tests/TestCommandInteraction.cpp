@@ -330,6 +330,110 @@ public:
     int onFinalCalledTimes = 0;
 } mockCommandHandlerDelegate;
 
+/**
+ * Handles every command asynchronously, as a bridge forwarding commands to slow devices would,
+ * and responds to each command when the test calls Complete(), or once its simulated I/O completes.
+ */
+class AsyncBatchCommandHandlerCallback : public CommandHandlerImpl::Callback
+{
+public:
+    static constexpr size_t kMaxCommands = 8;
+
+    enum class IoMode : uint8_t
+    {
+        kManual,     ///< Commands complete when the test calls Complete().
+        kSequential, ///< The I/O of a command starts when the previous command completes.
+        kConcurrent, ///< The I/O of all commands starts when they are dispatched.
+    };
+
+    void OnDone(CommandHandlerImpl & apCommandHandler) final { mDone = true; }
+    void DispatchCommand(CommandHandlerImpl & apCommandObj, const ConcreteCommandPath & aCommandPath,
+                         TLV::TLVReader & apPayload) final
+    {
+        NL_TEST_ASSERT(gSuite, mDispatchedCount < kMaxCommands);
+        PendingCommand & command = mCommands[mDispatchedCount];
+        command.mOwner           = this;
+        command.mIndex           = mDispatchedCount++;
+        command.mPath            = aCommandPath;
+        command.mHandle          = CommandHandler::Handle(&apCommandObj);
+
+        if (mIoMode == IoMode::kConcurrent || (mIoMode == IoMode::kSequential && command.mIndex == 0))
+        {
+            StartIo(command);
+        }
+    }
+    InteractionModel::Status CommandExists(const ConcreteCommandPath & aCommandPath)
+    {
+        return ServerClusterCommandExists(aCommandPath);
+    }
+
+    void Complete(size_t aIndex)
+    {
+        PendingCommand & command = mCommands[aIndex];
+        CommandHandler * handler = command.mHandle.Get();
+        NL_TEST_ASSERT(gSuite, handler != nullptr);
+
+        // Alternate between data and status responses, which are encoded differently.
+        if (aIndex % 2 == 0)
+        {
+            SimpleTLVPayload payloadWriter;
+            handler->AddResponse(command.mPath, command.mPath.mCommandId, payloadWriter);
+        }
+        else
+        {
+            handler->AddStatus(command.mPath, Protocols::InteractionModel::Status::Success);
+        }
+        command.mHandle.Release();
+        mCompletedCount++;
+
+        if (mIoMode == IoMode::kSequential && aIndex + 1 < mDispatchedCount)
+        {
+            StartIo(mCommands[aIndex + 1]);
+        }
+    }
+
+    void Reset(System::Layer * apSystemLayer = nullptr, IoMode aIoMode = IoMode::kManual,
+               System::Clock::Milliseconds32 aIoLatency = System::Clock::Milliseconds32(0))
+    {
+        mpSystemLayer    = apSystemLayer;
+        mIoMode          = aIoMode;
+        mIoLatency       = aIoLatency;
+        mDispatchedCount = 0;
+        mCompletedCount  = 0;
+        mDone            = false;
+    }
+
+    size_t mDispatchedCount = 0;
+    size_t mCompletedCount  = 0;
+    bool mDone              = false;
+
+private:
+    struct PendingCommand
+    {
+        AsyncBatchCommandHandlerCallback * mOwner = nullptr;
+        size_t mIndex                             = 0;
+        ConcreteCommandPath mPath                 = ConcreteCommandPath(0, 0, 0);
+        CommandHandler::Handle mHandle;
+    };
+
+    void StartIo(PendingCommand & aCommand)
+    {
+        CHIP_ERROR err = mpSystemLayer->StartTimer(mIoLatency, OnIoDone, &aCommand);
+        NL_TEST_ASSERT(gSuite, err == CHIP_NO_ERROR);
+    }
+
+    static void OnIoDone(System::Layer * aLayer, void * aAppState)
+    {
+        PendingCommand * command = static_cast<PendingCommand *>(aAppState);
+        command->mOwner->Complete(command->mIndex);
+    }
+
+    System::Layer * mpSystemLayer = nullptr;
+    IoMode mIoMode                = IoMode::kManual;
+    System::Clock::Milliseconds32 mIoLatency{ 0 };
+    PendingCommand mCommands[kMaxCommands];
+};
+
 class TestCommandInteraction
 {
 public:
@@ -361,6 +465,9 @@ public:
     static void TestCommandHandlerRejectsMultipleCommandsWithIdenticalCommandRef(nlTestSuite * apSuite, void * apContext);
     static void TestCommandHandlerRejectMultipleCommandsWhenHandlerOnlySupportsOne(nlTestSuite * apSuite, void * apContext);
     static void TestCommandHandlerAcceptMultipleCommands(nlTestSuite * apSuite, void * apContext);
+    static void TestCommandHandlerAsyncBatchRespondsInRequestOrder(nlTestSuite * apSuite, void * apContext);
+    static void TestCommandHandlerAsyncBatchRespondsInRequestOrderWhenCompletedInReverse(nlTestSuite * apSuite, void * apContext);
+    static void BenchmarkCommandHandlerAsyncBatchLatency(nlTestSuite * apSuite, void * apContext);
     static void TestCommandHandler_FillUpInvokeResponseMessageWhereSecondResponseIsStatusResponse(nlTestSuite * apSuite,
                                                                                                   void * apContext);
     static void TestCommandHandler_FillUpInvokeResponseMessageWhereSecondResponseIsDataResponsePrimative(nlTestSuite * apSuite,
@@ -435,6 +542,10 @@ private:
     static void FillCurrentInvokeResponseBuffer(nlTestSuite * apSuite, CommandHandlerImpl * apCommandHandler,
                                                 const ConcreteCommandPath & aRequestCommandPath, uint32_t aSizeToLeaveInBuffer);
     static void ValidateCommandHandlerEncodeInvokeResponseMessage(nlTestSuite * apSuite, void * apContext, bool aNeedStatusCode);
+    static void GenerateBatchInvokeRequest(nlTestSuite * apSuite, void * apContext, System::PacketBufferHandle & aPayload,
+                                           uint16_t aCommandCount);
+    static void CheckResponsesInRequestOrder(nlTestSuite * apSuite, System::PacketBufferHandle && aResponses,
+                                             uint16_t aCommandCount);
 };
 
 class TestExchangeDelegate : public Messaging::ExchangeDelegate
@@ -1940,6 +2051,194 @@ void TestCommandInteraction::TestCommandHandlerAcceptMultipleCommands(nlTestSuit
     NL_TEST_ASSERT(apSuite, commandDispatchedCount == 2);
 }
 
+void TestCommandInteraction::GenerateBatchInvokeRequest(nlTestSuite * apSuite, void * apContext,
+                                                        System::PacketBufferHandle & aPayload, uint16_t aCommandCount)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+
+    PendingResponseTrackerImpl pendingResponseTracker;
+    app::CommandSender commandSender(kCommandSenderTestOnlyMarker, &mockCommandSenderExtendedDelegate, &ctx.GetExchangeManager(),
+                                     &pendingResponseTracker);
+
+    app::CommandSender::ConfigParameters configParameters;
+    configParameters.SetRemoteMaxPathsPerInvoke(aCommandCount);
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == commandSender.SetCommandSenderConfig(configParameters));
+
+    for (uint16_t i = 0; i < aCommandCount; i++)
+    {
+        // Commands of a batch must have distinct paths: use a distinct command id for each.
+        auto commandPathParams = MakeTestCommandPath(static_cast<CommandId>(0x10 + i));
+
+        app::CommandSender::PrepareCommandParameters prepareCommandParams;
+        prepareCommandParams.SetStartDataStruct(true);
+        prepareCommandParams.SetCommandRef(i);
+        NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == commandSender.PrepareCommand(commandPathParams, prepareCommandParams));
+        NL_TEST_ASSERT(apSuite,
+                       CHIP_NO_ERROR == commandSender.GetCommandDataIBTLVWriter()->PutBoolean(chip::TLV::ContextTag(1), true));
+        app::CommandSender::FinishCommandParameters finishCommandParams;
+        finishCommandParams.SetEndDataStruct(true);
+        finishCommandParams.SetCommandRef(i);
+        NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == commandSender.FinishCommand(finishCommandParams));
+    }
+
+    commandSender.MoveToState(app::CommandSender::State::AddedCommand);
+    NL_TEST_ASSERT(apSuite, commandSender.Finalize(aPayload) == CHIP_NO_ERROR);
+}
+
+void TestCommandInteraction::CheckResponsesInRequestOrder(nlTestSuite * apSuite, System::PacketBufferHandle && aResponses,
+                                                          uint16_t aCommandCount)
+{
+    NL_TEST_ASSERT(apSuite, !aResponses.IsNull());
+    NL_TEST_ASSERT(apSuite, !aResponses->HasChainedBuffer());
+
+    System::PacketBufferTLVReader reader;
+    reader.Init(std::move(aResponses));
+    InvokeResponseMessage::Parser invokeResponseMessage;
+    NL_TEST_ASSERT(apSuite, invokeResponseMessage.Init(reader) == CHIP_NO_ERROR);
+    InvokeResponseIBs::Parser invokeResponses;
+    NL_TEST_ASSERT(apSuite, invokeResponseMessage.GetInvokeResponses(&invokeResponses) == CHIP_NO_ERROR);
+
+    TLV::TLVReader invokeResponsesReader;
+    invokeResponses.GetReader(&invokeResponsesReader);
+
+    uint16_t expectedRef = 0;
+    CHIP_ERROR err;
+    while ((err = invokeResponsesReader.Next()) == CHIP_NO_ERROR)
+    {
+        InvokeResponseIB::Parser invokeResponse;
+        NL_TEST_ASSERT(apSuite, invokeResponse.Init(invokeResponsesReader) == CHIP_NO_ERROR);
+
+        uint16_t ref = UINT16_MAX;
+        CommandDataIB::Parser commandData;
+        CommandStatusIB::Parser commandStatus;
+        if (invokeResponse.GetCommand(&commandData) == CHIP_NO_ERROR)
+        {
+            NL_TEST_ASSERT(apSuite, expectedRef % 2 == 0);
+            NL_TEST_ASSERT(apSuite, commandData.GetRef(&ref) == CHIP_NO_ERROR);
+        }
+        else
+        {
+            NL_TEST_ASSERT(apSuite, expectedRef % 2 == 1);
+            NL_TEST_ASSERT(apSuite, invokeResponse.GetStatus(&commandStatus) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite, commandStatus.GetRef(&ref) == CHIP_NO_ERROR);
+        }
+        NL_TEST_ASSERT(apSuite, ref == expectedRef);
+        expectedRef++;
+    }
+    NL_TEST_ASSERT(apSuite, err == CHIP_END_OF_TLV);
+    NL_TEST_ASSERT(apSuite, expectedRef == aCommandCount);
+}
+
+void TestCommandInteraction::TestCommandHandlerAsyncBatchRespondsInRequestOrder(nlTestSuite * apSuite, void * apContext)
+{
+    constexpr uint16_t kCommandCount    = 5;
+    constexpr size_t kCompletionOrder[] = { 3, 1, 4, 0, 2 };
+
+    System::PacketBufferHandle commandDatabuf;
+    GenerateBatchInvokeRequest(apSuite, apContext, commandDatabuf, kCommandCount);
+
+    AsyncBatchCommandHandlerCallback asyncBatchCallback;
+    asyncBatchCallback.Reset();
+    BasicCommandPathRegistry<kCommandCount> basicCommandPathRegistry;
+    MockCommandResponder mockCommandResponder;
+    CommandHandlerImpl::TestOnlyOverrides testOnlyOverrides{ &basicCommandPathRegistry, &mockCommandResponder };
+    CommandHandlerImpl commandHandler(testOnlyOverrides, &asyncBatchCallback);
+
+    InteractionModel::Status status = commandHandler.OnInvokeCommandRequest(mockCommandResponder, std::move(commandDatabuf), false);
+    NL_TEST_ASSERT(apSuite, status == InteractionModel::Status::Success);
+    NL_TEST_ASSERT(apSuite, asyncBatchCallback.mDispatchedCount == kCommandCount);
+
+    // All the commands are in flight at once, and complete in an order unrelated to the request.
+    for (size_t index : kCompletionOrder)
+    {
+        NL_TEST_ASSERT(apSuite, !asyncBatchCallback.mDone);
+        asyncBatchCallback.Complete(index);
+    }
+    NL_TEST_ASSERT(apSuite, asyncBatchCallback.mDone);
+    NL_TEST_ASSERT(apSuite, !mockCommandResponder.mResponseDropped);
+
+    // The responses are nonetheless encoded in the order of the requests.
+    CheckResponsesInRequestOrder(apSuite, std::move(mockCommandResponder.mChunks), kCommandCount);
+}
+
+void TestCommandInteraction::TestCommandHandlerAsyncBatchRespondsInRequestOrderWhenCompletedInReverse(nlTestSuite * apSuite,
+                                                                                                    void * apContext)
+{
+    constexpr uint16_t kCommandCount = AsyncBatchCommandHandlerCallback::kMaxCommands;
+
+    System::PacketBufferHandle commandDatabuf;
+    GenerateBatchInvokeRequest(apSuite, apContext, commandDatabuf, kCommandCount);
+
+    AsyncBatchCommandHandlerCallback asyncBatchCallback;
+    asyncBatchCallback.Reset();
+    BasicCommandPathRegistry<kCommandCount> basicCommandPathRegistry;
+    MockCommandResponder mockCommandResponder;
+    CommandHandlerImpl::TestOnlyOverrides testOnlyOverrides{ &basicCommandPathRegistry, &mockCommandResponder };
+    CommandHandlerImpl commandHandler(testOnlyOverrides, &asyncBatchCallback);
+
+    InteractionModel::Status status = commandHandler.OnInvokeCommandRequest(mockCommandResponder, std::move(commandDatabuf), false);
+    NL_TEST_ASSERT(apSuite, status == InteractionModel::Status::Success);
+    NL_TEST_ASSERT(apSuite, asyncBatchCallback.mDispatchedCount == kCommandCount);
+
+    // The first request completes last, so every other response has to be held back until then.
+    for (size_t index = kCommandCount; index-- > 0;)
+    {
+        NL_TEST_ASSERT(apSuite, !asyncBatchCallback.mDone);
+        NL_TEST_ASSERT(apSuite, mockCommandResponder.mChunks.IsNull());
+        asyncBatchCallback.Complete(index);
+    }
+    NL_TEST_ASSERT(apSuite, asyncBatchCallback.mDone);
+    NL_TEST_ASSERT(apSuite, asyncBatchCallback.mCompletedCount == kCommandCount);
+    NL_TEST_ASSERT(apSuite, !mockCommandResponder.mResponseDropped);
+
+    CheckResponsesInRequestOrder(apSuite, std::move(mockCommandResponder.mChunks), kCommandCount);
+}
+
+/**
+ * Compare the latency of a batch whose commands each wait on I/O when the I/O of the commands is
+ * performed one after the other, as when responses had to be sent in order as the commands completed,
+ * and when it is performed concurrently. Only the timings are logged: they depend on the load of the machine.
+ */
+void TestCommandInteraction::BenchmarkCommandHandlerAsyncBatchLatency(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx                = *static_cast<TestContext *>(apContext);
+    constexpr uint16_t kCommandCount = AsyncBatchCommandHandlerCallback::kMaxCommands;
+    constexpr System::Clock::Milliseconds32 kIoLatency(20);
+
+    const AsyncBatchCommandHandlerCallback::IoMode ioModes[] = { AsyncBatchCommandHandlerCallback::IoMode::kSequential,
+                                                                 AsyncBatchCommandHandlerCallback::IoMode::kConcurrent };
+    System::Clock::Milliseconds64 batchLatency[ArraySize(ioModes)];
+
+    for (size_t i = 0; i < ArraySize(ioModes); i++)
+    {
+        System::PacketBufferHandle commandDatabuf;
+        GenerateBatchInvokeRequest(apSuite, apContext, commandDatabuf, kCommandCount);
+
+        AsyncBatchCommandHandlerCallback asyncBatchCallback;
+        asyncBatchCallback.Reset(&ctx.GetSystemLayer(), ioModes[i], kIoLatency);
+        BasicCommandPathRegistry<kCommandCount> basicCommandPathRegistry;
+        MockCommandResponder mockCommandResponder;
+        CommandHandlerImpl::TestOnlyOverrides testOnlyOverrides{ &basicCommandPathRegistry, &mockCommandResponder };
+        CommandHandlerImpl commandHandler(testOnlyOverrides, &asyncBatchCallback);
+
+        const System::Clock::Timestamp start = System::SystemClock().GetMonotonicTimestamp();
+        InteractionModel::Status status =
+            commandHandler.OnInvokeCommandRequest(mockCommandResponder, std::move(commandDatabuf), false);
+        NL_TEST_ASSERT(apSuite, status == InteractionModel::Status::Success);
+        ctx.GetIOContext().DriveIOUntil(System::Clock::Seconds16(5), [&]() { return asyncBatchCallback.mDone; });
+        batchLatency[i] =
+            std::chrono::duration_cast<System::Clock::Milliseconds64>(System::SystemClock().GetMonotonicTimestamp() - start);
+
+        NL_TEST_ASSERT(apSuite, asyncBatchCallback.mDone);
+        NL_TEST_ASSERT(apSuite, asyncBatchCallback.mCompletedCount == kCommandCount);
+        CheckResponsesInRequestOrder(apSuite, std::move(mockCommandResponder.mChunks), kCommandCount);
+    }
+
+    ChipLogProgress(DataManagement,
+                    "Batch of %u commands with %" PRIu32 " ms of I/O each: %" PRIu64 " ms sequential, %" PRIu64 " ms concurrent",
+                    static_cast<unsigned>(kCommandCount), kIoLatency.count(), batchLatency[0].count(), batchLatency[1].count());
+}
+
 void TestCommandInteraction::TestCommandHandler_FillUpInvokeResponseMessageWhereSecondResponseIsStatusResponse(
     nlTestSuite * apSuite, void * apContext)
 {
@@ -2093,6 +2392,9 @@ const nlTest sTests[] =
 #endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
     NL_TEST_DEF("TestCommandHandlerRejectMultipleCommandsWhenHandlerOnlySupportsOne", chip::app::TestCommandInteraction::TestCommandHandlerRejectMultipleCommandsWhenHandlerOnlySupportsOne),
     NL_TEST_DEF("TestCommandHandlerAcceptMultipleCommands", chip::app::TestCommandInteraction::TestCommandHandlerAcceptMultipleCommands),
+    NL_TEST_DEF("TestCommandHandlerAsyncBatchRespondsInRequestOrder", chip::app::TestCommandInteraction::TestCommandHandlerAsyncBatchRespondsInRequestOrder),
+    NL_TEST_DEF("TestCommandHandlerAsyncBatchRespondsInRequestOrderWhenCompletedInReverse", chip::app::TestCommandInteraction::TestCommandHandlerAsyncBatchRespondsInRequestOrderWhenCompletedInReverse),
+    NL_TEST_DEF("BenchmarkCommandHandlerAsyncBatchLatency", chip::app::TestCommandInteraction::BenchmarkCommandHandlerAsyncBatchLatency),
     NL_TEST_DEF("TestCommandHandler_FillUpInvokeResponseMessageWhereSecondResponseIsStatusResponse", chip::app::TestCommandInteraction::TestCommandHandler_FillUpInvokeResponseMessageWhereSecondResponseIsStatusResponse),
     NL_TEST_DEF("TestCommandHandler_FillUpInvokeResponseMessageWhereSecondResponseIsDataResponsePrimative", chip::app::TestCommandInteraction::TestCommandHandler_FillUpInvokeResponseMessageWhereSecondResponseIsDataResponsePrimative),
     NL_TEST_DEF("TestCommandHandler_FillUpInvokeResponseMessageWhereSecondResponseIsDataResponse", chip::app::TestCommandInteraction::TestCommandHandler_FillUpInvokeResponseMessageWhereSecondResponseIsDataResponse),
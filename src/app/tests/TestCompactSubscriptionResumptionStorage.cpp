@@ -0,0 +1,258 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/CompactSubscriptionResumptionStorage.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <pw_unit_test/framework.h>
+
+using chip::DefaultStorageKeyAllocator;
+using chip::app::SubscriptionResumptionStorage;
+
+class TestCompactSubscriptionResumptionStorage : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+};
+
+namespace {
+
+void MakeSubscriptionInfo(SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo, chip::FabricIndex fabricIndex,
+                          chip::SubscriptionId subscriptionId)
+{
+    subscriptionInfo.mNodeId         = 1000 + subscriptionId;
+    subscriptionInfo.mFabricIndex    = fabricIndex;
+    subscriptionInfo.mSubscriptionId = subscriptionId;
+    subscriptionInfo.mMinInterval    = 1;
+    subscriptionInfo.mMaxInterval    = 60;
+    subscriptionInfo.mFabricFiltered = true;
+    subscriptionInfo.mAttributePaths.Calloc(1);
+    subscriptionInfo.mAttributePaths[0].mEndpointId  = 1;
+    subscriptionInfo.mAttributePaths[0].mClusterId   = 6;
+    subscriptionInfo.mAttributePaths[0].mAttributeId = static_cast<chip::AttributeId>(subscriptionId);
+    subscriptionInfo.mEventPaths.Calloc(1);
+    subscriptionInfo.mEventPaths[0].mEndpointId    = 0;
+    subscriptionInfo.mEventPaths[0].mClusterId     = 0x28;
+    subscriptionInfo.mEventPaths[0].mEventId       = 0;
+    subscriptionInfo.mEventPaths[0].mIsUrgentEvent = true;
+}
+
+void ExpectSubscriptionInfo(const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo,
+                            chip::FabricIndex fabricIndex, chip::SubscriptionId subscriptionId)
+{
+    EXPECT_EQ(subscriptionInfo.mNodeId, 1000 + subscriptionId);
+    EXPECT_EQ(subscriptionInfo.mFabricIndex, fabricIndex);
+    EXPECT_EQ(subscriptionInfo.mSubscriptionId, subscriptionId);
+    EXPECT_EQ(subscriptionInfo.mMinInterval, 1);
+    EXPECT_EQ(subscriptionInfo.mMaxInterval, 60);
+    EXPECT_TRUE(subscriptionInfo.mFabricFiltered);
+    ASSERT_EQ(subscriptionInfo.mAttributePaths.AllocatedSize(), 1u);
+    EXPECT_EQ(subscriptionInfo.mAttributePaths[0].mEndpointId, 1);
+    EXPECT_EQ(subscriptionInfo.mAttributePaths[0].mClusterId, 6u);
+    EXPECT_EQ(subscriptionInfo.mAttributePaths[0].mAttributeId, subscriptionId);
+    ASSERT_EQ(subscriptionInfo.mEventPaths.AllocatedSize(), 1u);
+    EXPECT_EQ(subscriptionInfo.mEventPaths[0].mEndpointId, 0);
+    EXPECT_EQ(subscriptionInfo.mEventPaths[0].mClusterId, 0x28u);
+    EXPECT_EQ(subscriptionInfo.mEventPaths[0].mEventId, 0u);
+    EXPECT_TRUE(subscriptionInfo.mEventPaths[0].mIsUrgentEvent);
+}
+
+size_t CountSubscriptions(SubscriptionResumptionStorage & subscriptionStorage)
+{
+    SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
+    auto * iterator = subscriptionStorage.IterateSubscriptions();
+    size_t count    = 0;
+    while (iterator->Next(subscriptionInfo))
+    {
+        count++;
+    }
+    EXPECT_EQ(iterator->Count(), count);
+    iterator->Release();
+    return count;
+}
+
+} // namespace
+
+TEST_F(TestCompactSubscriptionResumptionStorage, TestSubscriptionState)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::app::CompactSubscriptionResumptionStorage subscriptionStorage;
+    EXPECT_EQ(subscriptionStorage.Init(&storage), CHIP_NO_ERROR);
+
+    for (chip::SubscriptionId subscriptionId = 1; subscriptionId <= 3; subscriptionId++)
+    {
+        SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
+        MakeSubscriptionInfo(subscriptionInfo, static_cast<chip::FabricIndex>(subscriptionId), subscriptionId);
+        EXPECT_EQ(subscriptionStorage.Save(subscriptionInfo), CHIP_NO_ERROR);
+    }
+
+    // All the subscriptions are in a single record.
+    EXPECT_EQ(storage.GetNumKeys(), 1u);
+    EXPECT_TRUE(storage.SyncDoesKeyExist(DefaultStorageKeyAllocator::SubscriptionResumptionRecord().KeyName()));
+
+    SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
+    auto * iterator = subscriptionStorage.IterateSubscriptions();
+    EXPECT_EQ(iterator->Count(), 3u);
+    for (chip::SubscriptionId subscriptionId = 1; subscriptionId <= 3; subscriptionId++)
+    {
+        ASSERT_TRUE(iterator->Next(subscriptionInfo));
+        ExpectSubscriptionInfo(subscriptionInfo, static_cast<chip::FabricIndex>(subscriptionId), subscriptionId);
+    }
+    EXPECT_FALSE(iterator->Next(subscriptionInfo));
+    iterator->Release();
+
+    // Saving a subscription again replaces it.
+    MakeSubscriptionInfo(subscriptionInfo, 2, 2);
+    subscriptionInfo.mMaxInterval = 120;
+    EXPECT_EQ(subscriptionStorage.Save(subscriptionInfo), CHIP_NO_ERROR);
+    EXPECT_EQ(CountSubscriptions(subscriptionStorage), 3u);
+
+    iterator = subscriptionStorage.IterateSubscriptions();
+    SubscriptionResumptionStorage::SubscriptionInfo savedSubscriptionInfo;
+    while (iterator->Next(savedSubscriptionInfo) && savedSubscriptionInfo.mSubscriptionId != 2)
+    {
+    }
+    EXPECT_EQ(savedSubscriptionInfo.mSubscriptionId, 2u);
+    EXPECT_EQ(savedSubscriptionInfo.mMaxInterval, 120);
+    iterator->Release();
+
+    // Delete subscription 1 and fabric 2 and check only 3 remains.
+    EXPECT_EQ(subscriptionStorage.Delete(1001, 1, 1), CHIP_NO_ERROR);
+    EXPECT_EQ(subscriptionStorage.Delete(1001, 1, 1), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    EXPECT_EQ(subscriptionStorage.DeleteAll(2), CHIP_NO_ERROR);
+
+    iterator = subscriptionStorage.IterateSubscriptions();
+    EXPECT_EQ(iterator->Count(), 1u);
+    ASSERT_TRUE(iterator->Next(subscriptionInfo));
+    ExpectSubscriptionInfo(subscriptionInfo, 3, 3);
+    EXPECT_FALSE(iterator->Next(subscriptionInfo));
+    iterator->Release();
+
+    // The record is removed with the last subscription.
+    EXPECT_EQ(subscriptionStorage.DeleteAll(3), CHIP_NO_ERROR);
+    EXPECT_EQ(CountSubscriptions(subscriptionStorage), 0u);
+    EXPECT_EQ(storage.GetNumKeys(), 0u);
+}
+
+TEST_F(TestCompactSubscriptionResumptionStorage, TestSubscriptionMaxCount)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::app::CompactSubscriptionResumptionStorage subscriptionStorage;
+    EXPECT_EQ(subscriptionStorage.Init(&storage), CHIP_NO_ERROR);
+
+    SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
+    for (chip::SubscriptionId subscriptionId = 0; subscriptionId < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionId++)
+    {
+        MakeSubscriptionInfo(subscriptionInfo, 1, subscriptionId);
+        EXPECT_EQ(subscriptionStorage.Save(subscriptionInfo), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(CountSubscriptions(subscriptionStorage), std::make_unsigned_t<int>(CHIP_IM_MAX_NUM_SUBSCRIPTIONS));
+
+    MakeSubscriptionInfo(subscriptionInfo, 1, CHIP_IM_MAX_NUM_SUBSCRIPTIONS);
+    EXPECT_EQ(subscriptionStorage.Save(subscriptionInfo), CHIP_ERROR_NO_MEMORY);
+
+    // Replacing a subscription still works when the storage is full.
+    MakeSubscriptionInfo(subscriptionInfo, 1, 0);
+    EXPECT_EQ(subscriptionStorage.Save(subscriptionInfo), CHIP_NO_ERROR);
+    EXPECT_EQ(CountSubscriptions(subscriptionStorage), std::make_unsigned_t<int>(CHIP_IM_MAX_NUM_SUBSCRIPTIONS));
+}
+
+TEST_F(TestCompactSubscriptionResumptionStorage, TestSubscriptionMigration)
+{
+    chip::TestPersistentStorageDelegate storage;
+
+    {
+        chip::app::SimpleSubscriptionResumptionStorage simpleSubscriptionStorage;
+        EXPECT_EQ(simpleSubscriptionStorage.Init(&storage), CHIP_NO_ERROR);
+        for (chip::SubscriptionId subscriptionId = 1; subscriptionId <= 2; subscriptionId++)
+        {
+            SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
+            MakeSubscriptionInfo(subscriptionInfo, 1, subscriptionId);
+            EXPECT_EQ(simpleSubscriptionStorage.Save(subscriptionInfo), CHIP_NO_ERROR);
+        }
+    }
+    EXPECT_TRUE(storage.SyncDoesKeyExist(DefaultStorageKeyAllocator::SubscriptionResumptionMaxCount().KeyName()));
+
+    // Init moves the subscriptions into the record, and removes the keys of SimpleSubscriptionResumptionStorage.
+    chip::app::CompactSubscriptionResumptionStorage subscriptionStorage;
+    EXPECT_EQ(subscriptionStorage.Init(&storage), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.GetNumKeys(), 1u);
+    EXPECT_TRUE(storage.SyncDoesKeyExist(DefaultStorageKeyAllocator::SubscriptionResumptionRecord().KeyName()));
+
+    SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
+    auto * iterator = subscriptionStorage.IterateSubscriptions();
+    EXPECT_EQ(iterator->Count(), 2u);
+    ASSERT_TRUE(iterator->Next(subscriptionInfo));
+    ExpectSubscriptionInfo(subscriptionInfo, 1, 1);
+    ASSERT_TRUE(iterator->Next(subscriptionInfo));
+    ExpectSubscriptionInfo(subscriptionInfo, 1, 2);
+    EXPECT_FALSE(iterator->Next(subscriptionInfo));
+    iterator->Release();
+}
+
+TEST_F(TestCompactSubscriptionResumptionStorage, TestCorruptRecord)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::app::CompactSubscriptionResumptionStorage subscriptionStorage;
+    EXPECT_EQ(subscriptionStorage.Init(&storage), CHIP_NO_ERROR);
+
+    const uint8_t junkBytes[] = { 0x17, 0x15, 0x24, 0x01 };
+    EXPECT_EQ(storage.SyncSetKeyValue(DefaultStorageKeyAllocator::SubscriptionResumptionRecord().KeyName(), junkBytes,
+                                      sizeof(junkBytes)),
+              CHIP_NO_ERROR);
+
+    // A record that cannot be read is dropped, and does not prevent saving subscriptions.
+    EXPECT_EQ(CountSubscriptions(subscriptionStorage), 0u);
+    EXPECT_FALSE(storage.SyncDoesKeyExist(DefaultStorageKeyAllocator::SubscriptionResumptionRecord().KeyName()));
+
+    EXPECT_EQ(storage.SyncSetKeyValue(DefaultStorageKeyAllocator::SubscriptionResumptionRecord().KeyName(), junkBytes,
+                                      sizeof(junkBytes)),
+              CHIP_NO_ERROR);
+    SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
+    MakeSubscriptionInfo(subscriptionInfo, 1, 1);
+    EXPECT_EQ(subscriptionStorage.Save(subscriptionInfo), CHIP_NO_ERROR);
+    EXPECT_EQ(CountSubscriptions(subscriptionStorage), 1u);
+}
+
+TEST_F(TestCompactSubscriptionResumptionStorage, TestUnreadableRecordIsKept)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::app::CompactSubscriptionResumptionStorage subscriptionStorage;
+    EXPECT_EQ(subscriptionStorage.Init(&storage), CHIP_NO_ERROR);
+
+    SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
+    MakeSubscriptionInfo(subscriptionInfo, 1, 1);
+    EXPECT_EQ(subscriptionStorage.Save(subscriptionInfo), CHIP_NO_ERROR);
+
+    // A storage failure is not mistaken for a corrupt record: the subscriptions stay persisted.
+    storage.AddPoisonKey(DefaultStorageKeyAllocator::SubscriptionResumptionRecord().KeyName());
+    EXPECT_EQ(CountSubscriptions(subscriptionStorage), 0u);
+    SubscriptionResumptionStorage::SubscriptionInfo otherSubscriptionInfo;
+    MakeSubscriptionInfo(otherSubscriptionInfo, 1, 2);
+    EXPECT_EQ(subscriptionStorage.Save(otherSubscriptionInfo), CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    EXPECT_EQ(subscriptionStorage.DeleteAll(1), CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    storage.ClearPoisonKeys();
+
+    auto * iterator = subscriptionStorage.IterateSubscriptions();
+    EXPECT_EQ(iterator->Count(), 1u);
+    ASSERT_TRUE(iterator->Next(subscriptionInfo));
+    ExpectSubscriptionInfo(subscriptionInfo, 1, 1);
+    EXPECT_FALSE(iterator->Next(subscriptionInfo));
+    iterator->Release();
+}
@@ -0,0 +1,264 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/clusters/device-energy-management-server/ForecastEngine.h>
+#include <app/data-model/Decode.h>
+#include <app/data-model/Encode.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/core/TLV.h>
+#include <pw_unit_test/framework.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters::DeviceEnergyManagement;
+
+using Slot           = ForecastEngine::Slot;
+using Constraint     = ForecastEngine::Constraint;
+using SlotAdjustment = ForecastEngine::SlotAdjustment;
+
+namespace {
+
+constexpr uint32_t kStartTime = 757382400;
+
+Slot MakeSlot(uint32_t duration, int64_t nominalPower, Optional<int64_t> minPower = NullOptional)
+{
+    Slot slot;
+    slot.minDuration     = duration;
+    slot.maxDuration     = duration;
+    slot.defaultDuration = duration;
+    slot.nominalPower.SetValue(nominalPower);
+    slot.minPower = minPower;
+    slot.nominalEnergy.SetValue(nominalPower * duration / 3600);
+    return slot;
+}
+
+Constraint MakeConstraint(uint32_t offset, uint32_t duration, Optional<int64_t> nominalPower,
+                          Optional<int64_t> maximumEnergy = NullOptional)
+{
+    Constraint constraint;
+    constraint.startTime     = kStartTime + offset;
+    constraint.duration      = duration;
+    constraint.nominalPower  = nominalPower;
+    constraint.maximumEnergy = maximumEnergy;
+    return constraint;
+}
+
+SlotAdjustment MakeAdjustment(uint8_t slotIndex, int64_t nominalPower, uint32_t duration)
+{
+    SlotAdjustment adjustment;
+    adjustment.slotIndex    = slotIndex;
+    adjustment.nominalPower = nominalPower;
+    adjustment.duration     = duration;
+    return adjustment;
+}
+
+// Encodes a list the way a command carries it, so that it can be decoded into `decodable`.
+template <typename T>
+class EncodedList
+{
+public:
+    template <size_t N>
+    CHIP_ERROR Encode(const T (&items)[N])
+    {
+        TLV::TLVWriter writer;
+        writer.Init(mBuffer);
+        ReturnErrorOnFailure(DataModel::Encode(writer, TLV::AnonymousTag(), DataModel::List<const T>(items)));
+        ReturnErrorOnFailure(writer.Finalize());
+
+        mReader.Init(mBuffer, writer.GetLengthWritten());
+        ReturnErrorOnFailure(mReader.Next());
+        return DataModel::Decode(mReader, decodable);
+    }
+
+    DataModel::DecodableList<T> decodable;
+
+private:
+    uint8_t mBuffer[1024];
+    TLV::TLVReader mReader;
+};
+
+} // namespace
+
+TEST(TestDeviceEnergyManagementForecast, TestDecodeConstraints)
+{
+    Constraint buffer[4];
+    size_t count = 0;
+
+    // Constraints are sorted by start time.
+    const Constraint constraints[] = { MakeConstraint(600, 300, MakeOptional<int64_t>(1000)),
+                                       MakeConstraint(0, 600, MakeOptional<int64_t>(2000)) };
+    EncodedList<Constraint> encoded;
+    ASSERT_EQ(encoded.Encode(constraints), CHIP_NO_ERROR);
+    ASSERT_EQ(ForecastEngine::DecodeConstraints(encoded.decodable, Span<Constraint>(buffer), count), CHIP_NO_ERROR);
+    ASSERT_EQ(count, 2u);
+    EXPECT_EQ(buffer[0].startTime, kStartTime);
+    EXPECT_EQ(buffer[1].startTime, kStartTime + 600);
+
+    // Overlapping constraints are rejected.
+    const Constraint overlapping[] = { MakeConstraint(0, 600, MakeOptional<int64_t>(2000)),
+                                       MakeConstraint(300, 600, MakeOptional<int64_t>(1000)) };
+    EncodedList<Constraint> encodedOverlapping;
+    ASSERT_EQ(encodedOverlapping.Encode(overlapping), CHIP_NO_ERROR);
+    EXPECT_EQ(ForecastEngine::DecodeConstraints(encodedOverlapping.decodable, Span<Constraint>(buffer), count),
+              CHIP_ERROR_INVALID_ARGUMENT);
+
+    EXPECT_EQ(ForecastEngine::DecodeConstraints(encoded.decodable, Span<Constraint>(buffer, 1), count),
+              CHIP_ERROR_BUFFER_TOO_SMALL);
+}
+
+TEST(TestDeviceEnergyManagementForecast, TestApplyConstraints)
+{
+    const Slot slots[] = { MakeSlot(3600, 4000000), MakeSlot(3600, 2000000, MakeOptional<int64_t>(1000000)) };
+    Slot output[8];
+    size_t count = 0;
+
+    // A constraint from 00:30 to 01:30 limits the power to 3 kW: the first slot is split in
+    // two, the second one only runs at 2 kW and is unchanged.
+    const Constraint powerLimit[] = { MakeConstraint(1800, 3600, MakeOptional<int64_t>(3000000)) };
+    ASSERT_EQ(ForecastEngine::ApplyConstraints(kStartTime, Span<const Slot>(slots), Span<const Constraint>(powerLimit),
+                                               Span<Slot>(output), count),
+              CHIP_NO_ERROR);
+    ASSERT_EQ(count, 3u);
+    EXPECT_EQ(output[0].defaultDuration, 1800u);
+    EXPECT_EQ(output[0].nominalPower, MakeOptional<int64_t>(4000000));
+    EXPECT_EQ(output[0].nominalEnergy, MakeOptional<int64_t>(2000000));
+    EXPECT_EQ(output[1].defaultDuration, 1800u);
+    EXPECT_EQ(output[1].minDuration, 1800u);
+    EXPECT_EQ(output[1].nominalPower, MakeOptional<int64_t>(3000000));
+    EXPECT_EQ(output[1].nominalEnergy, MakeOptional<int64_t>(1500000));
+    EXPECT_EQ(output[2].defaultDuration, 3600u);
+    EXPECT_EQ(output[2].nominalPower, MakeOptional<int64_t>(2000000));
+    EXPECT_EQ(ForecastEngine::GetDuration(Span<const Slot>(output, count)), 7200u);
+
+    // Limiting the energy to 1.5 kWh over the second hour averages out at 1.5 kW.
+    const Constraint energyLimit[] = { MakeConstraint(3600, 3600, NullOptional, MakeOptional<int64_t>(1500000)) };
+    ASSERT_EQ(ForecastEngine::ApplyConstraints(kStartTime, Span<const Slot>(slots), Span<const Constraint>(energyLimit),
+                                               Span<Slot>(output), count),
+              CHIP_NO_ERROR);
+    ASSERT_EQ(count, 2u);
+    EXPECT_EQ(output[1].nominalPower, MakeOptional<int64_t>(1500000));
+    EXPECT_EQ(output[1].nominalEnergy, MakeOptional<int64_t>(1500000));
+
+    // The second slot cannot run below 1 kW.
+    const Constraint infeasible[] = { MakeConstraint(3600, 600, MakeOptional<int64_t>(500000)) };
+    EXPECT_EQ(ForecastEngine::ApplyConstraints(kStartTime, Span<const Slot>(slots), Span<const Constraint>(infeasible),
+                                               Span<Slot>(output), count),
+              CHIP_ERROR_INCORRECT_STATE);
+
+    EXPECT_EQ(ForecastEngine::ApplyConstraints(kStartTime, Span<const Slot>(slots), Span<const Constraint>(powerLimit),
+                                               Span<Slot>(output, 2), count),
+              CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    // A slot nominally running below the limit keeps its nominal power, but may not go above the limit either.
+    Slot flexible[] = { MakeSlot(3600, 2000000) };
+    flexible[0].maxPower.SetValue(5000000);
+    const Constraint wholeSlot[] = { MakeConstraint(0, 3600, MakeOptional<int64_t>(3000000)) };
+    ASSERT_EQ(ForecastEngine::ApplyConstraints(kStartTime, Span<const Slot>(flexible), Span<const Constraint>(wholeSlot),
+                                               Span<Slot>(output), count),
+              CHIP_NO_ERROR);
+    ASSERT_EQ(count, 1u);
+    EXPECT_EQ(output[0].defaultDuration, 3600u);
+    EXPECT_EQ(output[0].nominalPower, MakeOptional<int64_t>(2000000));
+    EXPECT_EQ(output[0].maxPower, MakeOptional<int64_t>(3000000));
+
+    // Without a constraint, the maximum power is left as is.
+    const Constraint laterConstraint[] = { MakeConstraint(1800, 1800, MakeOptional<int64_t>(3000000)) };
+    ASSERT_EQ(ForecastEngine::ApplyConstraints(kStartTime, Span<const Slot>(flexible), Span<const Constraint>(laterConstraint),
+                                               Span<Slot>(output), count),
+              CHIP_NO_ERROR);
+    ASSERT_EQ(count, 2u);
+    EXPECT_EQ(output[0].maxPower, MakeOptional<int64_t>(5000000));
+    EXPECT_EQ(output[1].maxPower, MakeOptional<int64_t>(3000000));
+    EXPECT_EQ(output[1].nominalPower, MakeOptional<int64_t>(2000000));
+}
+
+TEST(TestDeviceEnergyManagementForecast, TestApplySlotAdjustments)
+{
+    Slot slots[] = { MakeSlot(3600, 2000000), MakeSlot(1800, 1000000) };
+    slots[0].minPowerAdjustment.SetValue(1000000);
+    slots[0].maxPowerAdjustment.SetValue(3000000);
+    slots[0].minDurationAdjustment.SetValue(1800);
+    slots[0].maxDurationAdjustment.SetValue(7200);
+
+    // The second slot cannot be adjusted, so nothing is.
+    const SlotAdjustment rejected[] = { MakeAdjustment(0, 3000000, 1800), MakeAdjustment(1, 1000000, 1800) };
+    EncodedList<SlotAdjustment> encodedRejected;
+    ASSERT_EQ(encodedRejected.Encode(rejected), CHIP_NO_ERROR);
+    EXPECT_EQ(ForecastEngine::ApplySlotAdjustments(encodedRejected.decodable, Span<Slot>(slots)), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(slots[0].nominalPower, MakeOptional<int64_t>(2000000));
+
+    const SlotAdjustment outOfRange[] = { MakeAdjustment(0, 4000000, 1800) };
+    EncodedList<SlotAdjustment> encodedOutOfRange;
+    ASSERT_EQ(encodedOutOfRange.Encode(outOfRange), CHIP_NO_ERROR);
+    EXPECT_EQ(ForecastEngine::ApplySlotAdjustments(encodedOutOfRange.decodable, Span<Slot>(slots)), CHIP_ERROR_INVALID_ARGUMENT);
+
+    const SlotAdjustment unknownSlot[] = { MakeAdjustment(2, 2000000, 1800) };
+    EncodedList<SlotAdjustment> encodedUnknownSlot;
+    ASSERT_EQ(encodedUnknownSlot.Encode(unknownSlot), CHIP_NO_ERROR);
+    EXPECT_EQ(ForecastEngine::ApplySlotAdjustments(encodedUnknownSlot.decodable, Span<Slot>(slots)), CHIP_ERROR_INVALID_ARGUMENT);
+
+    const SlotAdjustment accepted[] = { MakeAdjustment(0, 3000000, 1800) };
+    EncodedList<SlotAdjustment> encodedAccepted;
+    ASSERT_EQ(encodedAccepted.Encode(accepted), CHIP_NO_ERROR);
+    EXPECT_EQ(ForecastEngine::ApplySlotAdjustments(encodedAccepted.decodable, Span<Slot>(slots)), CHIP_NO_ERROR);
+    EXPECT_EQ(slots[0].nominalPower, MakeOptional<int64_t>(3000000));
+    EXPECT_EQ(slots[0].defaultDuration, 1800u);
+    EXPECT_EQ(slots[0].nominalEnergy, MakeOptional<int64_t>(1500000));
+    EXPECT_EQ(ForecastEngine::GetDuration(Span<const Slot>(slots)), 3600u);
+}
+
+TEST(TestDeviceEnergyManagementForecast, TestApplyConstraintsLargeForecast)
+{
+    constexpr size_t kSlotCount       = 500;
+    constexpr size_t kConstraintCount = 250;
+
+    // Slots of 15 minutes, and constraints of 20 minutes every 30 minutes, so that most slots get split.
+    static Slot slots[kSlotCount];
+    static Constraint constraints[kConstraintCount];
+    static Slot output[2 * kSlotCount];
+    for (size_t i = 0; i < kSlotCount; i++)
+    {
+        slots[i] = MakeSlot(900, (i % 2 == 0) ? 4000000 : 2000000);
+    }
+    for (size_t i = 0; i < kConstraintCount; i++)
+    {
+        constraints[i] = MakeConstraint(static_cast<uint32_t>(i * 1800 + 300), 1200, MakeOptional<int64_t>(3000000));
+    }
+
+    size_t count = 0;
+    ASSERT_EQ(ForecastEngine::ApplyConstraints(kStartTime, Span<const Slot>(slots), Span<const Constraint>(constraints),
+                                               Span<Slot>(output), count),
+              CHIP_NO_ERROR);
+
+    EXPECT_GT(count, kSlotCount);
+    EXPECT_EQ(ForecastEngine::GetDuration(Span<const Slot>(output, count)), ForecastEngine::GetDuration(Span<const Slot>(slots)));
+
+    // No revised slot overlapping a constraint runs above 3 kW.
+    uint64_t slotStart = kStartTime;
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint64_t slotEnd = slotStart + output[i].defaultDuration;
+        for (const Constraint & constraint : constraints)
+        {
+            if (slotStart < static_cast<uint64_t>(constraint.startTime) + constraint.duration && slotEnd > constraint.startTime)
+            {
+                EXPECT_LE(output[i].nominalPower.Value(), 3000000);
+            }
+        }
+        slotStart += output[i].defaultDuration;
+    }
+}
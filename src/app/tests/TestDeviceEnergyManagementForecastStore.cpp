@@ -0,0 +1,175 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/DefaultAttributePersistenceProvider.h>
+#include <app/clusters/device-energy-management-server/ForecastStore.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <pw_unit_test/framework.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters::DeviceEnergyManagement;
+
+using Slot            = ForecastStore::Slot;
+using PowerAdjustment = ForecastStore::PowerAdjustment;
+
+namespace {
+
+constexpr EndpointId kEndpoint = 1;
+
+class TestDeviceEnergyManagementForecastStore : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+
+    void SetUp() override { ASSERT_EQ(mProvider.Init(&mStorage), CHIP_NO_ERROR); }
+
+    TestPersistentStorageDelegate mStorage;
+    DefaultAttributePersistenceProvider mProvider;
+};
+
+Slot MakeSlot(uint32_t duration, int64_t power)
+{
+    Slot slot;
+    slot.minDuration     = duration;
+    slot.maxDuration     = duration;
+    slot.defaultDuration = duration;
+    slot.nominalPower.SetValue(power);
+    slot.minPower.SetValue(0);
+    slot.maxPower.SetValue(power);
+    return slot;
+}
+
+} // namespace
+
+TEST_F(TestDeviceEnergyManagementForecastStore, TestForecastRoundTrip)
+{
+    Structs::CostStruct::Type cost;
+    cost.value    = 42;
+    Slot slots[3] = { MakeSlot(3600, 7000000), MakeSlot(1800, 11000000), MakeSlot(600, 0) };
+    slots[1].slotIsPauseable.SetValue(true);
+    slots[1].costs.SetValue(DataModel::List<const Structs::CostStruct::Type>(&cost, 1));
+
+    ForecastStore::Forecast forecast;
+    auto & value     = forecast.SetNonNull();
+    value.forecastId = 1234;
+    value.activeSlotNumber.SetNonNull(1);
+    value.startTime = 800000000;
+    value.endTime   = 800006000;
+    value.latestEndTime.SetValue(800010000);
+    value.slots                = DataModel::List<const Slot>(slots);
+    value.forecastUpdateReason = ForecastUpdateReasonEnum::kGridOptimization;
+    ASSERT_EQ(ForecastStore::SaveForecast(mProvider, kEndpoint, forecast), CHIP_NO_ERROR);
+
+    // Nothing was saved for other endpoints.
+    Slot restoredSlots[3];
+    ForecastStore::Forecast restored;
+    EXPECT_NE(ForecastStore::LoadForecast(mProvider, kEndpoint + 1, restored, Span<Slot>(restoredSlots)), CHIP_NO_ERROR);
+
+    ASSERT_EQ(ForecastStore::LoadForecast(mProvider, kEndpoint, restored, Span<Slot>(restoredSlots)), CHIP_NO_ERROR);
+    ASSERT_FALSE(restored.IsNull());
+    EXPECT_EQ(restored.Value().forecastId, 1234u);
+    EXPECT_EQ(restored.Value().activeSlotNumber, DataModel::MakeNullable<uint16_t>(1));
+    EXPECT_EQ(restored.Value().startTime, 800000000u);
+    EXPECT_EQ(restored.Value().endTime, 800006000u);
+    EXPECT_FALSE(restored.Value().earliestStartTime.HasValue());
+    EXPECT_EQ(restored.Value().latestEndTime, MakeOptional<uint32_t>(800010000));
+    EXPECT_EQ(restored.Value().forecastUpdateReason, ForecastUpdateReasonEnum::kGridOptimization);
+    ASSERT_EQ(restored.Value().slots.size(), 3u);
+    EXPECT_EQ(restored.Value().slots.data(), restoredSlots);
+    for (size_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(restoredSlots[i].defaultDuration, slots[i].defaultDuration);
+        EXPECT_EQ(restoredSlots[i].nominalPower, slots[i].nominalPower);
+        EXPECT_EQ(restoredSlots[i].maxPower, slots[i].maxPower);
+        EXPECT_EQ(restoredSlots[i].slotIsPauseable, slots[i].slotIsPauseable);
+        EXPECT_FALSE(restoredSlots[i].costs.HasValue());
+    }
+
+    // A forecast with more slots than the buffer can hold is not restored.
+    ForecastStore::Forecast untouched;
+    EXPECT_EQ(ForecastStore::LoadForecast(mProvider, kEndpoint, untouched, Span<Slot>(restoredSlots, 2)),
+              CHIP_ERROR_BUFFER_TOO_SMALL);
+    EXPECT_TRUE(untouched.IsNull());
+
+    // Clearing the forecast is persisted too.
+    ASSERT_EQ(ForecastStore::SaveForecast(mProvider, kEndpoint, ForecastStore::Forecast()), CHIP_NO_ERROR);
+    ASSERT_EQ(ForecastStore::LoadForecast(mProvider, kEndpoint, restored, Span<Slot>(restoredSlots)), CHIP_NO_ERROR);
+    EXPECT_TRUE(restored.IsNull());
+}
+
+TEST_F(TestDeviceEnergyManagementForecastStore, TestForecastIsCompact)
+{
+    Slot slots[10];
+    for (auto & slot : slots)
+    {
+        slot = MakeSlot(900, 7400000);
+    }
+
+    ForecastStore::Forecast forecast;
+    auto & value     = forecast.SetNonNull();
+    value.forecastId = 65535;
+    value.startTime  = 800000000;
+    value.endTime    = 800009000;
+    value.slots      = DataModel::List<const Slot>(slots);
+    ASSERT_EQ(ForecastStore::SaveForecast(mProvider, kEndpoint, forecast), CHIP_NO_ERROR);
+
+    // About 35 bytes per slot, against close to 200 for a slot in memory.
+    uint8_t record[1024];
+    uint16_t size = sizeof(record);
+    ASSERT_EQ(mStorage.SyncGetKeyValue(
+                  DefaultStorageKeyAllocator::AttributeValue(kEndpoint, Clusters::DeviceEnergyManagement::Id,
+                                                             Clusters::DeviceEnergyManagement::Attributes::Forecast::Id)
+                      .KeyName(),
+                  record, size),
+              CHIP_NO_ERROR);
+    EXPECT_LT(size, sizeof(slots) / 4);
+}
+
+TEST_F(TestDeviceEnergyManagementForecastStore, TestPowerAdjustmentCapabilityRoundTrip)
+{
+    PowerAdjustment adjustments[2];
+    adjustments[0].minPower    = -3000000;
+    adjustments[0].maxPower    = 7000000;
+    adjustments[0].minDuration = 60;
+    adjustments[0].maxDuration = 3600;
+    adjustments[1].maxPower    = 11000000;
+    adjustments[1].maxDuration = 600;
+
+    ForecastStore::PowerAdjustmentCapability capability;
+    capability.SetNonNull(DataModel::List<const PowerAdjustment>(adjustments));
+    ASSERT_EQ(ForecastStore::SavePowerAdjustmentCapability(mProvider, kEndpoint, capability), CHIP_NO_ERROR);
+
+    PowerAdjustment buffer[4];
+    ForecastStore::PowerAdjustmentCapability restored;
+    ASSERT_EQ(ForecastStore::LoadPowerAdjustmentCapability(mProvider, kEndpoint, restored, Span<PowerAdjustment>(buffer)),
+              CHIP_NO_ERROR);
+    ASSERT_FALSE(restored.IsNull());
+    ASSERT_EQ(restored.Value().size(), 2u);
+    EXPECT_EQ(buffer[0].minPower, -3000000);
+    EXPECT_EQ(buffer[0].maxDuration, 3600u);
+    EXPECT_EQ(buffer[1].maxPower, 11000000);
+    EXPECT_EQ(buffer[1].minDuration, 0u);
+
+    capability.SetNull();
+    ASSERT_EQ(ForecastStore::SavePowerAdjustmentCapability(mProvider, kEndpoint, capability), CHIP_NO_ERROR);
+    ASSERT_EQ(ForecastStore::LoadPowerAdjustmentCapability(mProvider, kEndpoint, restored, Span<PowerAdjustment>(buffer)),
+              CHIP_NO_ERROR);
+    EXPECT_TRUE(restored.IsNull());
+}
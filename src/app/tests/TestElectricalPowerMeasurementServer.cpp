@@ -0,0 +1,204 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/clusters/electrical-power-measurement-server/electrical-power-measurement-server.h>
+#include <app/tests/test-ember-api.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <pw_unit_test/framework.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters;
+using namespace chip::app::Clusters::ElectricalPowerMeasurement;
+
+namespace {
+
+constexpr EndpointId kTestEndpointId = 1;
+
+class TestDelegate : public Delegate
+{
+public:
+    using Delegate::MeasurementChanged;
+
+    PowerModeEnum GetPowerMode() override { return PowerModeEnum::kAc; }
+    uint8_t GetNumberOfMeasurementTypes() override { return 0; }
+
+    CHIP_ERROR StartAccuracyRead() override { return CHIP_NO_ERROR; }
+    CHIP_ERROR GetAccuracyByIndex(uint8_t, Structs::MeasurementAccuracyStruct::Type &) override
+    {
+        return CHIP_ERROR_PROVIDER_LIST_EXHAUSTED;
+    }
+    CHIP_ERROR EndAccuracyRead() override { return CHIP_NO_ERROR; }
+
+    CHIP_ERROR StartRangesRead() override { return CHIP_NO_ERROR; }
+    CHIP_ERROR GetRangeByIndex(uint8_t, Structs::MeasurementRangeStruct::Type &) override
+    {
+        return CHIP_ERROR_PROVIDER_LIST_EXHAUSTED;
+    }
+    CHIP_ERROR EndRangesRead() override { return CHIP_NO_ERROR; }
+
+    CHIP_ERROR StartHarmonicCurrentsRead() override { return CHIP_NO_ERROR; }
+    CHIP_ERROR GetHarmonicCurrentsByIndex(uint8_t, Structs::HarmonicMeasurementStruct::Type &) override
+    {
+        return CHIP_ERROR_PROVIDER_LIST_EXHAUSTED;
+    }
+    CHIP_ERROR EndHarmonicCurrentsRead() override { return CHIP_NO_ERROR; }
+
+    CHIP_ERROR StartHarmonicPhasesRead() override { return CHIP_NO_ERROR; }
+    CHIP_ERROR GetHarmonicPhasesByIndex(uint8_t, Structs::HarmonicMeasurementStruct::Type &) override
+    {
+        return CHIP_ERROR_PROVIDER_LIST_EXHAUSTED;
+    }
+    CHIP_ERROR EndHarmonicPhasesRead() override { return CHIP_NO_ERROR; }
+
+    DataModel::Nullable<int64_t> GetVoltage() override { return {}; }
+    DataModel::Nullable<int64_t> GetActiveCurrent() override { return {}; }
+    DataModel::Nullable<int64_t> GetReactiveCurrent() override { return {}; }
+    DataModel::Nullable<int64_t> GetApparentCurrent() override { return {}; }
+    DataModel::Nullable<int64_t> GetActivePower() override { return {}; }
+    DataModel::Nullable<int64_t> GetReactivePower() override { return {}; }
+    DataModel::Nullable<int64_t> GetApparentPower() override { return {}; }
+    DataModel::Nullable<int64_t> GetRMSVoltage() override { return {}; }
+    DataModel::Nullable<int64_t> GetRMSCurrent() override { return {}; }
+    DataModel::Nullable<int64_t> GetRMSPower() override { return {}; }
+    DataModel::Nullable<int64_t> GetFrequency() override { return {}; }
+    DataModel::Nullable<int64_t> GetPowerFactor() override { return {}; }
+    DataModel::Nullable<int64_t> GetNeutralCurrent() override { return {}; }
+};
+
+DataModel::Nullable<int64_t> Value(int64_t value)
+{
+    return DataModel::MakeNullable(value);
+}
+
+void ClearReportedChanges()
+{
+    chip::Test::reportedAttributeChanges = chip::Test::ReportedAttributeChanges();
+}
+
+bool WasReported(AttributeId attributeId)
+{
+    const auto & changes = chip::Test::reportedAttributeChanges;
+    for (size_t i = 0; i < changes.pathCount; i++)
+    {
+        if (changes.paths[i] == ConcreteAttributePath(kTestEndpointId, ElectricalPowerMeasurement::Id, attributeId))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+class TestElectricalPowerMeasurementServer : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+
+    void SetUp() override
+    {
+        ClearReportedChanges();
+        ASSERT_EQ(mInstance.Init(), CHIP_NO_ERROR);
+    }
+    void TearDown() override { mInstance.Shutdown(); }
+
+protected:
+    TestDelegate mDelegate;
+    Instance mInstance{ kTestEndpointId, mDelegate, BitMask<Feature>(Feature::kAlternatingCurrent),
+                        BitMask<OptionalAttributes>(OptionalAttributes::kOptionalAttributeVoltage,
+                                                    OptionalAttributes::kOptionalAttributeActiveCurrent,
+                                                    OptionalAttributes::kOptionalAttributeFrequency) };
+};
+
+TEST_F(TestElectricalPowerMeasurementServer, TestSingleChangeOutsideFrame)
+{
+    mDelegate.MeasurementChanged(Attributes::Voltage::Id, Value(230000));
+
+    EXPECT_EQ(chip::Test::reportedAttributeChanges.dataVersionIncreases, 1u);
+    EXPECT_EQ(chip::Test::reportedAttributeChanges.pathCount, 1u);
+    EXPECT_TRUE(WasReported(Attributes::Voltage::Id));
+}
+
+TEST_F(TestElectricalPowerMeasurementServer, TestFrameReportsOnlyChangedMeasurements)
+{
+    mInstance.BeginUpdate();
+    mDelegate.MeasurementChanged(Attributes::Voltage::Id, Value(230000));
+    mDelegate.MeasurementChanged(Attributes::ActivePower::Id, Value(1500000));
+    mDelegate.MeasurementChanged(Attributes::Frequency::Id, Value(50000));
+    EXPECT_EQ(chip::Test::reportedAttributeChanges.dataVersionIncreases, 0u);
+    mInstance.CommitUpdate();
+
+    // One data version increase for the frame, and only the three changed paths are dirty.
+    EXPECT_EQ(chip::Test::reportedAttributeChanges.dataVersionIncreases, 1u);
+    EXPECT_EQ(chip::Test::reportedAttributeChanges.pathCount, 3u);
+    EXPECT_TRUE(WasReported(Attributes::Voltage::Id));
+    EXPECT_TRUE(WasReported(Attributes::ActivePower::Id));
+    EXPECT_TRUE(WasReported(Attributes::Frequency::Id));
+    EXPECT_FALSE(WasReported(Attributes::ActiveCurrent::Id));
+    EXPECT_FALSE(WasReported(Attributes::NeutralCurrent::Id));
+}
+
+TEST_F(TestElectricalPowerMeasurementServer, TestInsignificantChangesAreNotReported)
+{
+    ReportableChange change;
+    change.absoluteDelta = 1000;
+    ASSERT_EQ(mInstance.SetReportableChange(Attributes::Voltage::Id, change), CHIP_NO_ERROR);
+
+    mInstance.BeginUpdate();
+    mDelegate.MeasurementChanged(Attributes::Voltage::Id, Value(230000));
+    mDelegate.MeasurementChanged(Attributes::ActiveCurrent::Id, Value(6000));
+    mInstance.CommitUpdate();
+    ClearReportedChanges();
+
+    mInstance.BeginUpdate();
+    mDelegate.MeasurementChanged(Attributes::Voltage::Id, Value(230500));
+    mDelegate.MeasurementChanged(Attributes::ActiveCurrent::Id, Value(6100));
+    mInstance.CommitUpdate();
+
+    EXPECT_EQ(chip::Test::reportedAttributeChanges.dataVersionIncreases, 1u);
+    EXPECT_EQ(chip::Test::reportedAttributeChanges.pathCount, 1u);
+    EXPECT_TRUE(WasReported(Attributes::ActiveCurrent::Id));
+    EXPECT_FALSE(WasReported(Attributes::Voltage::Id));
+}
+
+TEST_F(TestElectricalPowerMeasurementServer, TestNestedFramesCommitOnce)
+{
+    mInstance.BeginUpdate();
+    mDelegate.MeasurementChanged(Attributes::Voltage::Id, Value(230000));
+    mInstance.BeginUpdate();
+    mDelegate.MeasurementChanged(Attributes::Frequency::Id, Value(50000));
+    mInstance.CommitUpdate();
+    EXPECT_EQ(chip::Test::reportedAttributeChanges.dataVersionIncreases, 0u);
+    mInstance.CommitUpdate();
+
+    EXPECT_EQ(chip::Test::reportedAttributeChanges.dataVersionIncreases, 1u);
+    EXPECT_EQ(chip::Test::reportedAttributeChanges.pathCount, 2u);
+    EXPECT_TRUE(WasReported(Attributes::Voltage::Id));
+    EXPECT_TRUE(WasReported(Attributes::Frequency::Id));
+}
+
+TEST_F(TestElectricalPowerMeasurementServer, TestEmptyFrameReportsNothing)
+{
+    mInstance.BeginUpdate();
+    mInstance.CommitUpdate();
+
+    EXPECT_EQ(chip::Test::reportedAttributeChanges.dataVersionIncreases, 0u);
+    EXPECT_EQ(chip::Test::reportedAttributeChanges.pathCount, 0u);
+}
+
+} // namespace
@@ -0,0 +1,101 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/EndpointIndex.h>
+#include <pw_unit_test/framework.h>
+
+#include <map>
+#include <stdlib.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr size_t kMaxEndpoints = 1000;
+using TestIndex                = EndpointIndex<kMaxEndpoints>;
+
+} // namespace
+
+TEST(TestEndpointIndex, TestInsertFindRemove)
+{
+    static TestIndex index;
+    index.Clear();
+
+    EXPECT_EQ(index.Find(1), TestIndex::kInvalidIndex);
+    EXPECT_FALSE(index.Insert(kInvalidEndpointId, 0));
+    EXPECT_EQ(index.Find(kInvalidEndpointId), TestIndex::kInvalidIndex);
+
+    // Consecutive endpoint ids, as bridges allocate them.
+    for (uint16_t i = 0; i < kMaxEndpoints; i++)
+    {
+        ASSERT_TRUE(index.Insert(static_cast<EndpointId>(i + 2), i));
+    }
+    EXPECT_EQ(index.Count(), kMaxEndpoints);
+    EXPECT_FALSE(index.Insert(5000, 0));
+
+    for (uint16_t i = 0; i < kMaxEndpoints; i++)
+    {
+        EXPECT_EQ(index.Find(static_cast<EndpointId>(i + 2)), i);
+    }
+    EXPECT_EQ(index.Find(0), TestIndex::kInvalidIndex);
+
+    // Updating an endpoint does not take another entry.
+    EXPECT_TRUE(index.Insert(2, 42));
+    EXPECT_EQ(index.Find(2), 42);
+    EXPECT_EQ(index.Count(), kMaxEndpoints);
+
+    index.Remove(2);
+    index.Remove(2);
+    EXPECT_EQ(index.Find(2), TestIndex::kInvalidIndex);
+    EXPECT_EQ(index.Find(3), 1);
+    EXPECT_EQ(index.Count(), kMaxEndpoints - 1);
+    EXPECT_TRUE(index.Insert(5000, 7));
+    EXPECT_EQ(index.Find(5000), 7);
+}
+
+TEST(TestEndpointIndex, TestChurn)
+{
+    // Devices joining and leaving a bridge, checked against a reference map.
+    static TestIndex index;
+    index.Clear();
+    std::map<EndpointId, uint16_t> reference;
+
+    srand(1234);
+    for (int i = 0; i < 100000; i++)
+    {
+        const EndpointId endpoint = static_cast<EndpointId>(rand() % 2000);
+        if (rand() % 2 == 0 && reference.size() < kMaxEndpoints)
+        {
+            const uint16_t value = static_cast<uint16_t>(rand() % 0xFFFF);
+            ASSERT_TRUE(index.Insert(endpoint, value));
+            reference[endpoint] = value;
+        }
+        else
+        {
+            index.Remove(endpoint);
+            reference.erase(endpoint);
+        }
+    }
+
+    EXPECT_EQ(index.Count(), reference.size());
+    for (EndpointId endpoint = 0; endpoint < 2000; endpoint++)
+    {
+        auto it = reference.find(endpoint);
+        EXPECT_EQ(index.Find(endpoint), (it == reference.end()) ? TestIndex::kInvalidIndex : it->second);
+    }
+}
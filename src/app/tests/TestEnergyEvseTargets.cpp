@@ -0,0 +1,272 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/clusters/energy-evse-server/ChargingPlanner.h>
+#include <app/clusters/energy-evse-server/ChargingTargetsStore.h>
+#include <app/data-model/Decode.h>
+#include <app/data-model/Encode.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/core/TLV.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <pw_unit_test/framework.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters::EnergyEvse;
+
+using ChargingTarget         = ChargingTargetsStore::ChargingTarget;
+using ChargingTargetSchedule = ChargingTargetsStore::ChargingTargetSchedule;
+
+namespace {
+
+constexpr EndpointId kEndpoint = 1;
+
+// 2024-01-01 00:00 UTC, a Monday, in Matter epoch seconds.
+constexpr uint32_t kMondayMidnight = 757382400;
+constexpr uint32_t kSecondsPerDay  = 24 * 60 * 60;
+
+constexpr uint8_t kWeekdays = 0x3E; // Monday to Friday
+constexpr uint8_t kSaturday = 0x40;
+
+Optional<Percent> SoC(Percent percent)
+{
+    return MakeOptional(percent);
+}
+
+ChargingTarget MakeTarget(uint16_t minutesPastMidnight, Optional<Percent> targetSoC, Optional<int64_t> addedEnergy = NullOptional)
+{
+    ChargingTarget target;
+    target.targetTimeMinutesPastMidnight = minutesPastMidnight;
+    target.targetSoC                     = targetSoC;
+    target.addedEnergy                   = addedEnergy;
+    return target;
+}
+
+template <size_t N>
+ChargingTargetSchedule MakeSchedule(uint8_t days, const ChargingTarget (&targets)[N])
+{
+    ChargingTargetSchedule schedule;
+    schedule.dayOfWeekForSequence = BitMask<TargetDayOfWeekBitmap>(static_cast<TargetDayOfWeekBitmap>(days));
+    schedule.chargingTargets      = DataModel::List<const ChargingTarget>(targets);
+    return schedule;
+}
+
+// Encodes `schedules` the way a SetTargets command carries them, so that they can be decoded into `decodable`.
+class EncodedSchedules
+{
+public:
+    template <size_t N>
+    CHIP_ERROR Encode(const ChargingTargetSchedule (&schedules)[N])
+    {
+        TLV::TLVWriter writer;
+        writer.Init(mBuffer);
+        ReturnErrorOnFailure(
+            DataModel::Encode(writer, TLV::AnonymousTag(), DataModel::List<const ChargingTargetSchedule>(schedules)));
+        ReturnErrorOnFailure(writer.Finalize());
+
+        mReader.Init(mBuffer, writer.GetLengthWritten());
+        ReturnErrorOnFailure(mReader.Next());
+        return DataModel::Decode(mReader, decodable);
+    }
+
+    ChargingTargetsStore::DecodableChargingSchedules decodable;
+
+private:
+    uint8_t mBuffer[1024];
+    TLV::TLVReader mReader;
+};
+
+class TestEnergyEvseTargets : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+};
+
+TEST_F(TestEnergyEvseTargets, TestSetGetAndPersist)
+{
+    TestPersistentStorageDelegate storage;
+    ChargingTargetsStore store;
+    ASSERT_EQ(store.Init(storage, kEndpoint), CHIP_NO_ERROR);
+    EXPECT_EQ(store.GetTargets().size(), 0u);
+
+    // Targets are given out of order on purpose.
+    const ChargingTarget weekdayTargets[]    = { MakeTarget(18 * 60, SoC(80)), MakeTarget(7 * 60 + 30, SoC(60)) };
+    const ChargingTarget saturdayTargets[]   = { MakeTarget(10 * 60, NullOptional, MakeOptional<int64_t>(20000000)) };
+    const ChargingTargetSchedule schedules[] = { MakeSchedule(kWeekdays, weekdayTargets),
+                                                 MakeSchedule(kSaturday, saturdayTargets) };
+
+    EncodedSchedules encoded;
+    ASSERT_EQ(encoded.Encode(schedules), CHIP_NO_ERROR);
+    EXPECT_EQ(store.SetTargets(encoded.decodable), CHIP_NO_ERROR);
+
+    auto monday = store.GetTargetsForDay(1);
+    ASSERT_EQ(monday.size(), 2u);
+    EXPECT_EQ(monday[0].targetTimeMinutesPastMidnight, 7 * 60 + 30);
+    EXPECT_EQ(monday[1].targetTimeMinutesPastMidnight, 18 * 60);
+    EXPECT_EQ(store.GetTargetsForDay(0).size(), 0u);
+    EXPECT_EQ(store.GetTargetsForDay(6).size(), 1u);
+
+    // Days with identical targets are grouped back into one schedule.
+    auto checkTargets = [](ChargingTargetsStore & targetsStore) {
+        auto result = targetsStore.GetTargets();
+        ASSERT_EQ(result.size(), 2u);
+        EXPECT_EQ(result[0].dayOfWeekForSequence.Raw(), kWeekdays);
+        ASSERT_EQ(result[0].chargingTargets.size(), 2u);
+        EXPECT_EQ(result[0].chargingTargets[0].targetSoC, SoC(60));
+        EXPECT_EQ(result[1].dayOfWeekForSequence.Raw(), kSaturday);
+        ASSERT_EQ(result[1].chargingTargets.size(), 1u);
+        EXPECT_EQ(result[1].chargingTargets[0].addedEnergy, MakeOptional<int64_t>(20000000));
+    };
+    checkTargets(store);
+
+    ChargingTargetsStore restored;
+    ASSERT_EQ(restored.Init(storage, kEndpoint), CHIP_NO_ERROR);
+    checkTargets(restored);
+
+    EXPECT_EQ(restored.ClearTargets(), CHIP_NO_ERROR);
+    EXPECT_EQ(restored.GetTargets().size(), 0u);
+    EXPECT_EQ(storage.GetNumKeys(), 0u);
+}
+
+TEST_F(TestEnergyEvseTargets, TestPartialUpdateAndValidation)
+{
+    TestPersistentStorageDelegate storage;
+    ChargingTargetsStore store;
+    ASSERT_EQ(store.Init(storage, kEndpoint), CHIP_NO_ERROR);
+
+    const ChargingTarget morning[] = { MakeTarget(8 * 60, SoC(100)) };
+    const ChargingTarget evening[] = { MakeTarget(20 * 60, SoC(50)) };
+    {
+        const ChargingTargetSchedule schedules[] = { MakeSchedule(kWeekdays, morning) };
+        EncodedSchedules encoded;
+        ASSERT_EQ(encoded.Encode(schedules), CHIP_NO_ERROR);
+        EXPECT_EQ(store.SetTargets(encoded.decodable), CHIP_NO_ERROR);
+    }
+
+    // Only the days covered by the new schedules change.
+    uint32_t generation = store.GetGeneration();
+    {
+        const ChargingTargetSchedule schedules[] = { MakeSchedule(0x02, evening) };
+        EncodedSchedules encoded;
+        ASSERT_EQ(encoded.Encode(schedules), CHIP_NO_ERROR);
+        EXPECT_EQ(store.SetTargets(encoded.decodable), CHIP_NO_ERROR);
+    }
+    EXPECT_NE(store.GetGeneration(), generation);
+    EXPECT_EQ(store.GetTargetsForDay(1)[0].targetTimeMinutesPastMidnight, 20 * 60);
+    EXPECT_EQ(store.GetTargetsForDay(2)[0].targetTimeMinutesPastMidnight, 8 * 60);
+    EXPECT_EQ(store.GetTargets().size(), 2u);
+
+    // Invalid schedules are rejected as a whole.
+    generation = store.GetGeneration();
+    {
+        const ChargingTargetSchedule schedules[] = { MakeSchedule(0x04, evening), MakeSchedule(0x06, evening) };
+        EncodedSchedules encoded;
+        ASSERT_EQ(encoded.Encode(schedules), CHIP_NO_ERROR);
+        EXPECT_EQ(store.SetTargets(encoded.decodable), CHIP_ERROR_INVALID_ARGUMENT);
+    }
+    {
+        const ChargingTarget invalid[]           = { MakeTarget(24 * 60, SoC(50)) };
+        const ChargingTargetSchedule schedules[] = { MakeSchedule(0x04, invalid) };
+        EncodedSchedules encoded;
+        ASSERT_EQ(encoded.Encode(schedules), CHIP_NO_ERROR);
+        EXPECT_EQ(store.SetTargets(encoded.decodable), CHIP_ERROR_INVALID_ARGUMENT);
+    }
+    {
+        ChargingTarget tooMany[ChargingTargetsStore::kMaxTargetsPerDay + 1];
+        for (uint16_t i = 0; i < ArraySize(tooMany); i++)
+        {
+            tooMany[i] = MakeTarget(i, SoC(50));
+        }
+        const ChargingTargetSchedule schedules[] = { MakeSchedule(0x04, tooMany) };
+        EncodedSchedules encoded;
+        ASSERT_EQ(encoded.Encode(schedules), CHIP_NO_ERROR);
+        EXPECT_EQ(store.SetTargets(encoded.decodable), CHIP_ERROR_NO_MEMORY);
+    }
+    EXPECT_EQ(store.GetGeneration(), generation);
+    EXPECT_EQ(store.GetTargetsForDay(2)[0].targetTimeMinutesPastMidnight, 8 * 60);
+}
+
+TEST_F(TestEnergyEvseTargets, TestPlanner)
+{
+    EXPECT_EQ(ChargingPlanner::DayOfWeek(0), 6u);                                // 2000-01-01 was a Saturday
+    EXPECT_EQ(ChargingPlanner::DayOfWeek(kMondayMidnight / kSecondsPerDay), 1u); // 2024-01-01 was a Monday
+
+    TestPersistentStorageDelegate storage;
+    ChargingTargetsStore store;
+    ASSERT_EQ(store.Init(storage, kEndpoint), CHIP_NO_ERROR);
+
+    ChargingPlanner planner;
+    ChargingPlanner::Inputs inputs;
+    inputs.chargeCurrent = 32000; // 32A * 230V = 7.36kW
+    inputs.stateOfCharge.SetNonNull(20);
+    inputs.batteryCapacity.SetNonNull(100000000); // 100kWh
+
+    // No targets: nothing is planned.
+    EXPECT_TRUE(planner.Update(store, inputs, kMondayMidnight));
+    EXPECT_TRUE(planner.GetPlan().targetTime.IsNull());
+    EXPECT_TRUE(planner.GetPlan().startTime.IsNull());
+
+    const ChargingTarget targets[]           = { MakeTarget(7 * 60, SoC(80)),
+                                                 MakeTarget(18 * 60, NullOptional, MakeOptional<int64_t>(7360000)) };
+    const ChargingTargetSchedule schedules[] = { MakeSchedule(0x02, targets) }; // Monday only
+    EncodedSchedules encoded;
+    ASSERT_EQ(encoded.Encode(schedules), CHIP_NO_ERROR);
+    ASSERT_EQ(store.SetTargets(encoded.decodable), CHIP_NO_ERROR);
+
+    // 60% of 100kWh at 7.36kW takes 29348s: the 07:00 target cannot be reached, so start right away.
+    EXPECT_TRUE(planner.Update(store, inputs, kMondayMidnight));
+    const ChargingPlanner::Plan & plan = planner.GetPlan();
+    EXPECT_EQ(plan.targetTime.Value(), kMondayMidnight + 7 * 3600);
+    EXPECT_EQ(plan.requiredEnergy.Value(), 60000000);
+    EXPECT_EQ(plan.targetSoC.Value(), 80);
+    EXPECT_EQ(plan.startTime.Value(), kMondayMidnight);
+
+    // Nothing changed: the cached plan is kept.
+    EXPECT_FALSE(planner.Update(store, inputs, kMondayMidnight + 60));
+
+    // Less energy needed (9783s of charge): start later.
+    inputs.stateOfCharge.SetNonNull(60);
+    EXPECT_TRUE(planner.Update(store, inputs, kMondayMidnight + 60));
+    EXPECT_EQ(plan.requiredEnergy.Value(), 20000000);
+    EXPECT_EQ(plan.startTime.Value(), kMondayMidnight + 7 * 3600 - 9783);
+
+    // Once the first target passed, plan for the next one, which only specifies the added energy (1h of charge).
+    EXPECT_TRUE(planner.Update(store, inputs, kMondayMidnight + 7 * 3600));
+    EXPECT_EQ(plan.targetTime.Value(), kMondayMidnight + 18 * 3600);
+    EXPECT_EQ(plan.requiredEnergy.Value(), 7360000);
+    EXPECT_TRUE(plan.targetSoC.IsNull());
+    EXPECT_EQ(plan.startTime.Value(), kMondayMidnight + 17 * 3600);
+
+    // Targets are in local time.
+    inputs.localTimeOffset = 3600;
+    EXPECT_TRUE(planner.Update(store, inputs, kMondayMidnight + 7 * 3600));
+    EXPECT_EQ(plan.targetTime.Value(), kMondayMidnight + 17 * 3600);
+
+    // After the last target of the week, wrap around to next Monday.
+    inputs.localTimeOffset = 0;
+    EXPECT_TRUE(planner.Update(store, inputs, kMondayMidnight + 19 * 3600));
+    EXPECT_EQ(plan.targetTime.Value(), kMondayMidnight + 7 * kSecondsPerDay + 7 * 3600);
+
+    // Clearing the targets clears the plan.
+    EXPECT_EQ(store.ClearTargets(), CHIP_NO_ERROR);
+    EXPECT_TRUE(planner.Update(store, inputs, kMondayMidnight + 19 * 3600));
+    EXPECT_TRUE(plan.targetTime.IsNull());
+}
+
+} // namespace
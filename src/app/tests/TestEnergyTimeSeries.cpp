@@ -0,0 +1,127 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/clusters/electrical-energy-measurement-server/EnergyTimeSeries.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <pw_unit_test/framework.h>
+
+using namespace chip;
+using namespace chip::app::Clusters::ElectricalEnergyMeasurement;
+
+using Resolution     = EnergyTimeSeries::Resolution;
+using Sample         = EnergyTimeSeries::Sample;
+using EnergyStruct   = Structs::EnergyMeasurementStruct::Type;
+using TestTimeSeries = EnergyTimeSeriesWithStorage<8, 4, 4, 4>;
+using OptionalEnergy = Optional<EnergyStruct>;
+
+namespace {
+
+Sample MakeSample(uint32_t startTime, uint32_t endTime, int64_t imported, int64_t exported = 0)
+{
+    Sample sample;
+    sample.startTime = startTime;
+    sample.endTime   = endTime;
+    sample.imported  = imported;
+    sample.exported  = exported;
+    return sample;
+}
+
+OptionalEnergy MakeEnergy(int64_t energy, uint32_t endTimestamp)
+{
+    EnergyStruct measurement;
+    measurement.energy = energy;
+    measurement.endTimestamp.SetValue(endTimestamp);
+    return MakeOptional(measurement);
+}
+
+} // namespace
+
+TEST(TestEnergyTimeSeries, TestDownsampling)
+{
+    TestTimeSeries series(EnergyTimeSeries::Source::kPeriodic);
+
+    // Ten seconds samples of 1 mWh over 30 minutes.
+    for (uint32_t time = 0; time < 30 * 60; time += 10)
+    {
+        ASSERT_EQ(series.Append(MakeSample(time, time + 10, 1)), CHIP_NO_ERROR);
+    }
+
+    // The raw samples and minutes only keep the most recent history.
+    EXPECT_EQ(series.Size(Resolution::kRaw), 8u);
+    EXPECT_EQ(series.Size(Resolution::kOneMinute), 4u);
+    EXPECT_EQ(series.Size(Resolution::kFifteenMinutes), 1u); // The second quarter of an hour is not complete yet
+    EXPECT_EQ(series.Size(Resolution::kOneHour), 0u);
+
+    Sample samples[4];
+    ASSERT_EQ(series.Query(Resolution::kOneMinute, 0, UINT32_MAX, Span<Sample>(samples)), 4u);
+    EXPECT_EQ(samples[0].startTime, 25u * 60);
+    EXPECT_EQ(samples[3].endTime, 29u * 60);
+    EXPECT_EQ(samples[3].imported, 6);
+
+    ASSERT_EQ(series.Query(Resolution::kFifteenMinutes, 0, UINT32_MAX, Span<Sample>(samples)), 1u);
+    EXPECT_EQ(samples[0].endTime, 15u * 60);
+    EXPECT_EQ(samples[0].imported, 90);
+
+    // Samples ending within (from, to].
+    EXPECT_EQ(series.Total(Resolution::kRaw, 30 * 60 - 30, 30 * 60).imported, 3);
+    EXPECT_EQ(series.Total(Resolution::kOneMinute, 26 * 60, 28 * 60).imported, 12);
+    EXPECT_EQ(series.Query(Resolution::kRaw, 0, 30 * 60, Span<Sample>(samples, 2)), 2u);
+    EXPECT_EQ(samples[0].endTime, 30u * 60 - 70);
+
+    // Time cannot go backwards.
+    EXPECT_EQ(series.Append(MakeSample(0, 10, 1)), CHIP_ERROR_INVALID_ARGUMENT);
+
+    series.Clear();
+    EXPECT_EQ(series.Size(Resolution::kRaw), 0u);
+    EXPECT_EQ(series.Append(MakeSample(0, 10, 1)), CHIP_NO_ERROR);
+}
+
+TEST(TestEnergyTimeSeries, TestMeasurements)
+{
+    TestTimeSeries cumulative(EnergyTimeSeries::Source::kCumulative);
+
+    // The first cumulative value is the baseline.
+    EXPECT_EQ(cumulative.AppendMeasurement(MakeEnergy(1000, 100), MakeEnergy(50, 100)), CHIP_NO_ERROR);
+    EXPECT_EQ(cumulative.Size(Resolution::kRaw), 0u);
+
+    EXPECT_EQ(cumulative.AppendMeasurement(MakeEnergy(1200, 160), MakeEnergy(80, 160)), CHIP_NO_ERROR);
+    // The meter was reset to zero.
+    EXPECT_EQ(cumulative.AppendMeasurement(MakeEnergy(30, 220), MakeEnergy(80, 220)), CHIP_NO_ERROR);
+
+    Sample samples[2];
+    ASSERT_EQ(cumulative.Query(Resolution::kRaw, 0, UINT32_MAX, Span<Sample>(samples)), 2u);
+    EXPECT_EQ(samples[0].startTime, 100u);
+    EXPECT_EQ(samples[0].endTime, 160u);
+    EXPECT_EQ(samples[0].imported, 200);
+    EXPECT_EQ(samples[0].exported, 30);
+    EXPECT_EQ(samples[1].imported, 30);
+    EXPECT_EQ(samples[1].exported, 0);
+
+    EXPECT_EQ(cumulative.AppendMeasurement(NullOptional, NullOptional), CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Periodic measurements fall back on systimes, in milliseconds.
+    TestTimeSeries periodic(EnergyTimeSeries::Source::kPeriodic);
+    EnergyStruct measurement;
+    measurement.energy = 25;
+    measurement.startSystime.SetValue(60000);
+    measurement.endSystime.SetValue(120000);
+    EXPECT_EQ(periodic.AppendMeasurement(MakeOptional(measurement), NullOptional), CHIP_NO_ERROR);
+    ASSERT_EQ(periodic.Query(Resolution::kRaw, 0, UINT32_MAX, Span<Sample>(samples)), 1u);
+    EXPECT_EQ(samples[0].startTime, 60u);
+    EXPECT_EQ(samples[0].endTime, 120u);
+    EXPECT_EQ(samples[0].imported, 25);
+}
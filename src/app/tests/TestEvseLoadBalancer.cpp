@@ -0,0 +1,173 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/clusters/energy-evse-server/EvseLoadBalancer.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <pw_unit_test/framework.h>
+
+using namespace chip;
+using namespace chip::app::Clusters::EnergyEvse;
+
+namespace {
+
+constexpr int64_t kMinimumCurrent = 6000;
+
+class TestEvse : public EvseLoadBalancer::Participant
+{
+public:
+    explicit TestEvse(int64_t limit = 32000) : mLocalLimit(limit) {}
+
+    int64_t GetLocalCurrentLimit() override { return mLocalLimit; }
+    int64_t GetMinimumCurrent() override { return kMinimumCurrent; }
+    bool IsDrawingCurrent() override { return mDrawing; }
+    void OnCurrentAllocated(int64_t current) override
+    {
+        mCurrent = current;
+        mNotifications++;
+    }
+
+    int64_t mLocalLimit;
+    bool mDrawing           = false;
+    int64_t mCurrent        = 0;
+    uint32_t mNotifications = 0;
+};
+
+} // namespace
+
+TEST(TestEvseLoadBalancer, TestFairShare)
+{
+    EvseLoadBalancer balancer(40000);
+    TestEvse a(32000);
+    TestEvse b(32000);
+    TestEvse c(10000);
+
+    // A single EVSE gets its own limit.
+    ASSERT_EQ(balancer.Register(a), CHIP_NO_ERROR);
+    EXPECT_EQ(a.mCurrent, 32000);
+    EXPECT_EQ(balancer.Register(a), CHIP_ERROR_INCORRECT_STATE);
+
+    a.mDrawing = true;
+    balancer.Update(a);
+    EXPECT_EQ(a.mCurrent, 32000);
+
+    // Idle EVSEs are offered the headroom.
+    ASSERT_EQ(balancer.Register(b), CHIP_NO_ERROR);
+    ASSERT_EQ(balancer.Register(c), CHIP_NO_ERROR);
+    EXPECT_EQ(b.mCurrent, 8000);
+    EXPECT_EQ(c.mCurrent, 8000);
+
+    // Plugging in shares the capacity equally.
+    b.mDrawing = true;
+    balancer.Update(b);
+    EXPECT_EQ(a.mCurrent, 20000);
+    EXPECT_EQ(b.mCurrent, 20000);
+    EXPECT_EQ(c.mCurrent, 0);
+
+    // The share an EVSE cannot use goes to the others.
+    c.mDrawing = true;
+    balancer.Update(c);
+    EXPECT_EQ(a.mCurrent, 15000);
+    EXPECT_EQ(b.mCurrent, 15000);
+    EXPECT_EQ(c.mCurrent, 10000);
+    EXPECT_EQ(balancer.GetAllocatedCurrent(), 40000);
+
+    // Updates that change nothing are not notified.
+    const uint32_t notifications = a.mNotifications;
+    balancer.Update(a);
+    balancer.Update(c);
+    EXPECT_EQ(a.mNotifications, notifications);
+
+    // A lower local limit of one EVSE frees current for the others.
+    b.mLocalLimit = 9000;
+    balancer.Update(b);
+    EXPECT_EQ(a.mCurrent, 21000);
+    EXPECT_EQ(b.mCurrent, 9000);
+    EXPECT_EQ(c.mCurrent, 10000);
+
+    // Unplugging returns its share.
+    balancer.Unregister(a);
+    EXPECT_EQ(b.mCurrent, 9000);
+    EXPECT_EQ(c.mCurrent, 10000);
+    EXPECT_EQ(balancer.GetAllocatedCurrent(), 19000);
+
+    balancer.Unregister(b);
+    balancer.Unregister(c);
+}
+
+TEST(TestEvseLoadBalancer, TestMinimumCurrent)
+{
+    EvseLoadBalancer balancer(16000);
+    TestEvse evses[3];
+
+    for (auto & evse : evses)
+    {
+        evse.mDrawing = true;
+        ASSERT_EQ(balancer.Register(evse), CHIP_NO_ERROR);
+    }
+
+    // Only two EVSEs can get their minimum current: the first ones to draw current are served.
+    EXPECT_EQ(evses[0].mCurrent, 8000);
+    EXPECT_EQ(evses[1].mCurrent, 8000);
+    EXPECT_EQ(evses[2].mCurrent, 0);
+
+    // The first EVSE stops, then starts again: it is now the last one served.
+    evses[0].mDrawing = false;
+    balancer.Update(evses[0]);
+    EXPECT_EQ(evses[1].mCurrent, 8000);
+    EXPECT_EQ(evses[2].mCurrent, 8000);
+    evses[0].mDrawing = true;
+    balancer.Update(evses[0]);
+    EXPECT_EQ(evses[0].mCurrent, 0);
+
+    // A larger circuit serves everybody.
+    balancer.SetCapacity(30000);
+    EXPECT_EQ(evses[0].mCurrent, 10000);
+    EXPECT_EQ(evses[1].mCurrent, 10000);
+    EXPECT_EQ(evses[2].mCurrent, 10000);
+
+    for (auto & evse : evses)
+    {
+        balancer.Unregister(evse);
+    }
+}
+
+TEST(TestEvseLoadBalancer, TestManyEvsesStayWithinCapacity)
+{
+    constexpr size_t kEvseCount    = 64;
+    constexpr uint32_t kIterations = 1000;
+
+    EvseLoadBalancer balancer(kEvseCount * 16000);
+    TestEvse evses[kEvseCount];
+    for (size_t i = 0; i < kEvseCount; i++)
+    {
+        evses[i].mLocalLimit = static_cast<int64_t>(16000 + (i % 4) * 8000);
+        ASSERT_EQ(balancer.Register(evses[i]), CHIP_NO_ERROR);
+    }
+
+    for (uint32_t i = 0; i < kIterations; i++)
+    {
+        TestEvse & evse = evses[i % kEvseCount];
+        evse.mDrawing   = !evse.mDrawing;
+        balancer.Update(evse);
+        EXPECT_LE(balancer.GetAllocatedCurrent(), balancer.GetCapacity());
+    }
+
+    for (auto & evse : evses)
+    {
+        balancer.Unregister(evse);
+    }
+}
@@ -42,7 +42,9 @@
 #include <platform/CHIPDeviceLayer.h>
 
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+#include <app/CASESessionManager.h>
 #include <app/SimpleSubscriptionResumptionStorage.h>
+#include <credentials/GroupDataProviderImpl.h>
 #include <lib/support/TestPersistentStorageDelegate.h>
 #endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
 
@@ -63,6 +65,30 @@ public:
     }
 };
 
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+// Fails every session establishment synchronously, as if no OperationalSessionSetup could be allocated, and counts them.
+class FailingSessionSetupPool : public chip::OperationalSessionSetupPoolDelegate
+{
+public:
+    chip::OperationalSessionSetup * Allocate(const chip::CASEClientInitParams & params, chip::CASEClientPoolDelegate * clientPool,
+                                             chip::ScopedNodeId peerId,
+                                             chip::OperationalSessionReleaseDelegate * releaseDelegate) override
+    {
+        mNumAllocations++;
+        return nullptr;
+    }
+    void Release(chip::OperationalSessionSetup * device) override {}
+    chip::OperationalSessionSetup * FindSessionSetup(chip::ScopedNodeId peerId, bool forAddressUpdate) override
+    {
+        return nullptr;
+    }
+    void ReleaseAllSessionSetupsForFabric(chip::FabricIndex fabricIndex) override {}
+    void ReleaseAllSessionSetup() override {}
+
+    size_t mNumAllocations = 0;
+};
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+
 } // namespace
 
 namespace chip {
@@ -74,6 +100,7 @@ public:
     static void TestRemoveDuplicateConcreteAttribute(nlTestSuite * apSuite, void * apContext);
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
     static void TestSubjectHasPersistedSubscription(nlTestSuite * apSuite, void * apContext);
+    static void TestSubscriptionResumptionQueue(nlTestSuite * apSuite, void * apContext);
 #if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
     static void TestSubscriptionResumptionTimer(nlTestSuite * apSuite, void * apContext);
 #endif // CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
@@ -650,6 +677,80 @@ void TestInteractionModelEngine::TestSubjectHasPersistedSubscription(nlTestSuite
     subscriptionStorage.DeleteAll(fabric2);
 }
 
+/**
+ * @brief Test verifies that at most CHIP_CONFIG_MAX_CONCURRENT_SUBSCRIPTION_RESUMPTIONS queued resumptions establish their
+ *        session at once, and that the next ones start once one of them is done.
+ */
+void TestInteractionModelEngine::TestSubscriptionResumptionQueue(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx               = *static_cast<TestContext *>(apContext);
+    InteractionModelEngine * engine = InteractionModelEngine::GetInstance();
+    CHIP_ERROR err                  = CHIP_NO_ERROR;
+
+    FailingSessionSetupPool sessionSetupPool;
+    Credentials::GroupDataProviderImpl groupDataProvider;
+    CASESessionManager caseSessionManager;
+    CASESessionManagerConfig config;
+    config.sessionInitParams.sessionManager    = &ctx.GetSecureSessionManager();
+    config.sessionInitParams.exchangeMgr       = &ctx.GetExchangeManager();
+    config.sessionInitParams.fabricTable       = &ctx.GetFabricTable();
+    config.sessionInitParams.groupDataProvider = &groupDataProvider;
+    config.sessionSetupPool                    = &sessionSetupPool;
+    err                                        = caseSessionManager.Init(&ctx.GetSystemLayer(), config);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = engine->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(), app::reporting::GetDefaultReportScheduler(),
+                       &caseSessionManager);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    constexpr size_t kMaxInProgress = CHIP_CONFIG_MAX_CONCURRENT_SUBSCRIPTION_RESUMPTIONS;
+    constexpr size_t kNumQueued     = kMaxInProgress + 2;
+    SubscriptionResumptionStorage::SubscriptionInfo infos[kNumQueued];
+    SubscriptionResumptionSessionEstablisher * establishers[kNumQueued];
+    for (size_t i = 0; i < kNumQueued; i++)
+    {
+        infos[i].mNodeId         = static_cast<NodeId>(i + 1);
+        infos[i].mFabricIndex    = 1;
+        infos[i].mSubscriptionId = static_cast<SubscriptionId>(i + 1);
+
+        establishers[i] = Platform::New<SubscriptionResumptionSessionEstablisher>();
+        NL_TEST_ASSERT(apSuite, establishers[i] != nullptr);
+        NL_TEST_ASSERT(apSuite, establishers[i]->SetSubscriptionInfo(infos[i]) == CHIP_NO_ERROR);
+
+        NL_TEST_ASSERT(apSuite, !engine->IsSubscriptionResumptionQueued(infos[i]));
+        engine->QueueSubscriptionResumption(establishers[i]);
+        NL_TEST_ASSERT(apSuite, engine->IsSubscriptionResumptionQueued(infos[i]));
+    }
+    NL_TEST_ASSERT_EQUALS(apSuite, engine->mNumSubscriptionResumptionsQueued, kNumQueued);
+
+    // While as many sessions as allowed are being established, no other resumption starts.
+    for (size_t i = 0; i < kMaxInProgress; i++)
+    {
+        establishers[i]->mSessionEstablishmentStarted = true;
+    }
+    engine->StartQueuedSubscriptionResumptions();
+    NL_TEST_ASSERT_EQUALS(apSuite, sessionSetupPool.mNumAllocations, 0u);
+
+    // Once one is done, it leaves the queue and the next ones start, though not from within its own callback.
+    engine->OnSubscriptionResumptionSessionDone(*establishers[0]);
+    NL_TEST_ASSERT(apSuite, !engine->IsSubscriptionResumptionQueued(infos[0]));
+    Platform::Delete(establishers[0]);
+    NL_TEST_ASSERT_EQUALS(apSuite, sessionSetupPool.mNumAllocations, 0u);
+
+    // The sessions of the started resumptions fail synchronously, each of them freeing its slot for the next one.
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT_EQUALS(apSuite, sessionSetupPool.mNumAllocations, kNumQueued - kMaxInProgress);
+    for (size_t i = 1; i < kNumQueued; i++)
+    {
+        NL_TEST_ASSERT(apSuite, engine->IsSubscriptionResumptionQueued(infos[i]) == (i < kMaxInProgress));
+    }
+
+    // The resumptions still in progress are released with the engine.
+    engine->Shutdown();
+    NL_TEST_ASSERT(apSuite, engine->mpSubscriptionResumptionQueue == nullptr);
+    caseSessionManager.Shutdown();
+}
+
 #if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
 
 void TestInteractionModelEngine::TestSubscriptionResumptionTimer(nlTestSuite * apSuite, void * apContext)
@@ -755,6 +856,7 @@ const nlTest sTests[] =
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
                 NL_TEST_DEF("TestSubjectHasPersistedSubscription", chip::app::TestInteractionModelEngine::TestSubjectHasPersistedSubscription),
                 NL_TEST_DEF("TestDecrementNumSubscriptionsToResume", chip::app::TestInteractionModelEngine::TestDecrementNumSubscriptionsToResume),
+                NL_TEST_DEF("TestSubscriptionResumptionQueue", chip::app::TestInteractionModelEngine::TestSubscriptionResumptionQueue),
 #if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
                 NL_TEST_DEF("TestSubscriptionResumptionTimer", chip::app::TestInteractionModelEngine::TestSubscriptionResumptionTimer),
 #endif // CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
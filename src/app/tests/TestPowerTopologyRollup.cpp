@@ -0,0 +1,214 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/clusters/power-topology-server/PowerRollup.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <pw_unit_test/framework.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters::PowerTopology;
+
+using Quantity = PowerRollup::Quantity;
+using Change   = PowerRollup::Change;
+
+namespace {
+
+class TestNode : public PowerRollup::Node
+{
+public:
+    using PowerRollup::Node::Node;
+
+    void OnRollupChanged(BitFlags<Change> changes) override
+    {
+        mNotifications++;
+        mChanges.Set(changes);
+    }
+
+    void Clear()
+    {
+        mNotifications = 0;
+        mChanges.ClearAll();
+    }
+
+    unsigned mNotifications = 0;
+    BitFlags<Change> mChanges;
+};
+
+DataModel::Nullable<int64_t> Value(int64_t value)
+{
+    return DataModel::MakeNullable(value);
+}
+
+} // namespace
+
+TEST(TestPowerTopologyRollup, TestTotals)
+{
+    TestNode site(1), panel(2), evse1(3), evse2(4);
+    PowerRollup rollup;
+    ASSERT_EQ(rollup.Add(site), CHIP_NO_ERROR);
+    ASSERT_EQ(rollup.Add(panel, &site), CHIP_NO_ERROR);
+    ASSERT_EQ(rollup.Add(evse1, &panel), CHIP_NO_ERROR);
+    ASSERT_EQ(rollup.Add(evse2, &site), CHIP_NO_ERROR);
+
+    // Nothing was measured yet.
+    EXPECT_TRUE(site.GetTotal(Quantity::kActivePower).IsNull());
+
+    rollup.SetMeasurement(evse1, Quantity::kActivePower, Value(7000000));
+    rollup.SetMeasurement(evse2, Quantity::kActivePower, Value(11000000));
+    EXPECT_EQ(panel.GetTotal(Quantity::kActivePower), Value(7000000));
+    EXPECT_EQ(site.GetTotal(Quantity::kActivePower), Value(18000000));
+    EXPECT_TRUE(site.GetMeasurement(Quantity::kActivePower).IsNull());
+
+    // Quantities are independent.
+    EXPECT_TRUE(site.GetTotal(Quantity::kCumulativeEnergyImported).IsNull());
+    rollup.SetMeasurement(evse1, Quantity::kCumulativeEnergyImported, Value(500));
+    EXPECT_EQ(site.GetTotal(Quantity::kCumulativeEnergyImported), Value(500));
+
+    // A new measurement replaces the previous one; null takes it out of the totals.
+    rollup.SetMeasurement(evse1, Quantity::kActivePower, Value(3000000));
+    EXPECT_EQ(site.GetTotal(Quantity::kActivePower), Value(14000000));
+    rollup.SetMeasurement(evse1, Quantity::kActivePower, DataModel::NullNullable);
+    EXPECT_TRUE(panel.GetTotal(Quantity::kActivePower).IsNull());
+    EXPECT_EQ(site.GetTotal(Quantity::kActivePower), Value(11000000));
+
+    // A zero measurement is not the same as no measurement.
+    rollup.SetMeasurement(evse1, Quantity::kActivePower, Value(0));
+    EXPECT_EQ(panel.GetTotal(Quantity::kActivePower), Value(0));
+
+    // Removing a subtree takes its measurements out of the totals of its ancestors.
+    rollup.SetMeasurement(panel, Quantity::kActivePower, Value(-2000000));
+    rollup.SetMeasurement(evse1, Quantity::kActivePower, Value(5000000));
+    EXPECT_EQ(site.GetTotal(Quantity::kActivePower), Value(14000000));
+    rollup.Remove(panel);
+    EXPECT_EQ(site.GetTotal(Quantity::kActivePower), Value(11000000));
+    EXPECT_TRUE(site.GetTotal(Quantity::kCumulativeEnergyImported).IsNull());
+    EXPECT_EQ(panel.GetParent(), nullptr);
+    EXPECT_EQ(evse1.GetParent(), nullptr);
+
+    // Removed nodes can be added again, without their former measurements.
+    ASSERT_EQ(rollup.Add(evse1, &site), CHIP_NO_ERROR);
+    EXPECT_EQ(site.GetTotal(Quantity::kActivePower), Value(11000000));
+}
+
+TEST(TestPowerTopologyRollup, TestAddErrors)
+{
+    TestNode site(1), evse(2), foreign(3);
+    PowerRollup rollup, other;
+    ASSERT_EQ(rollup.Add(site), CHIP_NO_ERROR);
+    ASSERT_EQ(other.Add(foreign), CHIP_NO_ERROR);
+
+    EXPECT_EQ(rollup.Add(site), CHIP_ERROR_INCORRECT_STATE);
+    EXPECT_EQ(rollup.Add(evse, &foreign), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(rollup.Add(evse, &evse), CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Measurements of nodes of another rollup are ignored.
+    rollup.SetMeasurement(foreign, Quantity::kActivePower, Value(1000));
+    EXPECT_TRUE(foreign.GetMeasurement(Quantity::kActivePower).IsNull());
+
+    // The destructors of the rollups release the nodes.
+}
+
+TEST(TestPowerTopologyRollup, TestChildren)
+{
+    TestNode site(1), evse1(2), evse2(3), evse3(4);
+    PowerRollup rollup;
+    ASSERT_EQ(rollup.Add(site), CHIP_NO_ERROR);
+    ASSERT_EQ(rollup.Add(evse1, &site), CHIP_NO_ERROR);
+    ASSERT_EQ(rollup.Add(evse2, &site), CHIP_NO_ERROR);
+    ASSERT_EQ(rollup.Add(evse3, &site), CHIP_NO_ERROR);
+
+    EndpointId endpoint = kInvalidEndpointId;
+    ASSERT_EQ(site.GetChildAtIndex(1, endpoint), CHIP_NO_ERROR);
+    EXPECT_EQ(endpoint, 3);
+    EXPECT_EQ(site.GetChildAtIndex(3, endpoint), CHIP_ERROR_PROVIDER_LIST_EXHAUSTED);
+    EXPECT_EQ(site.GetActiveChildAtIndex(0, endpoint), CHIP_ERROR_PROVIDER_LIST_EXHAUSTED);
+
+    // Only children drawing or supplying power are active.
+    rollup.SetMeasurement(evse1, Quantity::kActivePower, Value(0));
+    rollup.SetMeasurement(evse2, Quantity::kActivePower, Value(7000000));
+    rollup.SetMeasurement(evse3, Quantity::kActivePower, Value(-3000000));
+    ASSERT_EQ(site.GetActiveChildAtIndex(0, endpoint), CHIP_NO_ERROR);
+    EXPECT_EQ(endpoint, 3);
+    ASSERT_EQ(site.GetActiveChildAtIndex(1, endpoint), CHIP_NO_ERROR);
+    EXPECT_EQ(endpoint, 4);
+    EXPECT_EQ(site.GetActiveChildAtIndex(2, endpoint), CHIP_ERROR_PROVIDER_LIST_EXHAUSTED);
+
+    // The site draws 4 kW in total, so it is active itself.
+    EXPECT_TRUE(site.IsActive());
+    EXPECT_FALSE(evse1.IsActive());
+
+    rollup.Remove(evse2);
+    ASSERT_EQ(site.GetChildAtIndex(1, endpoint), CHIP_NO_ERROR);
+    EXPECT_EQ(endpoint, 4);
+    ASSERT_EQ(site.GetActiveChildAtIndex(0, endpoint), CHIP_NO_ERROR);
+    EXPECT_EQ(endpoint, 4);
+}
+
+TEST(TestPowerTopologyRollup, TestNotifications)
+{
+    TestNode site(1), panel(2), evse1(3), evse2(4), idle(5);
+    PowerRollup rollup;
+    ASSERT_EQ(rollup.Add(site), CHIP_NO_ERROR);
+    ASSERT_EQ(rollup.Add(panel, &site), CHIP_NO_ERROR);
+    ASSERT_EQ(rollup.Add(evse1, &panel), CHIP_NO_ERROR);
+    ASSERT_EQ(rollup.Add(evse2, &panel), CHIP_NO_ERROR);
+    ASSERT_EQ(rollup.Add(idle, &site), CHIP_NO_ERROR);
+    EXPECT_EQ(panel.mNotifications, 2u);
+    EXPECT_TRUE(panel.mChanges.HasOnly(Change::kChildren));
+
+    for (TestNode * node : { &site, &panel, &evse1, &evse2, &idle })
+    {
+        node->Clear();
+    }
+
+    // Within a frame, each node is notified once, whatever the number of changes below it.
+    rollup.BeginUpdate();
+    rollup.SetMeasurement(evse1, Quantity::kActivePower, Value(7000000));
+    rollup.SetMeasurement(evse2, Quantity::kActivePower, Value(7000000));
+    rollup.SetMeasurement(evse2, Quantity::kCumulativeEnergyImported, Value(100));
+    EXPECT_EQ(site.mNotifications, 0u);
+    rollup.CommitUpdate();
+
+    EXPECT_EQ(evse1.mNotifications, 1u);
+    EXPECT_EQ(evse2.mNotifications, 1u);
+    EXPECT_EQ(panel.mNotifications, 1u);
+    EXPECT_TRUE(panel.mChanges.HasAll(Change::kTotals, Change::kActiveChildren));
+    EXPECT_EQ(site.mNotifications, 1u);
+    EXPECT_TRUE(site.mChanges.HasAll(Change::kTotals, Change::kActiveChildren));
+    EXPECT_FALSE(site.mChanges.Has(Change::kChildren));
+    // Nodes outside of the changed branches are not notified.
+    EXPECT_EQ(idle.mNotifications, 0u);
+
+    // Setting a measurement to its current value changes nothing.
+    site.Clear();
+    rollup.SetMeasurement(evse1, Quantity::kActivePower, Value(7000000));
+    EXPECT_EQ(site.mNotifications, 0u);
+
+    // The panel stays active while one of its children draws power.
+    panel.Clear();
+    site.Clear();
+    rollup.SetMeasurement(evse1, Quantity::kActivePower, Value(0));
+    EXPECT_TRUE(panel.mChanges.HasAll(Change::kTotals, Change::kActiveChildren));
+    EXPECT_TRUE(site.mChanges.HasOnly(Change::kTotals));
+
+    // Removing a node notifies its former parent.
+    site.Clear();
+    rollup.Remove(idle);
+    EXPECT_EQ(site.mNotifications, 1u);
+    EXPECT_TRUE(site.mChanges.HasOnly(Change::kChildren));
+}
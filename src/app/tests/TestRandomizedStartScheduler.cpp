@@ -0,0 +1,263 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/clusters/energy-evse-server/RandomizedStartScheduler.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <pw_unit_test/framework.h>
+#include <system/SystemClock.h>
+
+#include <memory>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app::Clusters;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+class TestTimerDelegate : public RandomizedStartScheduler::TimerDelegate
+{
+public:
+    CHIP_ERROR StartTimer(RandomizedStartScheduler & scheduler, System::Clock::Timeout aTimeout) override
+    {
+        mArmed   = true;
+        mTimeout = aTimeout;
+        mStarts++;
+        return CHIP_NO_ERROR;
+    }
+    void CancelTimer(RandomizedStartScheduler & scheduler) override { mArmed = false; }
+    System::Clock::Timestamp GetCurrentMonotonicTimestamp() override { return mNow; }
+
+    // Advances the time to the expiry of the timer, and fires it.
+    void FireTimer(RandomizedStartScheduler & scheduler)
+    {
+        ASSERT_TRUE(mArmed);
+        mArmed = false;
+        mNow += mTimeout;
+        scheduler.OnTimerExpired();
+    }
+
+    System::Clock::Timestamp mNow = 1000_ms;
+    System::Clock::Timeout mTimeout;
+    bool mArmed      = false;
+    uint32_t mStarts = 0;
+};
+
+class TestTransition : public RandomizedStartScheduler::Transition
+{
+public:
+    void OnRandomizedStart() override
+    {
+        mStarted = true;
+        mStartCount++;
+        if (mOrder != nullptr)
+        {
+            mOrder->push_back(mId);
+        }
+        if (mCancelOnStart != nullptr)
+        {
+            mScheduler->Cancel(*mCancelOnStart);
+        }
+        if (mReschedule)
+        {
+            EXPECT_EQ(mScheduler->Schedule(*this, System::Clock::kZero), CHIP_NO_ERROR);
+        }
+    }
+
+    int mId                               = 0;
+    bool mStarted                         = false;
+    uint32_t mStartCount                  = 0;
+    std::vector<int> * mOrder             = nullptr;
+    RandomizedStartScheduler * mScheduler = nullptr;
+    bool mReschedule                      = false;   // Schedules the transition again, with an empty window
+    TestTransition * mCancelOnStart       = nullptr; // Cancels another transition
+};
+
+} // namespace
+
+TEST(TestRandomizedStartScheduler, TestOrder)
+{
+    TestTimerDelegate timer;
+    RandomizedStartScheduler scheduler(timer);
+    std::vector<int> order;
+    TestTransition transitions[4];
+    for (int i = 0; i < 4; i++)
+    {
+        transitions[i].mId    = i;
+        transitions[i].mOrder = &order;
+    }
+
+    // The timer is only armed for the earliest transition.
+    ASSERT_EQ(scheduler.ScheduleAt(transitions[0], 5000_ms), CHIP_NO_ERROR);
+    EXPECT_EQ(timer.mTimeout, 4000_ms);
+    ASSERT_EQ(scheduler.ScheduleAt(transitions[1], 3000_ms), CHIP_NO_ERROR);
+    EXPECT_EQ(timer.mTimeout, 2000_ms);
+    ASSERT_EQ(scheduler.ScheduleAt(transitions[2], 8000_ms), CHIP_NO_ERROR);
+    ASSERT_EQ(scheduler.ScheduleAt(transitions[3], 3000_ms), CHIP_NO_ERROR);
+    EXPECT_EQ(timer.mStarts, 2u);
+    EXPECT_EQ(scheduler.GetPendingCount(), 4u);
+
+    // Transitions due together start in the order they were scheduled.
+    timer.FireTimer(scheduler);
+    EXPECT_EQ(order, (std::vector<int>{ 1, 3 }));
+    EXPECT_FALSE(transitions[1].IsPending());
+    EXPECT_EQ(timer.mTimeout, 2000_ms);
+
+    // Cancelling the next transition leaves the timer armed, the wake-up re-arms it.
+    scheduler.Cancel(transitions[0]);
+    EXPECT_TRUE(timer.mArmed);
+    timer.FireTimer(scheduler);
+    EXPECT_EQ(order.size(), 2u);
+    EXPECT_EQ(timer.mTimeout, 3000_ms);
+
+    // Rescheduling moves a pending transition.
+    ASSERT_EQ(scheduler.ScheduleAt(transitions[2], 6000_ms), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.GetPendingCount(), 1u);
+    timer.FireTimer(scheduler);
+    EXPECT_EQ(order, (std::vector<int>{ 1, 3, 2 }));
+
+    // Nothing left: no timer.
+    EXPECT_EQ(scheduler.GetPendingCount(), 0u);
+    EXPECT_FALSE(timer.mArmed);
+
+    // The last pending transition cancels the timer.
+    ASSERT_EQ(scheduler.Schedule(transitions[0], 0_ms), CHIP_NO_ERROR);
+    EXPECT_EQ(timer.mTimeout, 0_ms);
+    scheduler.Cancel(transitions[0]);
+    EXPECT_FALSE(timer.mArmed);
+    EXPECT_FALSE(transitions[0].mStarted);
+}
+
+TEST(TestRandomizedStartScheduler, TestSpreadAtScale)
+{
+    constexpr size_t kDeviceCount = 5000;
+    constexpr size_t kBuckets     = 10;
+    constexpr System::Clock::Milliseconds32 kWindow(600 * 1000);
+
+    TestTimerDelegate timer;
+    RandomizedStartScheduler scheduler(timer);
+    std::unique_ptr<TestTransition[]> transitions(new TestTransition[kDeviceCount]);
+    const System::Clock::Timestamp signalTime = timer.mNow;
+
+    // All the devices receive the same signal at the same time.
+    for (size_t i = 0; i < kDeviceCount; i++)
+    {
+        ASSERT_EQ(scheduler.Schedule(transitions[i], kWindow), CHIP_NO_ERROR);
+    }
+
+    // The timer is only re-armed when a new transition is the earliest one.
+    EXPECT_LT(timer.mStarts, 100u);
+    EXPECT_EQ(scheduler.GetPendingCount(), kDeviceCount);
+
+    // The start times are spread over the window.
+    size_t buckets[kBuckets] = {};
+    for (size_t i = 0; i < kDeviceCount; i++)
+    {
+        const System::Clock::Timestamp delay = transitions[i].GetStartTime() - signalTime;
+        ASSERT_LT(delay, System::Clock::Timestamp(kWindow));
+        buckets[delay.count() * kBuckets / kWindow.count()]++;
+    }
+    for (size_t bucket : buckets)
+    {
+        EXPECT_GT(bucket, kDeviceCount / kBuckets * 8 / 10);
+        EXPECT_LT(bucket, kDeviceCount / kBuckets * 12 / 10);
+    }
+
+    // Each expiry starts the due transitions, in start time order.
+    std::vector<int> order;
+    for (size_t i = 0; i < kDeviceCount; i++)
+    {
+        transitions[i].mId    = static_cast<int>(i);
+        transitions[i].mOrder = &order;
+    }
+    timer.mStarts                      = 0;
+    System::Clock::Timestamp lastStart = signalTime;
+    size_t started                     = 0;
+    while (timer.mArmed)
+    {
+        timer.FireTimer(scheduler);
+        for (; started < order.size(); started++)
+        {
+            const System::Clock::Timestamp startTime = transitions[static_cast<size_t>(order[started])].GetStartTime();
+            EXPECT_GE(startTime, lastStart);
+            EXPECT_LE(startTime, timer.mNow);
+            lastStart = startTime;
+        }
+    }
+    EXPECT_EQ(started, kDeviceCount);
+    EXPECT_LE(timer.mStarts, kDeviceCount);
+    EXPECT_EQ(scheduler.GetPendingCount(), 0u);
+}
+
+TEST(TestRandomizedStartScheduler, TestRescheduleFromStartWithFrozenClock)
+{
+    TestTimerDelegate timer;
+    RandomizedStartScheduler scheduler(timer);
+    TestTransition transitions[2];
+    for (TestTransition & transition : transitions)
+    {
+        transition.mScheduler  = &scheduler;
+        transition.mReschedule = true;
+    }
+
+    ASSERT_EQ(scheduler.Schedule(transitions[0], 0_ms), CHIP_NO_ERROR);
+    ASSERT_EQ(scheduler.Schedule(transitions[1], 0_ms), CHIP_NO_ERROR);
+
+    // The clock does not move: each expiry starts every transition once, and the transitions
+    // scheduled again from OnRandomizedStart() wait for the next expiry.
+    for (uint32_t expiry = 1; expiry <= 3; expiry++)
+    {
+        timer.FireTimer(scheduler);
+        EXPECT_EQ(timer.mNow, 1000_ms);
+        EXPECT_EQ(transitions[0].mStartCount, expiry);
+        EXPECT_EQ(transitions[1].mStartCount, expiry);
+        EXPECT_EQ(scheduler.GetPendingCount(), 2u);
+        EXPECT_TRUE(timer.mArmed);
+        EXPECT_EQ(timer.mTimeout, 0_ms);
+    }
+
+    scheduler.Cancel(transitions[0]);
+    scheduler.Cancel(transitions[1]);
+    EXPECT_FALSE(timer.mArmed);
+}
+
+TEST(TestRandomizedStartScheduler, TestCancelDueTransitionFromStart)
+{
+    TestTimerDelegate timer;
+    RandomizedStartScheduler scheduler(timer);
+    TestTransition transitions[3];
+
+    // The first transition to start cancels the second one, which is due at the same expiry.
+    transitions[0].mScheduler     = &scheduler;
+    transitions[0].mReschedule    = true;
+    transitions[0].mCancelOnStart = &transitions[1];
+    ASSERT_EQ(scheduler.ScheduleAt(transitions[0], 2000_ms), CHIP_NO_ERROR);
+    ASSERT_EQ(scheduler.ScheduleAt(transitions[1], 2000_ms), CHIP_NO_ERROR);
+    ASSERT_EQ(scheduler.ScheduleAt(transitions[2], 2000_ms), CHIP_NO_ERROR);
+
+    timer.FireTimer(scheduler);
+    EXPECT_EQ(transitions[0].mStartCount, 1u);
+    EXPECT_FALSE(transitions[1].mStarted);
+    EXPECT_FALSE(transitions[1].IsPending());
+    EXPECT_TRUE(transitions[2].mStarted);
+
+    // Only the rescheduled transition is left.
+    EXPECT_EQ(scheduler.GetPendingCount(), 1u);
+    EXPECT_TRUE(transitions[0].IsPending());
+    scheduler.Cancel(transitions[0]);
+    EXPECT_FALSE(timer.mArmed);
+}
@@ -0,0 +1,88 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/clusters/electrical-power-measurement-server/ReportableChangeFilter.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <pw_unit_test/framework.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters::ElectricalPowerMeasurement;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+DataModel::Nullable<int64_t> Value(int64_t value)
+{
+    return DataModel::MakeNullable(value);
+}
+
+} // namespace
+
+TEST(TestReportableChangeFilter, TestEveryChangeByDefault)
+{
+    ReportableChangeFilter filter;
+    EXPECT_TRUE(filter.ShouldReport(Value(1000), 0_ms));
+    EXPECT_FALSE(filter.ShouldReport(Value(1000), 100_ms));
+    EXPECT_TRUE(filter.ShouldReport(Value(1001), 200_ms));
+    EXPECT_TRUE(filter.ShouldReport(DataModel::NullNullable, 300_ms));
+    EXPECT_FALSE(filter.ShouldReport(DataModel::NullNullable, 400_ms));
+    EXPECT_TRUE(filter.ShouldReport(Value(1001), 500_ms));
+}
+
+TEST(TestReportableChangeFilter, TestAbsoluteAndPercentDelta)
+{
+    ReportableChangeFilter filter;
+    ReportableChange change;
+    change.absoluteDelta = 500;
+    change.percentDelta  = 5;
+    filter.SetReportableChange(change);
+
+    EXPECT_TRUE(filter.ShouldReport(Value(4000), 0_ms));
+    // Changes are measured against the last reported value, so that slow drifts are reported eventually.
+    EXPECT_FALSE(filter.ShouldReport(Value(4150), 100_ms));
+    EXPECT_TRUE(filter.ShouldReport(Value(4200), 200_ms)); // 5%
+    EXPECT_FALSE(filter.ShouldReport(Value(4000), 300_ms));
+    EXPECT_TRUE(filter.ShouldReport(Value(3700), 400_ms)); // 500 mW
+
+    // Large values and opposite signs do not overflow.
+    change.absoluteDelta = 0;
+    filter.SetReportableChange(change);
+    EXPECT_TRUE(filter.ShouldReport(Value(INT64_MAX), 500_ms));
+    EXPECT_FALSE(filter.ShouldReport(Value(INT64_MAX - INT64_MAX / 100), 600_ms));
+    EXPECT_TRUE(filter.ShouldReport(Value(INT64_MIN), 700_ms));
+
+    // Going to null is always reported.
+    EXPECT_TRUE(filter.ShouldReport(DataModel::NullNullable, 800_ms));
+}
+
+TEST(TestReportableChangeFilter, TestMaxInterval)
+{
+    ReportableChangeFilter filter;
+    ReportableChange change;
+    change.absoluteDelta = 1000;
+    change.maxInterval   = 10000_ms32;
+    filter.SetReportableChange(change);
+
+    EXPECT_TRUE(filter.ShouldReport(Value(230000), 0_ms));
+    EXPECT_FALSE(filter.ShouldReport(Value(230100), 5000_ms));
+    // A small change is reported once the last report is old enough, an unchanged value never is.
+    EXPECT_TRUE(filter.ShouldReport(Value(230200), 10000_ms));
+    EXPECT_FALSE(filter.ShouldReport(Value(230200), 15000_ms));
+    EXPECT_FALSE(filter.ShouldReport(Value(230300), 19000_ms));
+    EXPECT_TRUE(filter.ShouldReport(Value(230300), 20000_ms));
+}
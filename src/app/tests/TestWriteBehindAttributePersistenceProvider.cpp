@@ -0,0 +1,188 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/WriteBehindAttributePersistenceProvider.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <pw_unit_test/framework.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr System::Clock::Milliseconds32 kFlushWindow(10000);
+
+const ConcreteAttributePath kLevelPath(1, 0x0008, 0x0000);
+const ConcreteAttributePath kEnergyPath(2, 0x0091, 0x0001);
+
+class CountingStorageDelegate : public TestPersistentStorageDelegate
+{
+public:
+    unsigned mWrites = 0;
+
+protected:
+    CHIP_ERROR SyncSetKeyValueInternal(const char * key, const void * value, uint16_t size) override
+    {
+        mWrites++;
+        return TestPersistentStorageDelegate::SyncSetKeyValueInternal(key, value, size);
+    }
+};
+
+class TestWriteBehindAttributePersistenceProvider : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite()
+    {
+        ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR);
+        ASSERT_EQ(DeviceLayer::PlatformMgr().InitChipStack(), CHIP_NO_ERROR);
+    }
+    static void TearDownTestSuite()
+    {
+        DeviceLayer::PlatformMgr().Shutdown();
+        chip::Platform::MemoryShutdown();
+    }
+
+    void SetUp() override { ASSERT_EQ(mPersister.Init(&mStorage), CHIP_NO_ERROR); }
+
+    CountingStorageDelegate mStorage;
+    DefaultAttributePersistenceProvider mPersister;
+};
+
+} // namespace
+
+TEST_F(TestWriteBehindAttributePersistenceProvider, TestCoalescedWrites)
+{
+    WriteBehindAttributePersistenceProvider writeBehind(mPersister, kFlushWindow);
+
+    for (uint8_t level = 1; level <= 10; level++)
+    {
+        EXPECT_EQ(writeBehind.WriteValue(kLevelPath, ByteSpan(&level, 1)), CHIP_NO_ERROR);
+    }
+    uint32_t energy = 1000;
+    EXPECT_EQ(writeBehind.WriteScalarValue(kEnergyPath, energy), CHIP_NO_ERROR);
+    energy = 2000;
+    EXPECT_EQ(writeBehind.WriteScalarValue(kEnergyPath, energy), CHIP_NO_ERROR);
+
+    // Nothing is written before the end of the window, but reads see the last values.
+    EXPECT_EQ(mStorage.mWrites, 0u);
+    EXPECT_TRUE(writeBehind.HasPendingWrites());
+
+    uint32_t energyReadBack = 0;
+    EXPECT_EQ(writeBehind.ReadScalarValue(kEnergyPath, energyReadBack), CHIP_NO_ERROR);
+    EXPECT_EQ(energyReadBack, 2000u);
+
+    // The key spaces of the two interfaces are distinct.
+    EXPECT_EQ(writeBehind.ReadScalarValue(kLevelPath, energyReadBack), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    // One write per attribute, with its last value.
+    EXPECT_EQ(writeBehind.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.mWrites, 2u);
+    EXPECT_FALSE(writeBehind.HasPendingWrites());
+
+    energyReadBack = 0;
+    EXPECT_EQ(mPersister.ReadScalarValue(kEnergyPath, energyReadBack), CHIP_NO_ERROR);
+    EXPECT_EQ(energyReadBack, 2000u);
+
+    uint8_t level = 0;
+    uint16_t size = sizeof(level);
+    EXPECT_EQ(mStorage.SyncGetKeyValue(
+                  DefaultStorageKeyAllocator::AttributeValue(kLevelPath.mEndpointId, kLevelPath.mClusterId, kLevelPath.mAttributeId)
+                      .KeyName(),
+                  &level, size),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(level, 10);
+}
+
+TEST_F(TestWriteBehindAttributePersistenceProvider, TestFailedWritesArePending)
+{
+    WriteBehindAttributePersistenceProvider writeBehind(mPersister, kFlushWindow);
+    const std::string key =
+        DefaultStorageKeyAllocator::SafeAttributeValue(kEnergyPath.mEndpointId, kEnergyPath.mClusterId, kEnergyPath.mAttributeId)
+            .KeyName();
+
+    uint32_t energy = 1000;
+    EXPECT_EQ(writeBehind.WriteScalarValue(kEnergyPath, energy), CHIP_NO_ERROR);
+
+    mStorage.AddPoisonKey(key);
+    EXPECT_EQ(writeBehind.Flush(), CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    EXPECT_TRUE(writeBehind.HasPendingWrites());
+
+    mStorage.ClearPoisonKeys();
+    EXPECT_EQ(writeBehind.Flush(), CHIP_NO_ERROR);
+    EXPECT_FALSE(writeBehind.HasPendingWrites());
+    EXPECT_TRUE(mStorage.HasKey(key));
+
+    // Discarded values are never written.
+    energy = 2000;
+    EXPECT_EQ(writeBehind.WriteScalarValue(kEnergyPath, energy), CHIP_NO_ERROR);
+    writeBehind.Discard();
+    EXPECT_FALSE(writeBehind.HasPendingWrites());
+
+    uint32_t energyReadBack = 0;
+    EXPECT_EQ(writeBehind.ReadScalarValue(kEnergyPath, energyReadBack), CHIP_NO_ERROR);
+    EXPECT_EQ(energyReadBack, 1000u);
+}
+
+TEST_F(TestWriteBehindAttributePersistenceProvider, TestFullBufferFlushes)
+{
+    WriteBehindAttributePersistenceProvider writeBehind(mPersister, kFlushWindow);
+
+    uint8_t value = 42;
+    for (AttributeId attribute = 0; attribute < CHIP_CONFIG_MAX_PENDING_ATTRIBUTE_WRITES; attribute++)
+    {
+        EXPECT_EQ(writeBehind.WriteValue(ConcreteAttributePath(1, 0x0006, attribute), ByteSpan(&value, 1)), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(mStorage.mWrites, 0u);
+
+    // One attribute too many writes the pending ones, and only keeps the new one.
+    const ConcreteAttributePath extraPath(1, 0x0006, CHIP_CONFIG_MAX_PENDING_ATTRIBUTE_WRITES);
+    EXPECT_EQ(writeBehind.WriteValue(extraPath, ByteSpan(&value, 1)), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.mWrites, static_cast<unsigned>(CHIP_CONFIG_MAX_PENDING_ATTRIBUTE_WRITES));
+    EXPECT_TRUE(writeBehind.HasPendingWrites());
+
+    EXPECT_EQ(writeBehind.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.mWrites, static_cast<unsigned>(CHIP_CONFIG_MAX_PENDING_ATTRIBUTE_WRITES) + 1);
+}
+
+TEST_F(TestWriteBehindAttributePersistenceProvider, TestEmptyValueReplacesPendingWrite)
+{
+    WriteBehindAttributePersistenceProvider writeBehind(mPersister, kFlushWindow);
+
+    uint8_t value = 42;
+    EXPECT_EQ(writeBehind.WriteValue(kLevelPath, ByteSpan(&value, 1)), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.mWrites, 0u);
+
+    // An empty value is written through, and the value it replaces is no longer pending.
+    EXPECT_EQ(writeBehind.WriteValue(kLevelPath, ByteSpan()), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.mWrites, 1u);
+    EXPECT_FALSE(writeBehind.HasPendingWrites());
+
+    EXPECT_EQ(writeBehind.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.mWrites, 1u);
+
+    uint8_t buffer[4];
+    uint16_t size = sizeof(buffer);
+    EXPECT_EQ(mStorage.SyncGetKeyValue(
+                  DefaultStorageKeyAllocator::AttributeValue(kLevelPath.mEndpointId, kLevelPath.mClusterId, kLevelPath.mAttributeId)
+                      .KeyName(),
+                  buffer, size),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(size, 0u);
+}
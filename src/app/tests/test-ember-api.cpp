@@ -21,6 +21,7 @@
 #include <app/util/mock/Functions.h>
 
 chip::EndpointId chip::Test::numEndpoints = 0;
+chip::Test::ReportedAttributeChanges chip::Test::reportedAttributeChanges;
 
 // Used by the code in TestPowerSourceCluster.cpp (and generally things using mock ember functions may need this).
 uint16_t emberAfGetClusterServerEndpointIndex(chip::EndpointId endpoint, chip::ClusterId cluster,
@@ -34,3 +35,22 @@ uint16_t emberAfGetClusterServerEndpointIndex(chip::EndpointId endpoint, chip::C
     }
     return endpoint;
 }
+
+void MatterReportingAttributeChangeCallback(chip::EndpointId endpoint, chip::ClusterId clusterId,
+                                            chip::Span<const chip::AttributeId> attributeIds)
+{
+    auto & changes = chip::Test::reportedAttributeChanges;
+    if (attributeIds.empty())
+    {
+        return;
+    }
+
+    changes.dataVersionIncreases++;
+    for (chip::AttributeId attributeId : attributeIds)
+    {
+        if (changes.pathCount < chip::Test::ReportedAttributeChanges::kMaxPaths)
+        {
+            changes.paths[changes.pathCount++] = chip::app::ConcreteAttributePath(endpoint, clusterId, attributeId);
+        }
+    }
+}
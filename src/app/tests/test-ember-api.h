@@ -13,16 +13,33 @@
  *    See the License for the specific language governing permissions and
  *    limitations under the License.
  */
+#include <app/ConcreteAttributePath.h>
 #include <app/util/basic-types.h>
+#include <lib/support/Span.h>
 
 /// test-ember-api was created to consolidate and centralize stub functions that are related to ember and are used by the unit-tests
 
 namespace chip {
 namespace Test {
 extern chip::EndpointId numEndpoints;
-}
+
+// What the MatterReportingAttributeChangeCallback overload for several attributes was called with.
+struct ReportedAttributeChanges
+{
+    static constexpr size_t kMaxPaths = 32;
+
+    uint32_t dataVersionIncreases = 0;
+    chip::app::ConcreteAttributePath paths[kMaxPaths];
+    size_t pathCount = 0;
+};
+extern ReportedAttributeChanges reportedAttributeChanges;
+} // namespace Test
 } // namespace chip
 
 // Used by the code in TestPowerSourceCluster.cpp (and generally things using mock ember functions may need this).
 uint16_t emberAfGetClusterServerEndpointIndex(chip::EndpointId endpoint, chip::ClusterId cluster,
                                               uint16_t fixedClusterServerEndpointCount);
+
+// Used by the code in TestElectricalPowerMeasurementServer.cpp: records the changes in chip::Test::reportedAttributeChanges.
+void MatterReportingAttributeChangeCallback(chip::EndpointId endpoint, chip::ClusterId clusterId,
+                                            chip::Span<const chip::AttributeId> attributeIds);
@@ -0,0 +1,173 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/DataModelTypes.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * @brief Maps endpoint ids to their index in the endpoint table in constant time, so
+ *        that finding an endpoint does not depend on the number of endpoints, which
+ *        bridges of thousands of devices would otherwise pay on every attribute access.
+ *
+ * Open addressing with linear probing, in a table of at least twice as many slots as
+ * entries so that probe sequences stay short. Removing an entry shifts the following
+ * ones back instead of leaving a tombstone, so lookups do not degrade as bridged
+ * devices come and go.
+ */
+template <size_t kMaxEntries>
+class EndpointIndex
+{
+public:
+    static constexpr uint16_t kInvalidIndex = 0xFFFF;
+
+    EndpointIndex() { Clear(); }
+
+    void Clear()
+    {
+        for (auto & slot : mSlots)
+        {
+            slot.endpoint = kInvalidEndpointId;
+        }
+        mCount = 0;
+    }
+
+    /**
+     * @brief Records that `endpoint` is at `index` in the endpoint table, replacing
+     *        any previous index of the endpoint.
+     *
+     * @return false if the index already holds kMaxEntries endpoints or `endpoint` is invalid.
+     */
+    bool Insert(EndpointId endpoint, uint16_t index)
+    {
+        if (endpoint == kInvalidEndpointId)
+        {
+            return false;
+        }
+
+        size_t slot = Home(endpoint);
+        while (mSlots[slot].endpoint != kInvalidEndpointId && mSlots[slot].endpoint != endpoint)
+        {
+            slot = Next(slot);
+        }
+
+        if (mSlots[slot].endpoint == kInvalidEndpointId)
+        {
+            if (mCount >= kMaxEntries)
+            {
+                return false;
+            }
+            mCount++;
+        }
+        mSlots[slot].endpoint = endpoint;
+        mSlots[slot].index    = index;
+        return true;
+    }
+
+    void Remove(EndpointId endpoint)
+    {
+        size_t hole = FindSlot(endpoint);
+        if (hole == kSlotCount)
+        {
+            return;
+        }
+
+        // Move back the entries of the probe sequence that can no longer be reached past the hole.
+        for (size_t slot = Next(hole); mSlots[slot].endpoint != kInvalidEndpointId; slot = Next(slot))
+        {
+            const size_t home = Home(mSlots[slot].endpoint);
+            if (Distance(home, slot) >= Distance(hole, slot))
+            {
+                mSlots[hole] = mSlots[slot];
+                hole         = slot;
+            }
+        }
+        mSlots[hole].endpoint = kInvalidEndpointId;
+        mCount--;
+    }
+
+    /**
+     * @brief Returns the index of `endpoint` in the endpoint table, kInvalidIndex if it is not in the index.
+     */
+    uint16_t Find(EndpointId endpoint) const
+    {
+        const size_t slot = FindSlot(endpoint);
+        return (slot == kSlotCount) ? kInvalidIndex : mSlots[slot].index;
+    }
+
+    size_t Count() const { return mCount; }
+
+private:
+    static constexpr unsigned SlotBitsFor(size_t entries)
+    {
+        unsigned bits = 1;
+        while ((static_cast<size_t>(1) << bits) < 2 * entries)
+        {
+            bits++;
+        }
+        return bits;
+    }
+
+    static constexpr unsigned kSlotBits = SlotBitsFor(kMaxEntries);
+    static constexpr size_t kSlotCount  = static_cast<size_t>(1) << kSlotBits;
+    static_assert(kSlotBits < 32, "Too many endpoints");
+
+    struct Slot
+    {
+        EndpointId endpoint;
+        uint16_t index;
+    };
+
+    static size_t Home(EndpointId endpoint)
+    {
+        // Fibonacci hashing: the top bits of the product spread consecutive as well as strided endpoint ids.
+        return static_cast<size_t>(static_cast<uint32_t>(static_cast<uint32_t>(endpoint) * 2654435769u) >> (32 - kSlotBits));
+    }
+
+    static size_t Next(size_t slot) { return (slot + 1) & (kSlotCount - 1); }
+
+    static size_t Distance(size_t from, size_t to) { return (to + kSlotCount - from) & (kSlotCount - 1); }
+
+    size_t FindSlot(EndpointId endpoint) const
+    {
+        if (endpoint == kInvalidEndpointId)
+        {
+            return kSlotCount;
+        }
+
+        for (size_t slot = Home(endpoint); mSlots[slot].endpoint != kInvalidEndpointId; slot = Next(slot))
+        {
+            if (mSlots[slot].endpoint == endpoint)
+            {
+                return slot;
+            }
+        }
+        return kSlotCount;
+    }
+
+    Slot mSlots[kSlotCount];
+    size_t mCount = 0;
+};
+
+} // namespace app
+} // namespace chip
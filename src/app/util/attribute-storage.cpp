@@ -17,9 +17,11 @@
 
 #include <app/util/attribute-storage.h>
 
+#include <app/util/EndpointIndex.h>
 #include <app/util/attribute-storage-detail.h>
 
 #include <app/AttributeAccessInterfaceRegistry.h>
+#include <app/AttributePathExpandIterator.h>
 #include <app/AttributePersistenceProvider.h>
 #include <app/InteractionModelEngine.h>
 #include <app/reporting/reporting.h>
@@ -92,6 +94,11 @@ uint8_t singletonAttributeData[ACTUAL_SINGLETONS_SIZE];
 
 uint16_t emberEndpointCount = 0;
 
+// Index in emAfEndpoints of every configured endpoint, so that finding an endpoint
+// does not scan the endpoint table.
+EndpointIndex<MAX_ENDPOINT_COUNT> sEndpointIndex;
+static_assert(EndpointIndex<MAX_ENDPOINT_COUNT>::kInvalidIndex == kEmberInvalidEndpointIndex, "Invalid indexes must match");
+
 // If we have attributes that are more than 4 bytes, then
 // we need this data block for the defaults
 #if (defined(GENERATED_DEFAULTS) && GENERATED_DEFAULTS_COUNT)
@@ -147,21 +154,13 @@ bool emberAfIsThisDataTypeAListType(EmberAfAttributeType dataType)
 
 uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEndpoints)
 {
-    if (endpoint == kInvalidEndpointId)
+    const uint16_t epi = sEndpointIndex.Find(endpoint);
+    if (epi >= emberAfEndpointCount() ||
+        (ignoreDisabledEndpoints && !emAfEndpoints[epi].bitmask.Has(EmberAfEndpointOptions::isEnabled)))
     {
         return kEmberInvalidEndpointIndex;
     }
-
-    uint16_t epi;
-    for (epi = 0; epi < emberAfEndpointCount(); epi++)
-    {
-        if (emAfEndpoints[epi].endpoint == endpoint &&
-            (!ignoreDisabledEndpoints || emAfEndpoints[epi].bitmask.Has(EmberAfEndpointOptions::isEnabled)))
-        {
-            return epi;
-        }
-    }
-    return kEmberInvalidEndpointIndex;
+    return epi;
 }
 
 // Returns the index of a given endpoint.  Considers disabled endpoints.
@@ -181,6 +180,7 @@ void emberAfEndpointConfigure()
                   "FIXED_ENDPOINT_COUNT must not exceed the size of the endpoint data type");
 
     emberEndpointCount = FIXED_ENDPOINT_COUNT;
+    sEndpointIndex.Clear();
 
 #if FIXED_ENDPOINT_COUNT > 0
 
@@ -215,6 +215,7 @@ void emberAfEndpointConfigure()
 
         emAfEndpoints[ep].bitmask.Set(EmberAfEndpointOptions::isEnabled);
         emAfEndpoints[ep].bitmask.Set(EmberAfEndpointOptions::isFlatComposition);
+        sEndpointIndex.Insert(fixedEndpoints[ep], ep);
 
         // Increment currentDataVersions by 1 (slot) for every server cluster
         // this endpoint has.
@@ -244,20 +245,12 @@ void emberAfSetDynamicEndpointCount(uint16_t dynamicEndpointCount)
 
 uint16_t emberAfGetDynamicIndexFromEndpoint(EndpointId id)
 {
-    if (id == kInvalidEndpointId)
+    const uint16_t index = sEndpointIndex.Find(id);
+    if (index == kEmberInvalidEndpointIndex || index < FIXED_ENDPOINT_COUNT)
     {
         return kEmberInvalidEndpointIndex;
     }
-
-    uint16_t index;
-    for (index = FIXED_ENDPOINT_COUNT; index < MAX_ENDPOINT_COUNT; index++)
-    {
-        if (emAfEndpoints[index].endpoint == id)
-        {
-            return static_cast<uint8_t>(index - FIXED_ENDPOINT_COUNT);
-        }
-    }
-    return kEmberInvalidEndpointIndex;
+    return static_cast<uint16_t>(index - FIXED_ENDPOINT_COUNT);
 }
 
 CHIP_ERROR emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberAfEndpointType * ep,
@@ -282,12 +275,14 @@ CHIP_ERROR emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberA
     }
 
     index = static_cast<uint16_t>(realIndex);
-    for (uint16_t i = FIXED_ENDPOINT_COUNT; i < MAX_ENDPOINT_COUNT; i++)
+    if (sEndpointIndex.Find(id) != kEmberInvalidEndpointIndex)
     {
-        if (emAfEndpoints[i].endpoint == id)
-        {
-            return CHIP_ERROR_ENDPOINT_EXISTS;
-        }
+        return CHIP_ERROR_ENDPOINT_EXISTS;
+    }
+    if (emAfEndpoints[index].endpoint != kInvalidEndpointId)
+    {
+        // Do not leave the endpoint previously set at this index unreachable in the endpoint index.
+        sEndpointIndex.Remove(emAfEndpoints[index].endpoint);
     }
 
     emAfEndpoints[index].endpoint       = id;
@@ -297,8 +292,13 @@ CHIP_ERROR emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberA
     // Start the endpoint off as disabled.
     emAfEndpoints[index].bitmask.Clear(EmberAfEndpointOptions::isEnabled);
     emAfEndpoints[index].parentEndpointId = parentEndpointId;
+    sEndpointIndex.Insert(id, index);
 
-    emberAfSetDynamicEndpointCount(MAX_ENDPOINT_COUNT - FIXED_ENDPOINT_COUNT);
+    // Only the endpoints up to the last dynamic one in use are iterated over.
+    if (index >= emberEndpointCount)
+    {
+        emberAfSetDynamicEndpointCount(static_cast<uint16_t>(index + 1 - FIXED_ENDPOINT_COUNT));
+    }
 
     // Initialize the data versions.
     size_t dataSize = sizeof(DataVersion) * serverClusterCount;
@@ -321,14 +321,23 @@ EndpointId emberAfClearDynamicEndpoint(uint16_t index)
 {
     EndpointId ep = 0;
 
-    index = static_cast<uint8_t>(index + FIXED_ENDPOINT_COUNT);
+    const uint32_t realIndex = static_cast<uint32_t>(index) + FIXED_ENDPOINT_COUNT;
 
-    if ((index < MAX_ENDPOINT_COUNT) && (emAfEndpoints[index].endpoint != kInvalidEndpointId) &&
-        (emberAfEndpointIndexIsEnabled(index)))
+    if ((realIndex < MAX_ENDPOINT_COUNT) && (emAfEndpoints[realIndex].endpoint != kInvalidEndpointId) &&
+        (emberAfEndpointIndexIsEnabled(static_cast<uint16_t>(realIndex))))
     {
-        ep = emAfEndpoints[index].endpoint;
+        ep = emAfEndpoints[realIndex].endpoint;
         emberAfEndpointEnableDisable(ep, false);
-        emAfEndpoints[index].endpoint = kInvalidEndpointId;
+        emAfEndpoints[realIndex].endpoint = kInvalidEndpointId;
+        sEndpointIndex.Remove(ep);
+
+        // Stop iterating over the trailing unused dynamic endpoints.
+        uint16_t count = emberEndpointCount;
+        while (count > FIXED_ENDPOINT_COUNT && emAfEndpoints[count - 1].endpoint == kInvalidEndpointId)
+        {
+            count--;
+        }
+        emberEndpointCount = count;
     }
 
     return ep;
@@ -577,7 +586,17 @@ Status emAfReadOrWriteAttribute(const EmberAfAttributeSearchRecord * attRecord,
 
     uint16_t attributeOffsetIndex = 0;
 
-    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    const uint16_t endpointIndex = emberAfIndexFromEndpointIncludingDisabledEndpoints(attRecord->endpoint);
+    if (endpointIndex == kEmberInvalidEndpointIndex)
+    {
+        return Status::UnsupportedEndpoint;
+    }
+
+    // The storage offset only needs to be accumulated over the fixed endpoints, dynamic
+    // endpoints have no internal storage: go straight to the dynamic endpoint.
+    const uint16_t firstEndpointIndex = (endpointIndex < emberAfFixedEndpointCount()) ? 0 : endpointIndex;
+
+    for (uint16_t ep = firstEndpointIndex; ep < emberAfEndpointCount(); ep++)
     {
         // Is this a dynamic endpoint?
         bool isDynamicEndpoint = (ep >= emberAfFixedEndpointCount());
@@ -729,18 +748,14 @@ const EmberAfCluster * emberAfFindClusterInType(const EmberAfEndpointType * endp
 
 uint8_t emberAfClusterIndex(EndpointId endpoint, ClusterId clusterId, EmberAfClusterMask mask)
 {
-    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    const uint16_t ep = emberAfIndexFromEndpointIncludingDisabledEndpoints(endpoint);
+    if (ep != kEmberInvalidEndpointIndex)
     {
-        // Check the endpoint id first, because that way we avoid examining the
-        // endpoint type for endpoints that are not actually defined.
-        if (emAfEndpoints[ep].endpoint == endpoint)
+        const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
+        uint8_t index                            = 0xFF;
+        if (emberAfFindClusterInType(endpointType, clusterId, mask, &index) != nullptr)
         {
-            const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
-            uint8_t index                            = 0xFF;
-            if (emberAfFindClusterInType(endpointType, clusterId, mask, &index) != nullptr)
-            {
-                return index;
-            }
+            return index;
         }
     }
     return 0xFF;
@@ -928,6 +943,9 @@ bool emberAfEndpointEnableDisable(EndpointId endpoint, bool enable)
             emAfEndpoints[index].bitmask.Clear(EmberAfEndpointOptions::isEnabled);
         }
 
+        // Wildcard paths now expand to different concrete paths.
+        app::AttributePathExpandIterator::InvalidateExpansionCache();
+
         EndpointId parentEndpointId = emberAfParentEndpointFromIndex(index);
         while (parentEndpointId != kInvalidEndpointId)
         {
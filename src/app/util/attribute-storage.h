@@ -245,10 +245,14 @@ void emberAfEndpointConfigure();
 //
 // An optional parent endpoint id should be passed for child endpoints of composed device.
 //
+// Endpoints are found by id in constant time, and only the dynamic endpoints up to the
+// highest index in use are iterated over, so bridges can raise
+// CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT to thousands of endpoints.
+//
 // Returns  CHIP_NO_ERROR                   No error.
 //          CHIP_ERROR_NO_MEMORY            MAX_ENDPOINT_COUNT is reached or when no storage is left for clusters
 //          CHIP_ERROR_INVALID_ARGUMENT     The EndpointId value passed is kInvalidEndpointId
-//          CHIP_ERROR_ENDPOINT_EXISTS      If the EndpointId value passed already exists
+//          CHIP_ERROR_ENDPOINT_EXISTS      If the EndpointId value passed already exists, on a fixed or dynamic endpoint
 //
 CHIP_ERROR emberAfSetDynamicEndpoint(uint16_t index, chip::EndpointId id, const EmberAfEndpointType * ep,
                                      const chip::Span<chip::DataVersion> & dataVersionStorage,
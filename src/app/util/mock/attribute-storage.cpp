@@ -39,6 +39,7 @@
 #include <app/util/mock/Constants.h>
 #include <app/util/mock/MockNodeConfig.h>
 
+#include <app/AttributePathExpandIterator.h>
 #include <app/AttributeValueEncoder.h>
 #include <app/ConcreteAttributePath.h>
 #include <app/EventManagement.h>
@@ -456,12 +457,14 @@ CHIP_ERROR ReadSingleMockClusterData(FabricIndex aAccessingFabricIndex, const Co
 void SetMockNodeConfig(const MockNodeConfig & config)
 {
     mockConfig = &config;
+    chip::app::AttributePathExpandIterator::InvalidateExpansionCache();
 }
 
 /// Resets the mock attribute storage to the default configuration.
 void ResetMockNodeConfig()
 {
     mockConfig = nullptr;
+    chip::app::AttributePathExpandIterator::InvalidateExpansionCache();
 }
 
 } // namespace Test
@@ -0,0 +1,288 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <controller/CASEReconnectScheduler.h>
+
+#include <lib/dnssd/Resolver.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TypeTraits.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace Controller {
+
+void CASESessionManagerReconnectConnector::Connect(const ScopedNodeId & peerId,
+                                                   Callback::Callback<OnDeviceConnected> * onConnected,
+                                                   Callback::Callback<OnDeviceConnectionFailure> * onFailure)
+{
+    mSessionManager.FindOrEstablishSession(peerId, onConnected, onFailure);
+}
+
+void CASESessionManagerReconnectConnector::Prefetch(const ScopedNodeId & peerId)
+{
+    const FabricInfo * fabricInfo = mFabricTable.FindFabricWithIndex(peerId.GetFabricIndex());
+    VerifyOrReturn(fabricInfo != nullptr);
+
+    // Results are only consumed through the address resolver cache, so a
+    // failure here just means that the session setup will resolve by itself.
+    const PeerId dnssdPeerId(fabricInfo->GetCompressedFabricId(), peerId.GetNodeId());
+    CHIP_ERROR err = Dnssd::Resolver::Instance().ResolveNodeId(dnssdPeerId);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Controller, "Failed to prefetch address for " ChipLogFormatPeerId ": %" CHIP_ERROR_FORMAT,
+                     ChipLogValuePeerId(dnssdPeerId), err.Format());
+    }
+}
+
+CHIP_ERROR CASEReconnectScheduler::Init(CASEReconnectConnector * connector, Delegate * delegate, size_t maxConcurrent,
+                                        size_t prefetchDepth)
+{
+    VerifyOrReturnError(connector != nullptr && delegate != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(!mRunning && mInFlight == 0, CHIP_ERROR_INCORRECT_STATE);
+
+    mConnector     = connector;
+    mDelegate      = delegate;
+    mMaxConcurrent = std::min(std::max<size_t>(maxConcurrent, 1), kMaxConcurrent);
+    mPrefetchDepth = prefetchDepth;
+
+    for (auto & attempt : mAttempts)
+    {
+        attempt.scheduler = this;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CASEReconnectScheduler::Enqueue(const ScopedNodeId & peerId, Priority priority)
+{
+    VerifyOrReturnError(mConnector != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(to_underlying(priority) < kPriorityCount, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(!IsInFlight(peerId), CHIP_NO_ERROR);
+
+    QueuedPeer entry;
+    entry.peerId = peerId;
+
+    for (size_t i = 0; i < kPriorityCount; i++)
+    {
+        auto & queue = mQueues[i];
+        auto it =
+            std::find_if(queue.begin(), queue.end(), [&peerId](const QueuedPeer & queued) { return queued.peerId == peerId; });
+        if (it == queue.end())
+        {
+            continue;
+        }
+
+        VerifyOrReturnError(i < to_underlying(priority), CHIP_NO_ERROR);
+        entry.prefetched = it->prefetched;
+        queue.erase(it);
+        break;
+    }
+
+    mQueues[to_underlying(priority)].push_back(entry);
+
+    if (mRunning)
+    {
+        Dispatch();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CASEReconnectScheduler::Start()
+{
+    VerifyOrReturnError(mConnector != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!mRunning, CHIP_ERROR_INCORRECT_STATE);
+
+    mStats     = Stats();
+    mStartTime = System::SystemClock().GetMonotonicTimestamp();
+    mRunning   = true;
+
+    ChipLogProgress(Controller, "Reconnecting to %u peers, up to %u at a time", static_cast<unsigned>(PendingCount()),
+                    static_cast<unsigned>(mMaxConcurrent));
+
+    Dispatch();
+    return CHIP_NO_ERROR;
+}
+
+void CASEReconnectScheduler::Cancel()
+{
+    for (auto & attempt : mAttempts)
+    {
+        if (attempt.active)
+        {
+            attempt.onConnected.Cancel();
+            attempt.onFailure.Cancel();
+            attempt.active = false;
+        }
+    }
+    mInFlight = 0;
+
+    for (auto & queue : mQueues)
+    {
+        queue.clear();
+    }
+    mRunning = false;
+}
+
+size_t CASEReconnectScheduler::PendingCount() const
+{
+    size_t count = 0;
+    for (const auto & queue : mQueues)
+    {
+        count += queue.size();
+    }
+    return count;
+}
+
+void CASEReconnectScheduler::HandleConnected(void * context, Messaging::ExchangeManager & exchangeMgr,
+                                             const SessionHandle & sessionHandle)
+{
+    auto * attempt                     = static_cast<Attempt *>(context);
+    CASEReconnectScheduler * scheduler = attempt->scheduler;
+    const ScopedNodeId peerId          = attempt->peerId;
+
+    scheduler->ReleaseAttempt(*attempt);
+    scheduler->mStats.connected++;
+    scheduler->mDelegate->OnPeerConnected(peerId, exchangeMgr, sessionHandle);
+    scheduler->Dispatch();
+}
+
+void CASEReconnectScheduler::HandleFailure(void * context, const ScopedNodeId & peerId, CHIP_ERROR error)
+{
+    auto * attempt                     = static_cast<Attempt *>(context);
+    CASEReconnectScheduler * scheduler = attempt->scheduler;
+
+    scheduler->ReleaseAttempt(*attempt);
+    scheduler->mStats.failed++;
+    scheduler->mDelegate->OnPeerConnectionFailure(peerId, error);
+    scheduler->Dispatch();
+}
+
+bool CASEReconnectScheduler::IsInFlight(const ScopedNodeId & peerId) const
+{
+    for (const auto & attempt : mAttempts)
+    {
+        if (attempt.active && attempt.peerId == peerId)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CASEReconnectScheduler::PopNext(QueuedPeer & next)
+{
+    for (size_t i = kPriorityCount; i > 0; i--)
+    {
+        auto & queue = mQueues[i - 1];
+        if (!queue.empty())
+        {
+            next = queue.front();
+            queue.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+CASEReconnectScheduler::Attempt * CASEReconnectScheduler::FreeAttempt()
+{
+    for (auto & attempt : mAttempts)
+    {
+        if (!attempt.active)
+        {
+            return &attempt;
+        }
+    }
+    return nullptr;
+}
+
+void CASEReconnectScheduler::ReleaseAttempt(Attempt & attempt)
+{
+    VerifyOrDie(attempt.active && mInFlight > 0);
+    attempt.active = false;
+    mInFlight--;
+}
+
+void CASEReconnectScheduler::Dispatch()
+{
+    // Connectors may report results synchronously, from within Connect(): the
+    // outermost call keeps dispatching until the concurrency limit is reached.
+    VerifyOrReturn(!mDispatching);
+    mDispatching = true;
+
+    while (mRunning && mInFlight < mMaxConcurrent)
+    {
+        QueuedPeer next;
+        if (!PopNext(next))
+        {
+            break;
+        }
+
+        Attempt * attempt = FreeAttempt();
+        VerifyOrDie(attempt != nullptr);
+        attempt->peerId = next.peerId;
+        attempt->active = true;
+        mInFlight++;
+        mStats.maxInFlight = std::max(mStats.maxInFlight, mInFlight);
+
+        mConnector->Connect(next.peerId, &attempt->onConnected, &attempt->onFailure);
+    }
+
+    if (mRunning)
+    {
+        Prefetch();
+    }
+
+    mDispatching = false;
+
+    VerifyOrReturn(mRunning && mInFlight == 0 && PendingCount() == 0);
+
+    mRunning       = false;
+    mStats.elapsed = System::SystemClock().GetMonotonicTimestamp() - mStartTime;
+    ChipLogProgress(Controller, "Reconnect done in %" PRIu64 " ms: %u connected, %u failed",
+                    static_cast<uint64_t>(mStats.elapsed.count()), static_cast<unsigned>(mStats.connected),
+                    static_cast<unsigned>(mStats.failed));
+    mDelegate->OnReconnectComplete(mStats);
+}
+
+void CASEReconnectScheduler::Prefetch()
+{
+    size_t remaining = mPrefetchDepth;
+    for (size_t i = kPriorityCount; i > 0 && remaining > 0; i--)
+    {
+        for (auto & queued : mQueues[i - 1])
+        {
+            if (remaining == 0)
+            {
+                break;
+            }
+            remaining--;
+
+            if (!queued.prefetched)
+            {
+                queued.prefetched = true;
+                mConnector->Prefetch(queued.peerId);
+            }
+        }
+    }
+}
+
+} // namespace Controller
+} // namespace chip
@@ -0,0 +1,201 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Declaration of the CASE reconnect scheduler, which (re-)establishes
+ *      operational sessions to a large number of nodes with bounded
+ *      concurrency, e.g. after a controller restart.
+ */
+
+#pragma once
+
+#include <app/CASESessionManager.h>
+#include <app/OperationalSessionSetup.h>
+#include <credentials/FabricTable.h>
+#include <lib/core/CHIPCallback.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/ScopedNodeId.h>
+#include <system/SystemClock.h>
+
+#include <deque>
+
+namespace chip {
+namespace Controller {
+
+/// Establishes the sessions requested by the CASEReconnectScheduler.
+class CASEReconnectConnector
+{
+public:
+    virtual ~CASEReconnectConnector() = default;
+
+    /// Find or establish a session to `peerId`, reporting the result through
+    /// exactly one of the given callbacks (possibly before returning).
+    virtual void Connect(const ScopedNodeId & peerId, Callback::Callback<OnDeviceConnected> * onConnected,
+                         Callback::Callback<OnDeviceConnectionFailure> * onFailure) = 0;
+
+    /// Hint that a session to `peerId` will be requested soon, so that any
+    /// preparatory work (e.g. operational discovery) can start early.
+    virtual void Prefetch(const ScopedNodeId & peerId) {}
+};
+
+/// Connector using a CASESessionManager.
+///
+/// Prefetching issues an operational DNS-SD resolve for the node, so that its
+/// address is already known by the address resolver (see AddressResolve's
+/// address cache) once the session setup for it starts.
+class CASESessionManagerReconnectConnector : public CASEReconnectConnector
+{
+public:
+    CASESessionManagerReconnectConnector(CASESessionManager & sessionManager, const FabricTable & fabricTable) :
+        mSessionManager(sessionManager), mFabricTable(fabricTable)
+    {}
+
+    void Connect(const ScopedNodeId & peerId, Callback::Callback<OnDeviceConnected> * onConnected,
+                 Callback::Callback<OnDeviceConnectionFailure> * onFailure) override;
+    void Prefetch(const ScopedNodeId & peerId) override;
+
+private:
+    CASESessionManager & mSessionManager;
+    const FabricTable & mFabricTable;
+};
+
+/// Schedules session establishment to many nodes.
+///
+/// Peers are queued with a priority and connected in priority order (FIFO
+/// within a priority), with at most `maxConcurrent` session setups in flight.
+/// Bounding concurrency keeps a reconnect storm from exhausting CASE clients
+/// and MRP retransmission slots, while still overlapping the network round
+/// trips of several handshakes. The operational discovery for the next few
+/// queued peers is started ahead of time (`prefetchDepth`), so that it overlaps
+/// with the handshakes in flight.
+///
+/// All methods MUST be called with the Matter stack lock held.
+class CASEReconnectScheduler
+{
+public:
+    static constexpr size_t kMaxConcurrent = CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_CASE_CLIENTS;
+
+    enum class Priority : uint8_t
+    {
+        kLow          = 0,
+        kNormal       = 1,
+        kSubscription = 2, // peers with subscriptions to resume are connected first
+    };
+
+    struct Stats
+    {
+        size_t connected                      = 0;
+        size_t failed                         = 0;
+        size_t maxInFlight                    = 0;
+        System::Clock::Milliseconds64 elapsed = System::Clock::kZero; // from Start() until all peers were processed
+    };
+
+    class Delegate
+    {
+    public:
+        virtual ~Delegate() = default;
+
+        virtual void OnPeerConnected(const ScopedNodeId & peerId, Messaging::ExchangeManager & exchangeMgr,
+                                     const SessionHandle & sessionHandle) = 0;
+        virtual void OnPeerConnectionFailure(const ScopedNodeId & peerId, CHIP_ERROR error) = 0;
+
+        /// Called once the queue is drained and no session setup is in flight anymore.
+        virtual void OnReconnectComplete(const Stats & stats) {}
+    };
+
+    CASEReconnectScheduler() = default;
+    ~CASEReconnectScheduler() { Cancel(); }
+
+    CASEReconnectScheduler(const CASEReconnectScheduler &)             = delete;
+    CASEReconnectScheduler & operator=(const CASEReconnectScheduler &) = delete;
+
+    /// `maxConcurrent` is clamped to [1, kMaxConcurrent].
+    CHIP_ERROR Init(CASEReconnectConnector * connector, Delegate * delegate, size_t maxConcurrent = kMaxConcurrent,
+                    size_t prefetchDepth = kMaxConcurrent);
+
+    /// Queues `peerId` for connection. Queuing a peer that is already queued
+    /// only raises its priority (if higher); peers already being connected are
+    /// not queued again.
+    ///
+    /// Peers may be queued before or after Start().
+    CHIP_ERROR Enqueue(const ScopedNodeId & peerId, Priority priority = Priority::kNormal);
+
+    /// Starts connecting queued peers. If no peers are queued, completion is
+    /// reported before this returns.
+    CHIP_ERROR Start();
+
+    /// Drops all queued peers and stops reporting results for peers in flight.
+    void Cancel();
+
+    bool IsRunning() const { return mRunning; }
+    size_t PendingCount() const;
+    size_t InFlightCount() const { return mInFlight; }
+    const Stats & GetStats() const { return mStats; }
+
+private:
+    static constexpr size_t kPriorityCount = 3;
+
+    struct QueuedPeer
+    {
+        ScopedNodeId peerId;
+        bool prefetched = false;
+    };
+
+    struct Attempt
+    {
+        Attempt() : onConnected(HandleConnected, this), onFailure(HandleFailure, this) {}
+
+        CASEReconnectScheduler * scheduler = nullptr;
+        ScopedNodeId peerId;
+        bool active = false;
+        Callback::Callback<OnDeviceConnected> onConnected;
+        Callback::Callback<OnDeviceConnectionFailure> onFailure;
+    };
+
+    static void HandleConnected(void * context, Messaging::ExchangeManager & exchangeMgr, const SessionHandle & sessionHandle);
+    static void HandleFailure(void * context, const ScopedNodeId & peerId, CHIP_ERROR error);
+
+    bool IsInFlight(const ScopedNodeId & peerId) const;
+    bool PopNext(QueuedPeer & next);
+    Attempt * FreeAttempt();
+    void ReleaseAttempt(Attempt & attempt);
+
+    /// Starts as many session setups as allowed, prefetches upcoming peers and
+    /// reports completion. Safe against re-entrancy from synchronous callbacks.
+    void Dispatch();
+    void Prefetch();
+
+    CASEReconnectConnector * mConnector = nullptr;
+    Delegate * mDelegate                = nullptr;
+    size_t mMaxConcurrent               = kMaxConcurrent;
+    size_t mPrefetchDepth               = kMaxConcurrent;
+
+    std::deque<QueuedPeer> mQueues[kPriorityCount]; // indexed by Priority
+    Attempt mAttempts[kMaxConcurrent];
+    size_t mInFlight = 0;
+
+    bool mRunning                       = false;
+    bool mDispatching                   = false;
+    System::Clock::Timestamp mStartTime = System::Clock::kZero;
+    Stats mStats;
+};
+
+} // namespace Controller
+} // namespace chip
@@ -660,7 +660,7 @@ class AsyncReadTransaction:
     def GetAllEventValues(self):
         return self._events
 
-    def handleAttributeData(self, path: AttributePath, dataVersion: int, status: int, data: bytes):
+    def handleAttributeData(self, path: AttributePath, dataVersion: int, status: int, elements: bytes, stringData: bytes):
         try:
             imStatus = chip.interaction_model.Status(status)
 
@@ -668,8 +668,7 @@ class AsyncReadTransaction:
                 attributeValue = ValueDecodeFailure(
                     None, chip.interaction_model.InteractionModelError(imStatus))
             else:
-                tlvData = chip.tlv.TLVReader(data).get().get("Any", {})
-                attributeValue = tlvData
+                attributeValue = chip.tlv.DecodeTLVElements(elements, stringData)
 
             self._cache.UpdateTLV(path, dataVersion, attributeValue)
             self._changedPathSet.add(path)
@@ -848,7 +847,7 @@ class AsyncWriteTransaction:
 
 
 _OnReadAttributeDataCallbackFunct = CFUNCTYPE(
-    None, py_object, c_uint32, c_uint16, c_uint32, c_uint32, c_uint8, c_void_p, c_size_t)
+    None, py_object, c_uint32, c_uint16, c_uint32, c_uint32, c_uint8, c_void_p, c_size_t, c_void_p, c_size_t)
 _OnSubscriptionEstablishedCallbackFunct = CFUNCTYPE(None, py_object, c_uint32)
 _OnResubscriptionAttemptedCallbackFunct = CFUNCTYPE(None, py_object, PyChipError, c_uint32)
 _OnReadEventDataCallbackFunct = CFUNCTYPE(
@@ -864,10 +863,13 @@ _OnReportEndCallbackFunct = CFUNCTYPE(
 
 
 @_OnReadAttributeDataCallbackFunct
-def _OnReadAttributeDataCallback(closure, dataVersion: int, endpoint: int, cluster: int, attribute: int, status, data, len):
-    dataBytes = ctypes.string_at(data, len)
+def _OnReadAttributeDataCallback(closure, dataVersion: int, endpoint: int, cluster: int, attribute: int, status,
+                                 elements, elementCount, stringData, stringDataLen):
+    # The attribute value was decoded by the native code, see chip/tlv/TLVDecoder.h.
+    elementBytes = ctypes.string_at(elements, elementCount * chip.tlv.TLVElementStruct.size) if elementCount else b''
+    stringDataBytes = ctypes.string_at(stringData, stringDataLen) if stringDataLen else b''
     closure.handleAttributeData(AttributePath(
-        EndpointId=endpoint, ClusterId=cluster, AttributeId=attribute), dataVersion, status, dataBytes[:])
+        EndpointId=endpoint, ClusterId=cluster, AttributeId=attribute), dataVersion, status, elementBytes, stringDataBytes)
 
 
 @_OnReadEventDataCallbackFunct
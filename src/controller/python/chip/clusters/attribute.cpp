@@ -29,6 +29,7 @@
 #include <controller/CHIPDeviceController.h>
 #include <controller/python/chip/interaction_model/Delegate.h>
 #include <controller/python/chip/native/PyChipError.h>
+#include <controller/python/chip/tlv/TLVDecoder.h>
 #include <lib/support/CodeUtils.h>
 
 #include <cstdio>
@@ -70,8 +71,9 @@ struct __attribute__((packed)) DataVersionFilter
 
 using OnReadAttributeDataCallback       = void (*)(PyObject * appContext, chip::DataVersion version, chip::EndpointId endpointId,
                                              chip::ClusterId clusterId, chip::AttributeId attributeId,
-                                             std::underlying_type_t<Protocols::InteractionModel::Status> imstatus, uint8_t * data,
-                                             size_t dataLen);
+                                             std::underlying_type_t<Protocols::InteractionModel::Status> imstatus,
+                                             const TLVElement * elements, size_t elementCount, const uint8_t * stringData,
+                                             size_t stringDataLen);
 using OnReadEventDataCallback           = void (*)(PyObject * appContext, chip::EndpointId endpointId, chip::ClusterId clusterId,
                                          chip::EventId eventId, chip::EventNumber eventNumber, uint8_t priority, uint64_t timestamp,
                                          uint8_t timestampType, uint8_t * data, size_t dataLen,
@@ -112,25 +114,20 @@ public:
         // callback. If we do, that's a bug.
         //
         VerifyOrDie(!aPath.IsListItemOperation());
-        size_t bufferLen                  = (apData == nullptr ? 0 : apData->GetRemainingLength() + apData->GetLengthRead());
-        std::unique_ptr<uint8_t[]> buffer = std::unique_ptr<uint8_t[]>(apData == nullptr ? nullptr : new uint8_t[bufferLen]);
-        size_t size                       = 0;
+        size_t elementCount = 0;
         // When the apData is nullptr, means we did not receive a valid attribute data from server, status will be some error
         // status.
         if (apData != nullptr)
         {
-            // The TLVReader's read head is not pointing to the first element in the container instead of the container itself, use
-            // a TLVWriter to get a TLV with a normalized TLV buffer (Wrapped with a anonymous tag, no extra "end of container" tag
-            // at the end.)
-            TLV::TLVWriter writer;
-            writer.Init(buffer.get(), bufferLen);
-            CHIP_ERROR err = writer.CopyElement(TLV::AnonymousTag(), *apData);
+            // Decode the value natively, straight from the report buffer: decoding TLV in Python is far too slow for large
+            // subscriptions.
+            CHIP_ERROR err = mDecoder.Decode(*apData);
             if (err != CHIP_NO_ERROR)
             {
                 this->OnError(err);
                 return;
             }
-            size = writer.GetLengthWritten();
+            elementCount = mDecoder.ElementCount();
         }
 
         DataVersion version = 0;
@@ -140,7 +137,8 @@ public:
         }
 
         gOnReadAttributeDataCallback(mAppContext, version, aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId,
-                                     to_underlying(aStatus.mStatus), buffer.get(), size);
+                                     to_underlying(aStatus.mStatus), mDecoder.Elements(), elementCount, mDecoder.StringData(),
+                                     apData == nullptr ? 0 : mDecoder.StringDataLength());
     }
 
     void OnSubscriptionEstablished(SubscriptionId aSubscriptionId) override
@@ -238,6 +236,7 @@ public:
 
 private:
     BufferedReadCallback mBufferedReadCallback;
+    TLVDecoder mDecoder;
 
     PyObject * mAppContext;
 
@@ -0,0 +1,173 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "TLVDecoder.h"
+
+#include <lib/core/TLVTags.h>
+#include <lib/support/CodeUtils.h>
+
+#include <string.h>
+
+namespace chip {
+namespace python {
+
+CHIP_ERROR TLVDecoder::Decode(TLV::TLVReader & reader)
+{
+    mElements.clear();
+    mStringData.clear();
+
+    return DecodeElement(reader, 0);
+}
+
+CHIP_ERROR TLVDecoder::DecodeElement(TLV::TLVReader & reader, uint8_t depth)
+{
+    TLVElement element = {};
+
+    const TLV::Tag tag = reader.GetTag();
+    if (TLV::IsContextTag(tag))
+    {
+        element.tagKind   = to_underlying(TLVTagKind::kContext);
+        element.tagNumber = TLV::TagNumFromTag(tag);
+    }
+    else if (TLV::IsProfileTag(tag))
+    {
+        element.tagKind   = to_underlying(TLVTagKind::kProfile);
+        element.profileId = TLV::ProfileIdFromTag(tag);
+        element.tagNumber = TLV::TagNumFromTag(tag);
+    }
+    else
+    {
+        VerifyOrReturnError(tag == TLV::AnonymousTag(), CHIP_ERROR_INVALID_TLV_TAG);
+        element.tagKind = to_underlying(TLVTagKind::kAnonymous);
+    }
+
+    ReturnErrorOnFailure(DecodeValue(reader, element));
+    mElements.push_back(element);
+
+    if (TLV::TLVTypeIsContainer(reader.GetType()))
+    {
+        return DecodeContainer(reader, mElements.size() - 1, depth);
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR TLVDecoder::DecodeValue(TLV::TLVReader & reader, TLVElement & element)
+{
+    switch (reader.GetType())
+    {
+    case TLV::kTLVType_SignedInteger: {
+        int64_t value;
+        ReturnErrorOnFailure(reader.Get(value));
+        element.type  = to_underlying(TLVElementType::kSignedInteger);
+        element.value = static_cast<uint64_t>(value);
+        break;
+    }
+    case TLV::kTLVType_UnsignedInteger: {
+        uint64_t value;
+        ReturnErrorOnFailure(reader.Get(value));
+        element.type  = to_underlying(TLVElementType::kUnsignedInteger);
+        element.value = value;
+        break;
+    }
+    case TLV::kTLVType_Boolean: {
+        bool value;
+        ReturnErrorOnFailure(reader.Get(value));
+        element.type  = to_underlying(TLVElementType::kBoolean);
+        element.value = value ? 1 : 0;
+        break;
+    }
+    case TLV::kTLVType_FloatingPointNumber:
+        // Single precision numbers are kept as such, so that the Python side can tell them apart from doubles.
+        if (reader.IsElementDouble())
+        {
+            double value;
+            ReturnErrorOnFailure(reader.Get(value));
+            element.type = to_underlying(TLVElementType::kDouble);
+            static_assert(sizeof(value) == sizeof(element.value), "Unexpected double size");
+            memcpy(&element.value, &value, sizeof(value));
+        }
+        else
+        {
+            float value;
+            uint32_t bits;
+            ReturnErrorOnFailure(reader.Get(value));
+            element.type = to_underlying(TLVElementType::kFloat);
+            static_assert(sizeof(value) == sizeof(bits), "Unexpected float size");
+            memcpy(&bits, &value, sizeof(value));
+            element.value = bits;
+        }
+        break;
+    case TLV::kTLVType_UTF8String:
+    case TLV::kTLVType_ByteString: {
+        const uint32_t length = reader.GetLength();
+        const size_t offset   = mStringData.size();
+        element.type   = to_underlying(reader.GetType() == TLV::kTLVType_UTF8String ? TLVElementType::kUTF8String
+                                                                                      : TLVElementType::kByteString);
+        element.length = length;
+        element.value  = offset;
+        if (length > 0)
+        {
+            mStringData.resize(offset + length);
+            // GetBytes also works when the element spans several buffers of the backing store.
+            ReturnErrorOnFailure(reader.GetBytes(mStringData.data() + offset, length));
+        }
+        break;
+    }
+    case TLV::kTLVType_Null:
+        element.type = to_underlying(TLVElementType::kNull);
+        break;
+    case TLV::kTLVType_Structure:
+        element.type = to_underlying(TLVElementType::kStructure);
+        break;
+    case TLV::kTLVType_Array:
+        element.type = to_underlying(TLVElementType::kArray);
+        break;
+    case TLV::kTLVType_List:
+        element.type = to_underlying(TLVElementType::kList);
+        break;
+    default:
+        return CHIP_ERROR_INVALID_TLV_ELEMENT;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR TLVDecoder::DecodeContainer(TLV::TLVReader & reader, size_t index, uint8_t depth)
+{
+    VerifyOrReturnError(depth < kMaxContainerDepth, CHIP_ERROR_INVALID_TLV_ELEMENT);
+
+    TLV::TLVType outerContainerType;
+    ReturnErrorOnFailure(reader.EnterContainer(outerContainerType));
+
+    uint32_t count = 0;
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        ReturnErrorOnFailure(DecodeElement(reader, static_cast<uint8_t>(depth + 1)));
+        count++;
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    // Decoding the elements might have reallocated the records.
+    mElements[index].length = count;
+
+    return reader.ExitContainer(outerContainerType);
+}
+
+} // namespace python
+} // namespace chip
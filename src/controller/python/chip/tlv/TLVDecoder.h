@@ -0,0 +1,108 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/TLVReader.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace chip {
+namespace python {
+
+// Must match TLVElementType in chip/tlv/__init__.py.
+enum class TLVElementType : uint8_t
+{
+    kSignedInteger   = 0,
+    kUnsignedInteger = 1,
+    kBoolean         = 2,
+    kFloat           = 3,
+    kDouble          = 4,
+    kUTF8String      = 5,
+    kByteString      = 6,
+    kNull            = 7,
+    kStructure       = 8,
+    kArray           = 9,
+    kList            = 10,
+};
+
+// Must match TLVTagKind in chip/tlv/__init__.py.
+enum class TLVTagKind : uint8_t
+{
+    kAnonymous = 0,
+    kContext   = 1,
+    kProfile   = 2,
+};
+
+/*
+ * A decoded TLV element, in a fixed size layout that the Python side unpacks without parsing the TLV encoding.
+ *
+ * The elements of a container follow it, in encoding order, and nested containers are flattened the same way.
+ */
+struct __attribute__((packed)) TLVElement
+{
+    uint8_t type;    // TLVElementType
+    uint8_t tagKind; // TLVTagKind
+    uint32_t profileId;
+    uint32_t tagNumber;
+    // The length of strings, and the number of elements of containers.
+    uint32_t length;
+    // The value of integers and booleans, the IEEE 754 encoding of floating point numbers, and the offset of strings in
+    // the string data.
+    uint64_t value;
+};
+
+/*
+ * Decodes TLV into TLVElement records, directly from the buffer the TLVReader reads from, so that the Python controller
+ * does not have to decode the TLV encoding in Python.
+ *
+ * The decoder keeps its buffers from one Decode() call to the next, so that decoding a stream of reports does not
+ * allocate memory once the buffers are large enough.
+ */
+class TLVDecoder
+{
+public:
+    // Maximum nesting of containers, which bounds the recursion of the decoder. Deeper elements fail to decode.
+    static constexpr uint8_t kMaxContainerDepth = 32;
+
+    /*
+     * Decodes the element the reader is positioned on, including the elements it contains if it is a container. The
+     * previous results of the decoder are discarded.
+     */
+    CHIP_ERROR Decode(TLV::TLVReader & reader);
+
+    const TLVElement * Elements() const { return mElements.data(); }
+    size_t ElementCount() const { return mElements.size(); }
+
+    // Contents of the strings of the elements, which are not null-terminated.
+    const uint8_t * StringData() const { return mStringData.data(); }
+    size_t StringDataLength() const { return mStringData.size(); }
+
+private:
+    CHIP_ERROR DecodeElement(TLV::TLVReader & reader, uint8_t depth);
+    CHIP_ERROR DecodeValue(TLV::TLVReader & reader, TLVElement & element);
+    CHIP_ERROR DecodeContainer(TLV::TLVReader & reader, size_t index, uint8_t depth);
+
+    std::vector<TLVElement> mElements;
+    std::vector<uint8_t> mStringData;
+};
+
+} // namespace python
+} // namespace chip
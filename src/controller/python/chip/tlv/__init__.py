@@ -30,7 +30,7 @@ from __future__ import absolute_import, print_function
 import struct
 from collections import OrderedDict
 from collections.abc import Mapping, Sequence
-from enum import Enum
+from enum import Enum, IntEnum
 
 from .tlvlist import TLVList
 
@@ -699,6 +699,105 @@ class TLVReader(object):
                     raise ValueError("Attempt to decode unsupported TLV tag")
 
 
+class TLVElementType(IntEnum):
+    """Types of the TLVElement records of the native decoder. Must match chip/tlv/TLVDecoder.h."""
+    SignedInteger = 0
+    UnsignedInteger = 1
+    Boolean = 2
+    Float = 3
+    Double = 4
+    UTF8String = 5
+    ByteString = 6
+    Null = 7
+    Structure = 8
+    Array = 9
+    List = 10
+
+
+class TLVTagKind(IntEnum):
+    """Tag kinds of the TLVElement records of the native decoder. Must match chip/tlv/TLVDecoder.h."""
+    Anonymous = 0
+    Context = 1
+    Profile = 2
+
+
+# Layout of a packed TLVElement record: type, tagKind, profileId, tagNumber, length, value.
+TLVElementStruct = struct.Struct("<BBIIIQ")
+
+
+def DecodeTLVElements(elements: bytes, stringData: bytes):
+    """Build the python value of an element that the native code decoded into TLVElement records.
+
+    The value is the same as the one TLVReader returns for the element, without the cost of parsing
+    the TLV encoding in python.
+    """
+    result = None
+    # The container the next element goes in, the number of its elements still to come, and the
+    # same for the containers it is nested in.
+    container = None
+    remaining = 0
+    stack = []
+
+    for (elementType, tagKind, profileId, tagNumber, length, value) in TLVElementStruct.iter_unpack(elements):
+        if elementType == TLVElementType.UnsignedInteger:
+            decoded = uint(value)
+        elif elementType == TLVElementType.SignedInteger:
+            decoded = value - (1 << 64) if value & (1 << 63) else value
+        elif elementType == TLVElementType.Boolean:
+            decoded = bool(value)
+        elif elementType == TLVElementType.UTF8String:
+            decoded = stringData[value:value + length]
+            try:
+                decoded = str(decoded, "utf-8")
+            except Exception:
+                pass
+        elif elementType == TLVElementType.ByteString:
+            decoded = stringData[value:value + length]
+        elif elementType == TLVElementType.Structure:
+            decoded = {}
+        elif elementType == TLVElementType.Array:
+            decoded = []
+        elif elementType == TLVElementType.List:
+            decoded = TLVList()
+        elif elementType == TLVElementType.Null:
+            decoded = None
+        elif elementType == TLVElementType.Float:
+            (decoded,) = struct.unpack("<f", struct.pack("<L", value))
+            decoded = float32(decoded)
+        elif elementType == TLVElementType.Double:
+            (decoded,) = struct.unpack("<d", struct.pack("<Q", value))
+        else:
+            raise ValueError("Attempt to decode unsupported TLV type")
+
+        if container is None:
+            result = decoded
+        else:
+            if tagKind == TLVTagKind.Context:
+                tag = tagNumber
+            elif tagKind == TLVTagKind.Profile:
+                tag = (profileId, tagNumber)
+            else:
+                tag = None
+
+            if isinstance(container, dict):
+                container["Any" if tag is None else tag] = decoded
+            elif isinstance(container, TLVList):
+                container.append(tag, decoded)
+            else:
+                container.append(decoded)
+            remaining -= 1
+
+        if elementType >= TLVElementType.Structure and length > 0:
+            stack.append((container, remaining))
+            container = decoded
+            remaining = length
+
+        while container is not None and remaining == 0:
+            (container, remaining) = stack.pop()
+
+    return result
+
+
 def tlvTagToSortKey(tag):
     if tag is None:
         return -1
@@ -0,0 +1,212 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <pw_unit_test/framework.h>
+
+#include <controller/python/chip/tlv/TLVDecoder.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CodeUtils.h>
+
+#include <string.h>
+
+using namespace chip;
+using namespace chip::python;
+
+namespace {
+
+uint8_t gBuffer[1024];
+
+// Points `reader` at the first element `writer` wrote into gBuffer.
+void InitReader(TLV::TLVWriter & writer, TLV::TLVReader & reader)
+{
+    EXPECT_EQ(writer.Finalize(), CHIP_NO_ERROR);
+    reader.Init(gBuffer, writer.GetLengthWritten());
+    EXPECT_EQ(reader.Next(), CHIP_NO_ERROR);
+}
+
+TEST(TestTLVDecoder, TestTags)
+{
+    TLV::TLVWriter writer;
+    TLV::TLVType outer;
+    TLV::TLVType array;
+    writer.Init(gBuffer);
+    EXPECT_EQ(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, outer), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.Put(TLV::ContextTag(7), static_cast<uint8_t>(42)), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.Put(TLV::ProfileTag(0x1234'5678, 0x9abc'def0), static_cast<int16_t>(-3)), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.StartContainer(TLV::ContextTag(2), TLV::kTLVType_Array, array), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.Put(TLV::AnonymousTag(), true), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.PutNull(TLV::AnonymousTag()), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.EndContainer(array), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.EndContainer(outer), CHIP_NO_ERROR);
+
+    TLV::TLVReader reader;
+    InitReader(writer, reader);
+    TLVDecoder decoder;
+    EXPECT_EQ(decoder.Decode(reader), CHIP_NO_ERROR);
+
+    // The elements of each container follow it, in encoding order.
+    ASSERT_EQ(decoder.ElementCount(), 6u);
+    const TLVElement * elements = decoder.Elements();
+
+    EXPECT_EQ(elements[0].type, to_underlying(TLVElementType::kStructure));
+    EXPECT_EQ(elements[0].tagKind, to_underlying(TLVTagKind::kAnonymous));
+    EXPECT_EQ(elements[0].length, 3u);
+
+    EXPECT_EQ(elements[1].type, to_underlying(TLVElementType::kUnsignedInteger));
+    EXPECT_EQ(elements[1].tagKind, to_underlying(TLVTagKind::kContext));
+    EXPECT_EQ(elements[1].tagNumber, 7u);
+    EXPECT_EQ(elements[1].value, 42u);
+
+    EXPECT_EQ(elements[2].type, to_underlying(TLVElementType::kSignedInteger));
+    EXPECT_EQ(elements[2].tagKind, to_underlying(TLVTagKind::kProfile));
+    EXPECT_EQ(elements[2].profileId, 0x1234'5678u);
+    EXPECT_EQ(elements[2].tagNumber, 0x9abc'def0u);
+    EXPECT_EQ(static_cast<int64_t>(elements[2].value), -3);
+
+    EXPECT_EQ(elements[3].type, to_underlying(TLVElementType::kArray));
+    EXPECT_EQ(elements[3].tagKind, to_underlying(TLVTagKind::kContext));
+    EXPECT_EQ(elements[3].tagNumber, 2u);
+    EXPECT_EQ(elements[3].length, 2u);
+
+    EXPECT_EQ(elements[4].type, to_underlying(TLVElementType::kBoolean));
+    EXPECT_EQ(elements[4].tagKind, to_underlying(TLVTagKind::kAnonymous));
+    EXPECT_EQ(elements[4].value, 1u);
+
+    EXPECT_EQ(elements[5].type, to_underlying(TLVElementType::kNull));
+    EXPECT_EQ(elements[5].tagKind, to_underlying(TLVTagKind::kAnonymous));
+}
+
+TEST(TestTLVDecoder, TestFloats)
+{
+    TLV::TLVWriter writer;
+    TLV::TLVType outer;
+    writer.Init(gBuffer);
+    EXPECT_EQ(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, outer), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.Put(TLV::AnonymousTag(), 1.5f), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.Put(TLV::AnonymousTag(), -2.25), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.EndContainer(outer), CHIP_NO_ERROR);
+
+    TLV::TLVReader reader;
+    InitReader(writer, reader);
+    TLVDecoder decoder;
+    EXPECT_EQ(decoder.Decode(reader), CHIP_NO_ERROR);
+    ASSERT_EQ(decoder.ElementCount(), 3u);
+    const TLVElement * elements = decoder.Elements();
+
+    // Single precision numbers keep their own type and IEEE 754 encoding, in the low bits of the value.
+    float floatValue;
+    uint32_t floatBits;
+    EXPECT_EQ(elements[1].type, to_underlying(TLVElementType::kFloat));
+    EXPECT_EQ(elements[1].value >> 32, 0u);
+    floatBits = static_cast<uint32_t>(elements[1].value);
+    memcpy(&floatValue, &floatBits, sizeof(floatValue));
+    EXPECT_EQ(floatValue, 1.5f);
+
+    double doubleValue;
+    uint64_t doubleBits = elements[2].value;
+    EXPECT_EQ(elements[2].type, to_underlying(TLVElementType::kDouble));
+    memcpy(&doubleValue, &doubleBits, sizeof(doubleValue));
+    EXPECT_EQ(doubleValue, -2.25);
+}
+
+TEST(TestTLVDecoder, TestStrings)
+{
+    const uint8_t bytes[] = { 0x00, 0xff, 0x10 };
+
+    TLV::TLVWriter writer;
+    TLV::TLVType outer;
+    writer.Init(gBuffer);
+    EXPECT_EQ(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_List, outer), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.PutString(TLV::ContextTag(1), "hello"), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.PutString(TLV::ContextTag(2), ""), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.Put(TLV::ContextTag(3), ByteSpan(bytes)), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.EndContainer(outer), CHIP_NO_ERROR);
+
+    TLV::TLVReader reader;
+    InitReader(writer, reader);
+    TLVDecoder decoder;
+    EXPECT_EQ(decoder.Decode(reader), CHIP_NO_ERROR);
+    ASSERT_EQ(decoder.ElementCount(), 4u);
+    const TLVElement * elements = decoder.Elements();
+
+    EXPECT_EQ(elements[0].type, to_underlying(TLVElementType::kList));
+    EXPECT_EQ(elements[0].length, 3u);
+
+    // The string contents are appended to the string data, without terminators.
+    ASSERT_EQ(decoder.StringDataLength(), 8u);
+
+    EXPECT_EQ(elements[1].type, to_underlying(TLVElementType::kUTF8String));
+    EXPECT_EQ(elements[1].length, 5u);
+    EXPECT_EQ(memcmp(decoder.StringData() + elements[1].value, "hello", 5), 0);
+
+    EXPECT_EQ(elements[2].type, to_underlying(TLVElementType::kUTF8String));
+    EXPECT_EQ(elements[2].length, 0u);
+
+    EXPECT_EQ(elements[3].type, to_underlying(TLVElementType::kByteString));
+    EXPECT_EQ(elements[3].length, sizeof(bytes));
+    EXPECT_EQ(memcmp(decoder.StringData() + elements[3].value, bytes, sizeof(bytes)), 0);
+
+    // Decoding again discards the previous results.
+    writer.Init(gBuffer);
+    EXPECT_EQ(writer.PutString(TLV::AnonymousTag(), "abc"), CHIP_NO_ERROR);
+    InitReader(writer, reader);
+    EXPECT_EQ(decoder.Decode(reader), CHIP_NO_ERROR);
+    ASSERT_EQ(decoder.ElementCount(), 1u);
+    EXPECT_EQ(decoder.Elements()[0].value, 0u);
+    ASSERT_EQ(decoder.StringDataLength(), 3u);
+    EXPECT_EQ(memcmp(decoder.StringData(), "abc", 3), 0);
+}
+
+// Writes `depth` arrays nested in each other.
+void WriteNestedArrays(TLV::TLVWriter & writer, size_t depth)
+{
+    TLV::TLVType outer[TLVDecoder::kMaxContainerDepth + 1];
+    ASSERT_LE(depth, ArraySize(outer));
+
+    writer.Init(gBuffer);
+    for (size_t i = 0; i < depth; i++)
+    {
+        EXPECT_EQ(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, outer[i]), CHIP_NO_ERROR);
+    }
+    for (size_t i = depth; i > 0; i--)
+    {
+        EXPECT_EQ(writer.EndContainer(outer[i - 1]), CHIP_NO_ERROR);
+    }
+}
+
+TEST(TestTLVDecoder, TestDepthLimit)
+{
+    TLV::TLVWriter writer;
+    TLV::TLVReader reader;
+    TLVDecoder decoder;
+
+    WriteNestedArrays(writer, TLVDecoder::kMaxContainerDepth);
+    InitReader(writer, reader);
+    EXPECT_EQ(decoder.Decode(reader), CHIP_NO_ERROR);
+    EXPECT_EQ(decoder.ElementCount(), static_cast<size_t>(TLVDecoder::kMaxContainerDepth));
+
+    // One more level of nesting is rejected rather than recursed into.
+    WriteNestedArrays(writer, TLVDecoder::kMaxContainerDepth + 1);
+    InitReader(writer, reader);
+    EXPECT_EQ(decoder.Decode(reader), CHIP_ERROR_INVALID_TLV_ELEMENT);
+}
+
+} // namespace
@@ -17,7 +17,7 @@
 
 import unittest
 
-from chip.tlv import TLVList, TLVReader, TLVWriter
+from chip.tlv import DecodeTLVElements, TLVElementStruct, TLVElementType, TLVList, TLVReader, TLVTagKind, TLVWriter
 from chip.tlv import uint as tlvUint
 
 
@@ -196,6 +196,55 @@ class TestTLVReader(unittest.TestCase):
                          ], TLVList([(None, 1), (None, TLVList([(None, 2), (3, 4)]))]))
 
 
+class TestDecodeTLVElements(unittest.TestCase):
+    def _element(self, elementType, tag=None, length=0, value=0):
+        if tag is None:
+            return TLVElementStruct.pack(elementType, TLVTagKind.Anonymous, 0, 0, length, value)
+        return TLVElementStruct.pack(elementType, TLVTagKind.Context, 0, tag, length, value)
+
+    def test_scalars(self):
+        self.assertEqual(DecodeTLVElements(self._element(TLVElementType.UnsignedInteger, value=0xab), b''), tlvUint(0xab))
+        self.assertEqual(type(DecodeTLVElements(self._element(TLVElementType.UnsignedInteger, value=0xab), b'')), tlvUint)
+        self.assertEqual(DecodeTLVElements(self._element(TLVElementType.SignedInteger, value=(1 << 64) - 0x55), b''), -0x55)
+        self.assertEqual(DecodeTLVElements(self._element(TLVElementType.Boolean, value=1), b''), True)
+        self.assertEqual(DecodeTLVElements(self._element(TLVElementType.Null), b''), None)
+        self.assertEqual(DecodeTLVElements(self._element(TLVElementType.Float, value=0x3fc00000), b''), 1.5)
+        self.assertEqual(DecodeTLVElements(self._element(TLVElementType.Double, value=0x4002000000000000), b''), 2.25)
+        self.assertEqual(DecodeTLVElements(self._element(TLVElementType.UTF8String, length=5, value=2), b'\xde\xadhello'),
+                         'hello')
+        self.assertEqual(DecodeTLVElements(self._element(TLVElementType.ByteString, length=2), b'\xde\xadhello'),
+                         b'\xde\xad')
+
+    def test_containers(self):
+        # Same value as the first case of TestTLVReader.test_structure.
+        tlv_bytes = (b'\x15\x36\x01\x15\x35\x01\x26\x00\xBF\xA2\x55\x16\x37\x01\x24'
+                     b'\x02\x00\x24\x03\x28\x24\x04\x00\x18\x24\x02\x01\x18\x18\x18\x18')
+        elements = b''.join([
+            self._element(TLVElementType.Structure, length=1),
+            self._element(TLVElementType.Array, tag=1, length=1),
+            self._element(TLVElementType.Structure, length=1),
+            self._element(TLVElementType.Structure, tag=1, length=3),
+            self._element(TLVElementType.UnsignedInteger, tag=0, value=374710975),
+            self._element(TLVElementType.List, tag=1, length=3),
+            self._element(TLVElementType.UnsignedInteger, tag=2, value=0),
+            self._element(TLVElementType.UnsignedInteger, tag=3, value=40),
+            self._element(TLVElementType.UnsignedInteger, tag=4, value=0),
+            self._element(TLVElementType.UnsignedInteger, tag=2, value=1),
+        ])
+        decoded = DecodeTLVElements(elements, b'')
+        self.assertEqual(decoded, TLVReader(bytearray(tlv_bytes)).get()["Any"])
+        self.assertEqual(type(decoded[1][0][1][1]), TLVList)
+
+        # Empty containers are followed by their siblings.
+        elements = b''.join([
+            self._element(TLVElementType.Array, length=3),
+            self._element(TLVElementType.Structure),
+            self._element(TLVElementType.Array),
+            self._element(TLVElementType.SignedInteger, value=7),
+        ])
+        self.assertEqual(DecodeTLVElements(elements, b''), [{}, [], 7])
+
+
 class TestTLVTypes(unittest.TestCase):
     def test_list(self):
         var = TLVList([(None, 1), (None, 2), (1, 3)])
@@ -0,0 +1,404 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <controller/CASEReconnectScheduler.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <messaging/ExchangeMgr.h>
+#include <system/SystemClock.h>
+#include <transport/GroupSession.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Controller;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+using Priority = CASEReconnectScheduler::Priority;
+
+constexpr FabricIndex kFabricIndex = 1;
+
+ScopedNodeId MakePeer(NodeId nodeId)
+{
+    return ScopedNodeId(nodeId, kFabricIndex);
+}
+
+/// Simulates session setup: each Connect() completes after an operational
+/// discovery delay (skipped if the address was prefetched early enough),
+/// followed by the CASE handshake delay.
+class FakeConnector : public CASEReconnectConnector
+{
+public:
+    struct PendingConnect
+    {
+        ScopedNodeId peerId;
+        Callback::Callback<OnDeviceConnected> * onConnected;
+        Callback::Callback<OnDeviceConnectionFailure> * onFailure;
+        System::Clock::Timestamp completeAt;
+    };
+
+    FakeConnector(System::Clock::Internal::MockClock & clock) : mClock(clock), mSession(0x1234, kFabricIndex, 0) {}
+
+    void Connect(const ScopedNodeId & peerId, Callback::Callback<OnDeviceConnected> * onConnected,
+                 Callback::Callback<OnDeviceConnectionFailure> * onFailure) override
+    {
+        mConnectOrder.push_back(peerId);
+
+        if (mSynchronous)
+        {
+            onConnected->mCall(onConnected->mContext, mExchangeManager, SessionHandle(mSession));
+            return;
+        }
+
+        // Register the callbacks the same way OperationalSessionSetup does, so
+        // that cancellation by the scheduler can be observed.
+        mConnectedCallbacks.Enqueue(onConnected->Cancel());
+        mFailureCallbacks.Enqueue(onFailure->Cancel());
+
+        const System::Clock::Timestamp now      = mClock.GetMonotonicTimestamp();
+        System::Clock::Timestamp addressKnownAt = now + mDiscoveryLatency;
+        for (const auto & prefetch : mPrefetches)
+        {
+            if (prefetch.peerId == peerId)
+            {
+                addressKnownAt = std::max(now, prefetch.doneAt);
+            }
+        }
+
+        mPending.push_back({ peerId, onConnected, onFailure, addressKnownAt + mHandshakeLatency });
+        mMaxPending = std::max(mMaxPending, mPending.size());
+    }
+
+    void Prefetch(const ScopedNodeId & peerId) override
+    {
+        mPrefetches.push_back({ peerId, mClock.GetMonotonicTimestamp() + mDiscoveryLatency });
+    }
+
+    /// Advances time to the next completion and reports it. Returns false if
+    /// no session setup is pending.
+    bool CompleteNext()
+    {
+        auto next = std::min_element(mPending.begin(), mPending.end(), [](const PendingConnect & a, const PendingConnect & b) {
+            return a.completeAt < b.completeAt;
+        });
+        if (next == mPending.end())
+        {
+            return false;
+        }
+
+        PendingConnect connect = *next;
+        mPending.erase(next);
+
+        const System::Clock::Timestamp now = mClock.GetMonotonicTimestamp();
+        if (connect.completeAt > now)
+        {
+            mClock.AdvanceMonotonic(connect.completeAt - now);
+        }
+
+        // Cancelled by the requester: nothing to report.
+        if (!connect.onConnected->IsRegistered())
+        {
+            return true;
+        }
+        connect.onConnected->Cancel();
+        connect.onFailure->Cancel();
+
+        if (std::find(mFailingPeers.begin(), mFailingPeers.end(), connect.peerId) != mFailingPeers.end())
+        {
+            connect.onFailure->mCall(connect.onFailure->mContext, connect.peerId, CHIP_ERROR_TIMEOUT);
+        }
+        else
+        {
+            connect.onConnected->mCall(connect.onConnected->mContext, mExchangeManager, SessionHandle(mSession));
+        }
+        return true;
+    }
+
+    void CompleteAll()
+    {
+        while (CompleteNext())
+        {
+        }
+    }
+
+    bool WasPrefetched(const ScopedNodeId & peerId) const
+    {
+        return std::any_of(mPrefetches.begin(), mPrefetches.end(),
+                           [&peerId](const PrefetchRecord & prefetch) { return prefetch.peerId == peerId; });
+    }
+
+    System::Clock::Internal::MockClock & mClock;
+    System::Clock::Milliseconds64 mDiscoveryLatency = 0_ms64;
+    System::Clock::Milliseconds64 mHandshakeLatency = 0_ms64;
+    bool mSynchronous                               = false;
+    std::vector<ScopedNodeId> mFailingPeers;
+
+    std::vector<ScopedNodeId> mConnectOrder;
+    std::vector<PendingConnect> mPending;
+    size_t mMaxPending = 0;
+
+private:
+    struct PrefetchRecord
+    {
+        ScopedNodeId peerId;
+        System::Clock::Timestamp doneAt;
+    };
+
+    Messaging::ExchangeManager mExchangeManager;
+    Transport::IncomingGroupSession mSession;
+    Callback::CallbackDeque mConnectedCallbacks;
+    Callback::CallbackDeque mFailureCallbacks;
+    std::vector<PrefetchRecord> mPrefetches;
+};
+
+class RecordingDelegate : public CASEReconnectScheduler::Delegate
+{
+public:
+    void OnPeerConnected(const ScopedNodeId & peerId, Messaging::ExchangeManager & exchangeMgr,
+                         const SessionHandle & sessionHandle) override
+    {
+        mConnected.push_back(peerId);
+    }
+
+    void OnPeerConnectionFailure(const ScopedNodeId & peerId, CHIP_ERROR error) override { mFailed.push_back(peerId); }
+
+    void OnReconnectComplete(const CASEReconnectScheduler::Stats & stats) override
+    {
+        mCompleteCount++;
+        mStats = stats;
+    }
+
+    std::vector<ScopedNodeId> mConnected;
+    std::vector<ScopedNodeId> mFailed;
+    size_t mCompleteCount = 0;
+    CASEReconnectScheduler::Stats mStats;
+};
+
+class TestCASEReconnectScheduler : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+
+    void SetUp() override
+    {
+        mRealClock = &System::SystemClock();
+        System::Clock::Internal::SetSystemClockForTesting(&mMockClock);
+    }
+    void TearDown() override { System::Clock::Internal::SetSystemClockForTesting(mRealClock); }
+
+protected:
+    System::Clock::Internal::MockClock mMockClock;
+    System::Clock::ClockBase * mRealClock = nullptr;
+};
+
+TEST_F(TestCASEReconnectScheduler, TestPriorityOrder)
+{
+    FakeConnector connector(mMockClock);
+    RecordingDelegate delegate;
+    CASEReconnectScheduler scheduler;
+
+    ASSERT_EQ(scheduler.Init(&connector, &delegate, 1), CHIP_NO_ERROR);
+
+    EXPECT_EQ(scheduler.Enqueue(MakePeer(1), Priority::kNormal), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.Enqueue(MakePeer(2), Priority::kLow), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.Enqueue(MakePeer(3), Priority::kSubscription), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.Enqueue(MakePeer(4), Priority::kNormal), CHIP_NO_ERROR);
+    // Re-queuing raises the priority, but never lowers it.
+    EXPECT_EQ(scheduler.Enqueue(MakePeer(4), Priority::kSubscription), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.Enqueue(MakePeer(3), Priority::kLow), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.PendingCount(), 4u);
+
+    EXPECT_EQ(scheduler.Start(), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.InFlightCount(), 1u);
+    connector.CompleteAll();
+
+    const std::vector<ScopedNodeId> expected = { MakePeer(3), MakePeer(4), MakePeer(1), MakePeer(2) };
+    EXPECT_EQ(connector.mConnectOrder, expected);
+    EXPECT_EQ(delegate.mConnected, expected);
+    EXPECT_EQ(delegate.mCompleteCount, 1u);
+    EXPECT_FALSE(scheduler.IsRunning());
+}
+
+TEST_F(TestCASEReconnectScheduler, TestConcurrencyBound)
+{
+    FakeConnector connector(mMockClock);
+    RecordingDelegate delegate;
+    CASEReconnectScheduler scheduler;
+
+    connector.mHandshakeLatency = 100_ms64;
+    connector.mFailingPeers     = { MakePeer(5), MakePeer(17) };
+
+    ASSERT_EQ(scheduler.Init(&connector, &delegate, 4), CHIP_NO_ERROR);
+    for (NodeId node = 1; node <= 20; node++)
+    {
+        EXPECT_EQ(scheduler.Enqueue(MakePeer(node)), CHIP_NO_ERROR);
+    }
+
+    EXPECT_EQ(scheduler.Start(), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.InFlightCount(), 4u);
+    EXPECT_EQ(scheduler.PendingCount(), 16u);
+
+    // Peers that are already being connected are not queued again.
+    EXPECT_EQ(scheduler.Enqueue(MakePeer(1)), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.PendingCount(), 16u);
+
+    connector.CompleteAll();
+
+    EXPECT_EQ(connector.mMaxPending, 4u);
+    EXPECT_EQ(delegate.mConnected.size(), 18u);
+    EXPECT_EQ(delegate.mFailed.size(), 2u);
+    EXPECT_EQ(delegate.mCompleteCount, 1u);
+    EXPECT_EQ(delegate.mStats.connected, 18u);
+    EXPECT_EQ(delegate.mStats.failed, 2u);
+    EXPECT_EQ(delegate.mStats.maxInFlight, 4u);
+    EXPECT_EQ(delegate.mStats.elapsed, 500_ms64);
+}
+
+TEST_F(TestCASEReconnectScheduler, TestSynchronousCompletion)
+{
+    FakeConnector connector(mMockClock);
+    RecordingDelegate delegate;
+    CASEReconnectScheduler scheduler;
+
+    connector.mSynchronous = true;
+
+    ASSERT_EQ(scheduler.Init(&connector, &delegate, 2), CHIP_NO_ERROR);
+    for (NodeId node = 1; node <= 10; node++)
+    {
+        EXPECT_EQ(scheduler.Enqueue(MakePeer(node)), CHIP_NO_ERROR);
+    }
+
+    EXPECT_EQ(scheduler.Start(), CHIP_NO_ERROR);
+    EXPECT_FALSE(scheduler.IsRunning());
+    EXPECT_EQ(delegate.mConnected.size(), 10u);
+    EXPECT_EQ(delegate.mCompleteCount, 1u);
+
+    // Nothing queued: completion is reported right away.
+    EXPECT_EQ(scheduler.Start(), CHIP_NO_ERROR);
+    EXPECT_EQ(delegate.mCompleteCount, 2u);
+}
+
+TEST_F(TestCASEReconnectScheduler, TestPrefetch)
+{
+    FakeConnector connector(mMockClock);
+    RecordingDelegate delegate;
+    CASEReconnectScheduler scheduler;
+
+    ASSERT_EQ(scheduler.Init(&connector, &delegate, 1, 2), CHIP_NO_ERROR);
+    for (NodeId node = 1; node <= 5; node++)
+    {
+        EXPECT_EQ(scheduler.Enqueue(MakePeer(node)), CHIP_NO_ERROR);
+    }
+
+    EXPECT_EQ(scheduler.Start(), CHIP_NO_ERROR);
+    EXPECT_FALSE(connector.WasPrefetched(MakePeer(1)));
+    EXPECT_TRUE(connector.WasPrefetched(MakePeer(2)));
+    EXPECT_TRUE(connector.WasPrefetched(MakePeer(3)));
+    EXPECT_FALSE(connector.WasPrefetched(MakePeer(4)));
+
+    // A newly queued high priority peer moves to the front of the prefetch window.
+    EXPECT_EQ(scheduler.Enqueue(MakePeer(6), Priority::kSubscription), CHIP_NO_ERROR);
+    EXPECT_TRUE(connector.WasPrefetched(MakePeer(6)));
+
+    EXPECT_TRUE(connector.CompleteNext());
+    EXPECT_FALSE(connector.WasPrefetched(MakePeer(4)));
+    EXPECT_TRUE(connector.CompleteNext());
+    EXPECT_TRUE(connector.WasPrefetched(MakePeer(4)));
+}
+
+TEST_F(TestCASEReconnectScheduler, TestCancel)
+{
+    FakeConnector connector(mMockClock);
+    RecordingDelegate delegate;
+    CASEReconnectScheduler scheduler;
+
+    ASSERT_EQ(scheduler.Init(&connector, &delegate, 2), CHIP_NO_ERROR);
+    for (NodeId node = 1; node <= 5; node++)
+    {
+        EXPECT_EQ(scheduler.Enqueue(MakePeer(node)), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(scheduler.Start(), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.InFlightCount(), 2u);
+
+    scheduler.Cancel();
+    EXPECT_FALSE(scheduler.IsRunning());
+    EXPECT_EQ(scheduler.InFlightCount(), 0u);
+    EXPECT_EQ(scheduler.PendingCount(), 0u);
+
+    // Results of cancelled setups are not reported.
+    connector.CompleteAll();
+    EXPECT_TRUE(delegate.mConnected.empty());
+    EXPECT_EQ(delegate.mCompleteCount, 0u);
+}
+
+// Simulated time until sessions to a fleet of nodes are established, for
+// different concurrency limits. Discovery and handshake latencies are typical
+// of a Thread network with a few hops. `chip-tool perf reconnect` measures the
+// same against real nodes, through the CASESessionManager connector.
+TEST_F(TestCASEReconnectScheduler, BenchmarkTimeToAllConnected)
+{
+    constexpr NodeId kFleetSize = 64;
+
+    struct Scenario
+    {
+        size_t maxConcurrent;
+        size_t prefetchDepth;
+    };
+    const Scenario scenarios[] = {
+        { 1, 0 }, { 1, 1 }, { 4, 0 }, { 4, 4 }, { 8, 8 }, { CASEReconnectScheduler::kMaxConcurrent, 0 },
+    };
+
+    System::Clock::Milliseconds64 previous = System::Clock::Milliseconds64::max();
+    for (const auto & scenario : scenarios)
+    {
+        FakeConnector connector(mMockClock);
+        RecordingDelegate delegate;
+        CASEReconnectScheduler scheduler;
+
+        connector.mDiscoveryLatency = 250_ms64;
+        connector.mHandshakeLatency = 400_ms64;
+
+        ASSERT_EQ(scheduler.Init(&connector, &delegate, scenario.maxConcurrent, scenario.prefetchDepth), CHIP_NO_ERROR);
+        for (NodeId node = 1; node <= kFleetSize; node++)
+        {
+            EXPECT_EQ(scheduler.Enqueue(MakePeer(node), (node % 4 == 0) ? Priority::kSubscription : Priority::kNormal),
+                      CHIP_NO_ERROR);
+        }
+
+        EXPECT_EQ(scheduler.Start(), CHIP_NO_ERROR);
+        connector.CompleteAll();
+
+        ASSERT_EQ(delegate.mCompleteCount, 1u);
+        EXPECT_EQ(delegate.mStats.connected, kFleetSize);
+        EXPECT_LE(delegate.mStats.maxInFlight, scenario.maxConcurrent);
+        EXPECT_LE(delegate.mStats.elapsed, previous);
+        previous = delegate.mStats.elapsed;
+
+        ChipLogProgress(Test, "%u nodes, concurrency %u, prefetch %u: all connected after %" PRIu64 " ms",
+                        static_cast<unsigned>(kFleetSize), static_cast<unsigned>(scenario.maxConcurrent),
+                        static_cast<unsigned>(scenario.prefetchDepth), static_cast<uint64_t>(delegate.mStats.elapsed.count()));
+    }
+}
+
+} // namespace
@@ -1490,6 +1490,9 @@ static_assert(CHIP_DEVICE_CONFIG_BLE_EXT_ADVERTISING_INTERVAL_MIN <= CHIP_DEVICE
  * CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT
  *
  * When app platform is enabled, max number of endpoints
+ *
+ * Also the max number of dynamic endpoints of bridges. Finding an endpoint does not depend on
+ * this count, so bridges of thousands of devices can raise it at the cost of static memory.
  */
 #ifndef CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT
 #define CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT 0
@@ -0,0 +1,392 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+// AddressResolve.h pulls in the implementation header (which uses the address
+// cache) at its end, so it has to be included first.
+#include <lib/address_resolve/AddressResolve.h>
+
+#include <lib/address_resolve/AddressCache.h>
+
+#include <lib/core/TLV.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/SafeInt.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace AddressResolve {
+namespace {
+
+constexpr TLV::Tag kEntriesTag = TLV::ContextTag(1);
+
+constexpr TLV::Tag kCompressedFabricIdTag  = TLV::ContextTag(1);
+constexpr TLV::Tag kNodeIdTag              = TLV::ContextTag(2);
+constexpr TLV::Tag kIpAddressTag           = TLV::ContextTag(3);
+constexpr TLV::Tag kPortTag                = TLV::ContextTag(4);
+constexpr TLV::Tag kExpiryTag              = TLV::ContextTag(5); // real time, seconds since the Unix epoch
+constexpr TLV::Tag kIdleIntervalTag        = TLV::ContextTag(6);
+constexpr TLV::Tag kActiveIntervalTag      = TLV::ContextTag(7);
+constexpr TLV::Tag kActiveThresholdTag     = TLV::ContextTag(8);
+constexpr TLV::Tag kSupportsTcpTag         = TLV::ContextTag(9);
+constexpr TLV::Tag kIsICDOperatingAsLITTag = TLV::ContextTag(10);
+
+constexpr size_t kIpAddressSize = 16;
+
+constexpr size_t kMaxEntrySize = TLV::EstimateStructOverhead(sizeof(CompressedFabricId), // compressed fabric id
+                                                             sizeof(NodeId),             // node id
+                                                             kIpAddressSize,             // ip address
+                                                             sizeof(uint16_t),           // port
+                                                             sizeof(uint32_t),           // expiry
+                                                             sizeof(uint32_t),           // idle interval
+                                                             sizeof(uint32_t),           // active interval
+                                                             sizeof(uint16_t),           // active threshold
+                                                             sizeof(bool),               // supports tcp
+                                                             sizeof(bool)                // is ICD operating as LIT
+);
+
+constexpr size_t kMaxStorageSize = TLV::EstimateStructOverhead(AddressCache::kCacheSize * kMaxEntrySize);
+
+CHIP_ERROR GetRealTimeSeconds(System::Clock::Seconds32 & seconds)
+{
+    System::Clock::Microseconds64 realTime;
+    ReturnErrorOnFailure(System::SystemClock().GetClock_RealTime(realTime));
+    seconds = std::chrono::duration_cast<System::Clock::Seconds32>(realTime);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+bool AddressCache::Entry::IsRefreshDue(System::Clock::Timestamp now) const
+{
+    if (restored)
+    {
+        // Restored entries are from a previous run, so verify them as soon as they are used.
+        return true;
+    }
+
+    // Refresh once half of the TTL has elapsed, leaving the other half for the refresh to complete.
+    return (now - updateTime) >= (expiryTime - updateTime) / 2;
+}
+
+AddressCache::LookupStatus AddressCache::Lookup(const PeerId & peerId, System::Clock::Timestamp now, ResolveResult & result)
+{
+    VerifyOrReturnValue(kCacheSize > 0, LookupStatus::kMiss);
+
+    Entry * entry = Find(peerId);
+    VerifyOrReturnValue(entry != nullptr, LookupStatus::kMiss);
+
+    if (entry->IsExpired(now))
+    {
+        entry->inUse = false;
+        return LookupStatus::kMiss;
+    }
+
+    if (entry->servedSinceUpdate)
+    {
+        // Keep the entry so that a DNS-SD update can make it usable again.
+        ChipLogProgress(Discovery, "Cached address for " ChipLogFormatPeerId " already used without success, not reusing it",
+                        ChipLogValuePeerId(peerId));
+        return LookupStatus::kMiss;
+    }
+
+    entry->servedSinceUpdate = true;
+    entry->lastUsed          = now;
+    result                   = entry->result;
+
+    if (!entry->refreshRequested && entry->IsRefreshDue(now))
+    {
+        entry->refreshRequested = true;
+        return LookupStatus::kHitRefreshDue;
+    }
+
+    return LookupStatus::kHit;
+}
+
+void AddressCache::Update(const PeerId & peerId, const ResolveResult & result, System::Clock::Seconds32 ttl,
+                          System::Clock::Timestamp now)
+{
+    VerifyOrReturn(kCacheSize > 0);
+
+    if (ttl == System::Clock::kZero)
+    {
+        Remove(peerId);
+        return;
+    }
+
+    Entry * entry = Find(peerId);
+    if (entry == nullptr)
+    {
+        entry           = &AllocateEntry(now);
+        entry->peerId   = peerId;
+        entry->lastUsed = now;
+        entry->inUse    = true;
+    }
+
+    entry->result            = result;
+    entry->updateTime        = now;
+    entry->expiryTime        = now + ttl;
+    entry->servedSinceUpdate = false;
+    entry->refreshRequested  = false;
+    entry->restored          = false;
+}
+
+void AddressCache::MarkServed(const PeerId & peerId)
+{
+    Entry * entry = Find(peerId);
+    if (entry != nullptr)
+    {
+        entry->servedSinceUpdate = true;
+    }
+}
+
+void AddressCache::Remove(const PeerId & peerId)
+{
+    Entry * entry = Find(peerId);
+    if (entry != nullptr)
+    {
+        entry->inUse = false;
+    }
+}
+
+void AddressCache::Clear()
+{
+    for (auto & entry : mEntries)
+    {
+        entry.inUse = false;
+    }
+}
+
+size_t AddressCache::Count(System::Clock::Timestamp now) const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < kCacheSize; i++)
+    {
+        if (mEntries[i].inUse && !mEntries[i].IsExpired(now))
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+AddressCache::Entry * AddressCache::Find(const PeerId & peerId)
+{
+    for (size_t i = 0; i < kCacheSize; i++)
+    {
+        if (mEntries[i].inUse && (mEntries[i].peerId == peerId))
+        {
+            return &mEntries[i];
+        }
+    }
+    return nullptr;
+}
+
+AddressCache::Entry & AddressCache::AllocateEntry(System::Clock::Timestamp now)
+{
+    Entry * candidate = &mEntries[0];
+    for (size_t i = 0; i < kCacheSize; i++)
+    {
+        Entry & entry = mEntries[i];
+        if (!entry.inUse || entry.IsExpired(now))
+        {
+            return entry;
+        }
+        if (entry.lastUsed < candidate->lastUsed)
+        {
+            candidate = &entry;
+        }
+    }
+    return *candidate;
+}
+
+CHIP_ERROR AddressCache::SetStorage(PersistentStorageDelegate * storage, System::Clock::Timestamp now)
+{
+    mStorage = storage;
+    VerifyOrReturnError(mStorage != nullptr && kCacheSize > 0, CHIP_NO_ERROR);
+
+    CHIP_ERROR err = Load(now);
+    if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+    {
+        return CHIP_NO_ERROR;
+    }
+    return err;
+}
+
+CHIP_ERROR AddressCache::Load(System::Clock::Timestamp now)
+{
+    System::Clock::Seconds32 realTimeNow;
+    ReturnErrorOnFailure(GetRealTimeSeconds(realTimeNow));
+
+    Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
+    backingBuffer.Calloc(kMaxStorageSize);
+    VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    uint16_t len = static_cast<uint16_t>(kMaxStorageSize);
+    ReturnErrorOnFailure(
+        mStorage->SyncGetKeyValue(DefaultStorageKeyAllocator::AddressResolveCache().KeyName(), backingBuffer.Get(), len));
+
+    TLV::ScopedBufferTLVReader reader(std::move(backingBuffer), len);
+
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag()));
+    TLV::TLVType outerType;
+    ReturnErrorOnFailure(reader.EnterContainer(outerType));
+
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Array, kEntriesTag));
+    TLV::TLVType arrayType;
+    ReturnErrorOnFailure(reader.EnterContainer(arrayType));
+
+    CHIP_ERROR err;
+    while ((err = reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag())) == CHIP_NO_ERROR)
+    {
+        TLV::TLVType entryType;
+        ReturnErrorOnFailure(reader.EnterContainer(entryType));
+
+        CompressedFabricId compressedFabricId;
+        NodeId nodeId;
+        ReturnErrorOnFailure(reader.Next(kCompressedFabricIdTag));
+        ReturnErrorOnFailure(reader.Get(compressedFabricId));
+        ReturnErrorOnFailure(reader.Next(kNodeIdTag));
+        ReturnErrorOnFailure(reader.Get(nodeId));
+
+        ResolveResult result;
+
+        ByteSpan ipBytes;
+        ReturnErrorOnFailure(reader.Next(kIpAddressTag));
+        ReturnErrorOnFailure(reader.Get(ipBytes));
+        VerifyOrReturnError(ipBytes.size() == kIpAddressSize, CHIP_ERROR_INVALID_TLV_ELEMENT);
+        const uint8_t * ipData = ipBytes.data();
+        Inet::IPAddress ipAddress;
+        Inet::IPAddress::ReadAddress(ipData, ipAddress);
+
+        uint16_t port;
+        ReturnErrorOnFailure(reader.Next(kPortTag));
+        ReturnErrorOnFailure(reader.Get(port));
+        result.address = Transport::PeerAddress::UDP(ipAddress, port);
+
+        uint32_t expirySeconds;
+        ReturnErrorOnFailure(reader.Next(kExpiryTag));
+        ReturnErrorOnFailure(reader.Get(expirySeconds));
+
+        uint32_t idleInterval;
+        uint32_t activeInterval;
+        uint16_t activeThreshold;
+        ReturnErrorOnFailure(reader.Next(kIdleIntervalTag));
+        ReturnErrorOnFailure(reader.Get(idleInterval));
+        ReturnErrorOnFailure(reader.Next(kActiveIntervalTag));
+        ReturnErrorOnFailure(reader.Get(activeInterval));
+        ReturnErrorOnFailure(reader.Next(kActiveThresholdTag));
+        ReturnErrorOnFailure(reader.Get(activeThreshold));
+        result.mrpRemoteConfig = ReliableMessageProtocolConfig(System::Clock::Milliseconds32(idleInterval),
+                                                               System::Clock::Milliseconds32(activeInterval),
+                                                               System::Clock::Milliseconds16(activeThreshold));
+
+        ReturnErrorOnFailure(reader.Next(kSupportsTcpTag));
+        ReturnErrorOnFailure(reader.Get(result.supportsTcp));
+        ReturnErrorOnFailure(reader.Next(kIsICDOperatingAsLITTag));
+        ReturnErrorOnFailure(reader.Get(result.isICDOperatingAsLIT));
+
+        ReturnErrorOnFailure(reader.ExitContainer(entryType));
+
+        const System::Clock::Seconds32 expiry(expirySeconds);
+        if (expiry <= realTimeNow)
+        {
+            continue;
+        }
+
+        const PeerId peerId(compressedFabricId, nodeId);
+        Update(peerId, result, expiry - realTimeNow, now);
+
+        Entry * entry = Find(peerId);
+        if (entry != nullptr)
+        {
+            entry->restored = true;
+        }
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    ReturnErrorOnFailure(reader.ExitContainer(arrayType));
+    return reader.ExitContainer(outerType);
+}
+
+CHIP_ERROR AddressCache::Save(System::Clock::Timestamp now)
+{
+    VerifyOrReturnError(mStorage != nullptr && kCacheSize > 0, CHIP_NO_ERROR);
+
+    System::Clock::Seconds32 realTimeNow;
+    ReturnErrorOnFailure(GetRealTimeSeconds(realTimeNow));
+
+    Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
+    backingBuffer.Calloc(kMaxStorageSize);
+    VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), kMaxStorageSize);
+
+    TLV::TLVType outerType;
+    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, outerType));
+    TLV::TLVType arrayType;
+    ReturnErrorOnFailure(writer.StartContainer(kEntriesTag, TLV::kTLVType_Array, arrayType));
+
+    for (size_t i = 0; i < kCacheSize; i++)
+    {
+        const Entry & entry = mEntries[i];
+        if (!entry.inUse || entry.IsExpired(now) || entry.result.address.GetIPAddress().IsIPv6LinkLocal())
+        {
+            continue;
+        }
+
+        const auto remaining = std::chrono::duration_cast<System::Clock::Seconds32>(entry.expiryTime - now);
+        if (remaining == System::Clock::kZero)
+        {
+            continue;
+        }
+
+        uint8_t ipBytes[kIpAddressSize];
+        uint8_t * ipData = ipBytes;
+        entry.result.address.GetIPAddress().WriteAddress(ipData);
+
+        const ReliableMessageProtocolConfig & mrpConfig = entry.result.mrpRemoteConfig;
+
+        TLV::TLVType entryType;
+        ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, entryType));
+        ReturnErrorOnFailure(writer.Put(kCompressedFabricIdTag, entry.peerId.GetCompressedFabricId()));
+        ReturnErrorOnFailure(writer.Put(kNodeIdTag, entry.peerId.GetNodeId()));
+        ReturnErrorOnFailure(writer.Put(kIpAddressTag, ByteSpan(ipBytes)));
+        ReturnErrorOnFailure(writer.Put(kPortTag, entry.result.address.GetPort()));
+        ReturnErrorOnFailure(writer.Put(kExpiryTag, (realTimeNow + remaining).count()));
+        ReturnErrorOnFailure(writer.Put(kIdleIntervalTag, mrpConfig.mIdleRetransTimeout.count()));
+        ReturnErrorOnFailure(writer.Put(kActiveIntervalTag, mrpConfig.mActiveRetransTimeout.count()));
+        ReturnErrorOnFailure(writer.Put(kActiveThresholdTag, mrpConfig.mActiveThresholdTime.count()));
+        ReturnErrorOnFailure(writer.Put(kSupportsTcpTag, entry.result.supportsTcp));
+        ReturnErrorOnFailure(writer.Put(kIsICDOperatingAsLITTag, entry.result.isICDOperatingAsLIT));
+        ReturnErrorOnFailure(writer.EndContainer(entryType));
+    }
+
+    ReturnErrorOnFailure(writer.EndContainer(arrayType));
+    ReturnErrorOnFailure(writer.EndContainer(outerType));
+
+    const auto len = writer.GetLengthWritten();
+    VerifyOrReturnError(CanCastTo<uint16_t>(len), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    ReturnErrorOnFailure(writer.Finalize(backingBuffer));
+
+    return mStorage->SyncSetKeyValue(DefaultStorageKeyAllocator::AddressResolveCache().KeyName(), backingBuffer.Get(),
+                                     static_cast<uint16_t>(len));
+}
+
+} // namespace AddressResolve
+} // namespace chip
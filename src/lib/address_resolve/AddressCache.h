@@ -0,0 +1,118 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <lib/address_resolve/AddressResolve.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+#include <lib/core/PeerId.h>
+#include <system/SystemClock.h>
+
+namespace chip {
+namespace AddressResolve {
+
+/// Caches resolved operational addresses, keyed by PeerId.
+///
+/// Entries are only considered valid for the DNS-SD TTL of the advertisement
+/// they were obtained from, so that repeated lookups of the same node can be
+/// served without a new DNS-SD resolution while still honoring the expiry
+/// the node itself advertised.
+///
+/// Beyond plain expiry, the cache tracks whether an entry has already been
+/// handed out since it was last updated: a second lookup for the same node
+/// without an intervening DNS-SD update generally means that the cached address
+/// did not work, so such lookups are reported as misses and go to DNS-SD.
+///
+/// Entries may optionally be persisted (e.g. across a controller restart). As
+/// monotonic timestamps do not survive a reboot, expiry is persisted as real
+/// time and entries are only restored when real time is available.
+class AddressCache
+{
+public:
+    static constexpr size_t kCacheSize = CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE;
+
+    enum class LookupStatus
+    {
+        kMiss,          // no usable entry, a DNS-SD lookup is required
+        kHit,           // `result` is valid
+        kHitRefreshDue, // `result` is valid and the entry should be refreshed in the background
+    };
+
+    /// Returns the cached address for `peerId`, if one is available.
+    ///
+    /// A kHitRefreshDue status is only returned once per update, so callers can
+    /// use it as a trigger to start a single background refresh.
+    LookupStatus Lookup(const PeerId & peerId, System::Clock::Timestamp now, ResolveResult & result);
+
+    /// Adds or replaces the address for `peerId`, valid for `ttl` from `now`.
+    ///
+    /// A zero TTL (i.e. a DNS-SD goodbye) removes the entry. When the cache is
+    /// full, expired entries are replaced first, then the least recently used one.
+    void Update(const PeerId & peerId, const ResolveResult & result, System::Clock::Seconds32 ttl, System::Clock::Timestamp now);
+
+    /// Records that the current address for `peerId` was handed out by other
+    /// means than Lookup (e.g. directly from a DNS-SD resolution).
+    void MarkServed(const PeerId & peerId);
+
+    /// Removes any cached address for `peerId`.
+    void Remove(const PeerId & peerId);
+
+    /// Removes all cached addresses.
+    void Clear();
+
+    /// Number of entries that are still within their TTL.
+    size_t Count(System::Clock::Timestamp now) const;
+
+    /// Sets the storage used to persist entries and restores any previously
+    /// saved, unexpired entries from it. A null storage disables persistence.
+    CHIP_ERROR SetStorage(PersistentStorageDelegate * storage, System::Clock::Timestamp now);
+
+    /// Persists all unexpired entries to the configured storage (if any).
+    ///
+    /// Entries using IPv6 link-local addresses are not saved, as the interface
+    /// they were received on may not be valid anymore once restored.
+    CHIP_ERROR Save(System::Clock::Timestamp now);
+
+private:
+    struct Entry
+    {
+        PeerId peerId;
+        ResolveResult result;
+        System::Clock::Timestamp updateTime = System::Clock::kZero;
+        System::Clock::Timestamp expiryTime = System::Clock::kZero;
+        System::Clock::Timestamp lastUsed   = System::Clock::kZero;
+        bool inUse                          = false;
+        bool servedSinceUpdate              = false;
+        bool refreshRequested               = false;
+        bool restored                       = false; // loaded from storage: no update time known
+
+        bool IsExpired(System::Clock::Timestamp now) const { return now >= expiryTime; }
+        bool IsRefreshDue(System::Clock::Timestamp now) const;
+    };
+
+    Entry * Find(const PeerId & peerId);
+    Entry & AllocateEntry(System::Clock::Timestamp now);
+
+    CHIP_ERROR Load(System::Clock::Timestamp now);
+
+    // A size of at least 1 keeps the array valid if caching is disabled (kCacheSize == 0).
+    Entry mEntries[kCacheSize > 0 ? kCacheSize : 1];
+    PersistentStorageDelegate * mStorage = nullptr;
+};
+
+} // namespace AddressResolve
+} // namespace chip
@@ -34,6 +34,7 @@ void NodeLookupHandle::ResetForLookup(System::Clock::Timestamp now, const NodeLo
     mRequestStartTime = now;
     mRequest          = request;
     mResults          = NodeLookupResults();
+    mFromCache        = false;
 }
 
 void NodeLookupHandle::LookupResult(const ResolveResult & result)
@@ -58,10 +59,25 @@ void NodeLookupHandle::LookupResult(const ResolveResult & result)
 #endif
 }
 
+void NodeLookupHandle::UseCachedResult(const ResolveResult & result)
+{
+    MATTER_LOG_NODE_DISCOVERED(Tracing::DiscoveryInfoType::kIntermediateResult, &GetRequest().GetPeerId(), &result);
+
+    auto score = Dnssd::IPAddressSorter::ScoreIpAddress(result.address.GetIPAddress(), result.address.GetInterface());
+    mResults.UpdateResults(result, score);
+    mFromCache = true;
+}
+
 System::Clock::Timeout NodeLookupHandle::NextEventTimeout(System::Clock::Timestamp now)
 {
     const System::Clock::Timestamp elapsed = now - mRequestStartTime;
 
+    if (mFromCache && HasLookupResult())
+    {
+        // Cached results do not need to wait for any additional DNS-SD data.
+        return System::Clock::Timeout::zero();
+    }
+
     if (elapsed < mRequest.GetMinLookupTime())
     {
         return mRequest.GetMinLookupTime() - elapsed;
@@ -100,6 +116,11 @@ NodeLookupAction NodeLookupHandle::NextAction(System::Clock::Timestamp now)
     ChipLogProgress(Discovery, "Checking node lookup status for " ChipLogFormatPeerId " after %lu ms",
                     ChipLogValuePeerId(mRequest.GetPeerId()), static_cast<unsigned long>(elapsed.count()));
 
+    if (mFromCache && HasLookupResult())
+    {
+        return NodeLookupAction::Success(TakeLookupResult());
+    }
+
     // We are still within the minimal search time. Wait for more results.
     if (elapsed < mRequest.GetMinLookupTime())
     {
@@ -186,8 +207,33 @@ CHIP_ERROR Resolver::LookupNode(const NodeLookupRequest & request, Impl::NodeLoo
 
     VerifyOrReturnError(mSystemLayer != nullptr, CHIP_ERROR_INCORRECT_STATE);
 
-    handle.ResetForLookup(mTimeSource.GetMonotonicTimestamp(), request);
+    const System::Clock::Timestamp now = mTimeSource.GetMonotonicTimestamp();
+    handle.ResetForLookup(now, request);
     auto & peerId = request.GetPeerId();
+
+    ResolveResult cachedResult;
+    const AddressCache::LookupStatus cacheStatus = mAddressCache.Lookup(peerId, now, cachedResult);
+    if (cacheStatus != AddressCache::LookupStatus::kMiss)
+    {
+        if (cacheStatus == AddressCache::LookupStatus::kHitRefreshDue)
+        {
+            // The result of the refresh is only used to update the cache (see
+            // OnOperationalNodeResolved), so a failure here does not affect this lookup.
+            CHIP_ERROR err = Dnssd::Resolver::Instance().ResolveNodeId(peerId);
+            if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(Discovery, "Failed to refresh cached address for " ChipLogFormatPeerId ": %" CHIP_ERROR_FORMAT,
+                             ChipLogValuePeerId(peerId), err.Format());
+            }
+        }
+
+        handle.UseCachedResult(cachedResult);
+        mActiveLookups.PushBack(&handle);
+        ReArmTimer();
+        ChipLogProgress(Discovery, "Lookup for " ChipLogFormatPeerId " served from address cache", ChipLogValuePeerId(peerId));
+        return CHIP_NO_ERROR;
+    }
+
     ReturnErrorOnFailure(Dnssd::Resolver::Instance().ResolveNodeId(peerId));
     mActiveLookups.PushBack(&handle);
     ReArmTimer();
@@ -214,7 +260,10 @@ CHIP_ERROR Resolver::CancelLookup(Impl::NodeLookupHandle & handle, FailureCallba
 {
     VerifyOrReturnError(handle.IsActive(), CHIP_ERROR_INVALID_ARGUMENT);
     mActiveLookups.Remove(&handle);
-    Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(handle.GetRequest().GetPeerId());
+    if (!handle.IsFromCache())
+    {
+        Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(handle.GetRequest().GetPeerId());
+    }
 
     // Adjust any timing updates.
     ReArmTimer();
@@ -251,12 +300,16 @@ void Resolver::Shutdown()
 
         const PeerId peerId     = current->GetRequest().GetPeerId();
         NodeListener * listener = current->GetListener();
+        const bool fromCache    = current->IsFromCache();
 
         mActiveLookups.Erase(current);
 
         MATTER_LOG_NODE_DISCOVERY_FAILED(&peerId, CHIP_ERROR_SHUT_DOWN);
 
-        Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
+        if (!fromCache)
+        {
+            Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
+        }
         // Failure callback only called after iterator was cleared:
         // This allows failure handlers to deallocate structures that may
         // contain the active lookup data as a member (intrusive lists members)
@@ -267,12 +320,32 @@ void Resolver::Shutdown()
     // internal list of active lookups is empty at this point.
     ReArmTimer();
 
+    CHIP_ERROR err = mAddressCache.Save(mTimeSource.GetMonotonicTimestamp());
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Discovery, "Failed to save address cache: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+
     mSystemLayer = nullptr;
     Dnssd::Resolver::Instance().SetOperationalDelegate(nullptr);
 }
 
 void Resolver::OnOperationalNodeResolved(const Dnssd::ResolvedNodeData & nodeData)
 {
+    ResolveResult baseResult;
+
+    baseResult.address.SetPort(nodeData.resolutionData.port);
+    baseResult.address.SetInterface(nodeData.resolutionData.interfaceId);
+    baseResult.mrpRemoteConfig = nodeData.resolutionData.GetRemoteMRPConfig();
+    baseResult.supportsTcp     = nodeData.resolutionData.supportsTcp;
+
+    if (nodeData.resolutionData.isICDOperatingAsLIT.has_value())
+    {
+        baseResult.isICDOperatingAsLIT = *(nodeData.resolutionData.isICDOperatingAsLIT);
+    }
+
+    UpdateAddressCache(nodeData, baseResult);
+
     auto it = mActiveLookups.begin();
     while (it != mActiveLookups.end())
     {
@@ -283,17 +356,7 @@ void Resolver::OnOperationalNodeResolved(const Dnssd::ResolvedNodeData & nodeDat
             continue;
         }
 
-        ResolveResult result;
-
-        result.address.SetPort(nodeData.resolutionData.port);
-        result.address.SetInterface(nodeData.resolutionData.interfaceId);
-        result.mrpRemoteConfig = nodeData.resolutionData.GetRemoteMRPConfig();
-        result.supportsTcp     = nodeData.resolutionData.supportsTcp;
-
-        if (nodeData.resolutionData.isICDOperatingAsLIT.has_value())
-        {
-            result.isICDOperatingAsLIT = *(nodeData.resolutionData.isICDOperatingAsLIT);
-        }
+        ResolveResult result = baseResult;
 
         for (size_t i = 0; i < nodeData.resolutionData.numIPs; i++)
         {
@@ -314,6 +377,48 @@ void Resolver::OnOperationalNodeResolved(const Dnssd::ResolvedNodeData & nodeDat
     ReArmTimer();
 }
 
+void Resolver::UpdateAddressCache(const Dnssd::ResolvedNodeData & nodeData, const ResolveResult & baseResult)
+{
+    const PeerId & peerId = nodeData.operationalData.peerId;
+
+    if (nodeData.operationalData.hasZeroTTL)
+    {
+        // The node is going away: its address should not be used anymore.
+        mAddressCache.Remove(peerId);
+        return;
+    }
+
+    NodeLookupResults best;
+    ResolveResult result = baseResult;
+    for (size_t i = 0; i < nodeData.resolutionData.numIPs; i++)
+    {
+#if !INET_CONFIG_ENABLE_IPV4
+        if (!nodeData.resolutionData.ipAddress[i].IsIPv6())
+        {
+            continue;
+        }
+#endif
+        result.address.SetIPAddress(nodeData.resolutionData.ipAddress[i]);
+        best.UpdateResults(result,
+                           Dnssd::IPAddressSorter::ScoreIpAddress(result.address.GetIPAddress(), result.address.GetInterface()));
+    }
+
+    VerifyOrReturn(best.HasValidResult());
+    mAddressCache.Update(peerId, best.ConsumeResult(), System::Clock::Seconds32(nodeData.operationalData.ttlSeconds),
+                         mTimeSource.GetMonotonicTimestamp());
+
+    for (auto & activeLookup : mActiveLookups)
+    {
+        if (!activeLookup.IsFromCache() && (activeLookup.GetRequest().GetPeerId() == peerId))
+        {
+            // This address is about to be handed to an active lookup already, so a
+            // repeated lookup should not get it again from the cache.
+            mAddressCache.MarkServed(peerId);
+            break;
+        }
+    }
+}
+
 void Resolver::HandleAction(IntrusiveList<NodeLookupHandle>::Iterator & current)
 {
     const NodeLookupAction action = current->NextAction(mTimeSource.GetMonotonicTimestamp());
@@ -327,9 +432,13 @@ void Resolver::HandleAction(IntrusiveList<NodeLookupHandle>::Iterator & current)
     // final result, handle either success or failure
     const PeerId peerId     = current->GetRequest().GetPeerId();
     NodeListener * listener = current->GetListener();
+    const bool fromCache    = current->IsFromCache();
     mActiveLookups.Erase(current);
 
-    Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
+    if (!fromCache)
+    {
+        Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
+    }
 
     // ensure action is taken AFTER the current current lookup is marked complete
     // This allows failure handlers to deallocate structures that may
@@ -371,8 +480,10 @@ void Resolver::OnOperationalNodeResolutionFailed(const PeerId & peerId, CHIP_ERR
     {
         auto current = it;
         it++;
-        if (current->GetRequest().GetPeerId() != peerId)
+        if ((current->GetRequest().GetPeerId() != peerId) || current->IsFromCache())
         {
+            // Lookups served from the cache are not waiting on DNS-SD (any resolution
+            // for them is a background refresh), so they complete regardless.
             continue;
         }
 
@@ -423,11 +534,15 @@ void Resolver::ReArmTimer()
         {
             const PeerId peerId     = it->GetRequest().GetPeerId();
             NodeListener * listener = it->GetListener();
+            const bool fromCache    = it->IsFromCache();
 
             mActiveLookups.Erase(it);
             it = mActiveLookups.begin();
 
-            Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
+            if (!fromCache)
+            {
+                Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
+            }
             // Callback only called after active lookup is cleared
             // This allows failure handlers to deallocate structures that may
             // contain the active lookup data as a member (intrusive lists members)
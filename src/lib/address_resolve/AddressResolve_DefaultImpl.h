@@ -16,6 +16,7 @@
  */
 #pragma once
 
+#include <lib/address_resolve/AddressCache.h>
 #include <lib/address_resolve/AddressResolve.h>
 #include <lib/dnssd/IPAddressSorter.h>
 #include <lib/dnssd/Resolver.h>
@@ -136,6 +137,14 @@ public:
     /// Mark that a specific IP address has been found
     void LookupResult(const ResolveResult & result);
 
+    /// Complete the lookup with an address obtained from the address cache,
+    /// without waiting for the minimum lookup time.
+    void UseCachedResult(const ResolveResult & result);
+
+    /// Was the lookup served from the address cache (i.e. no DNS-SD resolution
+    /// was started for it)?
+    bool IsFromCache() const { return mFromCache; }
+
     /// Called after timeouts or after a series of IP addresses have been
     /// marked as found.
     ///
@@ -161,6 +170,7 @@ private:
     NodeLookupResults mResults;
     NodeLookupRequest mRequest; // active request to process
     System::Clock::Timestamp mRequestStartTime;
+    bool mFromCache = false;
 };
 
 class Resolver : public ::chip::AddressResolve::Resolver, public Dnssd::OperationalResolveDelegate
@@ -181,6 +191,13 @@ public:
     void OnOperationalNodeResolved(const Dnssd::ResolvedNodeData & nodeData) override;
     void OnOperationalNodeResolutionFailed(const PeerId & peerId, CHIP_ERROR error) override;
 
+    /// Cache of previously resolved addresses.
+    ///
+    /// The cache is updated from every operational DNS-SD resolution reported,
+    /// including the ones that no active lookup is waiting for, and can be given
+    /// storage to persist entries across restarts (saved on Shutdown).
+    AddressCache & GetAddressCache() { return mAddressCache; }
+
 private:
     static void OnResolveTimer(System::Layer * layer, void * context) { static_cast<Resolver *>(context)->HandleTimer(); }
 
@@ -200,9 +217,13 @@ private:
     /// be used after calling this method.
     void HandleAction(IntrusiveList<NodeLookupHandle>::Iterator & current);
 
+    /// Records the best address of a resolved node in the address cache.
+    void UpdateAddressCache(const Dnssd::ResolvedNodeData & nodeData, const ResolveResult & baseResult);
+
     System::Layer * mSystemLayer = nullptr;
     Time::TimeSource<Time::Source::kSystem> mTimeSource;
     IntrusiveList<NodeLookupHandle> mActiveLookups;
+    AddressCache mAddressCache;
 };
 
 } // namespace Impl
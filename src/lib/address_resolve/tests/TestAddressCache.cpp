@@ -0,0 +1,205 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <lib/address_resolve/AddressResolve.h>
+
+#include <lib/address_resolve/AddressCache.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <system/SystemClock.h>
+
+using namespace chip;
+using namespace chip::AddressResolve;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+using LookupStatus = AddressCache::LookupStatus;
+
+constexpr CompressedFabricId kCompressedFabricId = 0x1122334455667788;
+
+PeerId MakePeerId(NodeId nodeId)
+{
+    return PeerId(kCompressedFabricId, nodeId);
+}
+
+ResolveResult MakeResult(const char * address, uint16_t port = CHIP_PORT)
+{
+    Inet::IPAddress ipAddress;
+    if (!Inet::IPAddress::FromString(address, ipAddress))
+    {
+        ChipLogError(NotSpecified, "!!!!!!!! IP Parse failure");
+    }
+
+    ResolveResult result;
+    result.address = Transport::PeerAddress::UDP(ipAddress, port);
+    return result;
+}
+
+System::Clock::Timestamp Seconds(uint64_t seconds)
+{
+    return System::Clock::Timestamp(seconds * 1000);
+}
+
+class TestAddressCache : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+};
+
+TEST_F(TestAddressCache, TestLookupAndServeOnce)
+{
+    AddressCache cache;
+    ResolveResult result;
+
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), Seconds(0), result), LookupStatus::kMiss);
+
+    cache.Update(MakePeerId(1), MakeResult("fdff:aabb:ccdd:1::4", 1234), 120_s32, Seconds(0));
+    EXPECT_EQ(cache.Count(Seconds(0)), 1u);
+
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), Seconds(1), result), LookupStatus::kHit);
+    EXPECT_EQ(result.address, MakeResult("fdff:aabb:ccdd:1::4", 1234).address);
+
+    // Unknown nodes are not affected
+    EXPECT_EQ(cache.Lookup(MakePeerId(2), Seconds(1), result), LookupStatus::kMiss);
+
+    // A repeated lookup without a new DNS-SD update is not served from cache
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), Seconds(2), result), LookupStatus::kMiss);
+
+    // until an update is received
+    cache.Update(MakePeerId(1), MakeResult("2001::aabb:ccdd:2233:4455"), 120_s32, Seconds(3));
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), Seconds(4), result), LookupStatus::kHit);
+    EXPECT_EQ(result.address, MakeResult("2001::aabb:ccdd:2233:4455").address);
+
+    // Results handed out by other means also count
+    cache.Update(MakePeerId(1), MakeResult("2001::aabb:ccdd:2233:4455"), 120_s32, Seconds(5));
+    cache.MarkServed(MakePeerId(1));
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), Seconds(6), result), LookupStatus::kMiss);
+}
+
+TEST_F(TestAddressCache, TestExpiry)
+{
+    AddressCache cache;
+    ResolveResult result;
+
+    cache.Update(MakePeerId(1), MakeResult("fdff:aabb:ccdd:1::4"), 10_s32, Seconds(100));
+    EXPECT_EQ(cache.Count(Seconds(109)), 1u);
+    EXPECT_EQ(cache.Count(Seconds(110)), 0u);
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), Seconds(110), result), LookupStatus::kMiss);
+
+    // Zero TTL (goodbye) removes entries
+    cache.Update(MakePeerId(2), MakeResult("fdff:aabb:ccdd:1::4"), 10_s32, Seconds(100));
+    cache.Update(MakePeerId(2), MakeResult("fdff:aabb:ccdd:1::4"), 0_s32, Seconds(101));
+    EXPECT_EQ(cache.Lookup(MakePeerId(2), Seconds(101), result), LookupStatus::kMiss);
+    EXPECT_EQ(cache.Count(Seconds(101)), 0u);
+}
+
+TEST_F(TestAddressCache, TestRefreshDue)
+{
+    AddressCache cache;
+    ResolveResult result;
+
+    cache.Update(MakePeerId(1), MakeResult("fdff:aabb:ccdd:1::4"), 120_s32, Seconds(0));
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), Seconds(59), result), LookupStatus::kHit);
+
+    cache.Update(MakePeerId(1), MakeResult("fdff:aabb:ccdd:1::4"), 120_s32, Seconds(60));
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), Seconds(120), result), LookupStatus::kHitRefreshDue);
+}
+
+TEST_F(TestAddressCache, TestEviction)
+{
+    if (AddressCache::kCacheSize == 0)
+    {
+        GTEST_SKIP() << "Address cache disabled";
+    }
+
+    AddressCache cache;
+    ResolveResult result;
+
+    for (NodeId node = 1; node <= AddressCache::kCacheSize; node++)
+    {
+        cache.Update(MakePeerId(node), MakeResult("fdff:aabb:ccdd:1::4"), 120_s32, Seconds(node));
+    }
+    EXPECT_EQ(cache.Count(Seconds(20)), AddressCache::kCacheSize);
+
+    // Use node 1, so that node 2 becomes the least recently used entry.
+    EXPECT_EQ(cache.Lookup(MakePeerId(1), Seconds(20), result), LookupStatus::kHit);
+
+    const NodeId newNode = AddressCache::kCacheSize + 1;
+    cache.Update(MakePeerId(newNode), MakeResult("fdff:aabb:ccdd:1::4"), 120_s32, Seconds(21));
+    EXPECT_EQ(cache.Count(Seconds(21)), AddressCache::kCacheSize);
+
+    EXPECT_EQ(cache.Lookup(MakePeerId(2), Seconds(22), result), LookupStatus::kMiss);
+    EXPECT_EQ(cache.Lookup(MakePeerId(newNode), Seconds(22), result), LookupStatus::kHit);
+
+    cache.Clear();
+    EXPECT_EQ(cache.Count(Seconds(22)), 0u);
+}
+
+TEST_F(TestAddressCache, TestPersistence)
+{
+    if (AddressCache::kCacheSize < 3)
+    {
+        GTEST_SKIP() << "Address cache too small";
+    }
+
+    System::Clock::Internal::MockClock mockClock;
+    System::Clock::ClockBase * realClock = &System::SystemClock();
+    System::Clock::Internal::SetSystemClockForTesting(&mockClock);
+    mockClock.SetClock_RealTime(System::Clock::Microseconds64(1700000000ull * 1000000ull));
+
+    TestPersistentStorageDelegate storage;
+    {
+        AddressCache cache;
+        EXPECT_EQ(cache.SetStorage(&storage, Seconds(0)), CHIP_NO_ERROR);
+
+        ResolveResult result = MakeResult("2001::aabb:ccdd:2233:4455", 1234);
+        result.supportsTcp   = true;
+        cache.Update(MakePeerId(1), result, 120_s32, Seconds(0));
+        cache.Update(MakePeerId(2), MakeResult("fdff:aabb:ccdd:1::4"), 30_s32, Seconds(0));
+        // link-local addresses are not persisted
+        cache.Update(MakePeerId(3), MakeResult("fe80::aabb:ccdd:2233:4455"), 120_s32, Seconds(0));
+
+        EXPECT_EQ(cache.Save(Seconds(10)), CHIP_NO_ERROR);
+    }
+
+    // Restart after a minute: the entry for node 2 has expired meanwhile.
+    mockClock.AdvanceRealTime(System::Clock::Milliseconds64(60 * 1000));
+    {
+        AddressCache cache;
+        ResolveResult result;
+        EXPECT_EQ(cache.SetStorage(&storage, Seconds(1)), CHIP_NO_ERROR);
+        EXPECT_EQ(cache.Count(Seconds(1)), 1u);
+
+        // Restored entries are served but need a refresh.
+        EXPECT_EQ(cache.Lookup(MakePeerId(1), Seconds(1), result), LookupStatus::kHitRefreshDue);
+        EXPECT_EQ(result.address, MakeResult("2001::aabb:ccdd:2233:4455", 1234).address);
+        EXPECT_TRUE(result.supportsTcp);
+
+        EXPECT_EQ(cache.Lookup(MakePeerId(2), Seconds(1), result), LookupStatus::kMiss);
+        EXPECT_EQ(cache.Lookup(MakePeerId(3), Seconds(1), result), LookupStatus::kMiss);
+
+        // Remaining TTL is kept: 110s were left when saved, 60s passed since.
+        EXPECT_EQ(cache.Count(Seconds(50)), 1u);
+        EXPECT_EQ(cache.Count(Seconds(51)), 0u);
+    }
+
+    System::Clock::Internal::SetSystemClockForTesting(realClock);
+}
+
+} // namespace
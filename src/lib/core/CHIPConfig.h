@@ -931,6 +931,18 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_SERVER_MAX_NUM_DIRTY_SET 8
 #endif
 
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_PATH_EXPANSION_CACHE_SIZE
+ *
+ * @brief The number of distinct wildcard attribute paths whose expansion into concrete paths is cached, and shared by all the
+ *        reads and subscriptions that use them.
+ *
+ * The expansions are allocated from the heap, with one ConcreteAttributePath per concrete path. 0 disables the cache.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_PATH_EXPANSION_CACHE_SIZE
+#define CHIP_CONFIG_ATTRIBUTE_PATH_EXPANSION_CACHE_SIZE 0
+#endif
+
 /**
  * @def CHIP_IM_MAX_NUM_WRITE_HANDLER
  *
@@ -1216,6 +1228,21 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE (3 * CHIP_CONFIG_MAX_FABRICS)
 #endif
 
+/**
+ * @def CHIP_CONFIG_CASE_SESSION_RESUME_RAM_CACHE_SIZE
+ *
+ * @brief
+ *   Number of session resumption records that DefaultSessionResumptionStorage
+ *   additionally keeps in RAM, so that resuming a recently used session does
+ *   not require reading persistent storage. Records are written through to
+ *   storage; the least recently used one is dropped from RAM when full.
+ *
+ *   Set to 0 to disable the in-memory cache.
+ */
+#ifndef CHIP_CONFIG_CASE_SESSION_RESUME_RAM_CACHE_SIZE
+#define CHIP_CONFIG_CASE_SESSION_RESUME_RAM_CACHE_SIZE 4
+#endif
+
 /**
  * @def CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD
  *
@@ -1370,6 +1397,20 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS 1
 #endif // CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS
 
+/**
+ * @def CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE
+ *
+ * @brief Determines the maximum number of resolved operational addresses that the
+ *        default address resolver keeps cached (for at most the DNS-SD TTL of the
+ *        advertisement they were received from).
+ *
+ *        Cached addresses allow repeated lookups of the same node to complete
+ *        without waiting for a new DNS-SD resolution. Set to 0 to disable caching.
+ */
+#ifndef CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE
+#define CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE 8
+#endif // CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE
+
 /*
  * @def CHIP_CONFIG_NETWORK_COMMISSIONING_DEBUG_TEXT_BUFFER_SIZE
  *
@@ -1427,6 +1468,30 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_SUBSCRIPTION_RESUMPTION_STORAGE_CONCURRENT_ITERATORS 2
 #endif
 
+/**
+ * @def CHIP_CONFIG_COMPACT_SUBSCRIPTION_RESUMPTION_STORAGE
+ *
+ * @brief Controls whether the server persists its subscriptions with CompactSubscriptionResumptionStorage, which keeps all
+ *        the subscriptions in a single record, instead of SimpleSubscriptionResumptionStorage.
+ *
+ * Subscriptions persisted by SimpleSubscriptionResumptionStorage are moved into the record when the storage is initialized.
+ */
+#ifndef CHIP_CONFIG_COMPACT_SUBSCRIPTION_RESUMPTION_STORAGE
+#define CHIP_CONFIG_COMPACT_SUBSCRIPTION_RESUMPTION_STORAGE 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_MAX_CONCURRENT_SUBSCRIPTION_RESUMPTIONS
+ *
+ * @brief Maximum number of persisted subscriptions that the server resumes at the same time.
+ *
+ * Each resumption establishes a CASE session with the subscriber, so this bounds the CASE sessions that the server sets up
+ * at once when it resumes its subscriptions, e.g. after a reboot.
+ */
+#ifndef CHIP_CONFIG_MAX_CONCURRENT_SUBSCRIPTION_RESUMPTIONS
+#define CHIP_CONFIG_MAX_CONCURRENT_SUBSCRIPTION_RESUMPTIONS 4
+#endif
+
 /**
  * @brief Maximum length of Scene names
  */
@@ -1758,6 +1823,31 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_BDX_LOG_TRANSFERS 5
 #endif // CHIP_CONFIG_MAX_BDX_LOG_TRANSFERS
 
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS
+ *
+ * @brief
+ *   Delay, in milliseconds, for which the server keeps the writes of persisted
+ *   attributes in RAM before writing them all to storage at once. Each attribute
+ *   is written at most once per window, with its last value.
+ *
+ *   Set to 0 to write persisted attributes to storage as soon as they change.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS
+#define CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS 0
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_WINDOW_MS
+
+/**
+ * @def CHIP_CONFIG_MAX_PENDING_ATTRIBUTE_WRITES
+ *
+ * @brief
+ *   Maximum number of distinct attributes whose writes WriteBehindAttributePersistenceProvider
+ *   keeps in RAM. Writing one more attribute flushes the pending writes first.
+ */
+#ifndef CHIP_CONFIG_MAX_PENDING_ATTRIBUTE_WRITES
+#define CHIP_CONFIG_MAX_PENDING_ATTRIBUTE_WRITES 16
+#endif // CHIP_CONFIG_MAX_PENDING_ATTRIBUTE_WRITES
+
 /**
  * @}
  */
@@ -747,12 +747,120 @@ CHIP_ERROR TLVReader::SkipToEndOfContainer()
         if (err != CHIP_NO_ERROR)
             return err;
 
+        SkipBufferedElements(nestLevel, outerContainerType);
+
         err = ReadElement();
         if (err != CHIP_NO_ERROR)
             return err;
     }
 }
 
+/**
+ * Fast path of SkipToEndOfContainer(): skip over the elements that lie entirely within the
+ * current input buffer by scanning their heads in place, without decoding their tags or
+ * updating the element state of the reader for each of them.
+ *
+ * Scanning stops before the end of the container being skipped, and before any element that
+ * is not entirely within the buffer or that ReadElement() would reject, so that the regular
+ * path reads those and reports the same errors.
+ */
+void TLVReader::SkipBufferedElements(uint32_t & nestLevel, TLVType outerContainerType)
+{
+    const uint8_t * p     = mReadPoint;
+    TLVType containerType = mContainerType;
+
+    while (p < mBufEnd)
+    {
+        const uint8_t controlByte     = *p;
+        const TLVElementType elemType = static_cast<TLVElementType>(controlByte & kTLVTypeMask);
+        if (!IsValidTLVType(elemType) || !IsValidBufferedElement(controlByte, containerType))
+            break;
+
+        const uint8_t tagBytes      = sTagSizes[(controlByte & kTLVTagControlMask) >> kTLVTagControlShift];
+        const uint8_t valOrLenBytes = TLVFieldSizeToBytes(GetTLVFieldSize(elemType));
+        const size_t remainingLen   = static_cast<size_t>(mBufEnd - p);
+        size_t elemLen              = static_cast<size_t>(1 + tagBytes + valOrLenBytes);
+        if (elemLen > remainingLen)
+            break;
+
+        if (TLVTypeHasLength(elemType))
+        {
+            uint64_t dataLen     = 0;
+            const uint8_t * lenP = p + 1 + tagBytes;
+            for (uint8_t i = 0; i < valOrLenBytes; i++)
+            {
+                dataLen |= static_cast<uint64_t>(lenP[i]) << (8 * i);
+            }
+            if (dataLen > remainingLen - elemLen)
+                break;
+            elemLen += static_cast<size_t>(dataLen);
+        }
+
+        if (elemType == TLVElementType::EndOfContainer)
+        {
+            if (nestLevel == 0)
+                break;
+
+            nestLevel--;
+            containerType = (nestLevel == 0) ? outerContainerType : kTLVType_UnknownContainer;
+        }
+        else if (TLVTypeIsContainer(elemType))
+        {
+            nestLevel++;
+            containerType = static_cast<TLVType>(elemType);
+        }
+
+        p += elemLen;
+    }
+
+    mLenRead += static_cast<uint32_t>(p - mReadPoint);
+    mReadPoint     = p;
+    mContainerType = containerType;
+}
+
+/**
+ * Whether VerifyElement() would accept an element with the given control byte in a container of
+ * the given type, for the tags that can be checked from the control byte alone.
+ *
+ * Fully-qualified tags are never accepted, as they may encode special (context or anonymous) tags.
+ */
+bool TLVReader::IsValidBufferedElement(uint8_t controlByte, TLVType containerType) const
+{
+    const TLVTagControl tagControl = static_cast<TLVTagControl>(controlByte & kTLVTagControlMask);
+
+    switch (tagControl)
+    {
+    case TLVTagControl::FullyQualified_6Bytes:
+    case TLVTagControl::FullyQualified_8Bytes:
+        return false;
+    case TLVTagControl::ImplicitProfile_2Bytes:
+    case TLVTagControl::ImplicitProfile_4Bytes:
+        if (ImplicitProfileId == kProfileIdNotSpecified)
+            return false;
+        break;
+    default:
+        break;
+    }
+
+    if (static_cast<TLVElementType>(controlByte & kTLVTypeMask) == TLVElementType::EndOfContainer)
+        return containerType != kTLVType_NotSpecified && tagControl == TLVTagControl::Anonymous;
+
+    switch (containerType)
+    {
+    case kTLVType_NotSpecified:
+        return tagControl != TLVTagControl::ContextSpecific;
+    case kTLVType_Structure:
+        return tagControl != TLVTagControl::Anonymous;
+    case kTLVType_Array:
+        return tagControl == TLVTagControl::Anonymous;
+    case kTLVType_UnknownContainer:
+    case kTLVType_List:
+        return true;
+    default:
+        return false;
+    }
+}
+
 CHIP_ERROR TLVReader::ReadElement()
 {
     CHIP_ERROR err;
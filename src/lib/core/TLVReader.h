@@ -974,6 +974,8 @@ protected:
     void ClearElementState();
     CHIP_ERROR SkipData();
     CHIP_ERROR SkipToEndOfContainer();
+    void SkipBufferedElements(uint32_t & nestLevel, TLVType outerContainerType);
+    bool IsValidBufferedElement(uint8_t controlByte, TLVType containerType) const;
     CHIP_ERROR VerifyElement();
     Tag ReadTag(TLVTagControl tagControl, const uint8_t *& p) const;
     CHIP_ERROR EnsureData(CHIP_ERROR noDataErr);
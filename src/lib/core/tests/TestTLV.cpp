@@ -39,10 +39,13 @@
 #include <lib/support/Span.h>
 
 #include <lib/support/UnitTestUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
 #include <lib/support/logging/Constants.h>
 
+#include <system/SystemClock.h>
 #include <system/TLVPacketBufferBackingStore.h>
 
+#include <algorithm>
 #include <stdlib.h>
 #include <string.h>
 
@@ -2970,6 +2973,186 @@ TEST_F(TestTLV, CheckTLVSkipCircular)
     EXPECT_EQ(err, CHIP_NO_ERROR);
 }
 
+/**
+ * Backing store handing out an encoding in chunks of a fixed size, so that elements straddle
+ * buffers and skipping them goes through the element by element path of the reader.
+ */
+class ChunkedBackingStore : public TLVBackingStore
+{
+public:
+    ChunkedBackingStore(const uint8_t * data, uint32_t dataLen, uint32_t chunkLen) :
+        mData(data), mDataLen(dataLen), mChunkLen(chunkLen)
+    {}
+
+    CHIP_ERROR OnInit(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        mOffset = 0;
+        return GetNextBuffer(reader, bufStart, bufLen);
+    }
+
+    CHIP_ERROR GetNextBuffer(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        bufStart = mData + mOffset;
+        bufLen   = std::min(mChunkLen, mDataLen - mOffset);
+        mOffset += bufLen;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnInit(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override { return CHIP_ERROR_NOT_IMPLEMENTED; }
+    CHIP_ERROR GetNewBuffer(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+    CHIP_ERROR FinalizeBuffer(TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+private:
+    const uint8_t * mData;
+    uint32_t mDataLen;
+    uint32_t mChunkLen;
+    uint32_t mOffset = 0;
+};
+
+CHIP_ERROR NextAndSkip(TLVReader & reader)
+{
+    ReturnErrorOnFailure(reader.Next());
+    return reader.Skip();
+}
+
+void CheckSkipMatchesChunkedSkip(const uint8_t * encoding, uint32_t encodingLen, uint32_t implicitProfileId)
+{
+    TLVReader reference;
+    reference.Init(encoding, encodingLen);
+    reference.ImplicitProfileId   = implicitProfileId;
+    const CHIP_ERROR referenceErr = NextAndSkip(reference);
+    const uint32_t referenceLen   = reference.GetLengthRead();
+    const CHIP_ERROR nextErr      = reference.Next();
+
+    for (uint32_t chunkLen : { 1, 2, 3, 5, 8, 13 })
+    {
+        ChunkedBackingStore store(encoding, encodingLen, chunkLen);
+        TLVReader reader;
+        EXPECT_EQ(reader.Init(store, encodingLen), CHIP_NO_ERROR);
+        reader.ImplicitProfileId = implicitProfileId;
+
+        EXPECT_EQ(NextAndSkip(reader), referenceErr);
+        EXPECT_EQ(reader.GetLengthRead(), referenceLen);
+        EXPECT_EQ(reader.Next(), nextErr);
+        if (nextErr == CHIP_NO_ERROR)
+        {
+            EXPECT_EQ(reader.GetType(), reference.GetType());
+            EXPECT_EQ(reader.GetTag(), reference.GetTag());
+        }
+    }
+}
+
+void WriteLargeEncoding(TLVWriter & writer, uint32_t itemCount)
+{
+    TLVType outerType, listType, itemType;
+
+    EXPECT_EQ(writer.StartContainer(AnonymousTag(), kTLVType_Structure, outerType), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.StartContainer(ContextTag(1), kTLVType_Array, listType), CHIP_NO_ERROR);
+    for (uint32_t i = 0; i < itemCount; i++)
+    {
+        TLVType nestedType;
+        EXPECT_EQ(writer.StartContainer(AnonymousTag(), kTLVType_Structure, itemType), CHIP_NO_ERROR);
+        EXPECT_EQ(writer.Put(ContextTag(0), i), CHIP_NO_ERROR);
+        EXPECT_EQ(writer.Put(ContextTag(1), static_cast<int64_t>(i) * -100000), CHIP_NO_ERROR);
+        EXPECT_EQ(writer.PutString(ContextTag(2), "Living room ceiling light"), CHIP_NO_ERROR);
+        EXPECT_EQ(writer.PutNull(ContextTag(3)), CHIP_NO_ERROR);
+        EXPECT_EQ(writer.StartContainer(ContextTag(4), kTLVType_List, nestedType), CHIP_NO_ERROR);
+        EXPECT_EQ(writer.Put(CommonTag(5), true), CHIP_NO_ERROR);
+        EXPECT_EQ(writer.Put(ProfileTag(TestProfile_2, 6), 1.5), CHIP_NO_ERROR);
+        EXPECT_EQ(writer.EndContainer(nestedType), CHIP_NO_ERROR);
+        EXPECT_EQ(writer.EndContainer(itemType), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(writer.EndContainer(listType), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.PutString(ContextTag(2), sLargeString), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.EndContainer(outerType), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.Put(AnonymousTag(), static_cast<uint8_t>(42)), CHIP_NO_ERROR);
+}
+
+/**
+ *  Test that skipping containers within a contiguous buffer ends where, and fails like,
+ *  skipping them element by element does.
+ */
+TEST_F(TestTLV, CheckSkipContiguous)
+{
+    // clang-format off
+    static const uint8_t kAnonymousInStructure[]     = { 0x15, 0x24, 0x01, 0x05, 0x04, 0x07, 0x18 };
+    static const uint8_t kContextTagInArray[]        = { 0x16, 0x04, 0x01, 0x24, 0x01, 0x02, 0x18 };
+    static const uint8_t kTruncatedString[]          = { 0x15, 0x2C, 0x01, 0x10, 'a', 'b', 0x18 };
+    static const uint8_t kTaggedEndOfContainer[]     = { 0x17, 0x24, 0x01, 0x05, 0x38, 0x01 };
+    static const uint8_t kImplicitTag[]              = { 0x17, 0x84, 0x01, 0x00, 0x05, 0x18, 0x04, 0x01 };
+    static const uint8_t kFullyQualifiedSpecialTag[] = { 0x15, 0xC4, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x01, 0x01, 0x18 };
+    static const uint8_t kMissingEndOfContainer[]    = { 0x15, 0x24, 0x01, 0x05, 0x36, 0x02, 0x18 };
+    // clang-format on
+
+    CheckSkipMatchesChunkedSkip(Encoding1, sizeof(Encoding1), TestProfile_2);
+    CheckSkipMatchesChunkedSkip(kAnonymousInStructure, sizeof(kAnonymousInStructure), kProfileIdNotSpecified);
+    CheckSkipMatchesChunkedSkip(kContextTagInArray, sizeof(kContextTagInArray), kProfileIdNotSpecified);
+    CheckSkipMatchesChunkedSkip(kTruncatedString, sizeof(kTruncatedString), kProfileIdNotSpecified);
+    CheckSkipMatchesChunkedSkip(kTaggedEndOfContainer, sizeof(kTaggedEndOfContainer), kProfileIdNotSpecified);
+    CheckSkipMatchesChunkedSkip(kImplicitTag, sizeof(kImplicitTag), kProfileIdNotSpecified);
+    CheckSkipMatchesChunkedSkip(kImplicitTag, sizeof(kImplicitTag), TestProfile_1);
+    CheckSkipMatchesChunkedSkip(kFullyQualifiedSpecialTag, sizeof(kFullyQualifiedSpecialTag), kProfileIdNotSpecified);
+    CheckSkipMatchesChunkedSkip(kMissingEndOfContainer, sizeof(kMissingEndOfContainer), kProfileIdNotSpecified);
+
+    uint8_t buf[4096];
+    TLVWriter writer;
+    writer.Init(buf);
+    WriteLargeEncoding(writer, 20);
+    EXPECT_EQ(writer.Finalize(), CHIP_NO_ERROR);
+    CheckSkipMatchesChunkedSkip(buf, writer.GetLengthWritten(), kProfileIdNotSpecified);
+
+    // A limit on the length read cuts the contiguous buffer as well.
+    CheckSkipMatchesChunkedSkip(buf, writer.GetLengthWritten() - 10, kProfileIdNotSpecified);
+}
+
+/**
+ *  Compare skipping a large container within a contiguous buffer with skipping it element by
+ *  element, as happens when it is split across buffers.
+ */
+TEST_F(TestTLV, BenchmarkSkipContainer)
+{
+    constexpr uint32_t kItemCount  = 200;
+    constexpr uint32_t kIterations = 200;
+
+    Platform::ScopedMemoryBuffer<uint8_t> buf;
+    constexpr size_t kBufSize = 32 * 1024;
+    ASSERT_TRUE(buf.Calloc(kBufSize));
+    TLVWriter writer;
+    writer.Init(buf.Get(), kBufSize);
+    WriteLargeEncoding(writer, kItemCount);
+    ASSERT_EQ(writer.Finalize(), CHIP_NO_ERROR);
+    const uint32_t encodingLen = writer.GetLengthWritten();
+
+    uint64_t start = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (uint32_t i = 0; i < kIterations; i++)
+    {
+        TLVReader reader;
+        reader.Init(buf.Get(), encodingLen);
+        ASSERT_EQ(NextAndSkip(reader), CHIP_NO_ERROR);
+    }
+    const uint64_t contiguous = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+    start = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (uint32_t i = 0; i < kIterations; i++)
+    {
+        ChunkedBackingStore store(buf.Get(), encodingLen, 1);
+        TLVReader reader;
+        ASSERT_EQ(reader.Init(store, encodingLen), CHIP_NO_ERROR);
+        ASSERT_EQ(NextAndSkip(reader), CHIP_NO_ERROR);
+    }
+    const uint64_t elementByElement = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+    ChipLogProgress(Test, "Skipped %u bytes %u times: %lu us contiguous, %lu us element by element",
+                    static_cast<unsigned>(encodingLen), static_cast<unsigned>(kIterations), static_cast<unsigned long>(contiguous),
+                    static_cast<unsigned long>(elementByElement));
+}
+
 /**
  *  Test Buffer Overflow
  */
@@ -342,6 +342,8 @@ void DiscoveryImplPlatform::HandleNodeIdResolve(void * context, DnssdService * r
     nodeData.resolutionData.interfaceId = result->mInterface;
     nodeData.resolutionData.port        = result->mPort;
     nodeData.operationalData.peerId     = peerId;
+    nodeData.operationalData.hasZeroTTL = (result->mTtlSeconds == 0);
+    nodeData.operationalData.ttlSeconds = result->mTtlSeconds;
 
     size_t addressesFound = 0;
     for (auto & ip : addresses)
@@ -198,7 +198,12 @@ struct OperationalNodeData
 {
     PeerId peerId;
     bool hasZeroTTL;
-    void Reset() { peerId = PeerId(); }
+    uint32_t ttlSeconds = 0; // TTL of the SRV record the data was obtained from
+    void Reset()
+    {
+        peerId     = PeerId();
+        ttlSeconds = 0;
+    }
 };
 
 struct OperationalNodeBrowseData : public OperationalNodeData
@@ -135,6 +135,13 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
 
         responseFilter.SetReplyFilter(&queryReplyFilter);
 
+        if (!query.IsAnnounceBroadcast())
+        {
+            // Hash the queried name once, so that only the records indexed under
+            // that hash are visited and compared by name.
+            responseFilter.SetIncludeOnlyQNameHash(query.GetName().Hash());
+        }
+
         if (!mSendState.SendUnicast())
         {
             // According to https://tools.ietf.org/html/rfc6762#section-6  we should multicast at most 1/sec
@@ -21,6 +21,30 @@
 
 namespace mdns {
 namespace Minimal {
+namespace {
+
+// 32-bit FNV-1a, over lowercase ASCII so that hashing matches the case-insensitive
+// comparison of QNames.
+constexpr QNameHash kFnvOffsetBasis = 2166136261u;
+constexpr QNameHash kFnvPrime       = 16777619u;
+
+QNameHash HashByte(QNameHash hash, uint8_t value)
+{
+    return (hash ^ value) * kFnvPrime;
+}
+
+QNameHash HashPart(QNameHash hash, QNamePart part)
+{
+    for (const char * p = part; *p != '\0'; p++)
+    {
+        const char c = *p;
+        hash         = HashByte(hash, static_cast<uint8_t>(((c >= 'A') && (c <= 'Z')) ? (c - 'A' + 'a') : c));
+    }
+    // Separate parts, so that "ab.c" and "a.bc" hash differently.
+    return HashByte(hash, '.');
+}
+
+} // namespace
 
 bool SerializedQNameIterator::Next()
 {
@@ -194,6 +218,29 @@ bool SerializedQNameIterator::operator==(const SerializedQNameIterator & other)
     return a.IsValid() && b.IsValid();
 }
 
+QNameHash SerializedQNameIterator::Hash() const
+{
+    SerializedQNameIterator self = *this; // allow iteration
+    QNameHash hash               = kFnvOffsetBasis;
+
+    while (self.Next())
+    {
+        hash = HashPart(hash, self.Value());
+    }
+
+    return hash;
+}
+
+QNameHash FullQName::Hash() const
+{
+    QNameHash hash = kFnvOffsetBasis;
+    for (size_t i = 0; i < nameCount; i++)
+    {
+        hash = HashPart(hash, names[i]);
+    }
+    return hash;
+}
+
 bool FullQName::operator==(const FullQName & other) const
 {
     if (nameCount != other.nameCount)
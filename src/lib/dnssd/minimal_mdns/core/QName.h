@@ -36,6 +36,13 @@ namespace Minimal {
 /// A QName part is a null-terminated string
 using QNamePart = const char *;
 
+/// Case-insensitive hash of a QName.
+///
+/// Equal QNames (as compared by the QName equality operators) always have the
+/// same hash, so comparing hashes is a cheap way to rule out most mismatches
+/// before doing a full comparison.
+using QNameHash = uint32_t;
+
 /// A list of QNames that is simple to pass around
 ///
 /// As the struct may be copied, the lifetime of 'names' has to extend beyond
@@ -55,6 +62,8 @@ struct FullQName
 
     bool operator==(const FullQName & other) const;
     bool operator!=(const FullQName & other) const { return !(*this == other); }
+
+    QNameHash Hash() const;
 };
 
 /// A serialized QNAME is comprised of
@@ -100,6 +109,10 @@ public:
     bool operator==(const SerializedQNameIterator & other) const;
     bool operator!=(const SerializedQNameIterator & other) const { return !(*this == other); }
 
+    /// Hash of the remaining (not yet iterated) parts of the name. Does not
+    /// change iterator state.
+    QNameHash Hash() const;
+
     size_t OffsetInCurrentValidData() const { return static_cast<size_t>(mCurrentPosition - mValidData.Start()); }
 
 private:
@@ -297,4 +297,28 @@ TEST(TestQName, SerializedCompare)
     EXPECT_NE(AsSerializedQName(kThisIs), thisIsATestPtr);
 }
 
+TEST(TestQName, Hash)
+{
+    static const uint8_t kThisIsATest[]  = "\04ThIs\02is\01A\04tESt\00";
+    static const uint8_t kThisIsATestX[] = "\04this\02is\01a\05testx\00";
+
+    const QNamePart kName1[] = { "this", "is", "a", "test" };
+    const QNamePart kName2[] = { "THIS", "IS", "A", "TEST" };
+    const QNamePart kName3[] = { "thisi", "s", "a", "test" };
+
+    // Equal names hash the same, regardless of case or representation
+    EXPECT_EQ(FullQName(kName1).Hash(), FullQName(kName2).Hash());
+    EXPECT_EQ(AsSerializedQName(kThisIsATest).Hash(), FullQName(kName1).Hash());
+
+    // These are expected to be different for a reasonable hash
+    EXPECT_NE(FullQName(kName1).Hash(), FullQName(kName3).Hash());
+    EXPECT_NE(AsSerializedQName(kThisIsATestX).Hash(), FullQName(kName1).Hash());
+    EXPECT_NE(FullQName().Hash(), FullQName(kName1).Hash());
+
+    // Back references are followed
+    static const uint8_t kPtrItems[] = "\03abc\02is\01a\04test\00\04this\xc0\04";
+    SerializedQNameIterator thisIsATestPtr(BytesRange(kPtrItems, kPtrItems + sizeof(kPtrItems)), kPtrItems + 15);
+    EXPECT_EQ(thisIsATestPtr.Hash(), FullQName(kName1).Hash());
+}
+
 } // namespace
@@ -20,15 +20,30 @@
 #include <lib/dnssd/minimal_mdns/core/QNameString.h>
 #include <lib/dnssd/minimal_mdns/records/Ptr.h>
 
+#include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
 
+#include <algorithm>
+
 namespace mdns {
 namespace Minimal {
 
 const QNamePart kDnsSdQueryPath[] = { "_services", "_dns-sd", "_udp", "local" };
 
-QueryResponderBase::QueryResponderBase(Internal::QueryResponderInfo * infos, size_t infoSizes) :
-    Responder(QType::PTR, FullQName(kDnsSdQueryPath)), mResponderInfos(infos), mResponderInfoSize(infoSizes)
+namespace {
+
+struct QNameHashOrder
+{
+    bool operator()(const Internal::QueryResponderInfo * info, QNameHash hash) const { return info->qnameHash < hash; }
+    bool operator()(QNameHash hash, const Internal::QueryResponderInfo * info) const { return hash < info->qnameHash; }
+};
+
+} // namespace
+
+QueryResponderBase::QueryResponderBase(Internal::QueryResponderInfo * infos, Internal::QueryResponderInfo ** qnameHashIndex,
+                                       size_t infoSizes) :
+    Responder(QType::PTR, FullQName(kDnsSdQueryPath)),
+    mResponderInfos(infos), mResponderInfoSize(infoSizes), mQNameHashIndex(qnameHashIndex)
 {}
 
 void QueryResponderBase::Init()
@@ -37,11 +52,14 @@ void QueryResponderBase::Init()
     {
         mResponderInfos[i].Clear();
     }
+    mQNameHashIndexSize = 0;
 
     if (mResponderInfoSize > 0)
     {
         // reply to queries about services available
         mResponderInfos[0].responder = this;
+        mResponderInfos[0].qnameHash = GetQName().Hash();
+        IndexByQNameHash(&mResponderInfos[0]);
     }
 
     if (mResponderInfoSize < 2)
@@ -65,6 +83,8 @@ QueryResponderSettings QueryResponderBase::AddResponder(RecordResponder * respon
         {
             mResponderInfos[i].Clear();
             mResponderInfos[i].responder = responder;
+            mResponderInfos[i].qnameHash = responder->GetQName().Hash();
+            IndexByQNameHash(&mResponderInfos[i]);
 
             return QueryResponderSettings(&mResponderInfos[i]);
         }
@@ -83,22 +103,28 @@ void QueryResponderBase::ResetAdditionals()
 
 size_t QueryResponderBase::MarkAdditional(const FullQName & qname)
 {
+    return MarkAdditional(qname, qname.Hash());
+}
+
+size_t QueryResponderBase::MarkAdditional(const FullQName & qname, QNameHash qnameHash)
+{
+    Internal::QueryResponderInfo * const * candidates;
+    size_t candidateCount;
+    FindQNameHash(qnameHash, candidates, candidateCount);
+
     size_t count = 0;
-    for (size_t i = 0; i < mResponderInfoSize; i++)
+    for (size_t i = 0; i < candidateCount; i++)
     {
-        if (mResponderInfos[i].responder == nullptr)
-        {
-            continue; // not a valid entry
-        }
+        Internal::QueryResponderInfo * info = candidates[i];
 
-        if (mResponderInfos[i].reportNowAsAdditional)
+        if (info->reportNowAsAdditional)
         {
             continue; // already marked
         }
 
-        if (mResponderInfos[i].responder->GetQName() == qname)
+        if (info->responder->GetQName() == qname)
         {
-            mResponderInfos[i].reportNowAsAdditional = true;
+            info->reportNowAsAdditional = true;
             count++;
         }
     }
@@ -106,6 +132,37 @@ size_t QueryResponderBase::MarkAdditional(const FullQName & qname)
     return count;
 }
 
+QueryResponderIterator QueryResponderBase::begin(QueryResponderRecordFilter * filter)
+{
+    if (!filter->FiltersByQNameHash())
+    {
+        return QueryResponderIterator(filter, mResponderInfos, mResponderInfoSize);
+    }
+
+    Internal::QueryResponderInfo * const * first;
+    size_t count;
+    FindQNameHash(filter->GetQNameHash(), first, count);
+    return QueryResponderIterator(filter, first, count);
+}
+
+void QueryResponderBase::IndexByQNameHash(Internal::QueryResponderInfo * info)
+{
+    VerifyOrReturn(mQNameHashIndexSize < mResponderInfoSize);
+
+    Internal::QueryResponderInfo ** end = mQNameHashIndex + mQNameHashIndexSize;
+    Internal::QueryResponderInfo ** pos = std::upper_bound(mQNameHashIndex, end, info->qnameHash, QNameHashOrder());
+    std::move_backward(pos, end, end + 1);
+    *pos = info;
+    mQNameHashIndexSize++;
+}
+
+void QueryResponderBase::FindQNameHash(QNameHash qnameHash, Internal::QueryResponderInfo * const *& first, size_t & count) const
+{
+    auto range = std::equal_range(mQNameHashIndex, mQNameHashIndex + mQNameHashIndexSize, qnameHash, QNameHashOrder());
+    first      = range.first;
+    count      = static_cast<size_t>(range.second - range.first);
+}
+
 void QueryResponderBase::MarkAdditionalRepliesFor(QueryResponderIterator it)
 {
     Internal::QueryResponderInfo * info = it.GetInternal();
@@ -115,7 +172,7 @@ void QueryResponderBase::MarkAdditionalRepliesFor(QueryResponderIterator it)
         return; // nothing additional to report
     }
 
-    if (MarkAdditional(info->additionalQName) == 0)
+    if (MarkAdditional(info->additionalQName, info->additionalQNameHash) == 0)
     {
         return; // nothing additional added
     }
@@ -133,7 +190,8 @@ void QueryResponderBase::MarkAdditionalRepliesFor(QueryResponderIterator it)
         {
             if (ait.GetInternal()->alsoReportAdditionalQName)
             {
-                keepAdding = keepAdding || (MarkAdditional(ait.GetInternal()->additionalQName) != 0);
+                keepAdding = keepAdding ||
+                    (MarkAdditional(ait.GetInternal()->additionalQName, ait.GetInternal()->additionalQNameHash) != 0);
             }
         }
     }
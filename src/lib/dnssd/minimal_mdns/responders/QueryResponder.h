@@ -41,15 +41,20 @@ struct QueryResponderInfo : public QueryResponderRecord
 {
     bool reportNowAsAdditional; // report as additional data required
 
+    QNameHash qnameHash = 0; // hash of responder->GetQName(), for fast name matching
+
     bool alsoReportAdditionalQName = false; // report more data when this record is listed
     FullQName additionalQName;              // if alsoReportAdditionalQName is set, send this extra data
+    QNameHash additionalQNameHash = 0;      // hash of additionalQName
 
     void Clear()
     {
         responder                 = nullptr;
         reportService             = false;
         reportNowAsAdditional     = false;
+        qnameHash                 = 0;
         alsoReportAdditionalQName = false;
+        additionalQNameHash       = 0;
     }
 };
 
@@ -84,6 +89,7 @@ public:
         {
             mInfo->alsoReportAdditionalQName = true;
             mInfo->additionalQName           = qname;
+            mInfo->additionalQNameHash       = qname.Hash();
         }
         return *this;
     }
@@ -120,6 +126,21 @@ public:
         return *this;
     }
 
+    /// Only include records whose qname hash is `hash`.
+    ///
+    /// Records with a different hash cannot match the name: QueryResponderBase::begin
+    /// looks the hash up in its index, so they are never visited, and the (more
+    /// expensive) reply filter name comparison only runs on the records left.
+    QueryResponderRecordFilter & SetIncludeOnlyQNameHash(QNameHash hash)
+    {
+        mFilterByQNameHash = true;
+        mQNameHash         = hash;
+        return *this;
+    }
+
+    bool FiltersByQNameHash() const { return mFilterByQNameHash; }
+    QNameHash GetQNameHash() const { return mQNameHash; }
+
     /// Filter out anything that was multicast past ms.
     /// If ms is 0, no filtering is done
     QueryResponderRecordFilter & SetIncludeOnlyMulticastBeforeMS(chip::System::Clock::Timestamp time)
@@ -156,12 +177,14 @@ public:
 
 private:
     bool mIncludeAdditionalRepliesOnly                         = false;
+    bool mFilterByQNameHash                                    = false;
+    QNameHash mQNameHash                                       = 0;
     ReplyFilter * mReplyFilter                                 = nullptr;
     chip::System::Clock::Timestamp mIncludeOnlyMulticastBefore = chip::System::Clock::kZero;
 };
 
-/// Iterates over an array of QueryResponderRecord items, providing only 'valid' ones, where
-/// valid is based on the provided filter.
+/// Iterates over an array of QueryResponderRecord items, or over a range of an index pointing
+/// to such items, providing only 'valid' ones, where valid is based on the provided filter.
 class QueryResponderIterator
 {
 public:
@@ -175,6 +198,12 @@ public:
     {
         SkipInvalid();
     }
+    QueryResponderIterator(QueryResponderRecordFilter * recordFilter, Internal::QueryResponderInfo * const * indexPos,
+                           size_t size) :
+        mFilter(recordFilter), mIndexPos(indexPos), mCurrent((size > 0) ? *indexPos : nullptr), mRemaining(size)
+    {
+        SkipInvalid();
+    }
     QueryResponderIterator(const QueryResponderIterator & other)             = default;
     QueryResponderIterator & operator=(const QueryResponderIterator & other) = default;
 
@@ -182,8 +211,7 @@ public:
     {
         if (mRemaining != 0)
         {
-            mCurrent++;
-            mRemaining--;
+            Advance();
         }
         SkipInvalid();
         return *this;
@@ -206,14 +234,28 @@ public:
     const Internal::QueryResponderInfo * GetInternal() const { return mCurrent; }
 
 private:
+    /// Moves to the next item, either in the array or through the index.
+    void Advance()
+    {
+        mRemaining--;
+        if (mIndexPos != nullptr)
+        {
+            mIndexPos++;
+            mCurrent = (mRemaining > 0) ? *mIndexPos : nullptr;
+        }
+        else
+        {
+            mCurrent++;
+        }
+    }
+
     /// Skips invalid/not useful values.
     /// ensures that if mRemaining is 0, mCurrent is nullptr;
     void SkipInvalid()
     {
         while ((mRemaining > 0) && !mFilter->Accept(mCurrent))
         {
-            mRemaining--;
-            mCurrent++;
+            Advance();
         }
         if (mRemaining == 0)
         {
@@ -222,6 +264,7 @@ private:
     }
 
     QueryResponderRecordFilter * mFilter;
+    Internal::QueryResponderInfo * const * mIndexPos = nullptr; // set when iterating through an index
     Internal::QueryResponderInfo * mCurrent;
     size_t mRemaining;
 };
@@ -234,11 +277,15 @@ private:
 ///
 /// Maintains a stateful list of 'additional replies' that can be marked/unmarked
 /// for query processing
+///
+/// Registered records are also indexed by qname hash, so that looking up the records
+/// for a name only visits the records whose name has the same hash.
 class QueryResponderBase : public Responder // "_services._dns-sd._udp.local"
 {
 public:
     /// Builds a new responder with the given storage for the response infos
-    QueryResponderBase(Internal::QueryResponderInfo * infos, size_t infoSizes);
+    /// and for their qname hash index, both of infoSizes elements.
+    QueryResponderBase(Internal::QueryResponderInfo * infos, Internal::QueryResponderInfo ** qnameHashIndex, size_t infoSizes);
     ~QueryResponderBase() override {}
 
     /// Setup initial settings (clears all infos and sets up dns-sd query replies)
@@ -255,10 +302,10 @@ public:
     void AddAllResponses(const chip::Inet::IPPacketInfo * source, ResponderDelegate * delegate,
                          const ResponseConfiguration & configuration) override;
 
-    QueryResponderIterator begin(QueryResponderRecordFilter * filter)
-    {
-        return QueryResponderIterator(filter, mResponderInfos, mResponderInfoSize);
-    }
+    /// Iterates over the records accepted by the filter.
+    ///
+    /// If the filter includes only a qname hash, only the records with that hash are visited.
+    QueryResponderIterator begin(QueryResponderRecordFilter * filter);
     QueryResponderIterator end() { return QueryResponderIterator(); }
 
     /// Clear any items marked as 'additional'.
@@ -276,18 +323,31 @@ public:
     void ClearBroadcastThrottle();
 
 private:
+    size_t MarkAdditional(const FullQName & qname, QNameHash qnameHash);
+
+    /// Adds a registered record to the qname hash index, after the records with the same hash.
+    void IndexByQNameHash(Internal::QueryResponderInfo * info);
+
+    /// Range of the qname hash index holding the records with the given hash.
+    void FindQNameHash(QNameHash qnameHash, Internal::QueryResponderInfo * const *& first, size_t & count) const;
+
     Internal::QueryResponderInfo * mResponderInfos;
     size_t mResponderInfoSize;
+
+    // Registered records, sorted by qname hash and in registration order for the same hash.
+    Internal::QueryResponderInfo ** mQNameHashIndex;
+    size_t mQNameHashIndexSize = 0;
 };
 
 template <size_t kSize>
 class QueryResponder : public QueryResponderBase
 {
 public:
-    QueryResponder() : QueryResponderBase(mData, kSize) { Init(); }
+    QueryResponder() : QueryResponderBase(mData, mQNameHashIndexData, kSize) { Init(); }
 
 private:
     Internal::QueryResponderInfo mData[kSize];
+    Internal::QueryResponderInfo * mQNameHashIndexData[kSize];
 };
 
 } // namespace Minimal
@@ -58,6 +58,22 @@ private:
     std::vector<FullQName> mCaptures;
 };
 
+/// Reply filter recording every record it is asked about, i.e. every record the iteration visits.
+class VisitRecorder : public ReplyFilter
+{
+public:
+    bool Accept(QType qType, QClass qClass, FullQName qname) override
+    {
+        mVisited.push_back(qname);
+        return true;
+    }
+
+    std::vector<FullQName> & Visited() { return mVisited; }
+
+private:
+    std::vector<FullQName> mVisited;
+};
+
 TEST(TestQueryResponder, CanIterateOverResponders)
 {
     QueryResponder<10> responder;
@@ -164,4 +180,119 @@ TEST(TestQueryResponder, NonDiscoverableService)
         EXPECT_EQ(accumulator.Captures()[0], kName2);
     }
 }
+
+TEST(TestQueryResponder, QNameHashFilter)
+{
+    QueryResponder<10> responder;
+
+    EmptyResponder empty1(kName1);
+    EmptyResponder empty2(kName2);
+    EmptyResponder empty3(kName1);
+
+    EXPECT_TRUE(responder.AddResponder(&empty1).IsValid());
+    EXPECT_TRUE(responder.AddResponder(&empty2).IsValid());
+    EXPECT_TRUE(responder.AddResponder(&empty3).IsValid());
+
+    const QNamePart kName1Upper[] = { "SOME", "Test" };
+
+    QueryResponderRecordFilter filter;
+    filter.SetIncludeOnlyQNameHash(FullQName(kName1Upper).Hash());
+
+    std::vector<Responder *> matches;
+    for (auto it = responder.begin(&filter); it != responder.end(); it++)
+    {
+        matches.push_back(it->responder);
+    }
+
+    EXPECT_EQ(matches.size(), 2u);
+    if (matches.size() == 2)
+    {
+        EXPECT_EQ(matches[0], &empty1);
+        EXPECT_EQ(matches[1], &empty3);
+    }
+
+    // Additional marking uses the same matching
+    EXPECT_EQ(responder.MarkAdditional(kName2), 1u);
+    EXPECT_EQ(responder.MarkAdditional(kName2), 0u);
+}
+
+TEST(TestQueryResponder, QNameHashIndexSkipsOtherNames)
+{
+    QueryResponder<20> responder;
+
+    const QNamePart kOtherNames[][2] = { { "a", "test" }, { "b", "test" }, { "c", "test" }, { "d", "test" },
+                                         { "e", "test" }, { "f", "test" }, { "g", "test" }, { "h", "test" } };
+
+    std::vector<EmptyResponder> others;
+    for (const auto & name : kOtherNames)
+    {
+        others.emplace_back(FullQName(name));
+    }
+
+    EmptyResponder empty1(kName1);
+    EmptyResponder empty2(kName1);
+
+    // Interleave the records for kName1 with records for other names.
+    for (size_t i = 0; i < others.size(); i++)
+    {
+        EXPECT_TRUE(responder.AddResponder(&others[i]).IsValid());
+        if (i == 2)
+        {
+            EXPECT_TRUE(responder.AddResponder(&empty1).IsValid());
+        }
+        if (i == 5)
+        {
+            EXPECT_TRUE(responder.AddResponder(&empty2).IsValid());
+        }
+    }
+
+    VisitRecorder visitRecorder;
+    QueryResponderRecordFilter filter;
+    filter.SetReplyFilter(&visitRecorder).SetIncludeOnlyQNameHash(FullQName(kName1).Hash());
+
+    std::vector<Responder *> matches;
+    for (auto it = responder.begin(&filter); it != responder.end(); it++)
+    {
+        matches.push_back(it->responder);
+    }
+
+    // Only the records for kName1 are visited, in registration order.
+    EXPECT_EQ(visitRecorder.Visited().size(), 2u);
+    for (auto & visited : visitRecorder.Visited())
+    {
+        EXPECT_EQ(visited, kName1);
+    }
+    EXPECT_EQ(matches.size(), 2u);
+    if (matches.size() == 2)
+    {
+        EXPECT_EQ(matches[0], &empty1);
+        EXPECT_EQ(matches[1], &empty2);
+    }
+
+    // A name that is not registered visits nothing.
+    VisitRecorder noVisitRecorder;
+    QueryResponderRecordFilter missingFilter;
+    missingFilter.SetReplyFilter(&noVisitRecorder).SetIncludeOnlyQNameHash(FullQName(kName2).Hash());
+    EXPECT_TRUE(responder.begin(&missingFilter) == responder.end());
+    EXPECT_TRUE(noVisitRecorder.Visited().empty());
+
+    // Marking additionals goes through the same index.
+    EXPECT_EQ(responder.MarkAdditional(kName1), 2u);
+    EXPECT_EQ(responder.MarkAdditional(kName2), 0u);
+
+    size_t additionalCount = 0;
+    QueryResponderRecordFilter additionalFilter;
+    additionalFilter.SetIncludeAdditionalRepliesOnly(true);
+    for (auto it = responder.begin(&additionalFilter); it != responder.end(); it++)
+    {
+        EXPECT_EQ(it->responder->GetQName(), kName1);
+        additionalCount++;
+    }
+    EXPECT_EQ(additionalCount, 2u);
+
+    // Init clears the index along with the records.
+    responder.Init();
+    EXPECT_TRUE(responder.begin(&filter) == responder.end());
+}
+
 } // namespace
@@ -109,6 +109,9 @@ public:
     // LastKnownGoodTime
     static StorageKeyName LastKnownGoodTimeKey() { return StorageKeyName::FromConst("g/lkgt"); }
 
+    // Operational address resolution cache
+    static StorageKeyName AddressResolveCache() { return StorageKeyName::FromConst("g/arc"); }
+
     // Session resumption
     static StorageKeyName FabricSession(FabricIndex fabric, NodeId nodeId)
     {
@@ -208,6 +211,8 @@ public:
         return StorageKeyName::Formatted("g/su/%x", static_cast<unsigned>(index));
     }
     static StorageKeyName SubscriptionResumptionMaxCount() { return StorageKeyName::Formatted("g/sum"); }
+    // All the persisted subscriptions, in a single record.
+    static StorageKeyName SubscriptionResumptionRecord() { return StorageKeyName::Formatted("g/sur"); }
 
     // Number of scenes stored in a given endpoint's scene table, across all fabrics.
     static StorageKeyName EndpointSceneCountKey(EndpointId endpoint) { return StorageKeyName::Formatted("g/scc/e/%x", endpoint); }
@@ -233,6 +238,12 @@ public:
     static StorageKeyName TSTimeZone() { return StorageKeyName::FromConst("g/ts/tz"); }
     static StorageKeyName TSDSTOffset() { return StorageKeyName::FromConst("g/ts/dsto"); }
 
+    // Energy EVSE cluster
+    static StorageKeyName EVSEChargingTargets(EndpointId endpoint) { return StorageKeyName::Formatted("g/evse/%x/ct", endpoint); }
+
+    // Device Energy Management cluster
+    static StorageKeyName DEMForecastIdCounter(EndpointId endpoint) { return StorageKeyName::Formatted("g/dem/%x/fid", endpoint); }
+
     // FabricICDClientInfoCounter is only used by DefaultICDClientStorage
     // Records the number of ClientInfos for a particular fabric
     static StorageKeyName FabricICDClientInfoCounter(FabricIndex fabric) { return StorageKeyName::Formatted("f/%x/icdc", fabric); }
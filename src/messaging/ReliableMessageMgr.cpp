@@ -36,6 +36,7 @@
 #include <messaging/ReliableMessageContext.h>
 #include <messaging/ReliableMessageMgr.h>
 #include <platform/ConnectivityManager.h>
+#include <tracing/metric_event.h>
 
 #if CHIP_CONFIG_ENABLE_ICD_SERVER
 #include <app/icd/server/ICDConfigurationData.h> // nogncheck
@@ -159,6 +160,8 @@ void ReliableMessageMgr::ExecuteActions()
                 session->NotifySessionHang();
             }
 
+            MATTER_LOG_METRIC(Tracing::kMetricMRPRetransmitCount, sendCount);
+
             // Do not StartTimer, we will schedule the timer at the end of the timer handler.
             mRetransTable.ReleaseObject(entry);
 
@@ -284,6 +287,8 @@ bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, ui
     mRetransTable.ForEachActiveObject([&](auto * entry) {
         if (entry->ec->GetReliableMessageContext() == rc && entry->retainedBuf.GetMessageCounter() == ackMessageCounter)
         {
+            MATTER_LOG_METRIC(Tracing::kMetricMRPRetransmitCount, entry->sendCount);
+
             // Clear the entry from the retransmision table.
             ClearRetransTable(*entry);
 
@@ -64,6 +64,10 @@ using CHIP_CONFIG_PERSISTED_STORAGE_KEY_TYPE = const char *;
 #define CHIP_CONFIG_BDX_MAX_NUM_TRANSFERS 1
 #endif // CHIP_CONFIG_BDX_MAX_NUM_TRANSFERS
 
+#ifndef CHIP_CONFIG_ATTRIBUTE_PATH_EXPANSION_CACHE_SIZE
+#define CHIP_CONFIG_ATTRIBUTE_PATH_EXPANSION_CACHE_SIZE 4
+#endif // CHIP_CONFIG_ATTRIBUTE_PATH_EXPANSION_CACHE_SIZE
+
 // ==================== Security Configuration Overrides ====================
 
 #ifndef CHIP_CONFIG_KVS_PATH
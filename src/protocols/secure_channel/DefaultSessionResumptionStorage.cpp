@@ -20,18 +20,41 @@
 #include <lib/support/Base64.h>
 #include <lib/support/SafeInt.h>
 
+#include <algorithm>
+
 namespace chip {
 
 CHIP_ERROR DefaultSessionResumptionStorage::FindByScopedNodeId(const ScopedNodeId & node, ResumptionIdStorage & resumptionId,
                                                                Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs)
 {
+    CachedRecord * record = CacheFind(node);
+    if (record != nullptr)
+    {
+        CacheTouch(*record);
+        resumptionId = record->resumptionId;
+        sharedSecret = record->sharedSecret;
+        peerCATs     = record->peerCATs;
+        return CHIP_NO_ERROR;
+    }
+
     ReturnErrorOnFailure(LoadState(node, resumptionId, sharedSecret, peerCATs));
+    CacheStore(node, resumptionId, sharedSecret, peerCATs);
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DefaultSessionResumptionStorage::FindByResumptionId(ConstResumptionIdView resumptionId, ScopedNodeId & node,
                                                                Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs)
 {
+    CachedRecord * record = CacheFind(resumptionId);
+    if (record != nullptr)
+    {
+        CacheTouch(*record);
+        node         = record->node;
+        sharedSecret = record->sharedSecret;
+        peerCATs     = record->peerCATs;
+        return CHIP_NO_ERROR;
+    }
+
     ReturnErrorOnFailure(FindNodeByResumptionId(resumptionId, node));
     ResumptionIdStorage tmpResumptionId;
     ReturnErrorOnFailure(FindByScopedNodeId(node, tmpResumptionId, sharedSecret, peerCATs));
@@ -48,6 +71,25 @@ CHIP_ERROR DefaultSessionResumptionStorage::FindNodeByResumptionId(ConstResumpti
 
 CHIP_ERROR DefaultSessionResumptionStorage::Save(const ScopedNodeId & node, ConstResumptionIdView resumptionId,
                                                  const Crypto::P256ECDHDerivedSecret & sharedSecret, const CATValues & peerCATs)
+{
+    // The cached record (if any) is replaced once the new one has been
+    // written through: until then, it still tells which link to remove.
+    CHIP_ERROR err = SaveToStorage(node, resumptionId, sharedSecret, peerCATs);
+    if (err == CHIP_NO_ERROR)
+    {
+        CacheStore(node, resumptionId, sharedSecret, peerCATs);
+    }
+    else
+    {
+        // The storage may or may not hold the new record: do not serve a stale one.
+        CacheRemove(node);
+    }
+    return err;
+}
+
+CHIP_ERROR DefaultSessionResumptionStorage::SaveToStorage(const ScopedNodeId & node, ConstResumptionIdView resumptionId,
+                                                          const Crypto::P256ECDHDerivedSecret & sharedSecret,
+                                                          const CATValues & peerCATs)
 {
     SessionIndex index;
     ReturnErrorOnFailure(LoadIndex(index));
@@ -65,7 +107,7 @@ CHIP_ERROR DefaultSessionResumptionStorage::Save(const ScopedNodeId & node, Cons
             // resumption-id-keyed link is best effort.  If we cannot load
             // state to lookup the resumption ID for the key, the entry in
             // the link table will be leaked.
-            err = LoadState(node, oldResumptionId, oldSharedSecret, oldPeerCATs);
+            err = LoadRecord(node, oldResumptionId, oldSharedSecret, oldPeerCATs);
             if (err != CHIP_NO_ERROR)
             {
                 ChipLogError(SecureChannel,
@@ -114,7 +156,8 @@ CHIP_ERROR DefaultSessionResumptionStorage::Delete(const ScopedNodeId & node)
     ResumptionIdStorage resumptionId;
     Crypto::P256ECDHDerivedSecret sharedSecret;
     CATValues peerCATs;
-    CHIP_ERROR err = LoadState(node, resumptionId, sharedSecret, peerCATs);
+    CHIP_ERROR err = LoadRecord(node, resumptionId, sharedSecret, peerCATs);
+    CacheRemove(node);
     if (err == CHIP_NO_ERROR)
     {
         err = DeleteLink(resumptionId);
@@ -186,6 +229,7 @@ CHIP_ERROR DefaultSessionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
     CHIP_ERROR stickyErr = CHIP_NO_ERROR;
     size_t found         = 0;
     SessionIndex index;
+    CacheRemoveAll(fabricIndex);
     ReturnErrorOnFailure(LoadIndex(index));
     size_t initialSize = index.mSize;
     for (size_t i = 0; i < initialSize; ++i)
@@ -254,4 +298,98 @@ CHIP_ERROR DefaultSessionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
     return stickyErr;
 }
 
+CHIP_ERROR DefaultSessionResumptionStorage::LoadRecord(const ScopedNodeId & node, ResumptionIdStorage & resumptionId,
+                                                       Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs)
+{
+    CachedRecord * record = CacheFind(node);
+    if (record == nullptr)
+    {
+        return LoadState(node, resumptionId, sharedSecret, peerCATs);
+    }
+
+    resumptionId = record->resumptionId;
+    sharedSecret = record->sharedSecret;
+    peerCATs     = record->peerCATs;
+    return CHIP_NO_ERROR;
+}
+
+DefaultSessionResumptionStorage::CachedRecord * DefaultSessionResumptionStorage::CacheFind(const ScopedNodeId & node)
+{
+    for (size_t i = 0; i < kRamCacheSize; ++i)
+    {
+        if (mRamCache[i].inUse && mRamCache[i].node == node)
+        {
+            return &mRamCache[i];
+        }
+    }
+    return nullptr;
+}
+
+DefaultSessionResumptionStorage::CachedRecord * DefaultSessionResumptionStorage::CacheFind(ConstResumptionIdView resumptionId)
+{
+    for (size_t i = 0; i < kRamCacheSize; ++i)
+    {
+        const ResumptionIdStorage & cachedId = mRamCache[i].resumptionId;
+        if (mRamCache[i].inUse && std::equal(cachedId.begin(), cachedId.end(), resumptionId.begin(), resumptionId.end()))
+        {
+            return &mRamCache[i];
+        }
+    }
+    return nullptr;
+}
+
+void DefaultSessionResumptionStorage::CacheStore(const ScopedNodeId & node, ConstResumptionIdView resumptionId,
+                                                 const Crypto::P256ECDHDerivedSecret & sharedSecret, const CATValues & peerCATs)
+{
+    VerifyOrReturn(kRamCacheSize > 0);
+
+    CachedRecord * record = CacheFind(node);
+    if (record == nullptr)
+    {
+        // Use a free slot, or else the least recently used one.
+        record = &mRamCache[0];
+        for (size_t i = 0; i < kRamCacheSize && record->inUse; ++i)
+        {
+            if (!mRamCache[i].inUse || mRamCache[i].lastUsed < record->lastUsed)
+            {
+                record = &mRamCache[i];
+            }
+        }
+    }
+
+    record->node = node;
+    std::copy(resumptionId.begin(), resumptionId.end(), record->resumptionId.begin());
+    record->sharedSecret = sharedSecret;
+    record->peerCATs     = peerCATs;
+    record->inUse        = true;
+    CacheTouch(*record);
+}
+
+void DefaultSessionResumptionStorage::CacheRemove(const ScopedNodeId & node)
+{
+    CachedRecord * record = CacheFind(node);
+    if (record != nullptr)
+    {
+        CacheClear(*record);
+    }
+}
+
+void DefaultSessionResumptionStorage::CacheRemoveAll(FabricIndex fabricIndex)
+{
+    for (size_t i = 0; i < kRamCacheSize; ++i)
+    {
+        if (mRamCache[i].inUse && mRamCache[i].node.GetFabricIndex() == fabricIndex)
+        {
+            CacheClear(mRamCache[i]);
+        }
+    }
+}
+
+void DefaultSessionResumptionStorage::CacheClear(CachedRecord & record)
+{
+    Crypto::ClearSecretData(record.sharedSecret.Bytes(), record.sharedSecret.Capacity());
+    record.sharedSecret.SetLength(0);
+    record.inUse = false;
+}
+
 } // namespace chip
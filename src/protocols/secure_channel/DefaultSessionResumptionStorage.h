@@ -29,6 +29,10 @@ namespace chip {
  *   The implementation saves 2 maps:
  *     * <FabricIndex, PeerNodeId>   => <ResumptionId, ShareSecret, PeerCATs>
  *     * <ResumptionId>              => <FabricIndex, PeerNodeId>
+ *
+ *   The most recently used records are also kept in RAM (see CHIP_CONFIG_CASE_SESSION_RESUME_RAM_CACHE_SIZE), so that
+ *   frequently resumed sessions (e.g. with sleepy devices resuming on every wake cycle) are found without reading the
+ *   persistent storage. All changes are written through to the storage.
  */
 class DefaultSessionResumptionStorage : public SessionResumptionStorage
 {
@@ -66,6 +70,39 @@ protected:
     CHIP_ERROR virtual LoadState(const ScopedNodeId & node, ResumptionIdStorage & resumptionId,
                                  Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs)             = 0;
     CHIP_ERROR virtual DeleteState(const ScopedNodeId & node)                                                    = 0;
+
+private:
+    CHIP_ERROR SaveToStorage(const ScopedNodeId & node, ConstResumptionIdView resumptionId,
+                             const Crypto::P256ECDHDerivedSecret & sharedSecret, const CATValues & peerCATs);
+
+    // Like FindByScopedNodeId, but without adding records read from storage to the RAM cache.
+    CHIP_ERROR LoadRecord(const ScopedNodeId & node, ResumptionIdStorage & resumptionId,
+                          Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs);
+
+    static constexpr size_t kRamCacheSize = CHIP_CONFIG_CASE_SESSION_RESUME_RAM_CACHE_SIZE;
+
+    struct CachedRecord
+    {
+        ScopedNodeId node;
+        ResumptionIdStorage resumptionId;
+        Crypto::P256ECDHDerivedSecret sharedSecret;
+        CATValues peerCATs;
+        uint32_t lastUsed = 0;
+        bool inUse        = false;
+    };
+
+    CachedRecord * CacheFind(const ScopedNodeId & node);
+    CachedRecord * CacheFind(ConstResumptionIdView resumptionId);
+    void CacheStore(const ScopedNodeId & node, ConstResumptionIdView resumptionId,
+                    const Crypto::P256ECDHDerivedSecret & sharedSecret, const CATValues & peerCATs);
+    void CacheTouch(CachedRecord & record) { record.lastUsed = ++mRamCacheClock; }
+    void CacheRemove(const ScopedNodeId & node);
+    void CacheRemoveAll(FabricIndex fabricIndex);
+    static void CacheClear(CachedRecord & record);
+
+    // A size of at least 1 keeps the array valid if the cache is disabled (kRamCacheSize == 0).
+    CachedRecord mRamCache[kRamCacheSize > 0 ? kRamCacheSize : 1];
+    uint32_t mRamCacheClock = 0;
 };
 
 } // namespace chip
@@ -386,3 +386,76 @@ TEST(TestDefaultSessionResumptionStorage, TestDeleteAll)
         }
     }
 }
+
+TEST(TestDefaultSessionResumptionStorage, TestRamCache)
+{
+    constexpr size_t kRamCacheSize = CHIP_CONFIG_CASE_SESSION_RESUME_RAM_CACHE_SIZE;
+    if (kRamCacheSize == 0 || kRamCacheSize >= CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE)
+    {
+        GTEST_SKIP() << "RAM cache disabled or as large as the storage";
+    }
+
+    chip::SimpleSessionResumptionStorage sessionStorage;
+    chip::TestPersistentStorageDelegate storage;
+    sessionStorage.Init(&storage);
+    chip::Crypto::P256ECDHDerivedSecret sharedSecret;
+    struct
+    {
+        chip::SessionResumptionStorage::ResumptionIdStorage resumptionId;
+        chip::ScopedNodeId node;
+    } vectors[kRamCacheSize + 1];
+
+    // Create a shared secret.  We can use the same one for all entries.
+    sharedSecret.SetLength(sharedSecret.Capacity());
+    EXPECT_EQ(chip::Crypto::DRBG_get_bytes(sharedSecret.Bytes(), sharedSecret.Length()), CHIP_NO_ERROR);
+
+    // Populate test vectors and storage.
+    for (size_t i = 0; i < ArraySize(vectors); ++i)
+    {
+        EXPECT_EQ(chip::Crypto::DRBG_get_bytes(vectors[i].resumptionId.data(), vectors[i].resumptionId.size()), CHIP_NO_ERROR);
+        *vectors[i].resumptionId.data() = static_cast<uint8_t>(i);
+
+        vectors[i].node = chip::ScopedNodeId(static_cast<chip::NodeId>(i + 1), static_cast<chip::FabricIndex>(i + 1));
+        EXPECT_EQ(sessionStorage.Save(vectors[i].node, vectors[i].resumptionId, sharedSecret, chip::CATValues{}), CHIP_NO_ERROR);
+    }
+
+    // Reading from storage now fails: only records still held in RAM can be found.
+    for (auto & vector : vectors)
+    {
+        storage.AddPoisonKey(chip::SimpleSessionResumptionStorage::GetStorageKey(vector.node).KeyName());
+        storage.AddPoisonKey(chip::SimpleSessionResumptionStorage::GetStorageKey(vector.resumptionId).KeyName());
+    }
+
+    chip::ScopedNodeId outNode;
+    chip::SessionResumptionStorage::ResumptionIdStorage outResumptionId;
+    chip::Crypto::P256ECDHDerivedSecret outSharedSecret;
+    chip::CATValues outCats;
+
+    // The least recently used record was dropped from RAM when the last one was saved.
+    EXPECT_NE(sessionStorage.FindByScopedNodeId(vectors[0].node, outResumptionId, outSharedSecret, outCats), CHIP_NO_ERROR);
+    EXPECT_NE(sessionStorage.FindByResumptionId(vectors[0].resumptionId, outNode, outSharedSecret, outCats), CHIP_NO_ERROR);
+
+    for (size_t i = 1; i < ArraySize(vectors); ++i)
+    {
+        EXPECT_EQ(sessionStorage.FindByResumptionId(vectors[i].resumptionId, outNode, outSharedSecret, outCats), CHIP_NO_ERROR);
+        EXPECT_EQ(vectors[i].node, outNode);
+        EXPECT_EQ(memcmp(sharedSecret.ConstBytes(), outSharedSecret.ConstBytes(), sharedSecret.Length()), 0);
+
+        EXPECT_EQ(sessionStorage.FindByScopedNodeId(vectors[i].node, outResumptionId, outSharedSecret, outCats), CHIP_NO_ERROR);
+        EXPECT_EQ(memcmp(vectors[i].resumptionId.data(), outResumptionId.data(), vectors[i].resumptionId.size()), 0);
+    }
+
+    // Records read from storage are cached as well.
+    storage.ClearPoisonKeys();
+    EXPECT_EQ(sessionStorage.FindByResumptionId(vectors[0].resumptionId, outNode, outSharedSecret, outCats), CHIP_NO_ERROR);
+    storage.AddPoisonKey(chip::SimpleSessionResumptionStorage::GetStorageKey(vectors[0].node).KeyName());
+    storage.AddPoisonKey(chip::SimpleSessionResumptionStorage::GetStorageKey(vectors[0].resumptionId).KeyName());
+    EXPECT_EQ(sessionStorage.FindByScopedNodeId(vectors[0].node, outResumptionId, outSharedSecret, outCats), CHIP_NO_ERROR);
+    storage.ClearPoisonKeys();
+
+    // Deleted records are dropped from RAM too.
+    EXPECT_EQ(sessionStorage.Delete(vectors[0].node), CHIP_NO_ERROR);
+    EXPECT_EQ(sessionStorage.DeleteAll(vectors[1].node.GetFabricIndex()), CHIP_NO_ERROR);
+    EXPECT_NE(sessionStorage.FindByResumptionId(vectors[0].resumptionId, outNode, outSharedSecret, outCats), CHIP_NO_ERROR);
+    EXPECT_NE(sessionStorage.FindByResumptionId(vectors[1].resumptionId, outNode, outSharedSecret, outCats), CHIP_NO_ERROR);
+}
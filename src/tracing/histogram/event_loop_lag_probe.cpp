@@ -0,0 +1,78 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <tracing/histogram/event_loop_lag_probe.h>
+
+#include <lib/support/CodeUtils.h>
+#include <matter/tracing/build_config.h>
+#include <tracing/metric_event.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace chip {
+namespace Tracing {
+namespace Histogram {
+
+CHIP_ERROR EventLoopLagProbe::Start(System::Layer & systemLayer, System::Clock::Milliseconds32 period)
+{
+    VerifyOrReturnError(period > System::Clock::kZero, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(!IsRunning(), CHIP_ERROR_INCORRECT_STATE);
+
+    mSystemLayer = &systemLayer;
+    mPeriod      = period;
+
+    CHIP_ERROR err = ArmTimer();
+    if (err != CHIP_NO_ERROR)
+    {
+        mSystemLayer = nullptr;
+    }
+    return err;
+}
+
+void EventLoopLagProbe::Stop()
+{
+    VerifyOrReturn(IsRunning());
+    mSystemLayer->CancelTimer(OnTimerExpired, this);
+    mSystemLayer = nullptr;
+}
+
+CHIP_ERROR EventLoopLagProbe::ArmTimer()
+{
+    mDueTime = System::SystemClock().GetMonotonicMicroseconds64() + mPeriod;
+    return mSystemLayer->StartTimer(mPeriod, OnTimerExpired, this);
+}
+
+void EventLoopLagProbe::OnTimerExpired(System::Layer * systemLayer, void * context)
+{
+    auto * probe = static_cast<EventLoopLagProbe *>(context);
+    VerifyOrReturn(probe->IsRunning());
+
+#if MATTER_TRACING_ENABLED
+    const System::Clock::Microseconds64 now = System::SystemClock().GetMonotonicMicroseconds64();
+    const uint64_t lag                      = (now > probe->mDueTime) ? (now - probe->mDueTime).count() : 0;
+    MATTER_LOG_METRIC(kMetricEventLoopLag, static_cast<uint32_t>(std::min<uint64_t>(lag, std::numeric_limits<uint32_t>::max())));
+#endif // MATTER_TRACING_ENABLED
+
+    if (probe->ArmTimer() != CHIP_NO_ERROR)
+    {
+        probe->mSystemLayer = nullptr;
+    }
+}
+
+} // namespace Histogram
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,58 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+namespace Tracing {
+namespace Histogram {
+
+/// Measures how late the event loop runs timers.
+///
+/// A timer is armed every `period`; when it fires, the difference between the
+/// time it was due and the time it actually ran is emitted as a
+/// kMetricEventLoopLag metric (in microseconds). Under load this captures the
+/// time other work held up the Matter thread.
+///
+/// Start and Stop MUST be called with the Matter stack lock held.
+class EventLoopLagProbe
+{
+public:
+    EventLoopLagProbe() = default;
+    ~EventLoopLagProbe() { Stop(); }
+
+    CHIP_ERROR Start(System::Layer & systemLayer, System::Clock::Milliseconds32 period);
+    void Stop();
+
+    bool IsRunning() const { return mSystemLayer != nullptr; }
+
+private:
+    static void OnTimerExpired(System::Layer * systemLayer, void * context);
+
+    CHIP_ERROR ArmTimer();
+
+    System::Layer * mSystemLayer = nullptr;
+    System::Clock::Milliseconds32 mPeriod;
+    System::Clock::Microseconds64 mDueTime;
+};
+
+} // namespace Histogram
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,105 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <tracing/histogram/histogram.h>
+
+#include <limits>
+
+namespace chip {
+namespace Tracing {
+namespace Histogram {
+
+size_t Log2Histogram::BucketIndex(uint64_t value)
+{
+    size_t index = 0;
+    while (value != 0 && index < kBucketCount - 1)
+    {
+        value >>= 1;
+        index++;
+    }
+    return index;
+}
+
+uint64_t Log2Histogram::BucketUpperBound(size_t index)
+{
+    if (index >= kBucketCount - 1)
+    {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return static_cast<uint64_t>(1) << index;
+}
+
+void Log2Histogram::Record(uint64_t value)
+{
+    mBuckets[BucketIndex(value)]++;
+    mCount++;
+    mSum += value;
+    if (value < mMin)
+    {
+        mMin = value;
+    }
+    if (value > mMax)
+    {
+        mMax = value;
+    }
+}
+
+void Log2Histogram::Reset()
+{
+    for (auto & bucket : mBuckets)
+    {
+        bucket = 0;
+    }
+    mCount = 0;
+    mSum   = 0;
+    mMin   = std::numeric_limits<uint64_t>::max();
+    mMax   = 0;
+}
+
+uint64_t Log2Histogram::Percentile(uint8_t percent) const
+{
+    if (mCount == 0)
+    {
+        return 0;
+    }
+
+    if (percent > 100)
+    {
+        percent = 100;
+    }
+
+    // Rank of the sample we are looking for, rounded up so that any non-zero
+    // percentile selects at least the first sample.
+    const uint64_t rank = (mCount * percent + 99) / 100;
+    uint64_t seen       = 0;
+
+    for (size_t i = 0; i < kBucketCount; i++)
+    {
+        seen += mBuckets[i];
+        if (seen >= rank && seen != 0)
+        {
+            // Bucket upper bounds are exclusive, so the largest value in bucket i is one below it.
+            const uint64_t bucketMax = (i == 0) ? 0 : BucketUpperBound(i) - 1;
+            return bucketMax < mMax ? bucketMax : mMax;
+        }
+    }
+
+    return mMax;
+}
+
+} // namespace Histogram
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,72 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chip {
+namespace Tracing {
+namespace Histogram {
+
+/// A fixed-size histogram with power-of-two bucket boundaries.
+///
+/// Bucket 0 counts zero values and bucket `i` (for i >= 1) counts values
+/// in the range [2^(i-1), 2^i). Values that do not fit in the last bucket
+/// are clamped into it. Recording is O(1) and uses no dynamic memory, which
+/// keeps the cost of aggregating hot-path metrics predictable.
+class Log2Histogram
+{
+public:
+    static constexpr size_t kBucketCount = 33;
+
+    Log2Histogram() { Reset(); }
+
+    void Record(uint64_t value);
+    void Reset();
+
+    uint64_t Count() const { return mCount; }
+    uint64_t Sum() const { return mSum; }
+    uint64_t Min() const { return mCount == 0 ? 0 : mMin; }
+    uint64_t Max() const { return mMax; }
+    uint64_t Mean() const { return mCount == 0 ? 0 : mSum / mCount; }
+
+    uint64_t BucketCount(size_t index) const { return index < kBucketCount ? mBuckets[index] : 0; }
+
+    /// Returns the (exclusive) upper bound of the values counted by the given bucket.
+    static uint64_t BucketUpperBound(size_t index);
+
+    /// Returns the index of the bucket a value is counted in.
+    static size_t BucketIndex(uint64_t value);
+
+    /// Approximates the given percentile (0-100) from the bucket boundaries.
+    ///
+    /// The result is the upper bound of the bucket containing the percentile,
+    /// capped by the largest recorded value.
+    uint64_t Percentile(uint8_t percent) const;
+
+private:
+    uint64_t mBuckets[kBucketCount];
+    uint64_t mCount;
+    uint64_t mSum;
+    uint64_t mMin;
+    uint64_t mMax;
+};
+
+} // namespace Histogram
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,212 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <tracing/histogram/histogram_tracing.h>
+
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <cinttypes>
+#include <cstring>
+
+namespace chip {
+namespace Tracing {
+namespace Histogram {
+
+namespace {
+
+bool SameKey(MetricKey a, MetricKey b)
+{
+    // Metric keys are generally the same string constant, so the pointer comparison
+    // short-circuits the vast majority of lookups.
+    return (a == b) || (strcmp(a, b) == 0);
+}
+
+} // namespace
+
+void LoggingSnapshotDelegate::OnMetricSnapshot(MetricKey key, const Log2Histogram & histogram)
+{
+    ChipLogProgress(Automation,
+                    "Metric %s: count=%" PRIu64 " min=%" PRIu64 " mean=%" PRIu64 " p50=%" PRIu64 " p90=%" PRIu64 " p99=%" PRIu64
+                    " max=%" PRIu64,
+                    key, histogram.Count(), histogram.Min(), histogram.Mean(), histogram.Percentile(50), histogram.Percentile(90),
+                    histogram.Percentile(99), histogram.Max());
+}
+
+void HistogramBackend::SetSnapshotDelegate(SnapshotDelegate * delegate)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mDelegate = (delegate != nullptr) ? delegate : &mLoggingDelegate;
+}
+
+void HistogramBackend::SetSnapshotInterval(System::Clock::Milliseconds32 interval, bool resetAfterSnapshot)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mSnapshotInterval   = interval;
+    mResetAfterSnapshot = resetAfterSnapshot;
+    mNextSnapshot       = System::SystemClock().GetMonotonicTimestamp() + interval;
+}
+
+void HistogramBackend::Snapshot()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    SnapshotLocked();
+}
+
+void HistogramBackend::Reset()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    ResetLocked();
+    for (size_t i = 0; i < mSlotCount; i++)
+    {
+        mSlots[i].hasPendingBegin = false;
+    }
+}
+
+bool HistogramBackend::GetHistogram(MetricKey key, Log2Histogram & histogram) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    const MetricSlot * slot = FindSlot(key);
+    if (slot == nullptr)
+    {
+        return false;
+    }
+    histogram = slot->histogram;
+    return true;
+}
+
+uint32_t HistogramBackend::GetDroppedEventCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mDroppedCount;
+}
+
+void HistogramBackend::LogMetricEvent(const MetricEvent & event)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    MetricSlot * slot = FindOrAllocateSlot(event.key());
+    if (slot == nullptr)
+    {
+        mDroppedCount++;
+        return;
+    }
+
+    switch (event.type())
+    {
+    case MetricEvent::Type::kBeginEvent:
+        slot->beginTime       = System::SystemClock().GetMonotonicMicroseconds64();
+        slot->hasPendingBegin = true;
+        break;
+
+    case MetricEvent::Type::kEndEvent:
+        if (slot->hasPendingBegin)
+        {
+            slot->histogram.Record((System::SystemClock().GetMonotonicMicroseconds64() - slot->beginTime).count());
+            slot->hasPendingBegin = false;
+        }
+        break;
+
+    case MetricEvent::Type::kInstantEvent:
+        switch (event.ValueType())
+        {
+        case MetricEvent::Value::Type::kUInt32:
+            slot->histogram.Record(event.ValueUInt32());
+            break;
+        case MetricEvent::Value::Type::kInt32:
+            // Negative values have no meaningful place in a latency/size histogram; record them as zero.
+            slot->histogram.Record(event.ValueInt32() < 0 ? 0 : static_cast<uint64_t>(event.ValueInt32()));
+            break;
+        case MetricEvent::Value::Type::kChipErrorCode:
+        case MetricEvent::Value::Type::kUndefined:
+            // Occurrence counting only.
+            slot->histogram.Record(0);
+            break;
+        }
+        break;
+    }
+
+    if (mSnapshotInterval > System::Clock::kZero)
+    {
+        const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+        if (now >= mNextSnapshot)
+        {
+            SnapshotLocked();
+            if (mResetAfterSnapshot)
+            {
+                ResetLocked();
+            }
+            mNextSnapshot = now + mSnapshotInterval;
+        }
+    }
+}
+
+HistogramBackend::MetricSlot * HistogramBackend::FindSlot(MetricKey key)
+{
+    for (size_t i = 0; i < mSlotCount; i++)
+    {
+        if (SameKey(mSlots[i].key, key))
+        {
+            return &mSlots[i];
+        }
+    }
+    return nullptr;
+}
+
+const HistogramBackend::MetricSlot * HistogramBackend::FindSlot(MetricKey key) const
+{
+    return const_cast<HistogramBackend *>(this)->FindSlot(key);
+}
+
+HistogramBackend::MetricSlot * HistogramBackend::FindOrAllocateSlot(MetricKey key)
+{
+    MetricSlot * slot = FindSlot(key);
+    if (slot != nullptr || mSlotCount >= kMaxMetrics)
+    {
+        return slot;
+    }
+
+    slot      = &mSlots[mSlotCount++];
+    slot->key = key;
+    return slot;
+}
+
+void HistogramBackend::SnapshotLocked()
+{
+    mDelegate->OnSnapshotBegin();
+    for (size_t i = 0; i < mSlotCount; i++)
+    {
+        if (mSlots[i].histogram.Count() > 0)
+        {
+            mDelegate->OnMetricSnapshot(mSlots[i].key, mSlots[i].histogram);
+        }
+    }
+    mDelegate->OnSnapshotEnd();
+}
+
+void HistogramBackend::ResetLocked()
+{
+    // Keys and outstanding Begin events are kept so that durations spanning
+    // a snapshot window boundary are still recorded.
+    for (size_t i = 0; i < mSlotCount; i++)
+    {
+        mSlots[i].histogram.Reset();
+    }
+    mDroppedCount = 0;
+}
+
+} // namespace Histogram
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,133 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <system/SystemClock.h>
+#include <tracing/backend.h>
+#include <tracing/histogram/histogram.h>
+#include <tracing/metric_event.h>
+
+#include <mutex>
+
+namespace chip {
+namespace Tracing {
+namespace Histogram {
+
+/// Receives the aggregated histograms whenever a snapshot is taken.
+///
+/// Callbacks are made with the backend lock held, so implementations
+/// MUST NOT call back into the HistogramBackend.
+class SnapshotDelegate
+{
+public:
+    virtual ~SnapshotDelegate() = default;
+
+    virtual void OnSnapshotBegin() {}
+    virtual void OnMetricSnapshot(MetricKey key, const Log2Histogram & histogram) = 0;
+    virtual void OnSnapshotEnd() {}
+};
+
+/// Snapshot delegate that writes one summary line per metric to chip logging.
+class LoggingSnapshotDelegate : public SnapshotDelegate
+{
+public:
+    void OnMetricSnapshot(MetricKey key, const Log2Histogram & histogram) override;
+};
+
+/// A Backend that aggregates metric events into per-key histograms.
+///
+/// - Instant metric events with a value record that value (e.g. byte counts,
+///   retransmit counts, lag).
+/// - Begin/End metric event pairs record the elapsed time between them, in
+///   microseconds. Only one outstanding Begin is tracked per key, which matches
+///   how the SDK emits them from synchronous code paths.
+///
+/// Memory use is fixed: at most kMaxMetrics distinct keys are tracked and
+/// events for additional keys are counted as dropped.
+///
+/// Snapshots can be taken explicitly via Snapshot() or periodically by
+/// configuring SetSnapshotInterval, in which case the interval is checked
+/// whenever a metric event is received (no timers are needed).
+///
+/// THREAD SAFETY:
+///    All public methods are guarded by an internal mutex. As this uses
+///    std::mutex, this backend is intended for host builds (like the JSON
+///    backend).
+class HistogramBackend : public ::chip::Tracing::Backend
+{
+public:
+    static constexpr size_t kMaxMetrics = 32;
+
+    HistogramBackend() = default;
+
+    /// Sets where snapshots are delivered. A null delegate restores the default
+    /// delegate that writes snapshots to chip logging.
+    void SetSnapshotDelegate(SnapshotDelegate * delegate);
+
+    /// Take a snapshot automatically every `interval`. A zero interval disables
+    /// periodic snapshots. When `resetAfterSnapshot` is set, histograms are cleared
+    /// after every periodic snapshot so each snapshot covers a single window.
+    void SetSnapshotInterval(System::Clock::Milliseconds32 interval, bool resetAfterSnapshot = false);
+
+    /// Deliver the current state of all histograms to the snapshot delegate.
+    void Snapshot();
+
+    /// Clear all histograms and any outstanding Begin events.
+    void Reset();
+
+    /// Copies the histogram for the given key into `histogram`.
+    ///
+    /// Returns false if no event for that key has been seen.
+    bool GetHistogram(MetricKey key, Log2Histogram & histogram) const;
+
+    /// Number of metric events that could not be recorded because all slots were in use.
+    uint32_t GetDroppedEventCount() const;
+
+    void LogMetricEvent(const MetricEvent & event) override;
+
+private:
+    struct MetricSlot
+    {
+        MetricKey key = nullptr;
+        Log2Histogram histogram;
+        System::Clock::Microseconds64 beginTime = System::Clock::kZero;
+        bool hasPendingBegin                     = false;
+    };
+
+    MetricSlot * FindSlot(MetricKey key);
+    const MetricSlot * FindSlot(MetricKey key) const;
+    MetricSlot * FindOrAllocateSlot(MetricKey key);
+
+    void SnapshotLocked();
+    void ResetLocked();
+
+    mutable std::mutex mMutex;
+    MetricSlot mSlots[kMaxMetrics];
+    size_t mSlotCount      = 0;
+    uint32_t mDroppedCount = 0;
+
+    LoggingSnapshotDelegate mLoggingDelegate;
+    SnapshotDelegate * mDelegate = &mLoggingDelegate;
+
+    System::Clock::Milliseconds32 mSnapshotInterval = System::Clock::kZero;
+    System::Clock::Timestamp mNextSnapshot           = System::Clock::kZero;
+    bool mResetAfterSnapshot                         = false;
+};
+
+} // namespace Histogram
+} // namespace Tracing
+} // namespace chip
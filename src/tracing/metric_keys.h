@@ -54,5 +54,29 @@ constexpr MetricKey kMetricDeviceOperationalDiscoveryAttemptCount = "core_dev_op
 // CASE Session
 constexpr MetricKey kMetricDeviceCASESession = "core_dev_case_session";
 
+// Time spent building (and handing off for sending) a single report chunk for a Read interaction
+constexpr MetricKey kMetricIMReadReportBuild = "core_im_read_report_build";
+
+// Time spent building (and handing off for sending) a single report chunk for a Subscribe interaction
+constexpr MetricKey kMetricIMSubscribeReportBuild = "core_im_subscribe_report_build";
+
+// Number of bytes of AttributeReportIBs encoded into a single report chunk
+constexpr MetricKey kMetricIMAttributeEncodeBytes = "core_im_attribute_encode_bytes";
+
+// Time spent dispatching a single invoked command to its handler
+constexpr MetricKey kMetricIMCommandDispatch = "core_im_command_dispatch";
+
+// Time spent reading the persisted subscriptions to resume at boot
+constexpr MetricKey kMetricIMSubscriptionResumptionLoad = "core_im_subscription_resumption_load";
+
+// Time from queuing persisted subscriptions for resumption until all their sessions were established or failed to
+constexpr MetricKey kMetricIMSubscriptionResumption = "core_im_subscription_resumption";
+
+// Number of MRP retransmissions a reliable message needed before it was acknowledged or given up on
+constexpr MetricKey kMetricMRPRetransmitCount = "core_mrp_retransmit_ctr";
+
+// Delay, in microseconds, between when a periodic timer was due and when the event loop ran it
+constexpr MetricKey kMetricEventLoopLag = "core_sys_event_loop_lag";
+
 } // namespace Tracing
 } // namespace chip
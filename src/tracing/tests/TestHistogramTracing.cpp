@@ -0,0 +1,180 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <tracing/histogram/histogram.h>
+#include <tracing/histogram/histogram_tracing.h>
+#include <tracing/metric_event.h>
+#include <tracing/registry.h>
+
+#include <string>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Tracing;
+using namespace chip::Tracing::Histogram;
+
+namespace {
+
+class CollectingSnapshotDelegate : public SnapshotDelegate
+{
+public:
+    void OnSnapshotBegin() override { mSnapshots++; }
+    void OnMetricSnapshot(MetricKey key, const Log2Histogram & histogram) override
+    {
+        mKeys.push_back(key);
+        mCounts.push_back(histogram.Count());
+    }
+
+    size_t mSnapshots = 0;
+    std::vector<std::string> mKeys;
+    std::vector<uint64_t> mCounts;
+};
+
+TEST(TestHistogramTracing, TestBucketIndex)
+{
+    EXPECT_EQ(Log2Histogram::BucketIndex(0), 0u);
+    EXPECT_EQ(Log2Histogram::BucketIndex(1), 1u);
+    EXPECT_EQ(Log2Histogram::BucketIndex(2), 2u);
+    EXPECT_EQ(Log2Histogram::BucketIndex(3), 2u);
+    EXPECT_EQ(Log2Histogram::BucketIndex(4), 3u);
+    EXPECT_EQ(Log2Histogram::BucketIndex(1023), 10u);
+    EXPECT_EQ(Log2Histogram::BucketIndex(1024), 11u);
+    EXPECT_EQ(Log2Histogram::BucketIndex(UINT64_MAX), Log2Histogram::kBucketCount - 1);
+
+    EXPECT_EQ(Log2Histogram::BucketUpperBound(0), 1u);
+    EXPECT_EQ(Log2Histogram::BucketUpperBound(11), 2048u);
+}
+
+TEST(TestHistogramTracing, TestHistogramStatistics)
+{
+    Log2Histogram histogram;
+
+    EXPECT_EQ(histogram.Count(), 0u);
+    EXPECT_EQ(histogram.Min(), 0u);
+    EXPECT_EQ(histogram.Max(), 0u);
+    EXPECT_EQ(histogram.Percentile(50), 0u);
+
+    for (uint64_t i = 1; i <= 100; i++)
+    {
+        histogram.Record(i);
+    }
+
+    EXPECT_EQ(histogram.Count(), 100u);
+    EXPECT_EQ(histogram.Sum(), 5050u);
+    EXPECT_EQ(histogram.Min(), 1u);
+    EXPECT_EQ(histogram.Max(), 100u);
+    EXPECT_EQ(histogram.Mean(), 50u);
+
+    // 50th sample (value 50) lives in [32, 64)
+    EXPECT_EQ(histogram.Percentile(50), 63u);
+    // 99th sample (value 99) lives in [64, 128), capped by the max value
+    EXPECT_EQ(histogram.Percentile(99), 100u);
+    EXPECT_EQ(histogram.Percentile(0), 1u);
+
+    histogram.Reset();
+    EXPECT_EQ(histogram.Count(), 0u);
+    EXPECT_EQ(histogram.BucketCount(7), 0u);
+}
+
+TEST(TestHistogramTracing, TestInstantAndDurationMetrics)
+{
+    HistogramBackend backend;
+
+    {
+        ScopedRegistration scope(backend);
+
+        MATTER_LOG_METRIC(kMetricIMAttributeEncodeBytes, uint32_t(100));
+        MATTER_LOG_METRIC(kMetricIMAttributeEncodeBytes, uint32_t(300));
+        MATTER_LOG_METRIC(kMetricMRPRetransmitCount, uint8_t(2));
+
+        MATTER_LOG_METRIC_BEGIN(kMetricIMCommandDispatch);
+        MATTER_LOG_METRIC_END(kMetricIMCommandDispatch);
+
+        // An End without a matching Begin does not record a duration
+        MATTER_LOG_METRIC_END(kMetricIMCommandDispatch);
+    }
+
+    Log2Histogram histogram;
+
+    ASSERT_TRUE(backend.GetHistogram(kMetricIMAttributeEncodeBytes, histogram));
+    EXPECT_EQ(histogram.Count(), 2u);
+    EXPECT_EQ(histogram.Min(), 100u);
+    EXPECT_EQ(histogram.Max(), 300u);
+
+    ASSERT_TRUE(backend.GetHistogram(kMetricMRPRetransmitCount, histogram));
+    EXPECT_EQ(histogram.Count(), 1u);
+    EXPECT_EQ(histogram.Sum(), 2u);
+
+    ASSERT_TRUE(backend.GetHistogram(kMetricIMCommandDispatch, histogram));
+    EXPECT_EQ(histogram.Count(), 1u);
+
+    EXPECT_FALSE(backend.GetHistogram(kMetricEventLoopLag, histogram));
+
+    // Keys are matched by value, not only by pointer
+    std::string key(kMetricIMAttributeEncodeBytes);
+    ASSERT_TRUE(backend.GetHistogram(key.c_str(), histogram));
+    EXPECT_EQ(histogram.Count(), 2u);
+}
+
+TEST(TestHistogramTracing, TestSnapshotAndReset)
+{
+    HistogramBackend backend;
+    CollectingSnapshotDelegate delegate;
+    backend.SetSnapshotDelegate(&delegate);
+
+    {
+        ScopedRegistration scope(backend);
+        MATTER_LOG_METRIC(kMetricIMAttributeEncodeBytes, uint32_t(10));
+        MATTER_LOG_METRIC(kMetricEventLoopLag, uint32_t(20));
+    }
+
+    backend.Snapshot();
+    EXPECT_EQ(delegate.mSnapshots, 1u);
+    ASSERT_EQ(delegate.mKeys.size(), 2u);
+    EXPECT_EQ(delegate.mKeys[0], kMetricIMAttributeEncodeBytes);
+    EXPECT_EQ(delegate.mKeys[1], kMetricEventLoopLag);
+    EXPECT_EQ(delegate.mCounts[0], 1u);
+
+    backend.Reset();
+    delegate.mKeys.clear();
+    backend.Snapshot();
+    EXPECT_EQ(delegate.mSnapshots, 2u);
+    EXPECT_TRUE(delegate.mKeys.empty());
+}
+
+TEST(TestHistogramTracing, TestTooManyKeys)
+{
+    HistogramBackend backend;
+    std::vector<std::string> keys;
+
+    for (size_t i = 0; i < HistogramBackend::kMaxMetrics + 2; i++)
+    {
+        keys.push_back("metric_" + std::to_string(i));
+    }
+
+    for (const auto & key : keys)
+    {
+        backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kInstantEvent, key.c_str(), uint32_t(1)));
+    }
+
+    EXPECT_EQ(backend.GetDroppedEventCount(), 2u);
+
+    Log2Histogram histogram;
+    EXPECT_TRUE(backend.GetHistogram(keys[0].c_str(), histogram));
+    EXPECT_FALSE(backend.GetHistogram(keys.back().c_str(), histogram));
+}
+
+} // namespace